@@ -118,6 +118,12 @@ unix {
            HAVE_UNISTD_H
     DEFINES += HAVE_LIBZ
 }
+unix:!android {
+    DEFINES += HAVE_SHM_IQ_IN
+    HEADERS += src/sound/shmiq.h \
+    src/sound/shmiqin.h
+    SOURCES += src/sound/shmiqin.cpp
+}
 unix:!cross_compile {
     !sound {
          # check for pulseaudio before portaudio
@@ -386,6 +392,8 @@ HEADERS += \
     src/datadecoding/DABMOT.h \
     src/datadecoding/DataDecoder.h \
     src/datadecoding/DataEncoder.h \
+    src/datadecoding/epgbin.h \
+    src/datadecoding/epgstore.h \
     src/datadecoding/epgutil.h \
     src/datadecoding/Experiment.h \
     src/datadecoding/journaline/cpplog.h \
@@ -402,6 +410,7 @@ HEADERS += \
     src/datadecoding/MOTSlideShow.h \
     src/DataIO.h \
     src/drmchannel/ChannelSimulation.h \
+    src/drmchannel/IQFileChannel.h \
     src/DrmReceiver.h \
     src/DRMSignalIO.h \
     src/DrmSimulation.h \
@@ -420,16 +429,19 @@ HEADERS += \
     src/MDI/MDIDecode.h \
     src/MDI/MDIDefinitions.h \
     src/MDI/MDIInBuffer.h \
+    src/MDI/MDIOut.h \
     src/MDI/MDIRSCI.h \
     src/MDI/MDITagItemDecoders.h \
     src/MDI/MDITagItems.h \
     src/MDI/PacketInOut.h \
     src/MDI/PacketSinkFile.h \
+    src/MDI/PacketRing.h \
     src/MDI/PacketSocket.h \
     src/MDI/PacketSourceFile.h \
     src/MDI/Pft.h \
     src/MDI/RCITagItems.h \
     src/MDI/RSCITagItemDecoders.h \
+    src/MDI/RSIFanOut.h \
     src/MDI/RSISubscriber.h \
     src/MDI/TagItemDecoder.h \
     src/MDI/TagPacketDecoder.h \
@@ -451,12 +463,14 @@ HEADERS += \
     src/Parameter.h \
     src/PlotManager.h \
     src/ReceptLog.h \
+    src/ReceiverDaemon.h \
     src/resample/ResampleFilter.h \
     src/resample/Resample.h \
     src/Scheduler.h \
     src/SDC/SDC.h \
     src/ServiceInformation.h \
     src/sound/audiofilein.h \
+    src/sound/audiooutput.h \
     src/sound/selectioninterface.h \
     src/sound/sound.h \
     src/sound/soundinterface.h \
@@ -483,16 +497,20 @@ HEADERS += \
     src/UpsampleFilter.h \
     src/util/AudioFile.h \
     src/util/Buffer.h \
+    src/util/ClockDrift.h \
     src/util/CRC.h \
     src/util/FileTyper.h \
     src/util/LibraryLoader.h \
+    src/util/Latency.h \
     src/util/LogPrint.h \
     src/util/Modul.h \
+    src/util/PipelineBuffer.h \
     src/util/Pacer.h \
     src/util/Reassemble.h \
     src/util/Settings.h \
     src/util/Utilities.h \
     src/util/Vector.h \
+    src/util/WorkerPool.h \
     src/Version.h
 SOURCES += \
     src/AMDemodulation.cpp \
@@ -505,6 +523,8 @@ SOURCES += \
     src/datadecoding/DABMOT.cpp \
     src/datadecoding/DataDecoder.cpp \
     src/datadecoding/DataEncoder.cpp \
+    src/datadecoding/epgbin.cpp \
+    src/datadecoding/epgstore.cpp \
     src/datadecoding/epgutil.cpp \
     src/datadecoding/Experiment.cpp \
     src/datadecoding/Journaline.cpp \
@@ -518,6 +538,7 @@ SOURCES += \
     src/datadecoding/MOTSlideShow.cpp \
     src/DataIO.cpp \
     src/drmchannel/ChannelSimulation.cpp \
+    src/drmchannel/IQFileChannel.cpp \
     src/DrmReceiver.cpp \
     src/DRMSignalIO.cpp \
     src/DrmSimulation.cpp \
@@ -533,6 +554,7 @@ SOURCES += \
     src/MDI/AFPacketGenerator.cpp \
     src/MDI/MDIDecode.cpp \
     src/MDI/MDIInBuffer.cpp \
+    src/MDI/MDIOut.cpp \
     src/MDI/MDIRSCI.cpp \
     src/MDI/MDITagItemDecoders.cpp \
     src/MDI/MDITagItems.cpp \
@@ -542,6 +564,7 @@ SOURCES += \
     src/MDI/Pft.cpp \
     src/MDI/RCITagItems.cpp \
     src/MDI/RSCITagItemDecoders.cpp \
+    src/MDI/RSIFanOut.cpp \
     src/MDI/RSISubscriber.cpp \
     src/MDI/TagPacketDecoder.cpp \
     src/MDI/TagPacketDecoderMDI.cpp \
@@ -564,6 +587,7 @@ SOURCES += \
     src/Parameter.cpp \
     src/PlotManager.cpp \
     src/ReceptLog.cpp \
+    src/ReceiverDaemon.cpp \
     src/resample/Resample.cpp \
     src/resample/ResampleFilter.cpp \
     src/Scheduler.cpp \
@@ -572,6 +596,7 @@ SOURCES += \
     src/ServiceInformation.cpp \
     src/SimulationParameters.cpp \
     src/sound/audiofilein.cpp \
+    src/sound/audiooutput.cpp \
     src/sourcedecoders/aac_codec.cpp \
     src/sourcedecoders/AudioCodec.cpp \
     src/sourcedecoders/AudioSourceDecoder.cpp \
@@ -587,12 +612,15 @@ SOURCES += \
     src/tables/TableFAC.cpp \
     src/tables/TableStations.cpp \
     src/TextMessage.cpp \
+    src/util/ClockDrift.cpp \
     src/util/CRC.cpp \
     src/util/FileTyper.cpp \
+    src/util/Latency.cpp \
     src/util/LogPrint.cpp \
     src/util/Reassemble.cpp \
     src/util/Settings.cpp \
     src/util/Utilities.cpp \
+    src/util/WorkerPool.cpp \
     src/Version.cpp
 !console {
 HEADERS += \
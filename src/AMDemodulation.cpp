@@ -58,7 +58,7 @@ void CAMDemodulation::ProcessDataInternal(CParameter& Parameters)
     /* OPH: update free-running symbol counter */
     Parameters.Lock();
     iFreeSymbolCounter++;
-    if (iFreeSymbolCounter >= Parameters.CellMappingTable.iNumSymPerFrame)
+    if (iFreeSymbolCounter >= Parameters.pCellMappingTable->iNumSymPerFrame)
     {
         iFreeSymbolCounter = 0;
     }
@@ -165,7 +165,7 @@ void CAMDemodulation::InitInternal(CParameter& Parameters)
 {
     /* Get parameters from info class */
     Parameters.Lock();
-    iSymbolBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+    iSymbolBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
     iAudSampleRate = Parameters.GetAudSampleRate();
     iSigSampleRate = Parameters.GetSigSampleRate();
     Parameters.Unlock();
@@ -673,8 +673,9 @@ _BOOLEAN CFreqOffsAcq::Run(const CVector<_REAL>& vecrInpData)
         else
         {
             /* Copy vector to matlib vector and calculate real-valued FFT */
+            const _REAL* prHistory = vecrFFTHistory.Window();
             for (int i = 0; i < iTotalBufferSize; i++)
-                vecrFFTInput[i] = vecrFFTHistory[i];
+                vecrFFTInput[i] = prHistory[i];
 
             /* Calculate power spectrum (X = real(F) ^ 2 + imag(F) ^ 2) */
             vecrPSD = SqMag(rfft(vecrFFTInput, FftPlanAcq));
@@ -168,7 +168,7 @@ protected:
     int						iTotalBufferSize;
     int						iHalfBuffer;
     int						iAquisitionCounter;
-    CShiftRegister<_REAL>	vecrFFTHistory;
+    CMirroredShiftRegister<_REAL>	vecrFFTHistory;
     CRealVector				vecrPSD;
     int						iSearchWinStart;
     int						iSearchWinEnd;
@@ -72,7 +72,7 @@ void CAMSSPhaseDemod::InitInternal(CParameter& Parameters)
 {
     /* Get parameters from info class */
     Parameters.Lock();
-    iSymbolBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+    iSymbolBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
     rBPNormBW = CReal(AMSS_IF_FILTER_BW) / Parameters.GetSigSampleRate();
     Parameters.Unlock();
 
@@ -269,7 +269,7 @@ void CAMSSExtractBits::InitInternal(CParameter& Parameters)
 {
     /* Get parameters from info class */
     Parameters.Lock();
-    iSymbolBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+    iSymbolBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
     Parameters.Unlock();
 
     /* Define block-sizes for input and output */
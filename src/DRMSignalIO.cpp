@@ -41,63 +41,128 @@ const static int SineTable[] = { 0, 1, 0, -1, 0 };
 /******************************************************************************\
 * Transmitter                                                                  *
 \******************************************************************************/
-void CTransmitData::ProcessDataInternal(CParameter&)
+/* Output kernels. There is one instance per output format, so each one only
+   computes the two channel values it needs, and the conversion loops have no
+   branches on the format and can be vectorized by the compiler */
+template<int iFormat> struct CTransmitFormat;
+
+template<> struct CTransmitFormat<CTransmitData::OF_REAL_VAL>
 {
-    int i;
+    /* Use real valued signal as output for both sound card channels */
+    static inline void Map(const _COMPLEX& cIn, const _REAL rNorm,
+                           _REAL& rLeft, _REAL& rRight)
+    {
+        rLeft = rRight = cIn.real() * rNorm;
+    }
+};
 
-    /* Apply bandpass filter */
-    BPFilter.Process(*pvecInputData);
+template<> struct CTransmitFormat<CTransmitData::OF_IQ_POS>
+{
+    /* I: left channel, Q: right channel */
+    static inline void Map(const _COMPLEX& cIn, const _REAL rNorm,
+                           _REAL& rLeft, _REAL& rRight)
+    {
+        rLeft = cIn.real() * rNorm;
+        rRight = cIn.imag() * rNorm;
+    }
+};
 
-    /* Convert vector type. Fill vector with symbols (collect them) */
-    const int iNs2 = iInputBlockSize * 2;
-    for (i = 0; i < iNs2; i += 2)
+template<> struct CTransmitFormat<CTransmitData::OF_IQ_NEG>
+{
+    /* I: right channel, Q: left channel */
+    static inline void Map(const _COMPLEX& cIn, const _REAL rNorm,
+                           _REAL& rLeft, _REAL& rRight)
     {
-        const int iCurIndex = iBlockCnt * iNs2 + i;
-        _COMPLEX cInputData = (*pvecInputData)[i / 2];
+        rLeft = cIn.imag() * rNorm;
+        rRight = cIn.real() * rNorm;
+    }
+};
 
-        if (bHighQualityIQ && eOutputFormat != OF_REAL_VAL)
-            HilbertFilt(cInputData);
+template<> struct CTransmitFormat<CTransmitData::OF_EP>
+{
+    /* Envelope: left channel, phase: right channel */
+    static inline void Map(const _COMPLEX& cIn, const _REAL,
+                           _REAL& rLeft, _REAL& rRight)
+    {
+        rLeft = Abs(cIn) * (_REAL) 256.0;
+        rRight = Angle(cIn) * (_REAL) 5000.0; /* 2^15 / pi / 2 -> approx. 5000 */
+    }
+};
 
-        /* Imaginary, real */
-        const _SAMPLE sCurOutReal =
-            Real2Sample(cInputData.real() * rNormFactor);
-        const _SAMPLE sCurOutImag =
-            Real2Sample(cInputData.imag() * rNormFactor);
+template<int iFormat>
+static void ConvertToInt16(const _COMPLEX* pcIn, short* psOut, const int iLen,
+                           const _REAL rNorm)
+{
+    for (int i = 0; i < iLen; i++)
+    {
+        _REAL rLeft, rRight;
+        CTransmitFormat<iFormat>::Map(pcIn[i], rNorm, rLeft, rRight);
+        psOut[2 * i] = Real2Sample(rLeft);
+        psOut[2 * i + 1] = Real2Sample(rRight);
+    }
+}
 
-        /* Envelope, phase */
-        const _SAMPLE sCurOutEnv = 
-            Real2Sample(Abs(cInputData) * (_REAL) 256.0);
-        const _SAMPLE sCurOutPhase = /* 2^15 / pi / 2 -> approx. 5000 */
-            Real2Sample(Angle(cInputData) * (_REAL) 5000.0);
+template<int iFormat>
+static void ConvertToFloat32(const _COMPLEX* pcIn, float* pfOut, const int iLen,
+                             const _REAL rNorm)
+{
+    /* Same scale as the 16 bit output, but without clipping */
+    const _REAL rToFloat = (_REAL) 1.0 / (_REAL) 32768.0;
+    for (int i = 0; i < iLen; i++)
+    {
+        _REAL rLeft, rRight;
+        CTransmitFormat<iFormat>::Map(pcIn[i], rNorm, rLeft, rRight);
+        pfOut[2 * i] = (float) (rLeft * rToFloat);
+        pfOut[2 * i + 1] = (float) (rRight * rToFloat);
+    }
+}
 
-        switch (eOutputFormat)
-        {
-        case OF_REAL_VAL:
-            /* Use real valued signal as output for both sound card channels */
-            vecsDataOut[iCurIndex] = vecsDataOut[iCurIndex + 1] = sCurOutReal;
-            break;
+template<int iFormat>
+static void ConvertBlock(const _COMPLEX* pcIn, short* psOut, float* pfOut,
+                         const int iLen, const _REAL rNorm)
+{
+    if (pfOut != NULL)
+        ConvertToFloat32<iFormat>(pcIn, pfOut, iLen, rNorm);
+    else
+        ConvertToInt16<iFormat>(pcIn, psOut, iLen, rNorm);
+}
 
-        case OF_IQ_POS:
-            /* Send inphase and quadrature (I / Q) signal to stereo sound card
-               output. I: left channel, Q: right channel */
-            vecsDataOut[iCurIndex] = sCurOutReal;
-            vecsDataOut[iCurIndex + 1] = sCurOutImag;
-            break;
+void CTransmitData::ProcessDataInternal(CParameter&)
+{
+    /* Apply bandpass filter */
+    BPFilter.Process(*pvecInputData);
 
-        case OF_IQ_NEG:
-            /* Send inphase and quadrature (I / Q) signal to stereo sound card
-               output. I: right channel, Q: left channel */
-            vecsDataOut[iCurIndex] = sCurOutImag;
-            vecsDataOut[iCurIndex + 1] = sCurOutReal;
-            break;
+    /* The I / Q and envelope / phase outputs can use a better quadrature
+       signal, made from the real part by a Hilbert filter */
+    const _COMPLEX* pcIn = &(*pvecInputData)[0];
+    if (bHighQualityIQ && eOutputFormat != OF_REAL_VAL)
+    {
+        HilbertFilt(*pvecInputData);
+        pcIn = &veccHilbOut[0];
+    }
 
-        case OF_EP:
-            /* Send envelope and phase signal to stereo sound card
-               output. Envelope: left channel, Phase: right channel */
-            vecsDataOut[iCurIndex] = sCurOutEnv;
-            vecsDataOut[iCurIndex + 1] = sCurOutPhase;
-            break;
-        }
+    /* Convert vector type. Fill vector with symbols (collect them) */
+    const int iCurIndex = iBlockCnt * iInputBlockSize * 2;
+    short* psOut = bWriteFloat ? NULL : &vecsDataOut[iCurIndex];
+    float* pfOut = bWriteFloat ? &vecfDataOut[iCurIndex] : NULL;
+
+    switch (eOutputFormat)
+    {
+    case OF_REAL_VAL:
+        ConvertBlock<OF_REAL_VAL>(pcIn, psOut, pfOut, iInputBlockSize, rNormFactor);
+        break;
+
+    case OF_IQ_POS:
+        ConvertBlock<OF_IQ_POS>(pcIn, psOut, pfOut, iInputBlockSize, rNormFactor);
+        break;
+
+    case OF_IQ_NEG:
+        ConvertBlock<OF_IQ_NEG>(pcIn, psOut, pfOut, iInputBlockSize, rNormFactor);
+        break;
+
+    case OF_EP:
+        ConvertBlock<OF_EP>(pcIn, psOut, pfOut, iInputBlockSize, rNormFactor);
+        break;
     }
 
     iBlockCnt++;
@@ -112,10 +177,14 @@ void CTransmitData::FlushData()
     /* Zero the remain of the buffer, if incomplete */
     if (iBlockCnt != iNumBlocks)
     {
-        const int iSize = vecsDataOut.Size();
-        const int iStart = iSize * iBlockCnt / iNumBlocks;
-        for (i = iStart; i < iSize; i++)
-            vecsDataOut[i] = 0;
+        const int iStart = iBigBlockSize * iBlockCnt / iNumBlocks;
+        for (i = iStart; i < iBigBlockSize; i++)
+        {
+            if (bWriteFloat)
+                vecfDataOut[i] = 0;
+            else
+                vecsDataOut[i] = 0;
+        }
     }
 
     iBlockCnt = 0;
@@ -128,19 +197,29 @@ void CTransmitData::FlushData()
     else
     {
         /* Write data to file */
-        for (i = 0; i < iBigBlockSize; i++)
-        {
 #ifdef FILE_DRM_USING_RAW_DATA
-            const short sOut = vecsDataOut[i];
-
-            /* Write 2 bytes, 1 piece */
-            fwrite((const void*) &sOut, size_t(2), size_t(1),
-                   pFileTransmitter);
+        if (bWriteFloat)
+        {
+            fwrite((const void*) &vecfDataOut[0], sizeof(float),
+                   size_t(iBigBlockSize), pFileTransmitter);
+            iFileDataBytes += uint32_t(iBigBlockSize * sizeof(float));
+        }
+        else
+        {
+            fwrite((const void*) &vecsDataOut[0], sizeof(short),
+                   size_t(iBigBlockSize), pFileTransmitter);
+            iFileDataBytes += uint32_t(iBigBlockSize * sizeof(short));
+        }
 #else
-            /* This can be read with Matlab "load" command */
-            fprintf(pFileTransmitter, "%d\n", vecsDataOut[i]);
-#endif
+        /* This can be read with Matlab "load" command */
+        for (i = 0; i < iBigBlockSize; i++)
+        {
+            if (bWriteFloat)
+                fprintf(pFileTransmitter, "%e\n", vecfDataOut[i]);
+            else
+                fprintf(pFileTransmitter, "%d\n", vecsDataOut[i]);
         }
+#endif
 
         /* Flush the file buffer */
         fflush(pFileTransmitter);
@@ -157,26 +236,35 @@ void CTransmitData::InitInternal(CParameter& Parameters)
     /* Get signal sample rate */
     const int iSampleRate = Parameters.GetSigSampleRate();
     /* Define symbol block-size */
-    const int iSymbolBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+    const int iSymbolBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
 
     /* Init vector for storing a complete DRM frame number of OFDM symbols */
     iBlockCnt = 0;
     Parameters.Lock();
-    iNumBlocks = Parameters.CellMappingTable.iNumSymPerFrame;
+    iNumBlocks = Parameters.pCellMappingTable->iNumSymPerFrame;
     ESpecOcc eSpecOcc = Parameters.GetSpectrumOccup();
     Parameters.Unlock();
     iBigBlockSize = iSymbolBlockSize * 2 /* Stereo */ * iNumBlocks;
 
-    /* Init I/Q history */
-    vecrReHist.Init(NUM_TAPS_IQ_INPUT_FILT_HQ, (_REAL) 0.0);
-
-    vecsDataOut.Init(iBigBlockSize);
+    /* Init I/Q history, followed by the real part of the current block */
+    vecrReHist.Init(NUM_TAPS_IQ_INPUT_FILT_HQ - 1 + iSymbolBlockSize, (_REAL) 0.0);
+    veccHilbOut.Init(iSymbolBlockSize);
 
-    if (pFileTransmitter != NULL)
+    /* Float output is only available for files */
+    bWriteFloat = bFloatOutput && bUseSoundcard == FALSE;
+    if (bWriteFloat)
+    {
+        vecfDataOut.Init(iBigBlockSize);
+        vecsDataOut.Init(0);
+    }
+    else
     {
-        fclose(pFileTransmitter);
+        vecsDataOut.Init(iBigBlockSize);
+        vecfDataOut.Init(0);
     }
 
+    CloseFile();
+
     if (bUseSoundcard == TRUE)
     {
         /* Init sound interface */
@@ -195,6 +283,18 @@ void CTransmitData::InitInternal(CParameter& Parameters)
         /* Check for error */
         if (pFileTransmitter == NULL)
             throw CGenErr("The file " + strOutFileName + " cannot be created.");
+
+#ifdef FILE_DRM_USING_RAW_DATA
+        /* Wave header, the lengths are filled in when the file is closed */
+        const size_t iLen = strOutFileName.length();
+        bWaveFile = iLen > 4 &&
+            (strOutFileName.compare(iLen - 4, 4, ".wav") == 0 ||
+             strOutFileName.compare(iLen - 4, 4, ".WAV") == 0);
+        iFileSampleRate = iSampleRate;
+        iFileDataBytes = 0;
+        if (bWaveFile)
+            WriteWaveHeader();
+#endif
     }
 
 
@@ -204,7 +304,7 @@ void CTransmitData::InitInternal(CParameter& Parameters)
     /* All robustness modes and spectrum occupancies should have the same output
        power. Calculate the normaization factor based on the average power of
        symbol (the number 3000 was obtained through output tests) */
-    rNormFactor = (CReal) 3000.0 / Sqrt(Parameters.CellMappingTable.rAvPowPerSymbol);
+    rNormFactor = (CReal) 3000.0 / Sqrt(Parameters.pCellMappingTable->rAvPowPerSymbol);
 
     /* Apply amplification factor, 4.0 = +12dB
        (the maximum without clipping, obtained through output tests) */
@@ -217,26 +317,77 @@ void CTransmitData::InitInternal(CParameter& Parameters)
 CTransmitData::~CTransmitData()
 {
     /* Close file */
-    if (pFileTransmitter != NULL)
-        fclose(pFileTransmitter);
+    CloseFile();
 }
 
-void CTransmitData::HilbertFilt(_COMPLEX& vecData)
+void CTransmitData::CloseFile()
 {
-    int i;
+    if (pFileTransmitter == NULL)
+        return;
 
-    /* Move old data */
-    for (i = 0; i < NUM_TAPS_IQ_INPUT_FILT_HQ - 1; i++)
-        vecrReHist[i] = vecrReHist[i + 1];
+    /* Now the data length is known */
+    if (bWaveFile)
+    {
+        fseek(pFileTransmitter, 0, SEEK_SET);
+        WriteWaveHeader();
+    }
 
-    vecrReHist[NUM_TAPS_IQ_INPUT_FILT_HQ - 1] = vecData.real();
+    fclose(pFileTransmitter);
+    pFileTransmitter = NULL;
+    bWaveFile = FALSE;
+}
 
-    /* Filter */
-    _REAL rSum = (_REAL) 0.0;
-    for (i = 1; i < NUM_TAPS_IQ_INPUT_FILT_HQ; i += 2)
-        rSum += fHilFiltIQ_HQ[i] * vecrReHist[i];
+void CTransmitData::WriteWaveHeader()
+{
+    /* Always stereo, 16 bit PCM or 32 bit IEEE float (format tag 3) */
+    const uint16_t iFormatTag = bWriteFloat ? 3 : 1;
+    const uint16_t iChannels = 2;
+    const uint16_t iBitsPerSample = bWriteFloat ? 32 : 16;
+    const uint16_t iBlockAlign = iChannels * iBitsPerSample / 8;
+    const uint32_t iSamplesPerSec = uint32_t(iFileSampleRate);
+    const uint32_t iAvgBytesPerSec = iSamplesPerSec * iBlockAlign;
+    const uint32_t iFmtLength = 16;
+    const uint32_t iRiffLength = 36 + iFileDataBytes;
+
+    fwrite("RIFF", 1, 4, pFileTransmitter);
+    fwrite(&iRiffLength, 4, 1, pFileTransmitter);
+    fwrite("WAVEfmt ", 1, 8, pFileTransmitter);
+    fwrite(&iFmtLength, 4, 1, pFileTransmitter);
+    fwrite(&iFormatTag, 2, 1, pFileTransmitter);
+    fwrite(&iChannels, 2, 1, pFileTransmitter);
+    fwrite(&iSamplesPerSec, 4, 1, pFileTransmitter);
+    fwrite(&iAvgBytesPerSec, 4, 1, pFileTransmitter);
+    fwrite(&iBlockAlign, 2, 1, pFileTransmitter);
+    fwrite(&iBitsPerSample, 2, 1, pFileTransmitter);
+    fwrite("data", 1, 4, pFileTransmitter);
+    fwrite(&iFileDataBytes, 4, 1, pFileTransmitter);
+}
+
+void CTransmitData::HilbertFilt(const CVectorEx<_COMPLEX>& veccInput)
+{
+    int i, j;
+    const int iHist = NUM_TAPS_IQ_INPUT_FILT_HQ - 1;
+    const int iLen = iInputBlockSize;
 
-    vecData = _COMPLEX(vecrReHist[IQ_INP_HIL_FILT_DELAY_HQ], -rSum);
+    /* Append the real part of the new block to the history */
+    for (i = 0; i < iLen; i++)
+        vecrReHist[iHist + i] = veccInput[i].real();
+
+    /* Filter. Output "i" sees the samples "i" .. "i + iHist", the newest one
+       last. Only the odd taps are non-zero */
+    for (i = 0; i < iLen; i++)
+    {
+        const _REAL* prHist = &vecrReHist[i];
+        _REAL rSum = (_REAL) 0.0;
+        for (j = 1; j < NUM_TAPS_IQ_INPUT_FILT_HQ; j += 2)
+            rSum += fHilFiltIQ_HQ[j] * prHist[j];
+
+        veccHilbOut[i] = _COMPLEX(prHist[IQ_INP_HIL_FILT_DELAY_HQ], -rSum);
+    }
+
+    /* Keep the newest samples as history for the next block */
+    for (i = 0; i < iHist; i++)
+        vecrReHist[i] = vecrReHist[iLen + i];
 }
 
 
@@ -246,6 +397,7 @@ void CTransmitData::HilbertFilt(_COMPLEX& vecData)
 
 //inline _REAL sample2real(_SAMPLE s) { return _REAL(s)/32768.0; }
 inline _REAL sample2real(_SAMPLE s) { return _REAL(s); }
+inline _REAL sample2real(float s) { return _REAL(s) * 32768; } /* +-1.0 */
 
 #ifdef QT_MULTIMEDIA_LIB
 void
@@ -265,6 +417,123 @@ CReceiveData::SetSoundInterface(QAudioInput *p)
 }
 #endif
 
+template<class T> void CReceiveData::ConvertInput(const T* pIn)
+{
+    int i;
+
+    /* Write data to output buffer. Do not set the switch command inside
+       the for-loop for efficiency reasons */
+    switch (eInChanSelection)
+    {
+    case CS_LEFT_CHAN:
+        for (i = 0; i < iOutputBlockSize; i++)
+            (*pvecOutputData)[i] = sample2real(pIn[2 * i]);
+        break;
+
+    case CS_RIGHT_CHAN:
+        for (i = 0; i < iOutputBlockSize; i++)
+            (*pvecOutputData)[i] = sample2real(pIn[2 * i + 1]);
+        break;
+
+    case CS_MIX_CHAN:
+        for (i = 0; i < iOutputBlockSize; i++)
+        {
+            /* Mix left and right channel together */
+            const _REAL rLeftChan = sample2real(pIn[2 * i]);
+            const _REAL rRightChan = sample2real(pIn[2 * i + 1]);
+            (*pvecOutputData)[i] = (rLeftChan + rRightChan) / 2;
+        }
+        break;
+
+    case CS_SUB_CHAN:
+        for (i = 0; i < iOutputBlockSize; i++)
+        {
+            /* Subtract right channel from left */
+            const _REAL rLeftChan = sample2real(pIn[2 * i]);
+            const _REAL rRightChan = sample2real(pIn[2 * i + 1]);
+            (*pvecOutputData)[i] = (rLeftChan - rRightChan) / 2;
+        }
+        break;
+
+        /* I / Q input */
+    case CS_IQ_POS:
+        for (i = 0; i < iOutputBlockSize; i++)
+        {
+            (*pvecOutputData)[i] =
+                HilbertFilt(sample2real(pIn[2 * i]),
+                            sample2real(pIn[2 * i + 1]));
+        }
+        break;
+
+    case CS_IQ_NEG:
+        for (i = 0; i < iOutputBlockSize; i++)
+        {
+            (*pvecOutputData)[i] =
+                HilbertFilt(sample2real(pIn[2 * i + 1]),
+                            sample2real(pIn[2 * i]));
+        }
+        break;
+
+    case CS_IQ_POS_ZERO:
+        for (i = 0; i < iOutputBlockSize; i++)
+        {
+            /* Shift signal to vitual intermediate frequency before applying
+               the Hilbert filtering */
+            _COMPLEX cCurSig = _COMPLEX(sample2real(pIn[2 * i]),
+                                        sample2real(pIn[2 * i + 1]));
+
+            cCurSig *= cCurExp;
+
+            /* Rotate exp-pointer on step further by complex multiplication
+               with precalculated rotation vector cExpStep */
+            cCurExp *= cExpStep;
+
+            (*pvecOutputData)[i] =
+                HilbertFilt(cCurSig.real(), cCurSig.imag());
+        }
+        break;
+
+    case CS_IQ_NEG_ZERO:
+        for (i = 0; i < iOutputBlockSize; i++)
+        {
+            /* Shift signal to vitual intermediate frequency before applying
+               the Hilbert filtering */
+            _COMPLEX cCurSig = _COMPLEX(sample2real(pIn[2 * i + 1]),
+                                        sample2real(pIn[2 * i]));
+
+            cCurSig *= cCurExp;
+
+            /* Rotate exp-pointer on step further by complex multiplication
+               with precalculated rotation vector cExpStep */
+            cCurExp *= cExpStep;
+
+            (*pvecOutputData)[i] =
+                HilbertFilt(cCurSig.real(), cCurSig.imag());
+        }
+        break;
+
+    case CS_IQ_POS_SPLIT: /* Require twice the bandwidth */
+        for (i = 0; i < iOutputBlockSize; i++)
+        {
+            iPhase = (iPhase + 1) & 3;
+            (*pvecOutputData)[i] =
+                sample2real(pIn[2 * i])     * /*COS*/SineTable[iPhase + 1] -
+                sample2real(pIn[2 * i + 1]) * /*SIN*/SineTable[iPhase];
+        }
+        break;
+
+    case CS_IQ_NEG_SPLIT: /* Require twice the bandwidth */
+        for (i = 0; i < iOutputBlockSize; i++)
+        {
+            iPhase = (iPhase + 1) & 3;
+            (*pvecOutputData)[i] =
+                sample2real(pIn[2 * i + 1]) * /*COS*/SineTable[iPhase + 1] -
+                sample2real(pIn[2 * i])     * /*SIN*/SineTable[iPhase];
+        }
+        break;
+    }
+}
+
 void CReceiveData::ProcessDataInternal(CParameter& Parameters)
 {
     int i;
@@ -273,7 +542,7 @@ void CReceiveData::ProcessDataInternal(CParameter& Parameters)
     Parameters.Lock();
 
     iFreeSymbolCounter++;
-    if (iFreeSymbolCounter >= Parameters.CellMappingTable.iNumSymPerFrame * 2) /* x2 because iOutputBlockSize=iSymbolBlockSize/2 */
+    if (iFreeSymbolCounter >= Parameters.pCellMappingTable->iNumSymPerFrame * 2) /* x2 because iOutputBlockSize=iSymbolBlockSize/2 */
     {
         iFreeSymbolCounter = 0;
         /* calculate the PSD once per frame for the RSI output */
@@ -287,6 +556,8 @@ void CReceiveData::ProcessDataInternal(CParameter& Parameters)
 
     /* Get data from sound interface. The read function must be a
        blocking function! */
+    const _SAMPLE* psInput = &vecsSoundBuffer[0];
+    const float* pfInput = NULL;
     bool bBad = true;
     if (pSound == NULL)
     {
@@ -306,7 +577,27 @@ void CReceiveData::ProcessDataInternal(CParameter& Parameters)
     }
     else
     {
-        bBad = pSound->Read(vecsSoundBuffer);
+        /* Interfaces which hold the samples in memory hand them over in
+           place, a float block is only converted for the upscaler */
+        CSoundInInterface::ESampleFormat eFormat;
+        _BOOLEAN bError = FALSE;
+        const void* pInPlace =
+            pSound->ReadInPlace(vecsSoundBuffer.Size() / 2, eFormat, bError);
+
+        if (pInPlace == NULL)
+            bError = pSound->Read(vecsSoundBuffer);
+        else if (eFormat == CSoundInInterface::SF_INT16)
+            psInput = (const _SAMPLE*) pInPlace;
+        else if (iUpscaleRatio > 1)
+        {
+            const float* pfIn = (const float*) pInPlace;
+            for (i = 0; i < vecsSoundBuffer.Size(); i++)
+                vecsSoundBuffer[i] = Real2Sample(pfIn[i] * 32768);
+        }
+        else
+            pfInput = (const float*) pInPlace;
+
+        bBad = bError == TRUE;
     }
     Parameters.Lock();
     Parameters.ReceiveStatus.InterfaceI.SetStatus(bBad ? CRC_ERROR : RX_OK); /* Red light */
@@ -316,8 +607,8 @@ void CReceiveData::ProcessDataInternal(CParameter& Parameters)
     if (iUpscaleRatio > 1)
     {
         /* The actual upscaling, currently only 2X is supported */
-        InterpFIR_2X(2, &vecsSoundBuffer[0], vecf_ZL, vecf_YL, vecf_B);
-        InterpFIR_2X(2, &vecsSoundBuffer[1], vecf_ZR, vecf_YR, vecf_B);
+        InterpFIR_2X(2, &psInput[0], vecf_ZL, vecf_YL, vecf_B);
+        InterpFIR_2X(2, &psInput[1], vecf_ZR, vecf_YR, vecf_B);
 
         /* Write data to output buffer. Do not set the switch command inside
            the for-loop for efficiency reasons */
@@ -425,119 +716,10 @@ void CReceiveData::ProcessDataInternal(CParameter& Parameters)
     }
 
     /* Upscale ratio equal to one */
-	else {
-    /* Write data to output buffer. Do not set the switch command inside
-       the for-loop for efficiency reasons */
-        switch (eInChanSelection)
-        {
-        case CS_LEFT_CHAN:
-            for (i = 0; i < iOutputBlockSize; i++)
-                (*pvecOutputData)[i] = sample2real(vecsSoundBuffer[2 * i]);
-            break;
-
-        case CS_RIGHT_CHAN:
-            for (i = 0; i < iOutputBlockSize; i++)
-                (*pvecOutputData)[i] = sample2real(vecsSoundBuffer[2 * i + 1]);
-            break;
-
-        case CS_MIX_CHAN:
-            for (i = 0; i < iOutputBlockSize; i++)
-            {
-                /* Mix left and right channel together */
-                const _REAL rLeftChan = sample2real(vecsSoundBuffer[2 * i]);
-                const _REAL rRightChan = sample2real(vecsSoundBuffer[2 * i + 1]);
-                (*pvecOutputData)[i] = (rLeftChan + rRightChan) / 2;
-            }
-            break;
-
-        case CS_SUB_CHAN:
-            for (i = 0; i < iOutputBlockSize; i++)
-            {
-                /* Subtract right channel from left */
-                const _REAL rLeftChan = sample2real(vecsSoundBuffer[2 * i]);
-                const _REAL rRightChan = sample2real(vecsSoundBuffer[2 * i + 1]);
-                (*pvecOutputData)[i] = (rLeftChan - rRightChan) / 2;
-            }
-            break;
-
-            /* I / Q input */
-        case CS_IQ_POS:
-            for (i = 0; i < iOutputBlockSize; i++)
-            {
-                (*pvecOutputData)[i] =
-                    HilbertFilt(sample2real(vecsSoundBuffer[2 * i]),
-                                sample2real(vecsSoundBuffer[2 * i + 1]));
-            }
-            break;
-
-        case CS_IQ_NEG:
-            for (i = 0; i < iOutputBlockSize; i++)
-            {
-                (*pvecOutputData)[i] =
-                    HilbertFilt(sample2real(vecsSoundBuffer[2 * i + 1]),
-                                sample2real(vecsSoundBuffer[2 * i]));
-            }
-            break;
-
-        case CS_IQ_POS_ZERO:
-            for (i = 0; i < iOutputBlockSize; i++)
-            {
-                /* Shift signal to vitual intermediate frequency before applying
-                   the Hilbert filtering */
-                _COMPLEX cCurSig = _COMPLEX(sample2real(vecsSoundBuffer[2 * i]),
-                                            sample2real(vecsSoundBuffer[2 * i + 1]));
-
-                cCurSig *= cCurExp;
-
-                /* Rotate exp-pointer on step further by complex multiplication
-                   with precalculated rotation vector cExpStep */
-                cCurExp *= cExpStep;
-
-                (*pvecOutputData)[i] =
-                    HilbertFilt(cCurSig.real(), cCurSig.imag());
-            }
-            break;
-
-        case CS_IQ_NEG_ZERO:
-            for (i = 0; i < iOutputBlockSize; i++)
-            {
-                /* Shift signal to vitual intermediate frequency before applying
-                   the Hilbert filtering */
-                _COMPLEX cCurSig = _COMPLEX(sample2real(vecsSoundBuffer[2 * i + 1]),
-                                            sample2real(vecsSoundBuffer[2 * i]));
-
-                cCurSig *= cCurExp;
-
-                /* Rotate exp-pointer on step further by complex multiplication
-                   with precalculated rotation vector cExpStep */
-                cCurExp *= cExpStep;
-
-                (*pvecOutputData)[i] =
-                    HilbertFilt(cCurSig.real(), cCurSig.imag());
-            }
-            break;
-
-        case CS_IQ_POS_SPLIT: /* Require twice the bandwidth */
-            for (i = 0; i < iOutputBlockSize; i++)
-            {
-                iPhase = (iPhase + 1) & 3;
-                _REAL rValue = vecsSoundBuffer[2 * i]     * /*COS*/SineTable[iPhase + 1] -
-                               vecsSoundBuffer[2 * i + 1] * /*SIN*/SineTable[iPhase];
-                (*pvecOutputData)[i] = sample2real(rValue);
-            }
-            break;
-
-        case CS_IQ_NEG_SPLIT: /* Require twice the bandwidth */
-            for (i = 0; i < iOutputBlockSize; i++)
-            {
-                iPhase = (iPhase + 1) & 3;
-                _REAL rValue = vecsSoundBuffer[2 * i + 1] * /*COS*/SineTable[iPhase + 1] -
-                               vecsSoundBuffer[2 * i]     * /*SIN*/SineTable[iPhase];
-                (*pvecOutputData)[i] = sample2real(rValue);
-            }
-            break;
-        }
-	}
+    else if (pfInput != NULL)
+        ConvertInput(pfInput);
+    else
+        ConvertInput(psInput);
 
     /* Flip spectrum if necessary ------------------------------------------- */
     if (bFippedSpectrum == TRUE)
@@ -580,7 +762,7 @@ void CReceiveData::InitInternal(CParameter& Parameters)
        after some time a buffer overflow occur in the output buffer of
        InputResample.ProcessData() */
     /* Define output block-size */
-    iOutputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize / 2;
+    iOutputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize / 2;
     iMaxOutputBlockSize = iOutputBlockSize * 2;
     /* Get signal sample rate */
     iSampleRate = Parameters.GetSigSampleRate();
@@ -689,7 +871,7 @@ _REAL CReceiveData::HilbertFilt(const _REAL rRe, const _REAL rIm)
     return (rSum + vecrReHist[IQ_INP_HIL_FILT_DELAY]) / 2;
 }
 
-void CReceiveData::InterpFIR_2X(const int channels, _SAMPLE* X, vector<float>& Z, vector<float>& Y, vector<float>& B)
+void CReceiveData::InterpFIR_2X(const int channels, const _SAMPLE* X, vector<float>& Z, vector<float>& Y, vector<float>& B)
 {
 	/*
 	    2X interpolating filter. When combined with CS_IQ_POS_SPLIT or CS_IQ_NEG_SPLIT
@@ -803,8 +985,9 @@ void CReceiveData::GetInputSpec(CVector<_REAL>& vecrData,
     /* Copy data from shift register in Matlib vector */
     CRealVector vecrFFTInput(NUM_SMPLS_4_INPUT_SPECTRUM);
     mutexInpData.Lock();
+    const _REAL* prInpData = vecrInpData.Window();
     for (i = 0; i < NUM_SMPLS_4_INPUT_SPECTRUM; i++)
-        vecrFFTInput[i] = vecrInpData[i];
+        vecrFFTInput[i] = prInpData[i];
     mutexInpData.Unlock();
 
     /* Get squared magnitude of spectrum */
@@ -882,11 +1065,13 @@ void CReceiveData::CalculatePSD(CVector<_REAL>& vecrData,
        of PSD of input signal) */
     CFftPlans FftPlans; int i;
     mutexInpData.Lock();
+    const _REAL* prInpData = vecrInpData.Window();
     for (i = 0; i < iNumAvBlocksPSD; i++)
     {
         /* Copy data from shift register in Matlib vector */
+        const _REAL* prBlock = prInpData + i * (iLenPSDAvEachBlock - iPSDOverlap);
         for (int j = 0; j < iLenPSDAvEachBlock; j++)
-            vecrFFTInput[j] = vecrInpData[j + i * (iLenPSDAvEachBlock - iPSDOverlap)];
+            vecrFFTInput[j] = prBlock[j];
 
         /* Apply Hamming window */
         vecrFFTInput *= vecrHammWin;
@@ -979,8 +1164,8 @@ void CReceiveData::CalculateSigStrengthCorrection(CParameter &Parameters, CVecto
     {
         // Receiver is locked, so measure in the current DRM signal bandwidth Kmin to Kmax
         _REAL rDCFrequency = Parameters.GetDCFrequency();
-        rFreqKmin = rDCFrequency + _REAL(Parameters.CellMappingTable.iCarrierKmin)/Parameters.CellMappingTable.iFFTSizeN * iSampleRate;
-        rFreqKmax = rDCFrequency + _REAL(Parameters.CellMappingTable.iCarrierKmax)/Parameters.CellMappingTable.iFFTSizeN * iSampleRate;
+        rFreqKmin = rDCFrequency + _REAL(Parameters.pCellMappingTable->iCarrierKmin)/Parameters.pCellMappingTable->iFFTSizeN * iSampleRate;
+        rFreqKmax = rDCFrequency + _REAL(Parameters.pCellMappingTable->iCarrierKmax)/Parameters.pCellMappingTable->iFFTSizeN * iSampleRate;
     }
     else
     {
@@ -87,7 +87,8 @@ public:
     CTransmitData(CSoundOutInterface* pNS) : pFileTransmitter(NULL), pSound(pNS),
             eOutputFormat(OF_REAL_VAL), rDefCarOffset((_REAL) VIRTUAL_INTERMED_FREQ),
             strOutFileName("test/TransmittedData.txt"), bUseSoundcard(TRUE),
-            bAmplified(FALSE), bHighQualityIQ(FALSE) {}
+            bAmplified(FALSE), bHighQualityIQ(FALSE), bFloatOutput(FALSE), bWriteFloat(FALSE),
+            bWaveFile(FALSE), iFileSampleRate(0), iFileDataBytes(0) {}
     virtual ~CTransmitData();
 
     void SetIQOutput(const EOutFormat eFormat) {
@@ -111,11 +112,22 @@ public:
         return bHighQualityIQ;
     }
 
+    /* 32 bit float samples (full scale +-1) instead of 16 bit integers when
+       writing to a file, e.g. for SDR transmit chains */
+    void SetFloatOutput(_BOOLEAN bEnable) {
+        bFloatOutput = bEnable;
+    }
+    _BOOLEAN GetFloatOutput() {
+        return bFloatOutput;
+    }
+
     void SetCarOffset(const CReal rNewCarOffset)
     {
         rDefCarOffset = rNewCarOffset;
     }
 
+    /* A file name ending with ".wav" gets a wave header, other files are
+       raw interleaved samples */
     void SetWriteToFile(const string strNFN)
     {
         strOutFileName = strNFN;
@@ -123,11 +135,13 @@ public:
     }
 
     void FlushData();
+    void CloseFile();
 
 protected:
     FILE*				pFileTransmitter;
     CSoundOutInterface*	pSound;
     CVector<short>		vecsDataOut;
+    CVector<float>		vecfDataOut;
     int					iBlockCnt;
     int					iNumBlocks;
     EOutFormat			eOutputFormat;
@@ -144,9 +158,17 @@ protected:
 
     _BOOLEAN			bAmplified;
     _BOOLEAN			bHighQualityIQ;
+    _BOOLEAN			bFloatOutput;
+    _BOOLEAN			bWriteFloat; /* float output and writing to a file */
     CVector<_REAL>		vecrReHist;
+    CVector<_COMPLEX>	veccHilbOut;
+
+    _BOOLEAN			bWaveFile;
+    int					iFileSampleRate;
+    uint32_t			iFileDataBytes;
 
-    void HilbertFilt(_COMPLEX& vecData);
+    void HilbertFilt(const CVectorEx<_COMPLEX>& veccInput);
+    void WriteWaveHeader();
 
     virtual void InitInternal(CParameter& TransmParam);
     virtual void ProcessDataInternal(CParameter& Parameter);
@@ -215,7 +237,7 @@ protected:
 
     /* Access to vecrInpData buffer must be done 
        inside mutexInpData mutex */
-    CShiftRegister<_REAL>	vecrInpData;
+    CMirroredShiftRegister<_REAL>	vecrInpData;
     CMutex                  mutexInpData;
 
     int					iSampleRate;
@@ -253,7 +275,9 @@ protected:
     int FreqToBin(_REAL rFreq);
     _REAL CalcTotalPower(CVector<_REAL> &vecrData, int iStartBin, int iEndBin);
 
-    void InterpFIR_2X(const int channels, _SAMPLE* X, vector<float>& Z, vector<float>& Y, vector<float>& B);
+    void InterpFIR_2X(const int channels, const _SAMPLE* X, vector<float>& Z, vector<float>& Y, vector<float>& B);
+    /* Stereo input without upscaling, in the format of the interface */
+    template<class T> void ConvertInput(const T* pIn);
 };
 
 
@@ -161,7 +161,8 @@ void CWriteData::ProcessDataInternal(CParameter& Parameters)
             bBad = false;
     }
 #else
-    const _BOOLEAN bBad = pSound->Write(vecsTmpAudData);
+    const _BOOLEAN bBad = AudioOutput.IsRunning() ?
+        AudioOutput.Put(vecsTmpAudData) : pSound->Write(vecsTmpAudData);
 #endif
     Parameters.Lock();
     Parameters.ReceiveStatus.InterfaceO.SetStatus(bBad ? DATA_ERROR : RX_OK); /* Yellow light */
@@ -228,8 +229,19 @@ void CWriteData::InitInternal(CParameter& Parameters)
     if (bNewSoundBlocking != bSoundBlocking)
         bSoundBlocking = bNewSoundBlocking;
 
-    /* Init sound interface with blocking or non-blocking behaviour */
-    pSound->Init(iAudSampleRate, iAudFrameSize * 2 /* stereo */, bSoundBlocking);
+#ifndef QT_MULTIMEDIA_LIB
+    /* With a jitter buffer the output thread opens the sound interface with
+       small blocks */
+    if (AudioOutput.IsEnabled())
+        AudioOutput.Start(pSound, iAudSampleRate, iAudFrameSize * 2 /* stereo */);
+    else
+#endif
+    {
+        AudioOutput.Stop();
+
+        /* Init sound interface with blocking or non-blocking behaviour */
+        pSound->Init(iAudSampleRate, iAudFrameSize * 2 /* stereo */, bSoundBlocking);
+    }
 
     /* Init intermediate buffer needed for different channel selections */
     vecsTmpAudData.Init(iAudFrameSize * 2 /* stereo */);
@@ -303,6 +315,7 @@ void CWriteData::GetAudioSpec(CVector<_REAL>& vecrData,
     /* Init vector storing the average spectrum with zeros */
     CVector<_REAL> veccAvSpectrum(iLenPowSpec, (_REAL) 0.0);
 
+    const _SAMPLE* psOutput = vecsOutputData.Window();
     int iCurPosInStream = 0;
     for (i = 0; i < iNumBlocksAvAudioSpec; i++)
     {
@@ -312,7 +325,7 @@ void CWriteData::GetAudioSpec(CVector<_REAL>& vecrData,
         for (j = 0; j < iNumSmpls4AudioSprectrum; j++)
         {
             int jj =  2*(iCurPosInStream + j);
-            veccFFTInput[j] = _REAL(vecsOutputData[jj] + vecsOutputData[jj + 1]) / 2;
+            veccFFTInput[j] = _REAL(psOutput[jj] + psOutput[jj + 1]) / 2;
         }
 
         /* Apply window function */
@@ -853,7 +866,7 @@ void CWriteIQFile::NewFrequency(CParameter &)
 void CWriteIQFile::InitInternal(CParameter& Parameters)
 {
     /* Get parameters from info class */
-    const int iSymbolBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+    const int iSymbolBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
 
     iInputBlockSize = iSymbolBlockSize;
 
@@ -33,6 +33,7 @@
 #define DATA_H__3B0BA660_CA63_4344_BB2B_23E7A0D31912__INCLUDED_
 
 #include "sound/soundinterface.h"
+#include "sound/audiooutput.h"
 #ifdef QT_MULTIMEDIA_LIB
 #include <QIODevice>
 #endif
@@ -70,6 +71,10 @@ public:
     CReadData(CSoundInInterface* pNS) : pSound(pNS) {}
     virtual ~CReadData() {}
 
+    void SetSoundInterface(CSoundInInterface* pS) {
+        pSound = pS;
+    }
+
     _REAL GetLevelMeter() {
         return SignalLevelMeter.Level();
     }
@@ -112,6 +117,21 @@ public:
         SetInitFlag();
     }
 
+    /* Reserve of the jitter buffer in front of the sound card, see
+       CAudioOutput::SetLatency(). 0 writes the audio frames directly */
+    void SetOutputLatency(const int iNewLatencyMs)
+    {
+        AudioOutput.SetLatency(iNewLatencyMs);
+        SetInitFlag();
+    }
+    int GetOutputLatency() const {
+        return AudioOutput.GetLatency();
+    }
+    /* Must be called before the sound interface is closed */
+    void StopOutput() {
+        AudioOutput.Stop();
+    }
+
     void GetAudioSpec(CVector<_REAL>& vecrData, CVector<_REAL>& vecrScale);
 
     void SetOutChanSel(const EOutChanSel eNS) {
@@ -129,6 +149,7 @@ protected:
     QIODevice*              pIODevice;
 #endif
     CSoundOutInterface*		pSound;
+    CAudioOutput			AudioOutput;
     _BOOLEAN				bMuteAudio;
     CWaveFile				WaveFileAudio;
     _BOOLEAN				bDoWriteWaveFile;
@@ -138,7 +159,7 @@ protected:
     EOutChanSel				eOutChanSel;
     _REAL					rMixNormConst;
 
-    CShiftRegister<_SAMPLE>	vecsOutputData;
+    CMirroredShiftRegister<_SAMPLE>	vecsOutputData;
     CFftPlans				FftPlan;
     CComplexVector			veccFFTInput;
     CComplexVector			veccFFTOutput;
@@ -274,8 +295,8 @@ class CDataConvChanResam : public CReceiverModul<CChanSimDataMod, _REAL>
 protected:
     virtual void InitInternal(CParameter& Parameters)
     {
-        iInputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
-        iOutputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+        iInputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
+        iOutputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
     }
     virtual void ProcessDataInternal(CParameter&)
     {
@@ -284,15 +305,34 @@ protected:
     }
 };
 
+/* Same for the transmitter: the channel output is a real valued signal, it is
+   put in the real part at the level the OFDM modulator delivers */
+class CDataConvChanTransm : public CTransmitterModul<CChanSimDataMod, _COMPLEX>
+{
+protected:
+    virtual void InitInternal(CParameter& Parameters)
+    {
+        iInputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
+        iOutputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
+    }
+    virtual void ProcessDataInternal(CParameter&)
+    {
+        /* "/ 2" undoes the gain correction for real valued signals */
+        for (int i = 0; i < iOutputBlockSize; i++)
+            (*pvecOutputData)[i] =
+                _COMPLEX((*pvecInputData)[i].tOut / 2, (_REAL) 0.0);
+    }
+};
+
 /* Takes an input buffer and splits it 2 ways */
 class CSplit: public CReceiverModul<_REAL, _REAL>
 {
 protected:
     virtual void InitInternal(CParameter& Parameters)
     {
-        iInputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
-        iOutputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
-        iOutputBlockSize2 = Parameters.CellMappingTable.iSymbolBlockSize;
+        iInputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
+        iOutputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
+        iOutputBlockSize2 = Parameters.pCellMappingTable->iSymbolBlockSize;
     }
     virtual void ProcessDataInternal(CParameter&)
     {
@@ -40,6 +40,9 @@
 #include "sound/sound.h"
 #include "sound/soundnull.h"
 #include "sound/audiofilein.h"
+#ifdef HAVE_SHM_IQ_IN
+# include "sound/shmiqin.h"
+#endif
 #ifdef QT_MULTIMEDIA_LIB
 #include <QAudioFormat>
 #include <QIODevice>
@@ -73,6 +76,11 @@ CDRMReceiver::CDRMReceiver(CSettings* pSettings) : CDRMTransceiver(pSettings, ne
     eNewReceiverMode(RM_DRM), iAudioStreamID(STREAM_ID_NOT_USED),
     iDataStreamID(STREAM_ID_NOT_USED), bRestartFlag(TRUE),
     rInitResampleOffset((_REAL) 0.0),
+    mapAcqHints(), iAcqHintCnt(0), bUseWarmStart(TRUE), bWarmStart(FALSE),
+    iWarmStartFreq(0), rAcqSignalTime((_REAL) 0.0),
+    rTimeToAudio((_REAL) -1.0), AcqWorkerPool(), iAcqThreads(-1),
+    LatencyStats(), iAcqStartNs(0), strLatencyLogFile(), iLatencyLogPeriod(60),
+    tLatencyLogged(0),
     iBwAM(10000), iBwLSB(5000), iBwUSB(5000), iBwCW(150), iBwFM(6000),
     time_keeper(0),
 #ifdef HAVE_LIBHAMLIB
@@ -87,6 +95,9 @@ CDRMReceiver::CDRMReceiver(CSettings* pSettings) : CDRMTransceiver(pSettings, ne
     Parameters.SetReceiver(this);
     downstreamRSCI.SetReceiver(this);
     PlotManager.SetReceiver(this);
+    FreqSyncAcq.SetWorkerPool(&AcqWorkerPool);
+    TimeSync.SetWorkerPool(&AcqWorkerPool);
+    InitLatencyStats();
 #ifdef HAVE_LIBGPS
     Parameters.gps_data.gps_fd = -1;
 #endif
@@ -94,6 +105,7 @@ CDRMReceiver::CDRMReceiver(CSettings* pSettings) : CDRMTransceiver(pSettings, ne
 
 CDRMReceiver::~CDRMReceiver()
 {
+    WriteData.StopOutput();
     delete pSoundInInterface;
     delete pSoundOutInterface;
     delete pUpstreamRSCI;
@@ -388,6 +400,11 @@ CDRMReceiver::Run()
         downstreamRSCI.poll();
     }
 
+    /* Latency statistics */
+    if ((eReceiverMode == RM_DRM) && (pUpstreamRSCI->GetInEnabled() == FALSE))
+        UpdateAcqMilestones();
+    WriteLatencyLog();
+
     /* Play and/or save the audio */
     if (iAudioStreamID != STREAM_ID_NOT_USED || (eReceiverMode == RM_AM) || (eReceiverMode == RM_FM))
     {
@@ -465,6 +482,7 @@ CDRMReceiver::SetInput()
         {
             ReceiveData.ClearInputData();
             pSoundInInterface = new CSoundInNull();
+            pUpstreamRSCI->SetIngestStats(&LatencyStats);
             pUpstreamRSCI->SetOrigin(rsiOrigin);
         }
         else
@@ -486,6 +504,23 @@ CDRMReceiver::SetInput()
                 Parameters.SetSoundCardSigSampleRate(iSampleRate);
                 pSoundInInterface = AudioFileIn;
             }
+#ifdef HAVE_SHM_IQ_IN
+            else if (CShmIQIn::IsShmDevice(sSndDevIn))
+            {
+                /* I/Q ring of an SDR program, at its sample rate if it is
+                   already there */
+                CShmIQIn* ShmIQIn = new CShmIQIn();
+                ShmIQIn->SetDev(sSndDevIn);
+                const int iSampleRate = ShmIQIn->GetSampleRate();
+                if (iSampleRate > 0)
+                {
+                    if (iPrevSigSampleRate == 0)
+                        iPrevSigSampleRate = Parameters.GetSoundCardSigSampleRate();
+                    Parameters.SetSoundCardSigSampleRate(iSampleRate);
+                }
+                pSoundInInterface = ShmIQIn;
+            }
+#endif
             else
             {
                 /* Open sound card interface */
@@ -608,12 +643,21 @@ CDRMReceiver::DemodulateDRM(_BOOLEAN& bEnoughData)
          * only if no signal was decoded before */
         if (Parameters.eAcquiState == AS_NO_SIGNAL)
         {
-            /* Increment symbol counter and check if bound is reached */
+            /* Increment symbol counter and check if bound is reached. A
+               warm start gets less time before the full acquisition */
             iAcquDetecCnt++;
 
-            if (iAcquDetecCnt > NUM_OFDMSYM_U_ACQ_WITHOUT)
+            if ((iAcquDetecCnt > NUM_OFDMSYM_U_ACQ_WITHOUT) ||
+                (bWarmStart && (iAcquDetecCnt > NUM_OFDMSYM_U_ACQ_WARM)))
                 SetInStartMode();
         }
+
+        /* Signal time since the start of the acquisition */
+        if (rTimeToAudio < (_REAL) 0.0)
+        {
+            rAcqSignalTime += (_REAL) Parameters.pCellMappingTable->iSymbolBlockSize /
+                Parameters.GetSigSampleRate();
+        }
     }
 
     /* OFDM-demodulation ---------------------------------------- */
@@ -726,7 +770,7 @@ CDRMReceiver::UtilizeDRM(_BOOLEAN& bEnoughData)
 
             /* Store the number of correctly decoded audio blocks for
              *                            the history */
-            PlotManager.SetCurrentCDAud(AudioSourceDecoder.GetNumCorDecAudio());
+            AudioDecoded(AudioSourceDecoder.GetNumCorDecAudio());
         }
     }
     if( (iDataStreamID == STREAM_ID_NOT_USED)
@@ -742,7 +786,7 @@ CDRMReceiver::UtilizeDRM(_BOOLEAN& bEnoughData)
 
             /* Store the number of correctly decoded audio blocks for
              *                            the history */
-            PlotManager.SetCurrentCDAud(AudioSourceDecoder.GetNumCorDecAudio());
+            AudioDecoded(AudioSourceDecoder.GetNumCorDecAudio());
         }
     }
 }
@@ -861,7 +905,19 @@ CDRMReceiver::DetectAcquiFAC()
             if (iDelayedTrackModeCnt > 0)
                 iDelayedTrackModeCnt--;
             else
+            {
                 SetInTrackingModeDelayed();
+
+                /* The sample rate offset is tracked now */
+                UpdateClockDrift();
+            }
+
+            /* Remember the parameters of a fully decoded signal */
+            if ((Parameters.ReceiveStatus.SDC.GetStatus() == RX_OK) &&
+                (Parameters.ReceiveStatus.SLAudio.GetStatus() == RX_OK))
+            {
+                StoreAcqHint();
+            }
         }
         else
         {
@@ -1079,6 +1135,7 @@ CDRMReceiver::Start()
 void
 CDRMReceiver::CloseSoundInterfaces()
 {
+    WriteData.StopOutput(); /* the output thread writes to the sound card */
     pSoundInInterface->Close();
     pSoundOutInterface->Close();
 #ifdef QT_MULTIMEDIA_LIB
@@ -1104,18 +1161,44 @@ CDRMReceiver::SetInStartMode()
 {
     iUnlockedCount = MAX_UNLOCKED_COUNT;
 
+    /* A warm start which did not find the signal again is not tried twice */
+    if (bWarmStart && (Parameters.eAcquiState == AS_NO_SIGNAL))
+        mapAcqHints.erase(iWarmStartFreq);
+
+    const CAcqHint* pHint = GetAcqHint();
+    bWarmStart = pHint != NULL;
+    rAcqSignalTime = (_REAL) 0.0;
+    rTimeToAudio = (_REAL) -1.0;
+
+    /* Lock milestones are measured from here */
+    iAcqStartNs = CLatencyStats::GetTimeNs();
+    for (int i = 0; i < NUM_ACQ_MILESTONES; i++)
+        rAcqMilestoneTime[i] = (_REAL) -1.0;
+
     Parameters.Lock();
     /* Load start parameters for all modules */
+    iWarmStartFreq = Parameters.GetFrequency();
 
-    /* Define with which parameters the receiver should try to decode the
-       signal. If we are correct with our assumptions, the receiver does not
-       need to reinitialize */
-    Parameters.InitCellMapTable(RM_ROBUSTNESS_MODE_B, SO_3);
+    if (pHint != NULL)
+    {
+        /* Use the parameters of the last good reception on this frequency */
+        Parameters.InitCellMapTable(pHint->eRobustnessMode, pHint->eSpectOccup);
+        Parameters.SetInterleaverDepth(pHint->eSymbolInterlMode);
+        Parameters.SetMSCCodingScheme(pHint->eMSCCodingScheme);
+        Parameters.SetSDCCodingScheme(pHint->eSDCCodingScheme);
+    }
+    else
+    {
+        /* Define with which parameters the receiver should try to decode the
+           signal. If we are correct with our assumptions, the receiver does not
+           need to reinitialize */
+        Parameters.InitCellMapTable(RM_ROBUSTNESS_MODE_B, SO_3);
 
-    /* Set initial MLC parameters */
-    Parameters.SetInterleaverDepth(CParameter::SI_LONG);
-    Parameters.SetMSCCodingScheme(CS_3_SM);
-    Parameters.SetSDCCodingScheme(CS_2_SM);
+        /* Set initial MLC parameters */
+        Parameters.SetInterleaverDepth(CParameter::SI_LONG);
+        Parameters.SetMSCCodingScheme(CS_3_SM);
+        Parameters.SetSDCCodingScheme(CS_2_SM);
+    }
 
     /* Select the service we want to decode. Always zero, because we do not
        know how many services are transmitted in the signal we want to
@@ -1143,11 +1226,27 @@ CDRMReceiver::SetInStartMode()
     Parameters.iFrameIDReceiv = 0;
 
     /* Set synchronization parameters */
-    Parameters.rResampleOffset = rInitResampleOffset;	/* Initial resample offset */
+    Parameters.rResampleOffset = GetInitResampleOffset();	/* Initial resample offset */
     Parameters.rFreqOffsetAcqui = (_REAL) 0.0;
     Parameters.rFreqOffsetTrack = (_REAL) 0.0;
     Parameters.iTimingOffsTrack = 0;
 
+    if (pHint != NULL)
+    {
+        /* Services and streams as described by the last SDC, the SDC
+           decoder overwrites them as soon as a new SDC block arrives */
+        Parameters.MSCPrLe = pHint->MSCPrLe;
+        Parameters.iNumAudioService = pHint->iNumAudioService;
+        Parameters.iNumDataService = pHint->iNumDataService;
+        for (size_t i = 0; i < pHint->Service.size(); i++)
+            Parameters.Service[i] = pHint->Service[i];
+        for (size_t i = 0; i < pHint->Stream.size(); i++)
+            Parameters.Stream[i] = pHint->Stream[i];
+
+        Parameters.rResampleOffset = pHint->rResampleOffset;
+        Parameters.rFreqOffsetAcqui = pHint->rFreqOffset;
+    }
+
     Parameters.Unlock();
 
     /* Initialization of the modules */
@@ -1163,6 +1262,14 @@ CDRMReceiver::SetInStartMode()
     SyncUsingPil.StartAcquisition();
     SyncUsingPil.StopTrackPil();
 
+    if (pHint != NULL)
+    {
+        /* Frequency offset and robustness mode are known, only the timing
+           has to be found */
+        FreqSyncAcq.StopAcquisition();
+        TimeSync.StopRMDetAcqu();
+    }
+
     Parameters.Lock();
     /* Set flag that no signal is currently received */
     Parameters.eAcquiState = AS_NO_SIGNAL;
@@ -1218,6 +1325,210 @@ CDRMReceiver::SetInStartMode()
     }
 }
 
+const CAcqHint*
+CDRMReceiver::GetAcqHint()
+{
+    if (!bUseWarmStart || (pUpstreamRSCI->GetInEnabled() == TRUE))
+        return NULL;
+
+    Parameters.Lock();
+    const int iFreq = Parameters.GetFrequency();
+    const int iSigSampleRate = Parameters.GetSigSampleRate();
+    Parameters.Unlock();
+
+    map<int, CAcqHint>::iterator it = mapAcqHints.find(iFreq);
+    if ((it == mapAcqHints.end()) || (it->second.iSigSampleRate != iSigSampleRate))
+        return NULL;
+
+    it->second.iLastUsed = ++iAcqHintCnt;
+    return &it->second;
+}
+
+void
+CDRMReceiver::StoreAcqHint()
+{
+    if (!bUseWarmStart)
+        return;
+
+    Parameters.Lock();
+    CAcqHint& Hint = mapAcqHints[Parameters.GetFrequency()];
+    Hint.iSigSampleRate = Parameters.GetSigSampleRate();
+    Hint.eRobustnessMode = Parameters.GetWaveMode();
+    Hint.eSpectOccup = Parameters.GetSpectrumOccup();
+    Hint.eSymbolInterlMode = Parameters.GetInterleaverDepth();
+    Hint.eMSCCodingScheme = Parameters.eMSCCodingScheme;
+    Hint.eSDCCodingScheme = Parameters.eSDCCodingScheme;
+    Hint.rFreqOffset = Parameters.rFreqOffsetAcqui + Parameters.rFreqOffsetTrack;
+    Hint.rResampleOffset = Parameters.rResampleOffset;
+    Hint.MSCPrLe = Parameters.MSCPrLe;
+    Hint.iNumAudioService = Parameters.iNumAudioService;
+    Hint.iNumDataService = Parameters.iNumDataService;
+    Hint.Service = Parameters.Service;
+    Hint.Stream = Parameters.Stream;
+    Hint.iLastUsed = ++iAcqHintCnt;
+    Parameters.Unlock();
+
+    /* Forget the frequency which was not used for the longest time */
+    if (mapAcqHints.size() > MAX_NUM_ACQ_HINTS)
+    {
+        map<int, CAcqHint>::iterator itOldest = mapAcqHints.begin();
+        for (map<int, CAcqHint>::iterator it = mapAcqHints.begin();
+            it != mapAcqHints.end(); it++)
+        {
+            if (it->second.iLastUsed < itOldest->second.iLastUsed)
+                itOldest = it;
+        }
+        mapAcqHints.erase(itOldest);
+    }
+}
+
+_REAL
+CDRMReceiver::GetInitResampleOffset()
+{
+    /* Called with the parameters locked. A start value which was set
+       explicitly wins over the learned drift of the sound card */
+    if (rInitResampleOffset != (_REAL) 0.0)
+        return rInitResampleOffset;
+
+    if ((rsiOrigin != "") || (sSoundFile != "") || (pSoundInInterface == NULL))
+        return (_REAL) 0.0;
+
+    _REAL rOffsetPPM;
+    ClockDrift.SetDevice(pSoundInInterface->GetDev());
+    if (ClockDrift.GetOffsetPPM(rOffsetPPM) == FALSE)
+        return (_REAL) 0.0;
+
+    return rOffsetPPM * (_REAL) 1e-6 * Parameters.GetSigSampleRate();
+}
+
+void
+CDRMReceiver::UpdateClockDrift()
+{
+    /* Files and network inputs have no clock of their own */
+    Parameters.Lock();
+    if ((rsiOrigin == "") && (sSoundFile == "") && (pSoundInInterface != NULL))
+    {
+        ClockDrift.SetDevice(pSoundInInterface->GetDev());
+        ClockDrift.Update(Parameters.rResampleOffset * (_REAL) 1e6 /
+            Parameters.GetSigSampleRate());
+    }
+    Parameters.Unlock();
+}
+
+void
+CDRMReceiver::AudioDecoded(int iNumCorDecAudio)
+{
+    PlotManager.SetCurrentCDAud(iNumCorDecAudio);
+
+    if ((iNumCorDecAudio > 0) && (rTimeToAudio < (_REAL) 0.0))
+    {
+        rTimeToAudio = rAcqSignalTime;
+    }
+}
+
+void
+CDRMReceiver::InitLatencyStats()
+{
+    static const char* strMilestoneName[NUM_ACQ_MILESTONES] =
+        {"acq.freq", "acq.time", "acq.fac", "acq.sdc", "acq.audio"};
+
+    for (int i = 0; i < NUM_ACQ_MILESTONES; i++)
+    {
+        pAcqMilestoneHist[i] =
+            LatencyStats.GetHistogram(strMilestoneName[i], FALSE);
+        rAcqMilestoneTime[i] = (_REAL) -1.0;
+    }
+
+    /* Sound card and file I/O mostly waits for data, it is not counted as
+       processing time */
+    ReceiveData.SetLatencyStats(&LatencyStats, "io.input", FALSE);
+    WriteData.SetLatencyStats(&LatencyStats, "io.output", FALSE);
+    WriteIQFile.SetLatencyStats(&LatencyStats, "io.iqrecord", FALSE);
+
+    InputResample.SetLatencyStats(&LatencyStats, "mod.resample");
+    FreqSyncAcq.SetLatencyStats(&LatencyStats, "mod.freqsyncacq");
+    TimeSync.SetLatencyStats(&LatencyStats, "mod.timesync");
+    OFDMDemodulation.SetLatencyStats(&LatencyStats, "mod.ofdmdemod");
+    SyncUsingPil.SetLatencyStats(&LatencyStats, "mod.syncusingpil");
+    ChannelEstimation.SetLatencyStats(&LatencyStats, "mod.chanest");
+    OFDMCellDemapping.SetLatencyStats(&LatencyStats, "mod.celldemap");
+    FACMLCDecoder.SetLatencyStats(&LatencyStats, "mod.facdec");
+    UtilizeFACData.SetLatencyStats(&LatencyStats, "mod.facuse");
+    SDCMLCDecoder.SetLatencyStats(&LatencyStats, "mod.sdcdec");
+    UtilizeSDCData.SetLatencyStats(&LatencyStats, "mod.sdcuse");
+    SymbDeinterleaver.SetLatencyStats(&LatencyStats, "mod.deinterleaver");
+    MSCMLCDecoder.SetLatencyStats(&LatencyStats, "mod.mscdec");
+    MSCDemultiplexer.SetLatencyStats(&LatencyStats, "mod.mscdemux");
+    AudioSourceDecoder.SetLatencyStats(&LatencyStats, "mod.audiodec");
+    DataDecoder.SetLatencyStats(&LatencyStats, "mod.datadec");
+    Split.SetLatencyStats(&LatencyStats, "mod.split");
+    SplitForIQRecord.SetLatencyStats(&LatencyStats, "mod.split");
+    SplitAudio.SetLatencyStats(&LatencyStats, "mod.split");
+    AudioSourceEncoder.SetLatencyStats(&LatencyStats, "mod.audioenc");
+    SplitFAC.SetLatencyStats(&LatencyStats, "mod.split");
+    SplitSDC.SetLatencyStats(&LatencyStats, "mod.split");
+    for (int i = 0; i < MAX_NUM_STREAMS; i++)
+        SplitMSC[i].SetLatencyStats(&LatencyStats, "mod.split");
+    ConvertAudio.SetLatencyStats(&LatencyStats, "mod.convertaudio");
+    AMDemodulation.SetLatencyStats(&LatencyStats, "mod.amdemod");
+    AMSSPhaseDemod.SetLatencyStats(&LatencyStats, "mod.amssphase");
+    AMSSExtractBits.SetLatencyStats(&LatencyStats, "mod.amssbits");
+    AMSSDecode.SetLatencyStats(&LatencyStats, "mod.amssdec");
+    DecodeRSIMDI.SetLatencyStats(&LatencyStats, "mod.rsciin");
+}
+
+void
+CDRMReceiver::UpdateAcqMilestones()
+{
+    _BOOLEAN bReached[NUM_ACQ_MILESTONES];
+
+    Parameters.Lock();
+    bReached[AM_FREQ_ACQU] = FreqSyncAcq.GetAcquisition() == FALSE;
+    bReached[AM_TIME_ACQU] = Parameters.ReceiveStatus.TSync.GetStatus() == RX_OK;
+    bReached[AM_FAC_LOCK] = Parameters.eAcquiState == AS_WITH_SIGNAL;
+    bReached[AM_SDC_LOCK] = Parameters.ReceiveStatus.SDC.GetStatus() == RX_OK;
+    bReached[AM_FIRST_AUDIO] = Parameters.ReceiveStatus.SLAudio.GetStatus() == RX_OK;
+    Parameters.Unlock();
+
+    uint64_t iNowNs = 0;
+    for (int i = 0; i < NUM_ACQ_MILESTONES; i++)
+    {
+        if ((bReached[i] == TRUE) && (rAcqMilestoneTime[i] < (_REAL) 0.0))
+        {
+            if (iNowNs == 0)
+                iNowNs = CLatencyStats::GetTimeNs();
+
+            rAcqMilestoneTime[i] = (_REAL) (iNowNs - iAcqStartNs) / 1e9;
+            LatencyStats.Add(pAcqMilestoneHist[i], iNowNs - iAcqStartNs);
+        }
+    }
+}
+
+void
+CDRMReceiver::WriteLatencyLog()
+{
+    if (strLatencyLogFile.empty())
+        return;
+
+    const time_t tNow = time(NULL);
+    if (tNow - tLatencyLogged < iLatencyLogPeriod)
+        return;
+    tLatencyLogged = tNow;
+
+    FILE* pFile = fopen(strLatencyLogFile.c_str(), "a");
+    if (pFile == NULL)
+        return;
+
+    vector<string> vecstrLines;
+    LatencyStats.GetReport(vecstrLines);
+
+    char strTime[32];
+    strftime(strTime, sizeof(strTime), "%Y-%m-%d %H:%M:%S", gmtime(&tNow));
+    for (size_t i = 0; i < vecstrLines.size(); i++)
+        fprintf(pFile, "%s %s\n", strTime, vecstrLines[i].c_str());
+    fclose(pFile);
+}
+
 void
 CDRMReceiver::SetInTrackingMode()
 {
@@ -1629,6 +1940,31 @@ CDRMReceiver::LoadSettings()
     Parameters.SetDataDirectory(sDataFilesDirectory);
     s.Put("Receiver", "datafilesdirectory", Parameters.GetDataDirectory());
 
+    /* MOT object store: memory budget per decoder in kB, finished objects
+       are optionally spilled to disk instead of being dropped */
+    const int iMOTCacheSize = s.Get("Receiver", "motcachesize",
+        int(DEFAULT_MOT_CACHE_BUDGET / 1024));
+    const bool bMOTCacheSpill = s.Get("Receiver", "motcachespill", false);
+    DataDecoder.SetMOTCacheLimits(size_t(iMOTCacheSize) * 1024,
+        bMOTCacheSpill ? Parameters.GetDataDirectory("MOTCache") : string());
+    s.Put("Receiver", "motcachesize", iMOTCacheSize);
+    s.Put("Receiver", "motcachespill", bMOTCacheSpill);
+
+    /* Start the acquisition with the parameters of the last good reception
+       on the same frequency */
+    bUseWarmStart = s.Get("Receiver", "warmstart", true) ? TRUE : FALSE;
+
+    /* Threads for the parallel robustness mode and frequency search */
+    iAcqThreads = s.Get("Receiver", "acqthreads", int(-1));
+    AcqWorkerPool.SetNumThreads(iAcqThreads < 0 ?
+        CWorkerPool::DefaultNumThreads(NUM_ROBUSTNESS_MODES) : iAcqThreads);
+
+    /* Latency statistics, optionally appended to a file every
+       "latencylogperiod" seconds */
+    LatencyStats.SetEnabled(s.Get("Receiver", "latencystats", true) ? TRUE : FALSE);
+    strLatencyLogFile = s.Get("Receiver", "latencylog", string());
+    iLatencyLogPeriod = s.Get("Receiver", "latencylogperiod", int(60));
+
     /* Receiver ------------------------------------------------------------- */
 
     /* Sound card audio sample rate, some settings below depends on this one */
@@ -1708,6 +2044,9 @@ CDRMReceiver::LoadSettings()
     /* Sound In device */
     pSoundInInterface->SetDev(s.Get("Receiver", "snddevin", string()));
 
+    /* Learned clock drift of the sound cards */
+    ClockDrift.LoadSettings(s);
+
     /* Sound Out device */
     pSoundOutInterface->SetDev(s.Get("Receiver", "snddevout", string()));
 
@@ -1758,6 +2097,9 @@ CDRMReceiver::LoadSettings()
     /* Mute audio flag */
     WriteData.MuteAudio(s.Get("Receiver", "muteaudio", FALSE));
 
+    /* Audio output jitter buffer, ms. 0: off */
+    WriteData.SetOutputLatency(s.Get("Receiver", "audiolatency", int(0)));
+
     /* Output to File */
     str = s.Get("command", "writewav");
     if (str != "")
@@ -1844,6 +2186,12 @@ CDRMReceiver::SaveSettings()
 
     s.Put("Receiver", "mode", int(eReceiverMode));
 
+    s.Put("Receiver", "warmstart", bUseWarmStart == TRUE);
+    s.Put("Receiver", "acqthreads", iAcqThreads);
+    s.Put("Receiver", "latencystats", LatencyStats.GetEnabled() == TRUE);
+    s.Put("Receiver", "latencylog", strLatencyLogFile);
+    s.Put("Receiver", "latencylogperiod", iLatencyLogPeriod);
+
     /* Receiver ------------------------------------------------------------- */
 
     /* Fetch new sample rate if any */
@@ -1882,6 +2230,9 @@ CDRMReceiver::SaveSettings()
     /* Mute audio flag */
     s.Put("Receiver", "muteaudio", WriteData.GetMuteAudio());
 
+    /* Audio output jitter buffer */
+    s.Put("Receiver", "audiolatency", WriteData.GetOutputLatency());
+
     /* Reverberation */
     s.Put("Receiver", "reverb", AudioSourceDecoder.GetReverbEffect());
 
@@ -1894,6 +2245,9 @@ CDRMReceiver::SaveSettings()
     /* Sound In device */
     s.Put("Receiver", "snddevin", pSoundInInterface->GetDev());
 
+    /* Learned clock drift of the sound cards */
+    ClockDrift.SaveSettings(s);
+
     /* Sound Out device */
     s.Put("Receiver", "snddevout", pSoundOutInterface->GetDev());
 
@@ -1963,7 +2317,7 @@ CDRMReceiver::SaveSettings()
 
 void CConvertAudio::InitInternal(CParameter& Parameters)
 {
-    iInputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+    iInputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
     iOutputBlockSize = 2*iInputBlockSize;
     iMaxOutputBlockSize = 2 * int((_REAL) Parameters.GetAudSampleRate() * (_REAL) 0.4 /* 400 ms */);
 }
@@ -39,6 +39,7 @@
 #include "Parameter.h"
 #include "util/Buffer.h"
 #include "util/Utilities.h"
+#include "util/ClockDrift.h"
 #include "DataIO.h"
 #include "OFDM.h"
 #include "DRMSignalIO.h"
@@ -77,11 +78,51 @@
    for initalizing the channel estimation */
 #define NUM_FAC_DEL_TRACK_SWITCH		2
 
+/* Number of OFDM symbols a warm start (see CAcqHint) may take before the
+   full acquisition is started */
+#define NUM_OFDMSYM_U_ACQ_WARM			75
+
+/* Maximum number of frequencies for which acquisition results are kept */
+#define MAX_NUM_ACQ_HINTS				64
+
 /* Length of the history for synchronization parameters (used for the plot) */
 #define LEN_HIST_PLOT_SYNC_PARMS		2250
 
 
 /* Classes ********************************************************************/
+/* Acquisition results of the last good reception on a frequency. After a
+   fade or a retune to that frequency they are tried first, so only the
+   timing has to be found and the audio can be decoded before the next SDC
+   block arrives */
+class CAcqHint
+{
+public:
+    CAcqHint() : iSigSampleRate(0), eRobustnessMode(RM_ROBUSTNESS_MODE_B),
+        eSpectOccup(SO_3), eSymbolInterlMode(CParameter::SI_LONG),
+        eMSCCodingScheme(CS_3_SM), eSDCCodingScheme(CS_2_SM),
+        rFreqOffset((_REAL) 0.0), rResampleOffset((_REAL) 0.0), MSCPrLe(),
+        iNumAudioService(0), iNumDataService(0), Service(), Stream(),
+        iLastUsed(0) {}
+
+    int							iSigSampleRate;
+    ERobMode					eRobustnessMode;
+    ESpecOcc					eSpectOccup;
+    CParameter::ESymIntMod		eSymbolInterlMode;
+    ECodScheme					eMSCCodingScheme;
+    ECodScheme					eSDCCodingScheme;
+    _REAL						rFreqOffset; /* Acquisition plus tracking */
+    _REAL						rResampleOffset;
+
+    /* SDC contents */
+    CMSCProtLev					MSCPrLe;
+    size_t						iNumAudioService;
+    size_t						iNumDataService;
+    vector<CService>			Service;
+    vector<CStream>				Stream;
+
+    unsigned int				iLastUsed;
+};
+
 class CSettings;
 class CRig;
 
@@ -139,6 +180,10 @@ public:
 
     enum ESFStatus { SF_SNDCARDIN, SF_SNDFILEIN, SF_RSCIMDIIN };
 
+    /* Lock milestones of an acquisition, in the order they are reached */
+    enum EAcqMilestone { AM_FREQ_ACQU, AM_TIME_ACQU, AM_FAC_LOCK, AM_SDC_LOCK,
+                         AM_FIRST_AUDIO, NUM_ACQ_MILESTONES };
+
     CDRMReceiver(CSettings* pSettings=NULL);
     virtual ~CDRMReceiver();
 
@@ -176,6 +221,22 @@ public:
     {
         rInitResampleOffset = rNRO;
     }
+    /* Processing time of every module and time to each lock milestone */
+    CLatencyStats&			GetLatencyStats() {
+        return LatencyStats;
+    }
+    /* Seconds from the start of the acquisition, negative if not reached */
+    _REAL					GetAcqMilestoneTime(EAcqMilestone eMilestone) {
+        return rAcqMilestoneTime[eMilestone];
+    }
+    /* Signal time in seconds from the start of the last acquisition until
+       the first audio frame was decoded, negative while still waiting */
+    _REAL					GetTimeToAudio() {
+        return rTimeToAudio;
+    }
+    _BOOLEAN				GetWarmStart() {
+        return bWarmStart;
+    }
     void					SetAMDemodType(CAMDemodulation::EDemodType);
     void					SetAMFilterBW(int iBw);
     void					SetAMDemodAcq(_REAL rNewNorCen);
@@ -321,6 +382,11 @@ protected:
     void					SetInStartMode();
     void					SetInTrackingMode();
     void					SetInTrackingModeDelayed();
+    const CAcqHint*			GetAcqHint();
+    void					StoreAcqHint();
+    _REAL					GetInitResampleOffset();
+    void					UpdateClockDrift();
+    void					AudioDecoded(int iNumCorDecAudio);
     void					InitsForAllModules();
     void					Run();
     void					SetInput();
@@ -335,6 +401,9 @@ protected:
     void					DecodeFM(_BOOLEAN&);
     void					UtilizeFM(_BOOLEAN&);
     void					DetectAcquiFAC();
+    void					UpdateAcqMilestones();
+    void					WriteLatencyLog();
+    void					InitLatencyStats();
     void					DetectAcquiSymbol();
     void					InitReceiverMode();
     void					saveSDCtoFile();
@@ -429,6 +498,29 @@ protected:
     _BOOLEAN				bRestartFlag;
 
     _REAL					rInitResampleOffset;
+    CClockDriftModel		ClockDrift; /* of the sound card input */
+
+    /* Warm start and time to audio */
+    map<int, CAcqHint>		mapAcqHints; /* Key is the frequency in kHz */
+    unsigned int			iAcqHintCnt;
+    _BOOLEAN				bUseWarmStart;
+    _BOOLEAN				bWarmStart;
+    int						iWarmStartFreq;
+    _REAL					rAcqSignalTime;
+    _REAL					rTimeToAudio;
+
+    /* Threads for the acquisition search, "-1" for the number of idle cores */
+    CWorkerPool				AcqWorkerPool;
+    int						iAcqThreads;
+
+    /* Latency statistics */
+    CLatencyStats			LatencyStats;
+    CLatencyHistogram*		pAcqMilestoneHist[NUM_ACQ_MILESTONES];
+    _REAL					rAcqMilestoneTime[NUM_ACQ_MILESTONES];
+    uint64_t				iAcqStartNs;
+    string					strLatencyLogFile;
+    int						iLatencyLogPeriod; /* Seconds */
+    time_t					tLatencyLogged;
 
     CVectorEx<_BINARY>		vecbiMostRecentSDC;
 
@@ -28,7 +28,16 @@
 
 #include "DrmTransmitter.h"
 #include "sound/sound.h"
+#include "sound/soundnull.h"
+#include "sound/audiofilein.h"
 #include <sstream>
+#include <algorithm>
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <dirent.h>
+# include <sys/stat.h>
+#endif
 
 /* Implementation *************************************************************/
 void CDRMTransmitter::Start()
@@ -51,12 +60,23 @@ void CDRMTransmitter::Start()
     /* Closing the sound interfaces */
     CloseSoundInterfaces();
 
+    /* Complete the output file, if any */
+    TransmitData.CloseFile();
+
     /* Set flag to stopped */
     Parameters.eRunState = CParameter::STOPPED;
 }
 
 void CDRMTransmitter::Run()
 {
+#ifdef QT_CORE_LIB
+    if (bPipelined)
+    {
+        RunPipelined();
+        return;
+    }
+#endif
+
     /*
     	The hand over of data is done via an intermediate-buffer. The calling
     	convention is always "input-buffer, output-buffer". Additional, the
@@ -71,6 +91,17 @@ void CDRMTransmitter::Run()
         /* Audio source encoder */
         AudioSourceEncoder.ProcessData(Parameters, DataBuf, AudSrcBuf);
 
+
+        /* FAC and SDC data, the frame is complete before channel coding ******/
+        GenerateFACData.ReadData(Parameters, GenFACDataBuf);
+        GenerateSDCData.ReadData(Parameters, GenSDCDataBuf);
+
+        /* MDI output of the frame */
+        if (MDIOut.GetOutEnabled())
+            MDIOut.SendFrame(Parameters, AudSrcBuf, GenFACDataBuf, GenSDCDataBuf);
+
+
+        /* MSC ****************************************************************/
         /* MLC-encoder */
         MSCMLCEncoder.ProcessData(Parameters, AudSrcBuf, MLCEncBuf);
 
@@ -79,12 +110,10 @@ void CDRMTransmitter::Run()
 
 
         /* FAC ****************************************************************/
-        GenerateFACData.ReadData(Parameters, GenFACDataBuf);
         FACMLCEncoder.ProcessData(Parameters, GenFACDataBuf, FACMapBuf);
 
 
         /* SDC ****************************************************************/
-        GenerateSDCData.ReadData(Parameters, GenSDCDataBuf);
         SDCMLCEncoder.ProcessData(Parameters, GenSDCDataBuf, SDCMapBuf);
 
 
@@ -102,10 +131,134 @@ void CDRMTransmitter::Run()
             break;
 
         /* Transmit the signal ************************************************/
-        TransmitData.WriteData(Parameters, OFDMModBuf);
+        if (TransmitSignal())
+            break;
+    }
+}
+
+/*
+	Pipelined mode: the same modules as in Run(), cut into three stages which
+	run in their own threads. The stages are connected by bounded queues, so
+	audio encoding of the next frame and channel coding of the next symbols
+	overlap with the OFDM modulation and the sound card output. The FAC, SDC
+	and cell mapping stay in one stage since they share the frame counter.
+*/
+void CDRMTransmitter::RunPipelined()
+{
+#ifdef QT_CORE_LIB
+    CStageThread SourceStage(*this, &CDRMTransmitter::RunSourceStage);
+    CStageThread CodingStage(*this, &CDRMTransmitter::RunCodingStage);
+    SourceStage.start();
+    CodingStage.start();
+
+    /* The modulation stage feeds the sound card and does the soft stop */
+    RunModulationStage();
+
+    AudSrcPipe.Stop();
+    CarMapPipe.Stop();
+    SourceStage.wait();
+    CodingStage.wait();
+#endif
+}
+
+void CDRMTransmitter::RunSourceStage()
+{
+    for (;;)
+    {
+        /* The queue always takes more data, Push() waits if it is full */
+        AudSrcBuf.SetRequestFlag(TRUE);
+
+        ReadData.ReadData(Parameters, DataBuf);
+        AudioSourceEncoder.ProcessData(Parameters, DataBuf, AudSrcBuf);
+
+        if (!AudSrcPipe.Push(AudSrcBuf))
+            break;
+    }
+}
+
+void CDRMTransmitter::RunCodingStage()
+{
+    for (;;)
+    {
+        /* MSC ****************************************************************/
+        /* Only wait for the source stage if the MLC encoder asked for data */
+        if (AudSrcBufOut.GetRequestFlag() && AudSrcBufOut.GetFillLevel() == 0)
+        {
+            if (!AudSrcPipe.Pop(AudSrcBufOut))
+                break;
+            AudSrcBufOut.SetRequestFlag(FALSE);
+        }
+
+        /* FAC and SDC data, MDI output of the complete frame *****************/
+        GenerateFACData.ReadData(Parameters, GenFACDataBuf);
+        GenerateSDCData.ReadData(Parameters, GenSDCDataBuf);
+        if (MDIOut.GetOutEnabled())
+            MDIOut.SendFrame(Parameters, AudSrcBufOut, GenFACDataBuf, GenSDCDataBuf);
+
+        MSCMLCEncoder.ProcessData(Parameters, AudSrcBufOut, MLCEncBuf);
+        SymbInterleaver.ProcessData(Parameters, MLCEncBuf, IntlBuf);
+
+        /* FAC ****************************************************************/
+        FACMLCEncoder.ProcessData(Parameters, GenFACDataBuf, FACMapBuf);
+
+        /* SDC ****************************************************************/
+        SDCMLCEncoder.ProcessData(Parameters, GenSDCDataBuf, SDCMapBuf);
+
+        /* Mapping of the MSC, FAC, SDC and pilots on the carriers ************/
+        CarMapBuf.SetRequestFlag(TRUE);
+        OFDMCellMapping.ProcessData(Parameters, IntlBuf, FACMapBuf, SDCMapBuf,
+                                    CarMapBuf);
+
+        if (!CarMapPipe.Push(CarMapBuf))
+            break;
+    }
+}
+
+void CDRMTransmitter::RunModulationStage()
+{
+    for (;;)
+    {
+        if (CarMapBufOut.GetRequestFlag() && CarMapBufOut.GetFillLevel() == 0)
+        {
+            if (CarMapPipe.Pop(CarMapBufOut, TX_PIPE_WAIT_MS))
+                CarMapBufOut.SetRequestFlag(FALSE);
+            else if (Parameters.eRunState != CParameter::RUNNING)
+                break; /* nothing comes any more, no soft stop possible */
+        }
+
+        /* OFDM-modulation ****************************************************/
+        OFDMModulation.ProcessData(Parameters, CarMapBufOut, OFDMModBuf);
+
+        /* Soft stop **********************************************************/
+        if (CanSoftStopExit())
+            break;
+
+        /* Transmit the signal ************************************************/
+        if (TransmitSignal())
+            break;
     }
 }
 
+_BOOLEAN CDRMTransmitter::TransmitSignal()
+{
+    _BOOLEAN bWritten;
+
+    if (iChannelSim > 0)
+    {
+        /* The channel simulation sits between modulator and output */
+        DRMChannel.TransferData(Parameters, OFDMModBuf, ChanSimBuf);
+        DataConvChanTransm.ProcessData(Parameters, ChanSimBuf, ChanOutBuf);
+        bWritten = TransmitData.WriteData(Parameters, ChanOutBuf);
+    }
+    else
+        bWritten = TransmitData.WriteData(Parameters, OFDMModBuf);
+
+    /* An offline rendering ends after the requested number of symbols. It
+       always starts and ends at a frame boundary, the output module writes
+       the last frame on its own */
+    return bWritten && iRenderSymbolsLeft > 0 && --iRenderSymbolsLeft == 0;
+}
+
 #if 1
 /* Flavour 1: Stop at the frame boundary (worst case delay one frame) */
 _BOOLEAN CDRMTransmitter::CanSoftStopExit()
@@ -116,7 +269,7 @@ _BOOLEAN CDRMTransmitter::CanSoftStopExit()
     if (bNewSymbol)
     {
         /* Number of symbol by frame */
-        const int iSymbolPerFrame = Parameters.CellMappingTable.iNumSymPerFrame;
+        const int iSymbolPerFrame = Parameters.pCellMappingTable->iNumSymPerFrame;
 
         /* Set stop requested flag */
         const _BOOLEAN bStopRequested = Parameters.eRunState != CParameter::RUNNING;
@@ -173,7 +326,7 @@ _BOOLEAN CDRMTransmitter::CanSoftStopExit()
         else
         {
             /* Number of symbol by frame */
-            const int iSymbolPerFrame = Parameters.CellMappingTable.iNumSymPerFrame;
+            const int iSymbolPerFrame = Parameters.pCellMappingTable->iNumSymPerFrame;
 
             /* Update the symbol counter to keep track of frame beginning */
             if (++iSoftStopSymbolCount >= iSymbolPerFrame)
@@ -229,10 +382,146 @@ void CDRMTransmitter::Init()
     AudSrcBuf.Clear();
     DataBuf.Clear();
 
+    /* MDI output, the stream lengths may have changed */
+    MDIOut.Init(Parameters);
+
+    /* Queues between the stages of the pipelined mode */
+    if (bPipelined)
+    {
+        AudSrcPipe.Init(TX_PIPE_AUD_SRC_BLOCKS, AudSrcBuf.GetBufferSize());
+        CarMapPipe.Init(TX_PIPE_CAR_MAP_FRAMES *
+                        Parameters.pCellMappingTable->iNumSymPerFrame,
+                        CarMapBuf.GetBufferSize());
+        AudSrcBufOut.Init(AudSrcBuf.GetBufferSize());
+        CarMapBufOut.Init(CarMapBuf.GetBufferSize());
+        AudSrcBufOut.Clear();
+        CarMapBufOut.Clear();
+        AudSrcBufOut.SetRequestFlag(FALSE);
+        CarMapBufOut.SetRequestFlag(FALSE);
+    }
+
+    /* Channel simulation between modulator and output */
+    if (iChannelSim > 0)
+    {
+        Parameters.iDRMChannelNum = iChannelSim;
+        Parameters.SetNominalSNRdB(rChannelSNRdB);
+        DRMChannel.Init(Parameters, ChanSimBuf);
+        DataConvChanTransm.Init(Parameters, ChanOutBuf);
+        ChanSimBuf.Clear();
+        ChanOutBuf.Clear();
+    }
+
+    /* Length of an offline rendering, whole frames of 400 ms */
+    iRenderSymbolsLeft = 0;
+    if (rRenderSeconds > (_REAL) 0.0)
+    {
+        iRenderSymbolsLeft = (int) ceil(rRenderSeconds / (_REAL) 0.4) *
+                             Parameters.pCellMappingTable->iNumSymPerFrame;
+    }
+
     /* Initialize the soft stop */
     InitSoftStop();
 }
 
+void CDRMTransmitter::SetRenderToFile(const string& strFileName, const _REAL rSeconds)
+{
+    TransmitData.SetWriteToFile(strFileName);
+    rRenderSeconds = rSeconds;
+}
+
+void CDRMTransmitter::SetInputFile(const string& strFileName)
+{
+    /* The file is read without pacing, the output sets the speed */
+    CSoundInInterface* pSoundIn;
+    if (strFileName != "")
+    {
+        CAudioFileIn* pAudioFileIn = new CAudioFileIn();
+        pAudioFileIn->SetFileName(strFileName);
+        pSoundIn = pAudioFileIn;
+    }
+    else
+        pSoundIn = new CSoundInNull();
+
+    delete pSoundInInterface;
+    pSoundInInterface = pSoundIn;
+    ReadData.SetSoundInterface(pSoundIn);
+}
+
+/* Regular files of a directory, sorted by name */
+static void ListDirectory(const string& strDir, vector<string>& vecstrFiles)
+{
+#ifdef _WIN32
+    WIN32_FIND_DATAA FindData;
+    HANDLE hFind = FindFirstFileA((strDir + "\\*").c_str(), &FindData);
+    if (hFind == INVALID_HANDLE_VALUE)
+        throw CGenErr("The directory " + strDir + " cannot be read.");
+    do
+    {
+        if (!(FindData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+            vecstrFiles.push_back(strDir + "\\" + FindData.cFileName);
+    }
+    while (FindNextFileA(hFind, &FindData));
+    FindClose(hFind);
+#else
+    DIR* pDir = opendir(strDir.c_str());
+    if (pDir == NULL)
+        throw CGenErr("The directory " + strDir + " cannot be read.");
+    struct dirent* pEntry;
+    while ((pEntry = readdir(pDir)) != NULL)
+    {
+        const string strFile = strDir + "/" + pEntry->d_name;
+        struct stat FileStat;
+        if (stat(strFile.c_str(), &FileStat) == 0 && S_ISREG(FileStat.st_mode))
+            vecstrFiles.push_back(strFile);
+    }
+    closedir(pDir);
+#endif
+    sort(vecstrFiles.begin(), vecstrFiles.end());
+}
+
+void CDRMTransmitter::SetSlideShowDir(const string& strDir)
+{
+    vector<string> vecstrFiles;
+    ListDirectory(strDir, vecstrFiles);
+    if (vecstrFiles.empty())
+        throw CGenErr("The directory " + strDir + " contains no files.");
+
+    /* Same as the transmitter dialog, the format is the file extension */
+    AudioSourceEncoder.ClearPicFileNames();
+    AudioSourceEncoder.SetPathRemoval(TRUE);
+    for (size_t i = 0; i < vecstrFiles.size(); i++)
+    {
+        const size_t iDot = vecstrFiles[i].rfind('.');
+        const string strFormat = iDot == string::npos ? string() :
+                                 vecstrFiles[i].substr(iDot + 1);
+        AudioSourceEncoder.SetPicFileName(vecstrFiles[i], strFormat);
+    }
+
+    /* Only one service, see constructor */
+    Parameters.SetNumOfServices(0,1);
+    Parameters.SetCurSelDataService(0);
+    Parameters.SetAudDataFlag(0,  CService::SF_DATA);
+
+    CDataParam DataParam;
+    DataParam.iStreamID = 0;
+    DataParam.iPacketLen = TX_SLIDESHOW_PACKET_LEN;
+    DataParam.eDataUnitInd = CDataParam::DU_DATA_UNITS;
+    DataParam.eAppDomain = CDataParam::AD_DAB_SPEC_APP;
+    Parameters.SetDataParam(0, DataParam);
+    Parameters.Service[0].iServiceDescr = 0;
+}
+
+void CDRMTransmitter::SetChannelSimulation(const int iChannel, const _REAL rSNRdB)
+{
+    iChannelSim = iChannel;
+    rChannelSNRdB = rSNRdB;
+
+    /* The channel output is real valued, the I/Q outputs need the Hilbert
+       filter to restore the imaginary part */
+    if (iChannelSim > 0)
+        TransmitData.SetHighQualityIQ(TRUE);
+}
+
 CDRMTransmitter::~CDRMTransmitter()
 {
     delete pSoundInInterface;
@@ -243,7 +532,9 @@ CDRMTransmitter::CDRMTransmitter(CSettings* pSettings) : CDRMTransceiver(pSettin
         ReadData(pSoundInInterface), TransmitData(pSoundOutInterface),
         rDefCarOffset((_REAL) VIRTUAL_INTERMED_FREQ),
         // UEP only works with Dream receiver, FIXME! -> disabled for now
-        bUseUEP(FALSE)
+        bUseUEP(FALSE), iSoftStopSymbolCount(0), bPipelined(FALSE),
+        rRenderSeconds((_REAL) 0.0), iRenderSymbolsLeft(0), iChannelSim(0),
+        rChannelSNRdB((_REAL) 0.0)
 {
     /* Init streams */
     Parameters.ResetServicesStreams();
@@ -316,7 +607,7 @@ CDRMTransmitter::CDRMTransmitter(CSettings* pSettings) : CDRMTransceiver(pSettin
         DataParam.iStreamID = 0;
 
         /* Init SlideShow application */
-        DataParam.iPacketLen = 45; /* TEST */
+        DataParam.iPacketLen = TX_SLIDESHOW_PACKET_LEN;
         DataParam.eDataUnitInd = CDataParam::DU_DATA_UNITS;
         DataParam.eAppDomain = CDataParam::AD_DAB_SPEC_APP;
         Parameters.SetDataParam(0, DataParam);
@@ -452,6 +743,12 @@ void CDRMTransmitter::LoadSettings()
     /* IF amplified output */
     GetTransData()->SetAmplifiedOutput(s.Get(Transmitter, "ifamp", int(1)));
 
+    /* 32 bit float samples for file output */
+    GetTransData()->SetFloatOutput(s.Get(Transmitter, "iqfloat", int(0)));
+
+    /* Source encoding, channel coding and modulation in separate threads */
+    SetPipelined(s.Get(Transmitter, "pipelined", int(0)));
+
     /* Transmission of current time */
     value = s.Get(Transmitter, "currenttime", string("CT_OFF"));
     if      (value == "CT_OFF")        { Parameters.eTransmitCurrentTime = CParameter::CT_OFF;        }
@@ -513,6 +810,24 @@ void CDRMTransmitter::LoadSettings()
         if      (value == "OA_VOIP")  { Service.AudioParam.eOPUSApplication = CAudioParam::OA_VOIP;  }
         else if (value == "OA_AUDIO") { Service.AudioParam.eOPUSApplication = CAudioParam::OA_AUDIO; }
     }
+
+    /* MDI output to remote modulators, from the command line only */
+    istringstream ssMDIOut(s.Get("command", "mdiout", string()));
+    while (ssMDIOut >> value)
+        MDIOut.AddDestination(value);
+
+    /* Offline rendering to a file, from the command line only */
+    value = s.Get("command", "render", string());
+    if (value != "")
+    {
+        SetRenderToFile(value, s.Get("command", "renderlen", _REAL(TX_RENDER_DEFAULT_SEC)));
+        SetInputFile(s.Get("command", "fileio", string()));
+        value = s.Get("command", "slideshow", string());
+        if (value != "")
+            SetSlideShowDir(value);
+        SetChannelSimulation(s.Get("command", "channel", int(0)),
+                             s.Get("command", "snr", _REAL(TX_RENDER_DEFAULT_SNR_DB)));
+    }
 }
 
 void CDRMTransmitter::SaveSettings()
@@ -606,6 +921,12 @@ void CDRMTransmitter::SaveSettings()
     /* IF amplified output */
     s.Put(Transmitter, "ifamp", int(GetTransData()->GetAmplifiedOutput()));
 
+    /* 32 bit float samples for file output */
+    s.Put(Transmitter, "iqfloat", int(GetTransData()->GetFloatOutput()));
+
+    /* Pipelined mode */
+    s.Put(Transmitter, "pipelined", int(GetPipelined()));
+
     /* Transmission of current time */
     switch (Parameters.eTransmitCurrentTime) {
     case CParameter::CT_OFF:        value = "CT_OFF";        break;
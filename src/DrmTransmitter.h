@@ -31,6 +31,7 @@
 
 #include <iostream>
 #include "util/Buffer.h"
+#include "util/PipelineBuffer.h"
 #include "Parameter.h"
 #include "DataIO.h"
 #include "mlc/MLC.h"
@@ -39,9 +40,32 @@
 #include "OFDM.h"
 #include "DRMSignalIO.h"
 #include "sourcedecoders/AudioSourceEncoder.h"
+#include "drmchannel/ChannelSimulation.h"
+#include "MDI/MDIOut.h"
 #include "sound/soundinterface.h"
 #include "DrmTransceiver.h"
 
+#ifdef QT_CORE_LIB
+# include <QThread>
+#endif
+
+/* Definitions ****************************************************************/
+/* Depth of the queues between the pipeline stages. Source encoder blocks are
+   one DRM frame, cell mapping blocks one OFDM symbol */
+#define TX_PIPE_AUD_SRC_BLOCKS		2
+#define TX_PIPE_CAR_MAP_FRAMES		2
+/* The modulation stage checks for a stop request this often if the coding
+   stage does not deliver */
+#define TX_PIPE_WAIT_MS				100
+
+/* Defaults of an offline rendering: length in seconds, SNR of the channel
+   simulation */
+#define TX_RENDER_DEFAULT_SEC		60
+#define TX_RENDER_DEFAULT_SNR_DB	30
+
+/* Packet length of the SlideShow data service in bytes */
+#define TX_SLIDESHOW_PACKET_LEN		45
+
 /* Classes ********************************************************************/
 class CDRMTransmitter : public CDRMTransceiver
 {
@@ -74,6 +98,27 @@ public:
     _REAL GetCarOffset() {
         return rDefCarOffset;
     }
+
+    /* Run source encoding, channel coding and OFDM modulation in separate
+       threads. Takes effect at the next (re)start */
+    void SetPipelined(const _BOOLEAN bNewPipelined) {
+        bPipelined = bNewPipelined;
+    }
+    _BOOLEAN GetPipelined() const {
+        return bPipelined;
+    }
+
+    /* Offline mode: write "rSeconds" of signal (rounded up to whole frames)
+       to a file as fast as possible, then stop. The audio comes from
+       "strInputFile", silence if empty */
+    void SetRenderToFile(const string& strFileName, const _REAL rSeconds);
+    void SetInputFile(const string& strFileName);
+    /* Replaces the service by a SlideShow data service with all files of
+       the directory */
+    void SetSlideShowDir(const string& strDir);
+    /* Pass the signal through the channel model "iChannel" of the simulation
+       (0: off) with a nominal SNR of "rSNRdB" */
+    void SetChannelSimulation(const int iChannel, const _REAL rSNRdB);
 #ifdef QT_MULTIMEDIA_LIB
     void SetInputDevice(const QAudioDeviceInfo&) {}
     void SetOutputDevice(const QAudioDeviceInfo&) {}
@@ -83,6 +128,27 @@ protected:
     void Run();
     void InitSoftStop() { iSoftStopSymbolCount=0; };
     _BOOLEAN CanSoftStopExit();
+    /* TRUE if the last symbol of an offline rendering was written */
+    _BOOLEAN TransmitSignal();
+
+    /* Pipelined mode, each stage runs until the pipeline is stopped */
+    void RunPipelined();
+    void RunSourceStage();
+    void RunCodingStage();
+    void RunModulationStage();
+
+#ifdef QT_CORE_LIB
+    class CStageThread : public QThread
+    {
+    public:
+        CStageThread(CDRMTransmitter& NewTx, void (CDRMTransmitter::*pNewStage)())
+            : Tx(NewTx), pStage(pNewStage) {}
+    protected:
+        virtual void run() {(Tx.*pStage)();}
+        CDRMTransmitter& Tx;
+        void (CDRMTransmitter::*pStage)();
+    };
+#endif
 
     /* Buffers */
     CSingleBuffer<_SAMPLE>	DataBuf;
@@ -100,6 +166,17 @@ protected:
     CSingleBuffer<_COMPLEX>	CarMapBuf;
     CSingleBuffer<_COMPLEX>	OFDMModBuf;
 
+    /* Stage boundaries in pipelined mode, the "Out" buffers are the input
+       side of the next stage */
+    CPipelineBuffer<_BINARY>	AudSrcPipe;
+    CSingleBuffer<_BINARY>		AudSrcBufOut;
+    CPipelineBuffer<_COMPLEX>	CarMapPipe;
+    CSingleBuffer<_COMPLEX>		CarMapBufOut;
+
+    /* Channel simulation */
+    CSingleBuffer<CChanSimDataMod>	ChanSimBuf;
+    CSingleBuffer<_COMPLEX>			ChanOutBuf;
+
     /* Modules */
     CReadData				ReadData;
     CAudioSourceEncoder		AudioSourceEncoder;
@@ -112,10 +189,19 @@ protected:
     COFDMCellMapping		OFDMCellMapping;
     COFDMModulation			OFDMModulation;
     CTransmitData			TransmitData;
+    CDRMChannel				DRMChannel;
+    CDataConvChanTransm		DataConvChanTransm;
+    CMDIOut					MDIOut;
 
     _REAL					rDefCarOffset;
     _BOOLEAN				bUseUEP;
     int						iSoftStopSymbolCount;
+    _BOOLEAN				bPipelined;
+
+    _REAL					rRenderSeconds; /* 0: realtime operation */
+    int						iRenderSymbolsLeft;
+    int						iChannelSim;
+    _REAL					rChannelSNRdB;
 };
 
 
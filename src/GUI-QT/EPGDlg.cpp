@@ -167,36 +167,36 @@ void EPGDlg::select()
     advanced->setText(tr("no advanced profile data"));
     QString chan = channel->currentText();
     // get schedule for date +/- 1 - will allow user timezones sometime
-    QDomDocument *doc;
-    QDate o = date.addDays(-1);
-    doc = getFile (o, sids[chan], false);
-    if(doc)
-        epg.parseDoc(*doc);
-    doc = getFile (o, sids[chan], true);
-    if(doc)
-        epg.parseDoc(*doc);
-    o = date.addDays(1);
-    doc = getFile (o, sids[chan], false);
-    if(doc)
-        epg.parseDoc(*doc);
-    doc = getFile (o, sids[chan], true);
-    if(doc)
-        epg.parseDoc(*doc);
+    uint32_t sid = sids[chan];
+    time_t from = QDateTime(date.addDays(-1), QTime(0, 0), Qt::UTC).toTime_t();
+    time_t to = QDateTime(date.addDays(2), QTime(0, 0), Qt::UTC).toTime_t();
+    if (!epg.loadStore(sid, from, to))
+    {
+        /* nothing stored by the receiver yet, decode the files directly */
+        for (int d = -1; d <= 1; d++)
+        {
+            QDate o = date.addDays(d);
+            for (int adv = 0; adv < 2; adv++)
+            {
+                if (!epg.parseFile(getFileName(o, sid, adv!=0)))
+                    epg.parseFile(getFileName_etsi(o, sid, adv!=0));
+            }
+        }
+    }
 
+    /* the documents are only needed to show the XML */
     QString xml;
-    doc = getFile (date, sids[chan], false);
+    QDomDocument *doc = getFile (date, sid, false);
     if(doc)
     {
-        epg.parseDoc(*doc);
         xml = doc->toString();
         if (xml.length() > 0)
             basic->setText(xml);
     }
 
-    doc = getFile (date, sids[chan], true);
+    doc = getFile (date, sid, true);
     if(doc)
     {
-        epg.parseDoc(*doc);
         xml = doc->toString();
         if (xml.length() > 0)
             advanced->setText(xml);
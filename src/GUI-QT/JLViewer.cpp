@@ -185,10 +185,6 @@ void JLViewer::OnTimer()
         break;
     }
 
-    if(textBrowser->changed())
-    {
-        textBrowser->reload();
-    }
 }
 
 void JLViewer::OnButtonStepBack()
@@ -811,7 +811,7 @@ void TransmDialog::EnableData(const _BOOLEAN bFlag)
 		Parameters.Service[0].DataParam.iStreamID = 0;
 
 		/* Init SlideShow application */
-		Parameters.Service[0].DataParam.iPacketLen = 45; /* TEST */
+		Parameters.Service[0].DataParam.iPacketLen = TX_SLIDESHOW_PACKET_LEN;
 		Parameters.Service[0].DataParam.eDataUnitInd = CDataParam::DU_DATA_UNITS;
 		Parameters.Service[0].DataParam.eAppDomain = CDataParam::AD_DAB_SPEC_APP;
 
@@ -33,7 +33,7 @@
 
 JLBrowser::JLBrowser(QWidget * parent)
     : QTextBrowser(parent),decoder(NULL),strFhGIISText(),strJournalineHeadText(),
-      total(0),ready(0)
+      shown(JOURNALINE_IS_NO_LINK),links()
 {
 
     /* Set FhG IIS text */
@@ -54,43 +54,25 @@ JLBrowser::JLBrowser(QWidget * parent)
         "</h2></td></tr></table>";
 }
 
-bool JLBrowser::changed()
+JLBrowser::~JLBrowser()
 {
-    if(decoder==NULL)
-    {
-        return false;
-    }
-    int JourID = source().toString().toInt();
-
-    CNews News;
-    decoder->GetNews(JourID, News);
+    setDecoder(NULL);
+}
 
-    int new_total=News.vecItem.Size();
-    int new_ready=0;
-    bool dirty = false;
+void JLBrowser::ObjectChanged(const int iObjID)
+{
+    /* called from the decoding thread, handle it in the GUI thread */
+    QMetaObject::invokeMethod(this, "OnObjectChanged", Qt::QueuedConnection,
+                              Q_ARG(int, iObjID));
+}
 
-    for (int i = 0; i < new_total; i++)
-    {
-        switch(News.vecItem[i].iLink)
-        {
-        case JOURNALINE_IS_NO_LINK: /* Only text, no link */
-        case JOURNALINE_LINK_NOT_ACTIVE:
-            break;
-        default:
-            new_ready++;
-        }
-    }
-    if(new_total != total)
-    {
-        total = new_total;
-        dirty = true;
-    }
-    if(new_ready != ready)
+void JLBrowser::OnObjectChanged(int iObjID)
+{
+    if (iObjID == shown || iObjID == JOURNALINE_ALL_OBJECTS
+            || links.contains(iObjID))
     {
-        ready = new_ready;
-        dirty = true;
+        reload();
     }
-    return dirty;
 }
 
 QVariant JLBrowser::loadResource( int, const QUrl & name )
@@ -108,10 +90,14 @@ QVariant JLBrowser::loadResource( int, const QUrl & name )
         /* Decode UTF-8 coding for title */
         strTitle = QString().fromUtf8(News.sTitle.c_str());
 
-        ready = 0;
-        total = News.vecItem.Size();
-        for (int i = 0; i < total; i++)
+        /* remember what this page depends on */
+        shown = JourID;
+        links.clear();
+        for (int i = 0; i < News.vecItem.Size(); i++)
         {
+            if (News.vecItem[i].iLinkID != JOURNALINE_IS_NO_LINK)
+                links.insert(News.vecItem[i].iLinkID);
+
             QString strCurItem = QString().fromUtf8(News.vecItem[i].sText.c_str());
 
             /* Replace \n by html command <br> */
@@ -127,7 +113,6 @@ QVariant JLBrowser::loadResource( int, const QUrl & name )
                 strItems += QString("<li>") + strCurItem + QString("</li>");
                 break;
             default:
-                ready++;
                 QString strLinkStr = QString("%1").arg(News.vecItem[i].iLink);
                 /* Un-ordered list item with link */
                 strItems += QString("<li><a href=\"") + strLinkStr +
@@ -150,5 +135,11 @@ QVariant JLBrowser::loadResource( int, const QUrl & name )
 
 void JLBrowser::setDecoder(CDataDecoder* d)
 {
+    if (decoder == d)
+        return;
+    if (decoder)
+        decoder->RemoveJournalineListener(this);
     decoder = d;
+    if (decoder)
+        decoder->AddJournalineListener(this);
 }
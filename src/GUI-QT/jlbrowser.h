@@ -30,26 +30,33 @@
 #define _JLBROWSER_H
 
 #include <QTextBrowser>
+#include <QSet>
+#include "../datadecoding/Journaline.h"
 
 class CDataDecoder;
 
-class JLBrowser : public QTextBrowser
+/* Reloads the page when the decoder tells that the shown object or one of
+   the objects it links to has changed */
+class JLBrowser : public QTextBrowser, public CJournalineListener
 {
     Q_OBJECT
 public:
     JLBrowser(QWidget * parent = 0 );
-    ~JLBrowser() {}
+    ~JLBrowser();
     QVariant loadResource ( int type, const QUrl & name );
-    bool changed();
     void setDecoder(CDataDecoder* d);
+    void ObjectChanged(const int iObjID);
+
+protected slots:
+    void OnObjectChanged(int iObjID);
 
 protected:
 
     CDataDecoder*   decoder;
     QString         strFhGIISText;
     QString         strJournalineHeadText;
-    int             total;
-    int             ready;
+    int             shown;
+    QSet<int>       links;
 };
 
 #endif
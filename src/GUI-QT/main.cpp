@@ -40,6 +40,8 @@
 #include "../DrmTransmitter.h"
 #include "../DrmSimulation.h"
 #include "../util/Settings.h"
+#include "../drmchannel/IQFileChannel.h"
+#include "../ReceiverDaemon.h"
 #include <iostream>
 
 #ifdef QT_CORE_LIB
@@ -289,12 +291,38 @@ main(int argc, char **argv)
 			DRMReceiver.Start();
 #endif
 		}
+#ifdef QT_CORE_LIB
+		else if (mode == "daemon")
+		{
+#ifdef _WIN32
+	WSADATA wsaData;
+	(void)WSAStartup(MAKEWORD(2,2), &wsaData);
+#endif
+			QCoreApplication app(argc, argv);
+			CReceiverDaemon Daemon;
+			if (!Daemon.Load(Settings.Get("command", "daemonconfig", string())))
+				exit(1);
+			Daemon.Start();
+			const int iRet = app.exec();
+			Daemon.Stop();
+			return iRet;
+		}
+#endif
 		else if (mode == "transmit")
 		{
 			CDRMTransmitter DRMTransmitter(&Settings);
 			DRMTransmitter.LoadSettings();
 			DRMTransmitter.Start();
 		}
+		else if (mode == "channelsim")
+		{
+			CIQFileChannel IQFileChannel;
+			IQFileChannel.Process(Settings.Get("command", "fileio", string()),
+				Settings.Get("command", "chansim", string()),
+				Settings.Get("command", "channel", 1),
+				Settings.Get("command", "snr", _REAL(TX_RENDER_DEFAULT_SNR_DB)),
+				Settings.Get("Receiver", "sampleratesig", int(DEFAULT_SOUNDCRD_SAMPLE_RATE)));
+		}
 		else
 		{
 			string usage(Settings.UsageArguments());
@@ -264,6 +264,9 @@ public:
     void WakeOne() {
         WaitCond.wakeOne();
     }
+    void WakeAll() {
+        WaitCond.wakeAll();
+    }
     _BOOLEAN Wait(CMutex* mutex, unsigned long time) {
         return WaitCond.wait(&mutex->Mutex, time);
     }
@@ -285,6 +288,7 @@ class CWaitCondition
 {
 public:
     void WakeOne() {}
+    void WakeAll() {}
     _BOOLEAN Wait(CMutex*, unsigned long) {return TRUE;}
 };
 
@@ -67,11 +67,12 @@ void CInputResample::ProcessDataInternal(CParameter& Parameters)
 void CInputResample::InitInternal(CParameter& Parameters)
 {
     Parameters.Lock();
-    /* Init resample object */
-    ResampleObj.Init(Parameters.CellMappingTable.iSymbolBlockSize);
+    /* Init resample object, with the long filter since everything after it
+       sees the interpolation errors as noise */
+    ResampleObj.Init(Parameters.pCellMappingTable->iSymbolBlockSize, TRUE);
 
     /* Define block-sizes for input and output */
-    iInputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+    iInputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
 
     /* With this parameter we define the maximum lenght of the output buffer
        Due to the constrained sample rate offset estimation the output
@@ -82,6 +83,6 @@ void CInputResample::InitInternal(CParameter& Parameters)
        smaller than one symbol -> no data is read by the next unit, but
        after that the output block size is bigger than one symbol, therefore
        we have to allocate three symbols for output buffer */
-    iMaxOutputBlockSize = 3 * Parameters.CellMappingTable.iSymbolBlockSize;
+    iMaxOutputBlockSize = 3 * Parameters.pCellMappingTable->iSymbolBlockSize;
     Parameters.Unlock();
 }
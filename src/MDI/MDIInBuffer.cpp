@@ -42,17 +42,18 @@ CMDIInBuffer::Put(const vector<_BYTE>& data)
 	guard.Unlock();
 }
 
-/* get the buffer contents, but if it takes more than a second, return an empty buffer
+/* get the buffer contents, but if it takes more than the timeout (a second by
+ * default), return an empty buffer. A zero timeout doesn't wait at all.
  * clear the buffer after reading it so we don't read the same buffer twice
  * Its possible signals could get lost :(
  */
 void
-CMDIInBuffer::Get(vector<_BYTE>& data)
+CMDIInBuffer::Get(vector<_BYTE>& data, unsigned long iTimeoutMs)
 {
 	guard.Lock();
 	if(buffer.empty())
 	{
-		if(blocker.Wait(&guard, 1000))
+		if(iTimeoutMs > 0 && blocker.Wait(&guard, iTimeoutMs))
 		{
 			if(buffer.empty())
 				data.clear();
@@ -74,3 +75,13 @@ CMDIInBuffer::Get(vector<_BYTE>& data)
 	}
 	guard.Unlock();
 }
+
+/* true if no frame is waiting to be read */
+_BOOLEAN
+CMDIInBuffer::Empty()
+{
+	guard.Lock();
+	const _BOOLEAN bEmpty = buffer.empty();
+	guard.Unlock();
+	return bEmpty;
+}
@@ -40,7 +40,8 @@ public:
 	{}
 
 	void Put(const vector<_BYTE>& data);
-	void Get(vector<_BYTE>& data);
+	void Get(vector<_BYTE>& data, unsigned long iTimeoutMs = 1000);
+	_BOOLEAN Empty();
 
 protected:
 	queue< vector<_BYTE> > buffer;
@@ -0,0 +1,264 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Multiplex Distribution Interface (MDI, ETSI TS 102 820) output of the
+ *	transmitter, so that remote modulators can be fed from this encoder.
+ *	The FAC, SDC and MSC of each frame are packed into one AF packet which
+ *	is sent as it is or in PFT fragments, optionally with Reed-Solomon FEC
+ *	(ETSI TS 102 821), to any number of destinations. Each framing is built
+ *	once per frame and the fragments are sent from the builder's buffer.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "MDIOut.h"
+#include <iostream>
+#include <cstring>
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <sys/types.h>
+# include <sys/socket.h>
+#endif
+
+
+/* Implementation *************************************************************/
+CMDIOut::CMDIOut() : vecDest(), bUseAFCRC(TRUE), MSCBuf(), FACBuf(), SDCBuf(),
+	vecStreamBuf(MAX_NUM_STREAMS), MSCDemultiplexer(), bNewMSC(FALSE),
+	vecTagItemGeneratorStr(MAX_NUM_STREAMS), TagPacketGenerator('M'),
+	AFPacketGenerator(), vecbyAFPacket(), PftPackets(), PftFECPackets(),
+	iPftSeq(0)
+{
+	for (int i = 0; i < MAX_NUM_STREAMS; i++)
+		vecTagItemGeneratorStr[i].SetStreamNumber(i);
+
+	/* Init constant tag */
+	TagItemGeneratorProTyMDI.GenTag();
+}
+
+CMDIOut::~CMDIOut()
+{
+	for (size_t i = 0; i < vecDest.size(); i++)
+		delete vecDest[i].pSocket;
+}
+
+_BOOLEAN CMDIOut::AddDestination(const string& strDest)
+{
+	string d = strDest;
+	EFraming eFraming = FR_AF;
+	if (d.size() > 0 && (d[0] == 'P' || d[0] == 'p'))
+	{
+		eFraming = FR_PFT;
+		d.erase(0, 1);
+	}
+	else if (d.size() > 0 && (d[0] == 'F' || d[0] == 'f'))
+	{
+		eFraming = FR_PFT_FEC;
+		d.erase(0, 1);
+	}
+
+	CPacketSocketNative* pSocket = new CPacketSocketNative;
+	if (!pSocket->SetDestination(d))
+	{
+		cerr << "can't send MDI to " << d << endl;
+		delete pSocket;
+		return FALSE;
+	}
+
+	vecDest.push_back(CDestination(pSocket, eFraming));
+	return TRUE;
+}
+
+void CMDIOut::Init(CParameter&)
+{
+	/* The stream lengths may have changed */
+	MSCDemultiplexer.SetInitFlag();
+	MSCBuf.Clear();
+	FACBuf.Clear();
+	SDCBuf.Clear();
+	for (int i = 0; i < MAX_NUM_STREAMS; i++)
+		vecStreamBuf[i].Clear();
+	bNewMSC = FALSE;
+}
+
+void CMDIOut::SendFrame(CParameter& Parameters, CSingleBuffer<_BINARY>& MSCData,
+						CSingleBuffer<_BINARY>& FACData,
+						CSingleBuffer<_BINARY>& SDCData)
+{
+	/* The multiplex frame comes at the start of the frame, split it into the
+	   streams */
+	if (MSCData.GetFillLevel() > 0)
+	{
+		CopyBlock(MSCData, MSCBuf);
+		for (int i = 0; i < MAX_NUM_STREAMS; i++)
+			vecStreamBuf[i].Clear();
+		bNewMSC = MSCDemultiplexer.ProcessData(Parameters, MSCBuf, vecStreamBuf);
+	}
+
+	if (FACData.GetFillLevel() == 0)
+		return;
+
+	CopyBlock(FACData, FACBuf);
+	CopyBlock(SDCData, SDCBuf);
+
+	/* The generated FAC and SDC are always valid, the reception status
+	   belongs to the receiver */
+	TagItemGeneratorLoFrCnt.GenTag();
+	TagItemGeneratorFAC.GenTag(FACBuf, RX_OK);
+	TagItemGeneratorSDC.GenTag(Parameters, SDCBuf, /* empty without SDC */
+		SDCBuf.GetFillLevel() > 0 ? RX_OK : NOT_PRESENT);
+	TagItemGeneratorSDCChanInf.GenTag(Parameters);
+	TagItemGeneratorRobMod.GenTag(Parameters.GetWaveMode());
+	for (int i = 0; i < MAX_NUM_STREAMS; i++)
+	{
+		vecTagItemGeneratorStr[i].GenEmptyTag();
+		if (bNewMSC == TRUE)
+			vecTagItemGeneratorStr[i].GenTag(Parameters, vecStreamBuf[i]);
+	}
+	bNewMSC = FALSE;
+
+	GenDIPacket();
+}
+
+void CMDIOut::CopyBlock(CSingleBuffer<_BINARY>& In, CSingleBuffer<_BINARY>& Out)
+{
+	/* A single buffer keeps its block in the write buffer, reading it there
+	   leaves the fill level alone */
+	const int iLen = In.GetFillLevel();
+	if (Out.GetBufferSize() < iLen)
+		Out.Init(iLen);
+	Out.Clear();
+
+	CVectorEx<_BINARY>& vecIn = *In.QueryWriteBuffer();
+	CVectorEx<_BINARY>& vecOut = *Out.QueryWriteBuffer();
+	for (int i = 0; i < iLen; i++)
+		vecOut[i] = vecIn[i];
+	Out.Put(iLen);
+}
+
+void CMDIOut::GenDIPacket()
+{
+	TagPacketGenerator.Reset();
+	TagPacketGenerator.AddTagItem(&TagItemGeneratorProTyMDI);
+	TagPacketGenerator.AddTagItem(&TagItemGeneratorLoFrCnt);
+	TagPacketGenerator.AddTagItem(&TagItemGeneratorFAC);
+
+	/* sdc_ tag - don't send if empty */
+	if (TagItemGeneratorSDC.GetTotalLength() > 64)
+		TagPacketGenerator.AddTagItem(&TagItemGeneratorSDC);
+
+	TagPacketGenerator.AddTagItem(&TagItemGeneratorSDCChanInf);
+	TagPacketGenerator.AddTagItem(&TagItemGeneratorRobMod);
+	for (int i = 0; i < MAX_NUM_STREAMS; i++)
+	{
+		if (vecTagItemGeneratorStr[i].GetTotalLength() > 64)
+			TagPacketGenerator.AddTagItem(&vecTagItemGeneratorStr[i]);
+	}
+
+	vecbyAFPacket = AFPacketGenerator.GenAFPacket(bUseAFCRC, TagPacketGenerator);
+
+	/* Frame only for the kinds of destinations there are */
+	_BOOLEAN bPft = FALSE, bPftFEC = FALSE;
+	size_t i;
+	for (i = 0; i < vecDest.size(); i++)
+	{
+		if (vecDest[i].eFraming == FR_PFT)
+			bPft = TRUE;
+		else if (vecDest[i].eFraming == FR_PFT_FEC)
+			bPftFEC = TRUE;
+	}
+	if (bPft == TRUE)
+		PftPackets.Build(vecbyAFPacket, iPftSeq, MDI_OUT_FRAGMENT_SIZE);
+	if (bPftFEC == TRUE)
+	{
+		PftFECPackets.Build(vecbyAFPacket, iPftSeq, MDI_OUT_FRAGMENT_SIZE,
+			MDI_OUT_FEC_LOST_FRAGMENTS);
+	}
+	iPftSeq++;
+
+	for (i = 0; i < vecDest.size(); i++)
+		Send(vecDest[i]);
+}
+
+void CMDIOut::Send(const CDestination& Dest)
+{
+	CPacketSocketNative& Socket = *Dest.pSocket;
+
+	if (Dest.eFraming == FR_AF)
+	{
+		Socket.SendPacket(vecbyAFPacket);
+		return;
+	}
+
+	const CPftPacketBuilder& Packets =
+		Dest.eFraming == FR_PFT ? PftPackets : PftFECPackets;
+	const size_t iNumPackets = Packets.GetNumFragments();
+
+	if (!Socket.IsUdp())
+	{
+		/* Stream sockets take the fragments one by one */
+		vector<_BYTE> vecbyPacket;
+		for (size_t i = 0; i < iNumPackets; i++)
+		{
+			const _BYTE* p = Packets.GetFragment(i);
+			vecbyPacket.assign(p, p + Packets.GetFragmentLen(i));
+			Socket.SendPacket(vecbyPacket);
+		}
+		return;
+	}
+
+	const SOCKET s = Socket.GetSocket();
+	const sockaddr_in& Addr = Socket.GetDestAddr();
+#ifdef __linux__
+	mmsghdr msgs[MDI_OUT_BATCH_SIZE];
+	iovec iov[MDI_OUT_BATCH_SIZE];
+	size_t iSent = 0;
+	while (iSent < iNumPackets)
+	{
+		size_t iBatch = iNumPackets - iSent;
+		if (iBatch > MDI_OUT_BATCH_SIZE)
+			iBatch = MDI_OUT_BATCH_SIZE;
+		memset(msgs, 0, sizeof(mmsghdr) * iBatch);
+		for (size_t i = 0; i < iBatch; i++)
+		{
+			iov[i].iov_base = (void*) Packets.GetFragment(iSent + i);
+			iov[i].iov_len = Packets.GetFragmentLen(iSent + i);
+			msgs[i].msg_hdr.msg_name = (void*) &Addr;
+			msgs[i].msg_hdr.msg_namelen = sizeof(Addr);
+			msgs[i].msg_hdr.msg_iov = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		const int n = sendmmsg(s, msgs, (unsigned int) iBatch, 0);
+		if (n <= 0)
+			break; /* datagrams may get lost anyway */
+		iSent += n;
+	}
+#else
+	for (size_t i = 0; i < iNumPackets; i++)
+	{
+		(void) sendto(s, (const char*) Packets.GetFragment(i),
+			(int) Packets.GetFragmentLen(i), 0, (const sockaddr*) &Addr,
+			sizeof(Addr));
+	}
+#endif
+}
@@ -0,0 +1,120 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	MDI output of the transmitter. See MDIOut.cpp.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#if !defined(MDI_OUT_H_INCLUDED)
+#define MDI_OUT_H_INCLUDED
+
+#include "../GlobalDefinitions.h"
+#include "../Parameter.h"
+#include "../util/Buffer.h"
+#include "../MSCMultiplexer.h"
+#include "MDITagItems.h"
+#include "TagPacketGenerator.h"
+#include "AFPacketGenerator.h"
+#include "PacketSocket.h"
+#include "Pft.h"
+#include <vector>
+
+
+/* Definitions ****************************************************************/
+#define MDI_OUT_FRAGMENT_SIZE		800 /* bytes, as the RSCI with PFT */
+/* Lost fragments per AF packet the PFT FEC can recover */
+#define MDI_OUT_FEC_LOST_FRAGMENTS	2
+#define MDI_OUT_BATCH_SIZE			64 /* datagrams per sendmmsg() */
+
+
+/* Classes ********************************************************************/
+class CMDIOut
+{
+public:
+	CMDIOut();
+	virtual ~CMDIOut();
+
+	/* "strDest" is a CPacketSocketNative address. Prefix 'p': PFT fragments,
+	   'f': PFT fragments with FEC, else whole AF packets. Can be called for
+	   any number of destinations */
+	_BOOLEAN AddDestination(const string& strDest);
+	_BOOLEAN GetOutEnabled() const {return !vecDest.empty();}
+	void SetAFPktCRC(const _BOOLEAN bNAFPktCRC) {bUseAFCRC = bNAFPktCRC;}
+
+	void Init(CParameter& Parameters);
+
+	/* Called once per pass of the coding loop, after the source encoder and
+	   the FAC and SDC generation but before the channel coding. A DI frame
+	   is sent whenever "FACData" holds a new FAC block. The buffers are
+	   only read */
+	void SendFrame(CParameter& Parameters, CSingleBuffer<_BINARY>& MSCData,
+		CSingleBuffer<_BINARY>& FACData, CSingleBuffer<_BINARY>& SDCData);
+
+protected:
+	enum EFraming {FR_AF, FR_PFT, FR_PFT_FEC};
+
+	class CDestination
+	{
+	public:
+		CDestination(CPacketSocketNative* pNewSocket, const EFraming eNewFraming)
+			: pSocket(pNewSocket), eFraming(eNewFraming) {}
+
+		CPacketSocketNative*	pSocket;
+		EFraming				eFraming;
+	};
+
+	void CopyBlock(CSingleBuffer<_BINARY>& In, CSingleBuffer<_BINARY>& Out);
+	void GenDIPacket();
+	void Send(const CDestination& Dest);
+
+	vector<CDestination>	vecDest;
+	_BOOLEAN				bUseAFCRC;
+
+	/* Copies of the transmitter buffers, the tag generators consume them */
+	CSingleBuffer<_BINARY>			MSCBuf;
+	CSingleBuffer<_BINARY>			FACBuf;
+	CSingleBuffer<_BINARY>			SDCBuf;
+	vector<CSingleBuffer<_BINARY> >	vecStreamBuf;
+	CMSCDemultiplexer				MSCDemultiplexer;
+	_BOOLEAN						bNewMSC;
+
+	/* MDI tag items */
+	CTagItemGeneratorProTyMDI	TagItemGeneratorProTyMDI; /* *ptr tag */
+	CTagItemGeneratorLoFrCnt	TagItemGeneratorLoFrCnt; /* dlfc tag */
+	CTagItemGeneratorFAC		TagItemGeneratorFAC; /* fac_ tag */
+	CTagItemGeneratorSDC		TagItemGeneratorSDC; /* sdc_ tag */
+	CTagItemGeneratorSDCChanInf	TagItemGeneratorSDCChanInf; /* sdci tag */
+	CTagItemGeneratorRobMod		TagItemGeneratorRobMod; /* robm tag */
+	vector<CTagItemGeneratorStr>	vecTagItemGeneratorStr; /* strx tag */
+
+	CTagPacketGeneratorWithProfiles	TagPacketGenerator;
+	CAFPacketGenerator				AFPacketGenerator;
+
+	/* One AF packet per frame, framed once for each kind of destination */
+	vector<_BYTE>		vecbyAFPacket;
+	CPftPacketBuilder	PftPackets;
+	CPftPacketBuilder	PftFECPackets;
+	uint16_t			iPftSeq;
+};
+
+#endif // !defined(MDI_OUT_H_INCLUDED)
@@ -54,7 +54,7 @@ CDownstreamDI::CDownstreamDI() : iLogFraCnt(0), pDrmReceiver(NULL),
 	bMDIOutEnabled(FALSE), bMDIInEnabled(FALSE),bIsRecording(FALSE),
 	iFrequency(0), strRecordType(),
 	vecTagItemGeneratorStr(MAX_NUM_STREAMS), vecTagItemGeneratorRBP(MAX_NUM_STREAMS),
-	RSISubscribers(),pRSISubscriberFile(new CRSISubscriberFile)
+	RSISubscribers(),pRSISubscriberFile(new CRSISubscriberFile), FanOut()
 {
 	/* Initialise all the generators for strx and rbpx tags */
 	for (int i=0; i<MAX_NUM_STREAMS; i++)
@@ -77,6 +77,8 @@ CDownstreamDI::CDownstreamDI() : iLogFraCnt(0), pDrmReceiver(NULL),
 
 CDownstreamDI::~CDownstreamDI()
 {
+	/* The network thread uses the subscriber sockets */
+	FanOut.Stop();
 	for(vector<CRSISubscriber*>::iterator i = RSISubscribers.begin();
 			i!=RSISubscribers.end(); i++)
 	{
@@ -121,6 +123,7 @@ void CDownstreamDI::SendLockedFrame(CParameter& Parameter,
 	TagItemGeneratorRNIP.GenTag(TRUE,Parameter.rMaxPSDFreq, Parameter.rMaxPSDwrtSig);
 	TagItemGeneratorRxService.GenTag(TRUE, Parameter.GetCurSelAudioService());
 	TagItemGeneratorReceiverStatus.GenTag(Parameter);
+	GenLatencyTag(); /* rlat */
 	TagItemGeneratorRxFrequency.GenTag(TRUE, Parameter.GetFrequency()); /* rfre */
 	TagItemGeneratorRxActivated.GenTag(TRUE); /* ract */
 	TagItemGeneratorPowerSpectralDensity.GenTag(Parameter);
@@ -161,6 +164,8 @@ void CDownstreamDI::SendUnlockedFrame(CParameter& Parameter)
 
 	TagItemGeneratorReceiverStatus.GenTag(Parameter);
 
+	GenLatencyTag(); /* rlat */
+
 	TagItemGeneratorPowerSpectralDensity.GenTag(Parameter);
 
 	TagItemGeneratorPowerImpulseResponse.GenEmptyTag();
@@ -229,6 +234,21 @@ void CDownstreamDI::SendAMFrame(CParameter& Parameter, CSingleBuffer<_BINARY>& C
 	GenDIPacket();
 }
 
+void CDownstreamDI::GenLatencyTag()
+{
+	if (pDrmReceiver == NULL)
+		return;
+
+	vector<_REAL> vecrMilestoneTime(CDRMReceiver::NUM_ACQ_MILESTONES);
+	for (size_t i = 0; i < vecrMilestoneTime.size(); i++)
+	{
+		vecrMilestoneTime[i] = pDrmReceiver->
+			GetAcqMilestoneTime(CDRMReceiver::EAcqMilestone(i));
+	}
+	TagItemGeneratorLatency.GenTag(vecrMilestoneTime,
+		pDrmReceiver->GetLatencyStats().GetBusyNs());
+}
+
 void CDownstreamDI::SetReceiver(CDRMReceiver *pReceiver)
 {
 	pDrmReceiver = pReceiver;
@@ -302,6 +322,7 @@ void CDownstreamDI::GenDIPacket()
 	TagPacketGenerator.AddTagItem(&TagItemGeneratorRINT);
 	TagPacketGenerator.AddTagItem(&TagItemGeneratorRNIP);
 	TagPacketGenerator.AddTagItem(&TagItemGeneratorReceiverStatus);
+	TagPacketGenerator.AddTagItem(&TagItemGeneratorLatency);
 
 	TagPacketGenerator.AddTagItem(&TagItemGeneratorPowerSpectralDensity);
 	TagPacketGenerator.AddTagItem(&TagItemGeneratorPowerImpulseResponse);
@@ -315,14 +336,26 @@ void CDownstreamDI::GenDIPacket()
 
 	/*return TagPacketGenerator.GenAFPacket(bUseAFCRC);*/
 
-	/* transmit a packet to each subscriber */
+	/* transmit a packet to each subscriber. The packet is only generated
+	   once for all subscribers with the same profile and framing, network
+	   subscribers are then served by the fan-out thread */
+	FanOut.BeginFrame();
 	for(vector<CRSISubscriber*>::iterator s = RSISubscribers.begin();
 			s!=RSISubscribers.end(); s++)
 	{
-		// re-generate the profile tag for each subscriber
-		TagItemGeneratorProfile.GenTag((*s)->GetProfile());
-		(*s)->TransmitPacket(TagPacketGenerator);
+		if(!(*s)->IsActive())
+			continue;
+		const int iEncoder = FanOut.GetEncoder((*s)->GetProfile(),
+			(*s)->GetAFPktCRC(), (*s)->GetPFTFragmentSize());
+		if(FanOut.GetFrame(iEncoder) == NULL)
+		{
+			// re-generate the profile tag for each profile
+			TagItemGeneratorProfile.GenTag((*s)->GetProfile());
+			FanOut.Encode(iEncoder, TagPacketGenerator);
+		}
+		(*s)->SendFrame(FanOut, iEncoder);
 	}
+	FanOut.EndFrame();
 }
 
 void CDownstreamDI::ResetTags()
@@ -335,6 +368,7 @@ void CDownstreamDI::ResetTags()
 	TagItemGeneratorRobMod.Reset(); /* robm tag */
 	TagItemGeneratorRINF.Reset(); /* info tag */
 	TagItemGeneratorReceiverStatus.Reset(); /* rsta */
+	TagItemGeneratorLatency.Reset(); /* rlat */
 
 	TagItemGeneratorProfile.Reset(); /* rpro */
 	TagItemGeneratorGPS.Reset();	/* rgps */
@@ -535,7 +569,7 @@ void CDownstreamDI::poll()
 /******************************************************************************\
 * DI receive status, send control                                             *
 \******************************************************************************/
-CUpstreamDI::CUpstreamDI() : source(NULL), sink(), bUseAFCRC(TRUE), bMDIOutEnabled(FALSE), bMDIInEnabled(FALSE)
+CUpstreamDI::CUpstreamDI() : source(NULL), pIngestStats(NULL), sink(), bUseAFCRC(TRUE), bMDIOutEnabled(FALSE), bMDIInEnabled(FALSE)
 {
 	/* Init constant tag */
 	TagItemGeneratorProTyRSCI.GenTag();
@@ -568,7 +602,9 @@ _BOOLEAN CUpstreamDI::SetOrigin(const string& str)
 	{
 		// try a socket
 		delete source;
-		source = new CPacketSocketNative;
+		CPacketSocketNative* pSocket = new CPacketSocketNative;
+		pSocket->SetLatencyStats(pIngestStats);
+		source = pSocket;
 		bOK = source->SetOrigin(str);
 	}
 	if (bOK)
@@ -641,8 +677,15 @@ void CUpstreamDI::InitInternal(CParameter&)
 void CUpstreamDI::ProcessDataInternal(CParameter&)
 {
 	vector<_BYTE> vecbydata;
+	/* Frames already reassembled are delivered at once, one per call, so a
+	   burst doesn't leave a backlog behind. Otherwise a source with its own
+	   reader thread blocks until packets arrive, then poll() only drains
+	   them. Don't wait again in the queue in that case, an incomplete PFT
+	   frame would stall the fragments behind it */
+	const _BOOLEAN bPending = !queue.Empty();
+	const _BOOLEAN bWaited = bPending || source->WaitForPackets(1000);
 	source->poll();
-	queue.Get(vecbydata);
+	queue.Get(vecbydata, bWaited ? 0 : 1000);
 	size_t bytes = vecbydata.size();
 	iOutputBlockSize = bytes*SIZEOF__BYTE;
 	pvecOutputData->Init(iOutputBlockSize);
@@ -44,6 +44,7 @@
 #include "TagPacketDecoderRSCIControl.h"
 #include "TagPacketGenerator.h"
 #include "RSISubscriber.h"
+#include "RSIFanOut.h"
 #include <vector>
 
 /* Classes ********************************************************************/
@@ -63,6 +64,8 @@ public:
 	void SetAFPktCRC(const _BOOLEAN bNAFPktCRC) {bUseAFCRC=bNAFPktCRC;}
 	void SetFrequency(int iNewFreqkHz);
 	void SetReceiverMode(ERecMode eNewMode);
+	/* Queue time statistics of a network origin, set before SetOrigin() */
+	void SetIngestStats(CLatencyStats* pNewStats) {pIngestStats = pNewStats;}
 
 	/* CPacketSink */
 	virtual void SendPacket(const vector<_BYTE>& vecbydata, uint32_t addr=0, uint16_t port=0);
@@ -79,6 +82,7 @@ protected:
 	string						strDestination;
 	CMDIInBuffer	  			queue;
 	CPacketSource*				source;
+	CLatencyStats*				pIngestStats;
 	CRSISubscriberSocket		sink;
 	CPft						Pft;
 
@@ -141,6 +145,7 @@ public:
 protected:
 
 	void ResetTags();
+	void GenLatencyTag();
 
 	uint32_t					iLogFraCnt;
 	CDRMReceiver*				pDrmReceiver;
@@ -175,6 +180,7 @@ protected:
 	CTagItemGeneratorRNIP TagItemGeneratorRNIP; /* RNIP tag */
 	CTagItemGeneratorSignalStrength TagItemGeneratorSignalStrength; /* rdbv tag */
 	CTagItemGeneratorReceiverStatus TagItemGeneratorReceiverStatus; /* rsta tag */
+	CTagItemGeneratorLatency TagItemGeneratorLatency; /* rlat tag */
 
 	CTagItemGeneratorProfile TagItemGeneratorProfile; /* rpro */
 	CTagItemGeneratorRxDemodMode TagItemGeneratorRxDemodMode; /* rdmo */
@@ -199,6 +205,7 @@ protected:
 
 	vector< CRSISubscriber *>		RSISubscribers;
 	CRSISubscriberFile*				pRSISubscriberFile;
+	CRSIFanOut						FanOut;
 	CPacketSource*					source;
 	CPacketSink*					sink;
 	CSingleBuffer<_BINARY>			MDIInBuffer;
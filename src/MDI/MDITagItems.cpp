@@ -169,9 +169,9 @@ CTagItemGeneratorLoFrCnt::GetProfiles()
 }
 
 void
-CTagItemGeneratorFAC::GenTag(CParameter & Parameter, CSingleBuffer < _BINARY > &FACData)
+CTagItemGeneratorFAC::GenTag(CSingleBuffer < _BINARY > &FACData, ETypeRxStatus eStatus)
 {
-	if (Parameter.ReceiveStatus.FAC.GetStatus() == FALSE)
+	if (eStatus == NOT_PRESENT)
 	{
 		/* Empty tag if FAC is invalid */
 		PrepareTag(0);
@@ -205,9 +205,10 @@ CTagItemGeneratorFAC::GetProfiles()
 }
 
 void
-CTagItemGeneratorSDC::GenTag(CParameter & Parameter, CSingleBuffer < _BINARY > &SDCData)
+CTagItemGeneratorSDC::GenTag(CParameter & Parameter, CSingleBuffer < _BINARY > &SDCData,
+							 ETypeRxStatus eStatus)
 {
-	if (Parameter.ReceiveStatus.SDC.GetStatus() == FALSE)
+	if (eStatus == NOT_PRESENT)
 	{
 		PrepareTag(0);
 		SDCData.Clear();
@@ -1226,7 +1227,7 @@ CTagItemGeneratorPilots::GetProfiles()
 void
 CTagItemGeneratorPilots::GenTag(CParameter & Parameter)
 {
-	const CCellMappingTable& Param = Parameter.CellMappingTable;
+	const CCellMappingTable& Param = *Parameter.pCellMappingTable;
 	// Get parameters from parameter struct
 	int iScatPilTimeInt = Param.iScatPilTimeInt;
 	int iScatPilFreqInt = Param.iScatPilFreqInt;
@@ -1446,3 +1447,37 @@ CTagItemGeneratorAMAudio::GetTagName()
 {
 	return "rama";
 }
+
+void
+CTagItemGeneratorLatency::GenTag(const vector<_REAL>& vecrMilestoneTime,
+	uint64_t iBusyNs)
+{
+	/* One 32 bit value per milestone and the processing time */
+	PrepareTag((int(vecrMilestoneTime.size()) + 1) * 32);
+
+	/* Time to reach each milestone in ms, all ones if not reached */
+	for (size_t i = 0; i < vecrMilestoneTime.size(); i++)
+	{
+		if (vecrMilestoneTime[i] < (_REAL) 0.0)
+			Enqueue((uint32_t) 0xFFFFFFFF, 32);
+		else
+			Enqueue((uint32_t) (vecrMilestoneTime[i] * 1000), 32);
+	}
+
+	/* Processing time of all modules since the last tag in us. Compared to
+	   the frame duration this shows the CPU headroom */
+	Enqueue((uint32_t) ((iBusyNs - iLastBusyNs) / 1000), 32);
+	iLastBusyNs = iBusyNs;
+}
+
+string
+CTagItemGeneratorLatency::GetTagName()
+{
+	return "rlat";
+}
+
+string
+CTagItemGeneratorLatency::GetProfiles()
+{
+	return "ABCDQ";
+}
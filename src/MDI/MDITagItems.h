@@ -102,7 +102,10 @@ protected:
 class CTagItemGeneratorFAC : public CTagItemGeneratorWithProfiles /* fac_ tag */
 {
 public:
-	void GenTag(CParameter& Parameter, CSingleBuffer<_BINARY>& FACData);
+	void GenTag(CParameter& Parameter, CSingleBuffer<_BINARY>& FACData)
+		{GenTag(FACData, Parameter.ReceiveStatus.FAC.GetStatus());}
+	/* With the status given instead of taken from the receiver */
+	void GenTag(CSingleBuffer<_BINARY>& FACData, ETypeRxStatus eStatus);
 protected:
 	virtual string GetTagName();
 	virtual string GetProfiles(); // Return a string containing the set of profiles for this tag
@@ -111,7 +114,11 @@ protected:
 class CTagItemGeneratorSDC : public CTagItemGeneratorWithProfiles /* sdc_ tag */
 {
 public:
-	void GenTag(CParameter& Parameter, CSingleBuffer<_BINARY>& FACData);
+	void GenTag(CParameter& Parameter, CSingleBuffer<_BINARY>& SDCData)
+		{GenTag(Parameter, SDCData, Parameter.ReceiveStatus.SDC.GetStatus());}
+	/* With the status given instead of taken from the receiver */
+	void GenTag(CParameter& Parameter, CSingleBuffer<_BINARY>& SDCData,
+		ETypeRxStatus eStatus);
 protected:
 	virtual string GetTagName();
 	virtual string GetProfiles(); // Return a string containing the set of profiles for this tag
@@ -362,4 +369,18 @@ protected:
 		virtual string GetProfiles(void); // Return a string containing the set of profiles for this tag
 };
 
+class CTagItemGeneratorLatency : public CTagItemGeneratorWithProfiles /* rlat, Dream specific */
+{
+public:
+	CTagItemGeneratorLatency() : iLastBusyNs(0) {}
+	/* Times from the start of the acquisition in seconds, negative if the
+	   milestone was not reached yet, and total processing time so far */
+	void GenTag(const vector<_REAL>& vecrMilestoneTime, uint64_t iBusyNs);
+protected:
+	virtual string GetTagName();
+	virtual string GetProfiles(); // Return a string containing the set of profiles for this tag
+
+	uint64_t iLastBusyNs;
+};
+
 #endif
@@ -66,6 +66,9 @@ public:
 	virtual _BOOLEAN SetOrigin(const string& str) = 0;
 	virtual _BOOLEAN GetOrigin(string& str) = 0;
 	virtual void poll() = 0;
+	// Block until poll() has packets to deliver. Returns FALSE if the source
+	// can't wait (it has no reader thread), poll() then reads directly
+	virtual _BOOLEAN WaitForPackets(unsigned long) {return FALSE;}
 };
 
 
@@ -0,0 +1,109 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Single producer, single consumer ring of preallocated packet slots.
+ *	The socket ingest thread fills slots, the receiver thread drains them.
+ *	Only the fill count is shared, so no lock is taken per packet.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef PACKET_RING_H_INCLUDED
+#define PACKET_RING_H_INCLUDED
+
+#include "../GlobalDefinitions.h"
+#include <vector>
+
+#ifdef QT_CORE_LIB
+# include <QAtomicInt>
+#endif
+
+
+/* Classes ********************************************************************/
+class CRingPacket
+{
+public:
+	CRingPacket() : vecbyData(), iLen(0), iAddr(0), iPort(0), iTimeNs(0) {}
+
+	vector<_BYTE>	vecbyData; /* allocated once, never resized */
+	int				iLen;
+	uint32_t		iAddr; /* network byte order, like sockaddr_in */
+	uint16_t		iPort;
+	uint64_t		iTimeNs; /* arrival, CLatencyStats::GetTimeNs() */
+};
+
+class CPacketRing
+{
+public:
+	CPacketRing() : vecPackets(), iWrite(0), iRead(0), iCount(0) {}
+
+	void Init(const int iNumPackets, const int iMaxPacketLen)
+	{
+		vecPackets.resize(iNumPackets);
+		for (int i = 0; i < iNumPackets; i++)
+			vecPackets[i].vecbyData.resize(iMaxPacketLen);
+		iWrite = iRead = 0;
+		iCount.fetchAndStoreOrdered(0);
+	}
+	int Size() const {return (int) vecPackets.size();}
+
+	/* Producer side: fill up to NumFree() slots, then publish them */
+	int NumFree() {return Size() - iCount.fetchAndAddOrdered(0);}
+	CRingPacket& FreeSlot(const int i) {return vecPackets[(iWrite + i) % Size()];}
+	void Commit(const int iNum)
+	{
+		iWrite = (iWrite + iNum) % Size();
+		iCount.fetchAndAddOrdered(iNum);
+	}
+
+	/* Consumer side */
+	int NumUsed() {return iCount.fetchAndAddOrdered(0);}
+	CRingPacket& Front() {return vecPackets[iRead];}
+	void Pop()
+	{
+		iRead = (iRead + 1) % Size();
+		iCount.fetchAndAddOrdered(-1);
+	}
+
+protected:
+#ifdef QT_CORE_LIB
+	typedef QAtomicInt CCount;
+#else
+	/* Without threads both sides run in the same thread */
+	class CCount
+	{
+	public:
+		CCount(int i) : iVal(i) {}
+		int fetchAndAddOrdered(int i) {int o = iVal; iVal += i; return o;}
+		int fetchAndStoreOrdered(int i) {int o = iVal; iVal = i; return o;}
+	protected:
+		int iVal;
+	};
+#endif
+
+	vector<CRingPacket>	vecPackets;
+	int					iWrite; /* only touched by the producer */
+	int					iRead; /* only touched by the consumer */
+	CCount				iCount;
+};
+
+#endif
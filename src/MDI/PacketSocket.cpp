@@ -36,6 +36,7 @@ if I run it with the command:
 */
 
 #include "PacketSocket.h"
+#include "../util/Latency.h"
 #include <iostream>
 #include <sstream>
 #include <cerrno>
@@ -59,14 +60,25 @@ inline int inet_aton(const char*s, void * a) {
 # include <sys/socket.h>
 # include <unistd.h>
 # include <fcntl.h>
+# include <sys/select.h>
+# ifdef __linux__
+#  include <sys/epoll.h>
+# endif
 # define SOCKET_ERROR				(-1)
 # define INVALID_SOCKET				(-1)
 #endif
 
 CPacketSocketNative::CPacketSocketNative():
+#ifdef QT_CORE_LIB
+        pIngestThread(NULL),
+#endif
         pPacketSink(NULL), HostAddrOut(),
-        writeBuf(),udp(true),
-        s(INVALID_SOCKET), origin(""), dest("")
+        writeBuf(), vecbyPacket(), udp(true),
+        s(INVALID_SOCKET), origin(""), dest(""),
+        Ring(), MutexRing(), PacketsReady(), SpaceReady(),
+        bIngestRunning(false), bStopIngest(false), bRingFull(false),
+        iNumRingFull(0), iNumRingFullReported(0), pLatencyStats(NULL),
+        pQueueHist(NULL)
 {
 	memset(&sourceAddr, 0, sizeof(sourceAddr));
 	memset(&destAddr, 0, sizeof(destAddr));
@@ -75,6 +87,15 @@ CPacketSocketNative::CPacketSocketNative():
 
 CPacketSocketNative::~CPacketSocketNative()
 {
+	StopIngest();
+	if (s != INVALID_SOCKET)
+	{
+#ifdef _WIN32
+		closesocket(s);
+#else
+		close(s);
+#endif
+	}
 }
 
 // Set the sink which will receive the packets
@@ -350,78 +371,276 @@ CPacketSocketNative::SetOrigin(const string & strNewAddr)
 #else
     fcntl(s, F_SETFL, O_NONBLOCK);  // set to non-blocking
 #endif
+    /* Room for bursts while the receiver thread is busy */
+    int rcvbuf = INGEST_SOCKET_RCVBUF;
+    setsockopt(s, SOL_SOCKET, SO_RCVBUF, (char*)&rcvbuf, sizeof(rcvbuf));
+
+    StartIngest();
     return TRUE;
 }
 
 void
 CPacketSocketNative::poll()
 {
-    if (udp)
-        pollDatagram();
-    else
+    if (!udp)
         pollStream();
+    else if (bIngestRunning)
+        pollRing();
+    else
+        pollDatagram();
+}
+
+_BOOLEAN
+CPacketSocketNative::WaitForPackets(unsigned long iTimeoutMs)
+{
+    if (!bIngestRunning)
+        return FALSE;
+    MutexRing.Lock();
+    if (Ring.NumUsed() == 0)
+        (void)PacketsReady.Wait(&MutexRing, iTimeoutMs);
+    MutexRing.Unlock();
+    return TRUE;
+}
+
+void
+CPacketSocketNative::SetLatencyStats(CLatencyStats* pNewStats)
+{
+    pLatencyStats = pNewStats;
+    pQueueHist = pNewStats != NULL ?
+        pNewStats->GetHistogram("io.mdiqueue", FALSE) : NULL;
 }
 
 void
 CPacketSocketNative::pollStream()
 {
-    vector < _BYTE > vecbydata(MAX_SIZE_BYTES_NETW_BUF);
+    vecbyPacket.resize(MAX_SIZE_BYTES_NETW_BUF);
     /* Read block from network interface */
-    int iNumBytesRead = ::recv(s, (char *) &vecbydata[0], MAX_SIZE_BYTES_NETW_BUF, 0);
+    int iNumBytesRead = ::recv(s, (char *) &vecbyPacket[0], MAX_SIZE_BYTES_NETW_BUF, 0);
     if (iNumBytesRead > 0)
     {
         /* Decode the incoming packet */
         if (pPacketSink != NULL)
         {
-            vecbydata.resize(iNumBytesRead);
+            vecbyPacket.resize(iNumBytesRead);
             // TODO - is there any reason or possibility to optionally filter on source address?
-            pPacketSink->SendPacket(vecbydata, 0, 0);
+            pPacketSink->SendPacket(vecbyPacket, 0, 0);
         }
     }
 }
 
+/* Without the ingest thread the datagrams are read here, in the thread which
+   polls. The buffer keeps its capacity, resize() does not reallocate */
 void
 CPacketSocketNative::pollDatagram()
 {
-    vector < _BYTE > vecbydata(MAX_SIZE_BYTES_NETW_BUF);
     int readBytes = 0;
-	{
-		stringstream s;
-		char buf[32];
-		(void)buf;
-		s << "poll src: " << inet_ntop(AF_INET, &sourceAddr.sin_addr.s_addr, buf, sizeof(buf))
-		  << ":" << ntohs(sourceAddr.sin_port)
-		  << " dst: " << inet_ntop(AF_INET, &HostAddrOut.sin_addr.s_addr, buf, sizeof(buf)) 
-		  << ":" << ntohs(HostAddrOut.sin_port);
-		//qDebug(s.str().c_str());
-	}
-
     do {
         sockaddr_in sender;
         socklen_t l = sizeof(sender);
-        readBytes = ::recvfrom(s, (char*)&vecbydata[0], MAX_SIZE_BYTES_NETW_BUF, 0, (sockaddr*)&sender, &l);
+        vecbyPacket.resize(MAX_SIZE_BYTES_NETW_BUF);
+        readBytes = ::recvfrom(s, (char*)&vecbyPacket[0], MAX_SIZE_BYTES_NETW_BUF, 0, (sockaddr*)&sender, &l);
         if (readBytes>0) {
-			{
-				static int n=0;
-				stringstream s;
-				char buf[32];
-				(void)buf;
-				s << (n++) << " got from: " << inet_ntop(AF_INET, &sender.sin_addr.s_addr, buf, sizeof(buf))
-				  << ":" << ntohs(sender.sin_port);
-				//qDebug(s.str().c_str());
-			}
-            vecbydata.resize(readBytes);
-            if (sourceAddr.sin_addr.s_addr == htonl(INADDR_ANY))
-            {
-                pPacketSink->SendPacket(vecbydata, sender.sin_addr.s_addr, sender.sin_port);
-            }
-            else
-            {
-                if (sourceAddr.sin_addr.s_addr == sender.sin_addr.s_addr) // optionally filter on source address
-                {
-                    pPacketSink->SendPacket(vecbydata, sender.sin_addr.s_addr, sender.sin_port);
-                }
-            }
+            vecbyPacket.resize(readBytes);
+            DeliverDatagram(sender.sin_addr.s_addr, sender.sin_port);
         }
     } while (readBytes>0);
 }
+
+/* Hand the packets collected by the ingest thread to the sink */
+void
+CPacketSocketNative::pollRing()
+{
+    const int iNum = Ring.NumUsed();
+    if (iNum == 0)
+        return;
+    const _BOOLEAN bStats = pLatencyStats != NULL &&
+        pLatencyStats->GetEnabled() == TRUE;
+    const uint64_t iNow = bStats ? CLatencyStats::GetTimeNs() : 0;
+    for (int i = 0; i < iNum; i++)
+    {
+        const CRingPacket& Packet = Ring.Front();
+        if (bStats)
+            pLatencyStats->Add(pQueueHist, iNow - Packet.iTimeNs);
+        vecbyPacket.assign(Packet.vecbyData.begin(),
+            Packet.vecbyData.begin() + Packet.iLen);
+        const uint32_t addr = Packet.iAddr;
+        const uint16_t port = Packet.iPort;
+        Ring.Pop();
+        DeliverDatagram(addr, port);
+    }
+
+    if (bRingFull)
+    {
+        MutexRing.Lock();
+        SpaceReady.WakeOne();
+        MutexRing.Unlock();
+    }
+    if (iNumRingFull != iNumRingFullReported)
+    {
+        iNumRingFullReported = iNumRingFull;
+        cerr << "packet input ring full, receiver is not keeping up with " << origin << endl;
+    }
+}
+
+void
+CPacketSocketNative::DeliverDatagram(uint32_t addr, uint16_t port)
+{
+    if (pPacketSink == NULL)
+        return;
+    // optionally filter on source address
+    if (sourceAddr.sin_addr.s_addr == htonl(INADDR_ANY)
+            || sourceAddr.sin_addr.s_addr == addr)
+    {
+        pPacketSink->SendPacket(vecbyPacket, addr, port);
+    }
+}
+
+void
+CPacketSocketNative::StartIngest()
+{
+#ifdef QT_CORE_LIB
+    if (pIngestThread != NULL || s == INVALID_SOCKET)
+        return;
+    Ring.Init(INGEST_RING_SIZE, MAX_SIZE_BYTES_NETW_BUF);
+    bStopIngest = false;
+    bIngestRunning = true;
+    pIngestThread = new CIngestThread(*this);
+    pIngestThread->start();
+#endif
+}
+
+void
+CPacketSocketNative::StopIngest()
+{
+#ifdef QT_CORE_LIB
+    if (pIngestThread == NULL)
+        return;
+    bStopIngest = true;
+    MutexRing.Lock();
+    SpaceReady.WakeOne();
+    MutexRing.Unlock();
+    pIngestThread->wait();
+    delete pIngestThread;
+    pIngestThread = NULL;
+    bIngestRunning = false;
+#endif
+}
+
+/* Ingest thread: wait for the socket to become readable, then empty it into
+   the ring and wake the receiver thread once per burst */
+void
+CPacketSocketNative::Ingest()
+{
+#ifdef __linux__
+    int ep = epoll_create(1);
+    epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.fd = s;
+    if (ep < 0 || epoll_ctl(ep, EPOLL_CTL_ADD, s, &ev) < 0)
+    {
+        perror("epoll failed, reading packets in the receiver thread");
+        if (ep >= 0)
+            close(ep);
+        bIngestRunning = false;
+        return;
+    }
+#endif
+    while (!bStopIngest)
+    {
+        if (Ring.NumFree() == 0)
+        {
+            /* Leave the datagrams in the socket buffer until there is room */
+            if (!bRingFull)
+                iNumRingFull = iNumRingFull + 1;
+            bRingFull = true;
+            MutexRing.Lock();
+            if (Ring.NumFree() == 0 && !bStopIngest)
+                (void)SpaceReady.Wait(&MutexRing, INGEST_WAIT_MS);
+            MutexRing.Unlock();
+            continue;
+        }
+        bRingFull = false;
+
+#ifdef __linux__
+        epoll_event evReady;
+        const int iReady = epoll_wait(ep, &evReady, 1, INGEST_WAIT_MS);
+#else
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(s, &fds);
+        timeval tv;
+        tv.tv_sec = 0;
+        tv.tv_usec = INGEST_WAIT_MS * 1000;
+        const int iReady = select(int(s) + 1, &fds, NULL, NULL, &tv);
+#endif
+        if (iReady <= 0)
+            continue;
+
+        int iNum = 0, n;
+        while ((n = ReadBatch()) > 0)
+            iNum += n;
+        if (iNum > 0)
+        {
+            MutexRing.Lock();
+            PacketsReady.WakeOne();
+            MutexRing.Unlock();
+        }
+    }
+#ifdef __linux__
+    close(ep);
+#endif
+}
+
+/* Read what fits into the free slots, returns the number of packets read */
+int
+CPacketSocketNative::ReadBatch()
+{
+    const int iFree = Ring.NumFree();
+    if (iFree == 0)
+        return 0;
+#ifdef __linux__
+    const int iBatch = iFree < INGEST_BATCH_SIZE ? iFree : INGEST_BATCH_SIZE;
+    mmsghdr msgs[INGEST_BATCH_SIZE];
+    iovec iov[INGEST_BATCH_SIZE];
+    sockaddr_in senders[INGEST_BATCH_SIZE];
+    memset(msgs, 0, sizeof(msgs));
+    for (int i = 0; i < iBatch; i++)
+    {
+        CRingPacket& Packet = Ring.FreeSlot(i);
+        iov[i].iov_base = &Packet.vecbyData[0];
+        iov[i].iov_len = Packet.vecbyData.size();
+        msgs[i].msg_hdr.msg_name = &senders[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(senders[i]);
+        msgs[i].msg_hdr.msg_iov = &iov[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    const int n = recvmmsg(s, msgs, iBatch, MSG_DONTWAIT, NULL);
+    if (n <= 0)
+        return 0;
+    const uint64_t iNow = CLatencyStats::GetTimeNs();
+    for (int i = 0; i < n; i++)
+    {
+        CRingPacket& Packet = Ring.FreeSlot(i);
+        Packet.iLen = msgs[i].msg_len;
+        Packet.iAddr = senders[i].sin_addr.s_addr;
+        Packet.iPort = senders[i].sin_port;
+        Packet.iTimeNs = iNow;
+    }
+#else
+    CRingPacket& Packet = Ring.FreeSlot(0);
+    sockaddr_in sender;
+    socklen_t l = sizeof(sender);
+    const int iLen = ::recvfrom(s, (char*)&Packet.vecbyData[0],
+        (int) Packet.vecbyData.size(), 0, (sockaddr*)&sender, &l);
+    if (iLen <= 0)
+        return 0;
+    Packet.iLen = iLen;
+    Packet.iAddr = sender.sin_addr.s_addr;
+    Packet.iPort = sender.sin_port;
+    Packet.iTimeNs = CLatencyStats::GetTimeNs();
+    const int n = 1;
+#endif
+    Ring.Commit(n);
+    return n;
+}
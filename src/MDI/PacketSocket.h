@@ -43,7 +43,20 @@
    double of this size should be ok for all possible cases */
 #define MAX_SIZE_BYTES_NETW_BUF		10000
 
+/* UDP ingest thread: a multicast group can burst many datagrams between two
+   polls of the receiver thread, they are read in batches into a ring */
+#define INGEST_RING_SIZE			256 /* packets */
+#define INGEST_BATCH_SIZE			32 /* packets per recvmmsg() */
+#define INGEST_WAIT_MS				200 /* poll period for the stop flag */
+#define INGEST_SOCKET_RCVBUF		(4 << 20) /* bytes */
+
 #include "PacketInOut.h"
+#include "PacketRing.h"
+#include "../util/Latency.h"
+
+#ifdef QT_CORE_LIB
+# include <QThread>
+#endif
 
 class CPacketSocketNative :
 	public CPacketSocket
@@ -66,10 +79,39 @@ public:
 	virtual bool GetOrigin(string& str);
 
 	void poll();
+	virtual _BOOLEAN WaitForPackets(unsigned long iTimeoutMs);
+
+	/* For senders which write to the socket directly (RSI fan-out) */
+	SOCKET GetSocket() const {return s;}
+	const sockaddr_in& GetDestAddr() const {return HostAddrOut;}
+	bool IsUdp() const {return udp;}
+
+	/* Time the packets wait in the ingest ring, "NULL" switches it off */
+	void SetLatencyStats(CLatencyStats* pNewStats);
 
 private:
 	void pollStream();
 	void pollDatagram();
+	void pollRing();
+	void DeliverDatagram(uint32_t addr, uint16_t port);
+
+	/* UDP ingest thread */
+	void StartIngest();
+	void StopIngest();
+	void Ingest();
+	int ReadBatch();
+
+#ifdef QT_CORE_LIB
+	class CIngestThread : public QThread
+	{
+	public:
+		CIngestThread(CPacketSocketNative& NewSocket) : Socket(NewSocket) {}
+	protected:
+		virtual void run() {Socket.Ingest();}
+		CPacketSocketNative& Socket;
+	};
+	CIngestThread*	pIngestThread;
+#endif
 
 	vector<string> parseDest(const string & strNewAddr);
 	CPacketSink *pPacketSink;
@@ -77,8 +119,21 @@ private:
 	sockaddr_in sourceAddr, destAddr;
 	sockaddr_in HostAddrOut;
 	vector<_BYTE>	writeBuf;
+	vector<_BYTE>	vecbyPacket; /* reused for every packet passed to the sink */
 	bool udp;
 	SOCKET s;
 	string origin, dest;
+
+	CPacketRing		Ring;
+	CMutex			MutexRing; /* only for the wakeups, not the packets */
+	CWaitCondition	PacketsReady;
+	CWaitCondition	SpaceReady;
+	volatile bool	bIngestRunning;
+	volatile bool	bStopIngest;
+	volatile bool	bRingFull;
+	volatile uint64_t	iNumRingFull;
+	uint64_t		iNumRingFullReported;
+	CLatencyStats*		pLatencyStats;
+	CLatencyHistogram*	pQueueHist;
 };
 #endif
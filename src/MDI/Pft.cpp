@@ -33,11 +33,14 @@
 #include "Pft.h"
 #include "../util/CRC.h"
 #include <iostream>
+#include <cstring>
 
 CPft::CPft(int isrc, int idst):
 iSource(isrc),
 iDest(idst),
-mapFragments()
+mapFragments(),
+iRSk(0),
+iRSz(0)
 {
 }
 
@@ -65,11 +68,10 @@ bool CPft::DecodePFTPacket(const vector < _BYTE > &vecIn,
 	iAddr = (n & 0x4000) ? 1 : 0;
 	iPlen = n & 0x3FFF;
 
-//	int iRSk, iRSz;
 	if (iFEC == 1)
 	{
-//		iRSk = (int) vecIn[12];
-//		iRSz = (int) vecIn[13];
+		iRSk = (int) vecIn[12];
+		iRSz = (int) vecIn[13];
 		iHeaderLen += 2;
 	}
 
@@ -122,81 +124,278 @@ bool CPft::DecodeSimplePFTPacket(const vector < _BYTE > &vecIn,
 		vecOut = vecIn;
 		return true;
 	}
+	CReassemblerN& Fragments = mapFragments[iPseq];
+	/* all fragments but the last carry the same payload length */
+	Fragments.SetSizeHint(size_t(iFcount) * vecIn.size());
 	/* CReassembler does not modify the input vector, but its derived classes using CVectors do. */
-	mapFragments[iPseq].AddSegment(const_cast < vector < _BYTE > &>(vecIn),
+	Fragments.AddSegment(const_cast < vector < _BYTE > &>(vecIn),
 								   iFindex, iFindex == (iFcount - 1));
 
-	if (mapFragments[iPseq].Ready())
+	if (Fragments.Ready())
 	{
-		vecOut = mapFragments[iPseq].vecData;
+		vecOut.swap(Fragments.vecData);
+		mapFragments.erase(iPseq);
 		return true;
 	}
 
+	/* forget about packets which will never be completed */
+	map<int,CReassemblerN>::iterator i = mapFragments.begin();
+	while (i != mapFragments.end())
+	{
+		const uint16_t iAge = uint16_t(iPseq - i->first);
+		if ((iAge > MAX_PFT_PSEQ_WINDOW) && (iAge < 0x10000 - MAX_PFT_PSEQ_WINDOW))
+			mapFragments.erase(i++);
+		else
+			++i;
+	}
+
 	return false;
 }
 
-bool CPft::DecodePFTPacketWithFEC(const vector < _BYTE > &,
-								  vector < _BYTE > &)
+bool CPft::DecodePFTPacketWithFEC(const vector < _BYTE > &vecIn,
+								  vector < _BYTE > &vecOut)
 {
-	cerr << "sorry, PFT/FEC not implemented yet" << endl;
-	return false;
+	/* The fragments carry the interleaved RS code words, one row per chunk
+	   of RSk data bytes plus the parity. Only complete packets are used,
+	   lost fragments are not recovered */
+	vector<_BYTE> vecCoded;
+	if (!DecodeSimplePFTPacket(vecIn, vecCoded))
+		return false;
+
+	const size_t iRowLen = size_t(iRSk) + PFT_RS_PARITY_LEN;
+	const size_t iNumRows = vecCoded.size() / iRowLen;
+	if (iRSk == 0 || iNumRows * iRowLen != vecCoded.size() ||
+		iNumRows * size_t(iRSk) < size_t(iRSz))
+	{
+		cerr << "PFT FEC packet with wrong length" << endl;
+		return false;
+	}
+
+	vecOut.resize(iNumRows * size_t(iRSk) - size_t(iRSz));
+	for (size_t i = 0; i < vecOut.size(); i++)
+	{
+		const size_t iRow = i / size_t(iRSk);
+		const size_t iCol = i - iRow * size_t(iRSk);
+		vecOut[i] = vecCoded[iCol * iNumRows + iRow];
+	}
+	return true;
 }
 
 void
 CPft::MakePFTPackets(const vector < _BYTE > &vecbydata, vector < vector < _BYTE > >&packets,
 	uint16_t sequence_counter, size_t fragment_size)
 {
-	uint32_t num_packets, data_size = vecbydata.size();
-	size_t header_bytesize, payload_bytesize;
-	header_bytesize = 14;		// no addressing or FEC
-	if ((fragment_size > 0) && (fragment_size < (data_size + header_bytesize)))
-	{
-		payload_bytesize = fragment_size - header_bytesize;
-		num_packets = data_size / payload_bytesize;
-		if (num_packets * payload_bytesize < data_size)
-			num_packets++;
-		payload_bytesize = data_size / num_packets;
-		if (num_packets * payload_bytesize < data_size)
-			payload_bytesize++;
+	CPftPacketBuilder Builder;
+	Builder.Build(vecbydata, sequence_counter, fragment_size);
+
+	packets.resize(Builder.GetNumFragments());
+	for (size_t n = 0; n < packets.size(); n++)
+	{
+		const _BYTE* p = Builder.GetFragment(n);
+		packets[n].assign(p, p + Builder.GetFragmentLen(n));
 	}
-	else
+}
+
+/* Galois field GF(2^8) with the field polynomial x^8+x^4+x^3+x^2+1 and the
+   generator polynomial (x+a^0)(x+a^1)...(x+a^47) of the PFT RS code */
+class CPftRSTables
+{
+public:
+	CPftRSTables()
+	{
+		int i, j;
+		int x = 1;
+		for (i = 0; i < 255; i++)
+		{
+			Exp[i] = Exp[i + 255] = (_BYTE) x;
+			Log[x] = i;
+			x <<= 1;
+			if (x & 0x100)
+				x ^= 0x11D;
+		}
+		Log[0] = 0; /* never used */
+
+		/* Coefficient of x^j in Gen[j], Gen[PFT_RS_PARITY_LEN] = 1 */
+		for (j = 0; j <= PFT_RS_PARITY_LEN; j++)
+			Gen[j] = 0;
+		Gen[0] = 1;
+		for (i = 0; i < PFT_RS_PARITY_LEN; i++)
+		{
+			for (j = i + 1; j > 0; j--)
+				Gen[j] = Gen[j - 1] ^ Mul(Gen[j], Exp[i]);
+			Gen[0] = Mul(Gen[0], Exp[i]);
+		}
+	}
+
+	_BYTE Mul(const _BYTE a, const _BYTE b) const
+	{
+		if (a == 0 || b == 0)
+			return 0;
+		return Exp[Log[a] + Log[b]];
+	}
+
+	_BYTE	Exp[510];
+	int		Log[256];
+	_BYTE	Gen[PFT_RS_PARITY_LEN + 1];
+};
+
+static const CPftRSTables PftRSTables;
+
+void CPftPacketBuilder::Build(const vector<_BYTE>& vecbyAF, const uint16_t iSeq,
+							  const size_t iFragmentSize, const int iFECLost)
+{
+	if (iFECLost > 0)
+	{
+		BuildFEC(vecbyAF, iSeq, iFragmentSize, iFECLost);
+		return;
+	}
+
+	/* Equal payload lengths, only the last fragment may be shorter */
+	const size_t iDataSize = vecbyAF.size();
+	size_t iNumPackets = 1;
+	size_t iPayloadSize = iDataSize;
+	if ((iFragmentSize > PFT_HEADER_LEN) &&
+		(iFragmentSize < iDataSize + PFT_HEADER_LEN))
+	{
+		const size_t iMaxPayload = iFragmentSize - PFT_HEADER_LEN;
+		iNumPackets = (iDataSize + iMaxPayload - 1) / iMaxPayload;
+		iPayloadSize = (iDataSize + iNumPackets - 1) / iNumPackets;
+	}
+
+	const size_t iSlot = PFT_HEADER_LEN + iPayloadSize;
+	vecbyBuffer.resize(iNumPackets * iSlot);
+	veciOffset.resize(iNumPackets);
+	veciLen.resize(iNumPackets);
+
+	size_t iRemaining = iDataSize;
+	for (size_t n = 0; n < iNumPackets; n++)
+	{
+		const size_t iLen = iRemaining < iPayloadSize ? iRemaining : iPayloadSize;
+		_BYTE* p = &vecbyBuffer[n * iSlot];
+		PutHeader(p, iSeq, uint32_t(n), uint32_t(iNumPackets), iLen);
+		if (iLen > 0)
+			memcpy(p + PFT_HEADER_LEN, &vecbyAF[iDataSize - iRemaining], iLen);
+		veciOffset[n] = n * iSlot;
+		veciLen[n] = PFT_HEADER_LEN + iLen;
+		iRemaining -= iLen;
+	}
+}
+
+void CPftPacketBuilder::BuildFEC(const vector<_BYTE>& vecbyAF, const uint16_t iSeq,
+								 const size_t iFragmentSize, const int iFECLost)
+{
+	/* c chunks of k bytes, the last one padded with z zeros, each chunk is
+	   followed by its parity. The rows are sent column by column, so a lost
+	   fragment costs each code word at most ceil(s / c) bytes */
+	const size_t iDataSize = vecbyAF.size();
+	const size_t c = iDataSize == 0 ? 1 :
+		(iDataSize + PFT_RS_DATA_LEN - 1) / PFT_RS_DATA_LEN;
+	const size_t k = iDataSize == 0 ? 1 : (iDataSize + c - 1) / c;
+	const size_t z = c * k - iDataSize;
+	const size_t iRowLen = k + PFT_RS_PARITY_LEN;
+	const size_t iTotal = c * iRowLen;
+
+	size_t iMaxPayload = c * PFT_RS_PARITY_LEN / size_t(iFECLost + 1);
+	if ((iFragmentSize > PFT_HEADER_LEN_FEC) &&
+		(iFragmentSize - PFT_HEADER_LEN_FEC < iMaxPayload))
+	{
+		iMaxPayload = iFragmentSize - PFT_HEADER_LEN_FEC;
+	}
+	if (iMaxPayload == 0)
+		iMaxPayload = 1;
+
+	const size_t iNumPackets = (iTotal + iMaxPayload - 1) / iMaxPayload;
+	const size_t s = (iTotal + iNumPackets - 1) / iNumPackets;
+	const size_t iSlot = PFT_HEADER_LEN_FEC + s;
+	vecbyBuffer.resize(iNumPackets * iSlot);
+	veciOffset.resize(iNumPackets);
+	veciLen.resize(iNumPackets);
+
+	size_t n;
+	for (n = 0; n < iNumPackets; n++)
+	{
+		const size_t iLen = n + 1 < iNumPackets ? s : iTotal - n * s;
+		PutHeader(&vecbyBuffer[n * iSlot], iSeq, uint32_t(n),
+			uint32_t(iNumPackets), iLen, int(k), int(z));
+		veciOffset[n] = n * iSlot;
+		veciLen[n] = PFT_HEADER_LEN_FEC + iLen;
+	}
+
+	/* Write the code words straight to their places in the fragments.
+	   Interleaved position q is byte q % s of fragment q / s */
+	for (size_t r = 0; r < c; r++)
+	{
+		const size_t iStart = r * k;
+		const size_t iLen = iStart + k <= iDataSize ? k : iDataSize - iStart;
+		const _BYTE* pbyRow = iLen > 0 ? &vecbyAF[iStart] : NULL;
+		EncodeRS(pbyRow, iLen, k - iLen);
+
+		for (size_t j = 0; j < iRowLen; j++)
+		{
+			_BYTE by;
+			if (j < iLen)
+				by = pbyRow[j];
+			else if (j < k)
+				by = 0;
+			else
+				by = vecbyParity[j - k];
+
+			const size_t q = j * c + r;
+			n = q / s;
+			vecbyBuffer[n * iSlot + PFT_HEADER_LEN_FEC + q - n * s] = by;
+		}
+	}
+}
+
+void CPftPacketBuilder::PutHeader(_BYTE* pbyHeader, const uint16_t iSeq,
+								  const uint32_t iIndex, const uint32_t iCount,
+								  const size_t iPayloadLen, const int iRSk,
+								  const int iRSz)
+{
+	_BYTE* p = pbyHeader;
+	*p++ = 'P';
+	*p++ = 'F';
+	*p++ = _BYTE(iSeq >> 8);
+	*p++ = _BYTE(iSeq & 0xff);
+	*p++ = _BYTE(iIndex >> 16);
+	*p++ = _BYTE((iIndex >> 8) & 0xff);
+	*p++ = _BYTE(iIndex & 0xff);
+	*p++ = _BYTE(iCount >> 16);
+	*p++ = _BYTE((iCount >> 8) & 0xff);
+	*p++ = _BYTE(iCount & 0xff);
+	/* FEC flag, no addressing, payload length */
+	const uint16_t iFlagsLen = uint16_t((iRSk >= 0 ? 0x8000 : 0) | (iPayloadLen & 0x3FFF));
+	*p++ = _BYTE(iFlagsLen >> 8);
+	*p++ = _BYTE(iFlagsLen & 0xff);
+	if (iRSk >= 0)
+	{
+		*p++ = _BYTE(iRSk);
+		*p++ = _BYTE(iRSz);
+	}
+
+	CCRC CRCObject;
+	CRCObject.Reset(16);
+	for (_BYTE* q = pbyHeader; q < p; q++)
+		CRCObject.AddByte(*q);
+	const uint16_t iCRC = uint16_t(CRCObject.GetCRC());
+	*p++ = _BYTE(iCRC >> 8);
+	*p = _BYTE(iCRC & 0xff);
+}
+
+void CPftPacketBuilder::EncodeRS(const _BYTE* pbyData, const size_t iLen,
+								 const size_t iNumZeros)
+{
+	/* Remainder of the division by the generator polynomial, highest
+	   coefficient first. Shortening needs no extra work, leading zeros do
+	   not change the remainder */
+	_BYTE* p = &vecbyParity[0];
+	memset(p, 0, PFT_RS_PARITY_LEN);
+	for (size_t i = 0; i < iLen + iNumZeros; i++)
 	{
-		num_packets = 1;
-		payload_bytesize = data_size;
-	}
-	size_t bytes_remaining = data_size;
-	packets.clear();
-	packets.resize(num_packets);
-	vector<_BYTE>::const_iterator p = vecbydata.begin();
-	for (uint32_t n = 0; n < num_packets; n++)
-	{
-		if (bytes_remaining < payload_bytesize)
-			payload_bytesize = bytes_remaining;	// last packet
-
-		CCRC CRCObject;
-		CRCObject.Reset(16);
-
-		// write PFT Packet Header
-		uint8_t c;
-		c='P'; CRCObject.AddByte(c); packets[n].push_back(c);
-		c='F'; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=sequence_counter >> 8; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=sequence_counter & 0xff; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=n >> 16; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=(n >> 8) & 0xff; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=n & 0xff; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=num_packets >> 16; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=(num_packets >> 8) & 0xff; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=num_packets & 0xff; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=payload_bytesize >> 8; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=payload_bytesize & 0xff; CRCObject.AddByte(c); packets[n].push_back(c);
-		// CRC
-		uint16_t crc_val = uint16_t(CRCObject.GetCRC());
-		c=crc_val >> 8; CRCObject.AddByte(c); packets[n].push_back(c);
-		c=crc_val & 0xff; CRCObject.AddByte(c); packets[n].push_back(c);
-		// write PFT Packet Payload
-		packets[n].insert(packets[n].end(), p, p+payload_bytesize);
-		p += payload_bytesize;
-		bytes_remaining -= payload_bytesize;
+		const _BYTE byFeedback = (i < iLen ? pbyData[i] : 0) ^ p[0];
+		for (int j = 0; j < PFT_RS_PARITY_LEN - 1; j++)
+			p[j] = p[j + 1] ^ PftRSTables.Mul(byFeedback,
+				PftRSTables.Gen[PFT_RS_PARITY_LEN - 1 - j]);
+		p[PFT_RS_PARITY_LEN - 1] = PftRSTables.Mul(byFeedback, PftRSTables.Gen[0]);
 	}
 }
@@ -32,6 +32,16 @@
 #include "../util/Reassemble.h"
 #include <map>
 
+/* Packets more than this many sequence numbers old are given up */
+#define MAX_PFT_PSEQ_WINDOW 64
+
+/* PFT FEC (ETSI TS 102 821): shortened Reed-Solomon RS(255,207) over the
+   chunks of an AF packet */
+#define PFT_RS_DATA_LEN		207
+#define PFT_RS_PARITY_LEN	48
+#define PFT_HEADER_LEN		14
+#define PFT_HEADER_LEN_FEC	16
+
 class CPft
 {
 public:
@@ -56,6 +66,41 @@ protected:
 	int iFEC;
 	int iAddr;
 	int iPlen;
+	int iRSk;
+	int iRSz;
+};
+
+/* Builds the PFT fragments of an AF packet in one buffer which is reused for
+   every packet. The fragments can be handed to the socket in place */
+class CPftPacketBuilder
+{
+public:
+	CPftPacketBuilder() : vecbyBuffer(), veciOffset(), veciLen(),
+		vecbyParity(PFT_RS_PARITY_LEN) {}
+
+	/* "iFragmentSize": maximum datagram size, 0 for no limit. "iFECLost":
+	   number of lost fragments the receiver can recover, 0: no FEC */
+	void Build(const vector<_BYTE>& vecbyAF, const uint16_t iSeq,
+		const size_t iFragmentSize, const int iFECLost = 0);
+
+	size_t GetNumFragments() const {return veciLen.size();}
+	const _BYTE* GetFragment(const size_t i) const
+		{return &vecbyBuffer[veciOffset[i]];}
+	size_t GetFragmentLen(const size_t i) const {return veciLen[i];}
+
+protected:
+	void BuildFEC(const vector<_BYTE>& vecbyAF, const uint16_t iSeq,
+		const size_t iFragmentSize, const int iFECLost);
+	void PutHeader(_BYTE* pbyHeader, const uint16_t iSeq, const uint32_t iIndex,
+		const uint32_t iCount, const size_t iPayloadLen, const int iRSk = -1,
+		const int iRSz = 0);
+	/* Parity of "iLen" bytes followed by "iNumZeros" zero bytes */
+	void EncodeRS(const _BYTE* pbyData, const size_t iLen, const size_t iNumZeros);
+
+	vector<_BYTE>	vecbyBuffer;
+	vector<size_t>	veciOffset;
+	vector<size_t>	veciLen;
+	vector<_BYTE>	vecbyParity;
 };
 
 #endif
@@ -0,0 +1,375 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Fan-out of RSI packets to many subscribers
+ *
+ * The receiver thread serialises each DI frame once per encoding, that is
+ * per profile, AF CRC and PFT fragment size, and all subscribers with the
+ * same encoding share the buffers. The network subscribers are then served
+ * by a separate thread, so a slow network or a large number of clients does
+ * not delay the signal processing:
+ *	- UDP subscribers get all packets of a frame with one sendmmsg() call
+ *	  (Linux, other systems use sendto()),
+ *	- TCP subscribers get a queue of frames written with non-blocking
+ *	  sends. If a client does not keep up, new frames are dropped for this
+ *	  client only once RSI_TCP_MAX_QUEUED_FRAMES are waiting.
+ * Without thread support the packets are sent at the end of the frame.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "RSIFanOut.h"
+#include "Pft.h"
+#include "TagPacketGenerator.h"
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <sys/types.h>
+# include <sys/socket.h>
+# include <fcntl.h>
+#endif
+
+
+/* Implementation *************************************************************/
+static bool WouldBlock()
+{
+#ifdef _WIN32
+	return WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+	return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+#endif
+}
+
+CRSIFanOut::CRSIFanOut() :
+#ifdef QT_CORE_LIB
+	pNetworkThread(NULL),
+#endif
+	vecEncoders(), Mutex(), JobsReady(), vecJobs(), bStop(false),
+	TcpQueues(), bTcpPending(false)
+{
+}
+
+CRSIFanOut::~CRSIFanOut()
+{
+	Stop();
+
+	/* Frames which were never sent */
+	for (size_t i = 0; i < vecJobs.size(); i++)
+		delete vecJobs[i].pFrame;
+	for (size_t i = 0; i < vecEncoders.size(); i++)
+		delete vecEncoders[i].pFrame;
+	for (map<SOCKET, CTcpQueue>::iterator q = TcpQueues.begin();
+		q != TcpQueues.end(); q++)
+	{
+		while (!q->second.Frames.empty())
+		{
+			Release(q->second.Frames.front());
+			q->second.Frames.pop_front();
+		}
+	}
+}
+
+void CRSIFanOut::Stop()
+{
+#ifdef QT_CORE_LIB
+	if (pNetworkThread == NULL)
+		return;
+	Mutex.Lock();
+	bStop = true;
+	JobsReady.WakeOne();
+	Mutex.Unlock();
+	pNetworkThread->wait();
+	delete pNetworkThread;
+	pNetworkThread = NULL;
+#endif
+}
+
+void CRSIFanOut::BeginFrame()
+{
+	for (size_t i = 0; i < vecEncoders.size(); i++)
+	{
+		vecEncoders[i].pFrame = NULL;
+		vecEncoders[i].vecDest.clear();
+	}
+}
+
+int CRSIFanOut::GetEncoder(const char cProfile, const _BOOLEAN bUseAFCRC,
+	const size_t iFragmentSize)
+{
+	for (size_t i = 0; i < vecEncoders.size(); i++)
+	{
+		const CEncoder& Enc = vecEncoders[i];
+		if (Enc.cProfile == cProfile && Enc.bUseAFCRC == bUseAFCRC
+			&& Enc.iFragmentSize == iFragmentSize)
+		{
+			return (int) i;
+		}
+	}
+	vecEncoders.push_back(CEncoder(cProfile, bUseAFCRC, iFragmentSize));
+	return (int) vecEncoders.size() - 1;
+}
+
+const CRSIFrame* CRSIFanOut::GetFrame(const int iEncoder) const
+{
+	return vecEncoders[iEncoder].pFrame;
+}
+
+const CRSIFrame& CRSIFanOut::Encode(const int iEncoder,
+	CTagPacketGenerator& Generator)
+{
+	CEncoder& Enc = vecEncoders[iEncoder];
+	Enc.pFrame = new CRSIFrame;
+
+	Generator.SetProfile(Enc.cProfile);
+	vector<_BYTE> packet =
+		Enc.AFPacketGenerator.GenAFPacket(Enc.bUseAFCRC, Generator);
+	if (Enc.iFragmentSize > 0)
+	{
+		CPft::MakePFTPackets(packet, Enc.pFrame->vecPackets, Enc.iPftSeq,
+			Enc.iFragmentSize);
+		Enc.iPftSeq++;
+	}
+	else
+		Enc.pFrame->vecPackets.push_back(packet);
+
+	return *Enc.pFrame;
+}
+
+void CRSIFanOut::AddDestination(const int iEncoder, CPacketSocketNative* pSocket)
+{
+	vecEncoders[iEncoder].vecDest.push_back(pSocket);
+}
+
+void CRSIFanOut::EndFrame()
+{
+	vector<CJob> vecNewJobs;
+	for (size_t i = 0; i < vecEncoders.size(); i++)
+	{
+		CEncoder& Enc = vecEncoders[i];
+		if (Enc.pFrame == NULL)
+			continue;
+		if (Enc.vecDest.empty())
+			delete Enc.pFrame; /* only used by file subscribers */
+		else
+			vecNewJobs.push_back(CJob(Enc.pFrame, Enc.vecDest));
+		Enc.pFrame = NULL;
+		Enc.vecDest.clear();
+	}
+	if (vecNewJobs.empty())
+		return;
+
+#ifdef QT_CORE_LIB
+	if (pNetworkThread == NULL)
+	{
+		bStop = false;
+		pNetworkThread = new CNetworkThread(*this);
+		pNetworkThread->start();
+	}
+
+	Mutex.Lock();
+	vecJobs.insert(vecJobs.end(), vecNewJobs.begin(), vecNewJobs.end());
+	/* The network thread is stuck, drop the oldest frames */
+	while (vecJobs.size() > RSI_FANOUT_MAX_JOBS)
+	{
+		delete vecJobs.front().pFrame;
+		vecJobs.erase(vecJobs.begin());
+	}
+	JobsReady.WakeOne();
+	Mutex.Unlock();
+#else
+	SendJobs(vecNewJobs);
+	FlushTcp();
+#endif
+}
+
+void CRSIFanOut::Run()
+{
+	vector<CJob> vecSendJobs;
+	Mutex.Lock();
+	while (!bStop)
+	{
+		if (vecJobs.empty())
+		{
+			/* Retry soon if a TCP subscriber could not take everything */
+			(void) JobsReady.Wait(&Mutex, bTcpPending ?
+				RSI_FANOUT_TCP_RETRY_MS : RSI_FANOUT_WAIT_MS);
+		}
+		vecSendJobs.swap(vecJobs);
+		Mutex.Unlock();
+
+		SendJobs(vecSendJobs);
+		vecSendJobs.clear();
+		FlushTcp();
+
+		Mutex.Lock();
+	}
+	Mutex.Unlock();
+}
+
+void CRSIFanOut::SendJobs(vector<CJob>& vecSendJobs)
+{
+	for (size_t i = 0; i < vecSendJobs.size(); i++)
+	{
+		CJob& Job = vecSendJobs[i];
+		for (size_t j = 0; j < Job.vecDest.size(); j++)
+		{
+			const CPacketSocketNative& Socket = *Job.vecDest[j];
+			if (Socket.IsUdp())
+				SendUdp(*Job.pFrame, Socket);
+			else
+				QueueTcp(Job.pFrame, Socket);
+		}
+		if (Job.pFrame->iRefs == 0)
+			delete Job.pFrame;
+		Job.pFrame = NULL;
+	}
+}
+
+void CRSIFanOut::SendUdp(const CRSIFrame& Frame, const CPacketSocketNative& Socket)
+{
+	const SOCKET s = Socket.GetSocket();
+	const sockaddr_in& Addr = Socket.GetDestAddr();
+	const size_t iNumPackets = Frame.vecPackets.size();
+#ifdef __linux__
+	mmsghdr msgs[RSI_FANOUT_BATCH_SIZE];
+	iovec iov[RSI_FANOUT_BATCH_SIZE];
+	size_t iSent = 0;
+	while (iSent < iNumPackets)
+	{
+		size_t iBatch = iNumPackets - iSent;
+		if (iBatch > RSI_FANOUT_BATCH_SIZE)
+			iBatch = RSI_FANOUT_BATCH_SIZE;
+		memset(msgs, 0, sizeof(mmsghdr) * iBatch);
+		for (size_t i = 0; i < iBatch; i++)
+		{
+			const vector<_BYTE>& vecbyPacket = Frame.vecPackets[iSent + i];
+			iov[i].iov_base = (void*) &vecbyPacket[0];
+			iov[i].iov_len = vecbyPacket.size();
+			msgs[i].msg_hdr.msg_name = (void*) &Addr;
+			msgs[i].msg_hdr.msg_namelen = sizeof(Addr);
+			msgs[i].msg_hdr.msg_iov = &iov[i];
+			msgs[i].msg_hdr.msg_iovlen = 1;
+		}
+		const int n = sendmmsg(s, msgs, (unsigned int) iBatch, 0);
+		if (n <= 0)
+			break; /* datagrams may get lost anyway */
+		iSent += n;
+	}
+#else
+	for (size_t i = 0; i < iNumPackets; i++)
+	{
+		const vector<_BYTE>& vecbyPacket = Frame.vecPackets[i];
+		(void) sendto(s, (const char*) &vecbyPacket[0], (int) vecbyPacket.size(),
+			0, (const sockaddr*) &Addr, sizeof(Addr));
+	}
+#endif
+}
+
+void CRSIFanOut::QueueTcp(CRSIFrame* pFrame, const CPacketSocketNative& Socket)
+{
+	const SOCKET s = Socket.GetSocket();
+	map<SOCKET, CTcpQueue>::iterator q = TcpQueues.find(s);
+	if (q == TcpQueues.end())
+	{
+		/* From now on this socket is only written by this thread */
+#ifdef _WIN32
+		u_long mode = 1;
+		(void) ioctlsocket(s, FIONBIO, &mode);
+#else
+		fcntl(s, F_SETFL, fcntl(s, F_GETFL) | O_NONBLOCK);
+#endif
+		q = TcpQueues.insert(make_pair(s, CTcpQueue())).first;
+	}
+
+	CTcpQueue& Queue = q->second;
+	if (Queue.bClosed)
+		return;
+	if (Queue.Frames.size() >= RSI_TCP_MAX_QUEUED_FRAMES)
+	{
+		if (Queue.iDropped == 0)
+			cerr << "RSI subscriber is not reading, dropping frames" << endl;
+		Queue.iDropped++;
+		return;
+	}
+	pFrame->iRefs++;
+	Queue.Frames.push_back(pFrame);
+}
+
+void CRSIFanOut::FlushTcp()
+{
+	bTcpPending = false;
+	for (map<SOCKET, CTcpQueue>::iterator q = TcpQueues.begin();
+		q != TcpQueues.end(); q++)
+	{
+		CTcpQueue& Queue = q->second;
+		bool bClosed = false;
+		while (!Queue.Frames.empty())
+		{
+			CRSIFrame* pFrame = Queue.Frames.front();
+			if (Queue.iPacket >= pFrame->vecPackets.size())
+			{
+				Queue.Frames.pop_front();
+				Release(pFrame);
+				Queue.iPacket = Queue.iOffset = 0;
+				continue;
+			}
+			const vector<_BYTE>& vecbyPacket = pFrame->vecPackets[Queue.iPacket];
+			const int n = send(q->first, (const char*) &vecbyPacket[Queue.iOffset],
+				(int) (vecbyPacket.size() - Queue.iOffset), 0);
+			if (n < 0)
+			{
+				bClosed = !WouldBlock();
+				break;
+			}
+			Queue.iOffset += n;
+			if (Queue.iOffset >= vecbyPacket.size())
+			{
+				Queue.iPacket++;
+				Queue.iOffset = 0;
+			}
+		}
+
+		if (bClosed)
+		{
+			cerr << "RSI subscriber connection lost" << endl;
+			Queue.bClosed = true;
+			while (!Queue.Frames.empty())
+			{
+				Release(Queue.Frames.front());
+				Queue.Frames.pop_front();
+			}
+		}
+		if (!Queue.Frames.empty())
+			bTcpPending = true;
+	}
+}
+
+void CRSIFanOut::Release(CRSIFrame* pFrame)
+{
+	pFrame->iRefs--;
+	if (pFrame->iRefs <= 0)
+		delete pFrame;
+}
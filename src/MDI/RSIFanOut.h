@@ -0,0 +1,159 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Fan-out of RSI packets to many subscribers. See RSIFanOut.cpp.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef RSI_FAN_OUT_H_INCLUDED
+#define RSI_FAN_OUT_H_INCLUDED
+
+#include "../GlobalDefinitions.h"
+#include "AFPacketGenerator.h"
+#include "PacketSocket.h"
+#include <vector>
+#include <deque>
+#include <map>
+
+#ifdef QT_CORE_LIB
+# include <QThread>
+#endif
+
+
+/* Definitions ****************************************************************/
+#define RSI_FANOUT_BATCH_SIZE		64 /* datagrams per sendmmsg() */
+#define RSI_FANOUT_MAX_JOBS			64 /* frames waiting for the network thread */
+#define RSI_FANOUT_WAIT_MS			400 /* one DRM frame */
+#define RSI_FANOUT_TCP_RETRY_MS		20
+/* Frames queued for a TCP subscriber which does not read fast enough, newer
+   frames are dropped for this subscriber only */
+#define RSI_TCP_MAX_QUEUED_FRAMES	10
+
+
+/* Classes ********************************************************************/
+class CTagPacketGenerator;
+
+/* One DI frame encoded for one profile: the AF packet or its PFT fragments */
+class CRSIFrame
+{
+public:
+	CRSIFrame() : vecPackets(), iRefs(0) {}
+
+	vector< vector<_BYTE> >	vecPackets;
+	int						iRefs; /* TCP queues holding it, network thread only */
+};
+
+class CRSIFanOut
+{
+public:
+	CRSIFanOut();
+	virtual ~CRSIFanOut();
+
+	/* Receiver thread, once per DI frame: BeginFrame(), for each subscriber
+	   GetEncoder() and GetFrame() or Encode(), then EndFrame() */
+	void BeginFrame();
+	int GetEncoder(const char cProfile, const _BOOLEAN bUseAFCRC,
+		const size_t iFragmentSize);
+	/* NULL if this encoder has not been used in this frame yet */
+	const CRSIFrame* GetFrame(const int iEncoder) const;
+	const CRSIFrame& Encode(const int iEncoder, CTagPacketGenerator& Generator);
+	/* The frame is sent to this socket by the network thread */
+	void AddDestination(const int iEncoder, CPacketSocketNative* pSocket);
+	void EndFrame();
+
+	/* Must be called before the sockets are deleted */
+	void Stop();
+
+protected:
+	class CEncoder
+	{
+	public:
+		CEncoder(const char cNewProfile, const _BOOLEAN bNewUseAFCRC,
+			const size_t iNewFragmentSize) : cProfile(cNewProfile),
+			bUseAFCRC(bNewUseAFCRC), iFragmentSize(iNewFragmentSize),
+			AFPacketGenerator(), iPftSeq(0), pFrame(NULL), vecDest() {}
+
+		char						cProfile;
+		_BOOLEAN					bUseAFCRC;
+		size_t						iFragmentSize; /* 0: no PFT */
+		CAFPacketGenerator			AFPacketGenerator;
+		uint16_t					iPftSeq;
+		CRSIFrame*					pFrame;
+		vector<CPacketSocketNative*>	vecDest;
+	};
+
+	class CJob
+	{
+	public:
+		CJob(CRSIFrame* pNewFrame, const vector<CPacketSocketNative*>& vecNewDest)
+			: pFrame(pNewFrame), vecDest(vecNewDest) {}
+
+		CRSIFrame*						pFrame;
+		vector<CPacketSocketNative*>	vecDest;
+	};
+
+	class CTcpQueue
+	{
+	public:
+		CTcpQueue() : Frames(), iPacket(0), iOffset(0), iDropped(0),
+			bClosed(false) {}
+
+		deque<CRSIFrame*>	Frames;
+		size_t				iPacket; /* position in the first frame */
+		size_t				iOffset;
+		uint64_t			iDropped;
+		bool				bClosed; /* peer has gone, stop queueing */
+	};
+
+	/* Network thread */
+	void Run();
+	void SendJobs(vector<CJob>& vecSendJobs);
+	void SendUdp(const CRSIFrame& Frame, const CPacketSocketNative& Socket);
+	void QueueTcp(CRSIFrame* pFrame, const CPacketSocketNative& Socket);
+	void FlushTcp();
+	void Release(CRSIFrame* pFrame);
+
+#ifdef QT_CORE_LIB
+	class CNetworkThread : public QThread
+	{
+	public:
+		CNetworkThread(CRSIFanOut& NewFanOut) : FanOut(NewFanOut) {}
+	protected:
+		virtual void run() {FanOut.Run();}
+		CRSIFanOut& FanOut;
+	};
+	CNetworkThread*		pNetworkThread;
+#endif
+
+	vector<CEncoder>	vecEncoders; /* receiver thread only */
+
+	CMutex				Mutex;
+	CWaitCondition		JobsReady;
+	vector<CJob>		vecJobs; /* guarded by Mutex */
+	volatile bool		bStop;
+
+	map<SOCKET, CTcpQueue>	TcpQueues; /* network thread only */
+	bool					bTcpPending;
+};
+
+#endif
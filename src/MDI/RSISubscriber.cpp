@@ -32,6 +32,7 @@
 
 #include "PacketSocket.h"
 #include "RSISubscriber.h"
+#include "RSIFanOut.h"
 #include "../DrmReceiver.h"
 #include "TagPacketGenerator.h"
 
@@ -84,6 +85,15 @@ void CRSISubscriber::TransmitPacket(CTagPacketGenerator& Generator)
 	}
 }
 
+void CRSISubscriber::SendFrame(CRSIFanOut& FanOut, const int iEncoder)
+{
+	const CRSIFrame* pFrame = FanOut.GetFrame(iEncoder);
+	if (pPacketSink == 0 || pFrame == NULL)
+		return;
+	for(size_t i=0; i<pFrame->vecPackets.size(); i++)
+		pPacketSink->SendPacket(pFrame->vecPackets[i]);
+}
+
 
 /* implementation of function from CPacketSink interface - process incoming RCI commands */
 void CRSISubscriber::SendPacket(const vector<_BYTE>& vecbydata, uint32_t, uint16_t)
@@ -126,7 +136,10 @@ _BOOLEAN CRSISubscriberSocket::SetDestination(const string& dest)
 	}
 	_BOOLEAN bOk = pSocket->SetDestination(d);
 	if(bOk)
+	{
+		strDestination = d;
 		pSocket->SetPacketSink(this);
+	}
 	return bOk;
 }
 
@@ -172,6 +185,13 @@ void CRSISubscriberSocket::poll()
 		pSocket->poll();
 }
 
+void CRSISubscriberSocket::SendFrame(CRSIFanOut& FanOut, const int iEncoder)
+{
+	/* subscribers which only send us RCI commands get nothing */
+	if(pSocket!=NULL && strDestination != "")
+		FanOut.AddDestination(iEncoder, pSocket);
+}
+
 CRSISubscriberFile::CRSISubscriberFile(): CRSISubscriber(NULL), pPacketSinkFile(NULL)
 {
 	/* override the subscriber back to NULL to prevent Cpro doing anything */
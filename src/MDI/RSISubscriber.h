@@ -39,6 +39,8 @@
 class CPacketSink;
 class CDRMReceiver;
 class CTagPacketGenerator;
+class CPacketSocketNative;
+class CRSIFanOut;
 
 class CRSISubscriber : public CPacketSocket
 {
@@ -56,11 +58,18 @@ public:
 	char GetProfile(void) const {return cProfile;}
 
 	void SetPFTFragmentSize(const int iFrag=-1);
+	/* 0 if PFT is not used */
+	size_t GetPFTFragmentSize() const {return bNeedPft ? fragment_size : 0;}
 
 	/* Generate and send a packet */
 	void TransmitPacket(CTagPacketGenerator& Generator);
 
+	/* Send the frame encoded by the fan-out for this subscriber's profile */
+	virtual void SendFrame(CRSIFanOut& FanOut, const int iEncoder);
+	_BOOLEAN IsActive() const {return pPacketSink != NULL;}
+
 	void SetAFPktCRC(const _BOOLEAN bNAFPktCRC) {bUseAFCRC = bNAFPktCRC;}
+	_BOOLEAN GetAFPktCRC() const {return bUseAFCRC;}
 
 
 	/* from CPacketSink interface */
@@ -98,8 +107,11 @@ public:
 	void ResetPacketSink() {}
 	void poll();
 
+	/* Network subscribers are served by the fan-out thread */
+	virtual void SendFrame(CRSIFanOut& FanOut, const int iEncoder);
+
 private:
-	CPacketSocket* pSocket;
+	CPacketSocketNative* pSocket;
 	string strDestination;
 	uint32_t uIf, uAddr;
 	uint16_t uPort;
@@ -76,12 +76,12 @@ void COFDMModulation::InitInternal(CParameter& Parameters)
 {
     Parameters.Lock();
     /* Get global parameters */
-    iDFTSize = Parameters.CellMappingTable.iFFTSizeN;
-    iGuardSize = Parameters.CellMappingTable.iGuardSize;
-    iShiftedKmin = Parameters.CellMappingTable.iShiftedKmin;
+    iDFTSize = Parameters.pCellMappingTable->iFFTSizeN;
+    iGuardSize = Parameters.pCellMappingTable->iGuardSize;
+    iShiftedKmin = Parameters.pCellMappingTable->iShiftedKmin;
 
     /* Last index */
-    iEndIndex = Parameters.CellMappingTable.iShiftedKmax + 1;
+    iEndIndex = Parameters.pCellMappingTable->iShiftedKmax + 1;
 
     /* Normalized offset correction factor for IF shift. Subtract the
        default IF frequency ("VIRTUAL_INTERMED_FREQ") */
@@ -103,8 +103,8 @@ void COFDMModulation::InitInternal(CParameter& Parameters)
     veccFFTOutput.Init(iDFTSize);
 
     /* Define block-sizes for input and output */
-    iInputBlockSize = Parameters.CellMappingTable.iNumCarrier;
-    iOutputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+    iInputBlockSize = Parameters.pCellMappingTable->iNumCarrier;
+    iOutputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
     Parameters.Unlock();
 }
 
@@ -163,10 +163,10 @@ void COFDMDemodulation::InitInternal(CParameter& Parameters)
 {
     Parameters.Lock();
     iSampleRate = Parameters.GetSigSampleRate();
-    iDFTSize = Parameters.CellMappingTable.iFFTSizeN;
-    iGuardSize = Parameters.CellMappingTable.iGuardSize;
-    iShiftedKmin = Parameters.CellMappingTable.iShiftedKmin;
-    iShiftedKmax = Parameters.CellMappingTable.iShiftedKmax;
+    iDFTSize = Parameters.pCellMappingTable->iFFTSizeN;
+    iGuardSize = Parameters.pCellMappingTable->iGuardSize;
+    iShiftedKmin = Parameters.pCellMappingTable->iShiftedKmin;
+    iShiftedKmax = Parameters.pCellMappingTable->iShiftedKmax;
 
     /* Init plans for FFT (faster processing of Fft and Ifft commands) */
     FftPlan.Init(iDFTSize);
@@ -179,12 +179,12 @@ void COFDMDemodulation::InitInternal(CParameter& Parameters)
     iLenPowSpec = iDFTSize / 2;
     vecrPowSpec.Init(iLenPowSpec, (_REAL) 0.0);
     rLamPSD = IIR1Lam(TICONST_PSD_EST_OFDM, (CReal) iSampleRate /
-                      Parameters.CellMappingTable.iSymbolBlockSize); /* Lambda for IIR filter */
+                      Parameters.pCellMappingTable->iSymbolBlockSize); /* Lambda for IIR filter */
 
 
     /* Define block-sizes for input and output */
     iInputBlockSize = iDFTSize;
-    iOutputBlockSize = Parameters.CellMappingTable.iNumCarrier;
+    iOutputBlockSize = Parameters.pCellMappingTable->iNumCarrier;
     Parameters.Unlock();
 }
 
@@ -351,13 +351,13 @@ void COFDMDemodSimulation::InitInternal(CParameter& Parameters)
 {
     Parameters.Lock();
     /* Set internal parameters */
-    iDFTSize = Parameters.CellMappingTable.iFFTSizeN;
-    iGuardSize = Parameters.CellMappingTable.iGuardSize;
-    iNumCarrier = Parameters.CellMappingTable.iNumCarrier;
-    iShiftedKmin = Parameters.CellMappingTable.iShiftedKmin;
-    iShiftedKmax = Parameters.CellMappingTable.iShiftedKmax;
-    iSymbolBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
-    iNumSymPerFrame = Parameters.CellMappingTable.iNumSymPerFrame;
+    iDFTSize = Parameters.pCellMappingTable->iFFTSizeN;
+    iGuardSize = Parameters.pCellMappingTable->iGuardSize;
+    iNumCarrier = Parameters.pCellMappingTable->iNumCarrier;
+    iShiftedKmin = Parameters.pCellMappingTable->iShiftedKmin;
+    iShiftedKmax = Parameters.pCellMappingTable->iShiftedKmax;
+    iSymbolBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
+    iNumSymPerFrame = Parameters.pCellMappingTable->iNumSymPerFrame;
 
     iNumTapsChan = Parameters.iNumTaps;
 
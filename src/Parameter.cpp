@@ -118,7 +118,7 @@ CParameter::CParameter():
     rMaxPSDFreq(0.0),
     rSigStrengthCorrection(0.0),
     eRunState(STOPPED),
-    CellMappingTable(),
+    pCellMappingTable(NULL),
     audioencoder(""),audiodecoder(""),
     use_gpsd(0), restart_gpsd(false),
     gps_host("localhost"), gps_port("2497"),
@@ -142,7 +142,7 @@ CParameter::CParameter():
     Mutex(), lenient_RSCI(false)
 {
     GenerateRandomSerialNumber();
-    CellMappingTable.MakeTable(eRobustnessMode, eSpectOccup, iSigSampleRate);
+    pCellMappingTable = CCellMappingTable::Get(eRobustnessMode, eSpectOccup, iSigSampleRate);
     gps_data.set=0;
     gps_data.status=0;
 #ifdef HAVE_LIBGPS
@@ -232,7 +232,7 @@ CParameter::CParameter(const CParameter& p):
     rMaxPSDFreq(p.rMaxPSDFreq),
     rSigStrengthCorrection(p.rSigStrengthCorrection),
     eRunState(p.eRunState),
-    CellMappingTable(), // jfbc CCellMappingTable uses a CMatrix :(
+    pCellMappingTable(p.pCellMappingTable),
     audioencoder(p.audioencoder),audiodecoder(p.audiodecoder),
     use_gpsd(p.use_gpsd),restart_gpsd(p.restart_gpsd),
     gps_host(p.gps_host),gps_port(p.gps_port),
@@ -256,7 +256,6 @@ CParameter::CParameter(const CParameter& p):
 //, Mutex() // jfbc: I don't think this state should be copied
   ,lenient_RSCI(p.lenient_RSCI)
 {
-    CellMappingTable.MakeTable(eRobustnessMode, eSpectOccup, iSigSampleRate);
     matcReceivedPilotValues = p.matcReceivedPilotValues; // TODO
     gps_data = p.gps_data;
 }
@@ -340,7 +339,7 @@ CParameter& CParameter::operator=(const CParameter& p)
     rMaxPSDFreq = p.rMaxPSDFreq;
     rSigStrengthCorrection = p.rSigStrengthCorrection;
     eRunState = p.eRunState;
-    CellMappingTable.MakeTable(eRobustnessMode, eSpectOccup, iSigSampleRate); // don't copy CMatrix
+    pCellMappingTable = p.pCellMappingTable;
     audiodecoder =  p.audiodecoder;
     audioencoder =  p.audioencoder;
     use_gpsd = p.use_gpsd;
@@ -579,7 +578,7 @@ void CParameter::InitCellMapTable(const ERobMode eNewWaveMode,
     /* Set new values and make table */
     eRobustnessMode = eNewWaveMode;
     eSpectOccup = eNewSpecOcc;
-    CellMappingTable.MakeTable(eRobustnessMode, eSpectOccup, iSigSampleRate);
+    pCellMappingTable = CCellMappingTable::Get(eRobustnessMode, eSpectOccup, iSigSampleRate);
 }
 
 _BOOLEAN CParameter::SetWaveMode(const ERobMode eNewWaveMode)
@@ -604,7 +603,7 @@ _BOOLEAN CParameter::SetWaveMode(const ERobMode eNewWaveMode)
         eRobustnessMode = eNewWaveMode;
 
         /* This parameter change provokes update of table */
-        CellMappingTable.MakeTable(eRobustnessMode, eSpectOccup, iSigSampleRate);
+        pCellMappingTable = CCellMappingTable::Get(eRobustnessMode, eSpectOccup, iSigSampleRate);
 
         /* Set init flags */
         if (pDRMRec) pDRMRec->InitsForWaveMode();
@@ -638,7 +637,7 @@ void CParameter::SetSpectrumOccup(ESpecOcc eNewSpecOcc)
         eSpectOccup = eNewSpecOcc;
 
         /* This parameter change provokes update of table */
-        CellMappingTable.MakeTable(eRobustnessMode, eSpectOccup, iSigSampleRate);
+        pCellMappingTable = CCellMappingTable::Get(eRobustnessMode, eSpectOccup, iSigSampleRate);
 
         /* Set init flags */
         if (pDRMRec) pDRMRec->InitsForSpectrumOccup();
@@ -1005,9 +1004,9 @@ _REAL CParameter::GetSysSNRdBPilPos() const
     	positions compared to the total SNR of the DRM signal.
     */
     return (_REAL) 10.0 * log10(pow((_REAL) 10.0, rSysSimSNRdB / 10) /
-                                CellMappingTable.rAvPowPerSymbol *
-				CellMappingTable.rAvScatPilPow *
-				(_REAL) CellMappingTable.iNumCarrier);
+                                pCellMappingTable->rAvPowPerSymbol *
+				pCellMappingTable->rAvScatPilPow *
+				(_REAL) pCellMappingTable->iNumCarrier);
 }
 
 void
@@ -1080,7 +1079,7 @@ _REAL CParameter::GetSysToNomBWCorrFact()
     _REAL rNomBW = GetNominalBandwidth();
 
     /* Calculate system bandwidth (N / T_u) */
-    const _REAL rSysBW = (_REAL) CellMappingTable.iNumCarrier / CellMappingTable.iFFTSizeN * iSigSampleRate;
+    const _REAL rSysBW = (_REAL) pCellMappingTable->iNumCarrier / pCellMappingTable->iFFTSizeN * iSigSampleRate;
 
     return rSysBW / rNomBW;
 }
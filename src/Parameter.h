@@ -1340,7 +1340,8 @@ public:
     _REAL GetSysToNomBWCorrFact();
     volatile enum { STOPPED, RUNNING, STOP_REQUESTED, RESTART } eRunState;
 
-    CCellMappingTable CellMappingTable;
+    /* Shared, read only */
+    const CCellMappingTable* pCellMappingTable;
 
     CMinMaxMean SNRstat, SigStrstat;
 
@@ -73,7 +73,7 @@ CPlotManager::UpdateParamHistories(ERecState eReceiverState)
         _REAL rResampleOffset = Parameters.rResampleOffset;
         _REAL rSNR = Parameters.GetSNR();
         _REAL rSigmaEstimate = Parameters.rSigmaEstimate;
-        _REAL iNumSymPerFrame = Parameters.CellMappingTable.iNumSymPerFrame;
+        _REAL iNumSymPerFrame = Parameters.pCellMappingTable->iNumSymPerFrame;
         _REAL rMeanDelay = (Parameters.rMinDelay +	Parameters.rMaxDelay) / 2.0;
         Parameters.Unlock();
 
@@ -163,7 +163,7 @@ CPlotManager::GetFreqSamOffsHist(CVector < _REAL > &vecrFreqOffs,
 
     Parameters.Lock();
     /* Duration of OFDM symbol */
-    const _REAL rTs = (CReal) (Parameters.CellMappingTable.iFFTSizeN + Parameters.CellMappingTable.iGuardSize) / Parameters.GetSigSampleRate();
+    const _REAL rTs = (CReal) (Parameters.pCellMappingTable->iFFTSizeN + Parameters.pCellMappingTable->iGuardSize) / Parameters.GetSigSampleRate();
     /* Value from frequency acquisition */
     rFreqAquVal = Parameters.rFreqOffsetAcqui * Parameters.GetSigSampleRate();
     Parameters.Unlock();
@@ -202,9 +202,9 @@ CPlotManager::GetDopplerDelHist(CVector < _REAL > &vecrLenIR,
 
     Parameters.Lock();
     /* Duration of DRM frame */
-    const _REAL rDRMFrameDur = (CReal) (Parameters.CellMappingTable.iFFTSizeN
-                                        + Parameters.CellMappingTable.iGuardSize) /
-                               Parameters.GetSigSampleRate() * Parameters.CellMappingTable.iNumSymPerFrame;
+    const _REAL rDRMFrameDur = (CReal) (Parameters.pCellMappingTable->iFFTSizeN
+                                        + Parameters.pCellMappingTable->iGuardSize) /
+                               Parameters.GetSigSampleRate() * Parameters.pCellMappingTable->iNumSymPerFrame;
     Parameters.Unlock();
 
     /* Lock resources */
@@ -232,8 +232,8 @@ CPlotManager::GetSNRHist(CVector < _REAL > &vecrSNR,
     /* Duration of DRM frame */
     Parameters.Lock();
     /* Duration of DRM frame */
-    const _REAL rDRMFrameDur = (CReal) (Parameters.CellMappingTable.iFFTSizeN + Parameters.CellMappingTable.iGuardSize) /
-                               Parameters.GetSigSampleRate() * Parameters.CellMappingTable.iNumSymPerFrame;
+    const _REAL rDRMFrameDur = (CReal) (Parameters.pCellMappingTable->iFFTSizeN + Parameters.pCellMappingTable->iGuardSize) /
+                               Parameters.GetSigSampleRate() * Parameters.pCellMappingTable->iNumSymPerFrame;
     Parameters.Unlock();
 
     /* Init output vectors */
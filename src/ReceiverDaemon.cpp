@@ -0,0 +1,568 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Headless daemon hosting several receivers in one process
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "ReceiverDaemon.h"
+
+#ifdef QT_CORE_LIB
+#include "DrmReceiver.h"
+#include <QCoreApplication>
+#include <iostream>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <csignal>
+
+#ifdef _WIN32
+# include <Ws2tcpip.h>
+# include <windows.h>
+# define close_socket(s)			closesocket(s)
+#else
+# include <arpa/inet.h>
+# include <sys/types.h>
+# include <sys/socket.h>
+# include <sys/select.h>
+# include <netinet/in.h>
+# include <unistd.h>
+# define SOCKET_ERROR				(-1)
+# define INVALID_SOCKET				(-1)
+# define close_socket(s)			::close(s)
+#endif
+#ifdef __linux__
+# include <pthread.h>
+# include <sched.h>
+#endif
+
+/* Set by SIGTERM/SIGINT, polled by the control thread */
+static volatile sig_atomic_t bQuitSignal = 0;
+
+static void
+OnQuitSignal(int)
+{
+	bQuitSignal = 1;
+}
+
+static const char*
+StatusName(ETypeRxStatus eStatus)
+{
+	switch (eStatus)
+	{
+	case RX_OK:
+		return "ok";
+	case CRC_ERROR:
+		return "crc";
+	case DATA_ERROR:
+		return "data";
+	default:
+		return "-";
+	}
+}
+
+
+/* Implementation *************************************************************/
+CDaemonInstance::CDaemonInstance(const string& strNewName,
+	CSettings* pNewSettings, const string& strNewSettingsFile, int iNewCore)
+	: strName(strNewName), strSettingsFile(strNewSettingsFile),
+	iCore(iNewCore), pSettings(pNewSettings), pReceiver(NULL)
+{
+	pReceiver = new CDRMReceiver(pSettings);
+	pReceiver->LoadSettings();
+}
+
+CDaemonInstance::~CDaemonInstance()
+{
+	Stop();
+	delete pReceiver;
+	delete pSettings;
+}
+
+void
+CDaemonInstance::run()
+{
+#ifdef __linux__
+	if (iCore >= 0)
+	{
+		cpu_set_t CpuSet;
+		CPU_ZERO(&CpuSet);
+		CPU_SET(iCore, &CpuSet);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(CpuSet), &CpuSet))
+			cerr << strName << ": cannot pin to core " << iCore << endl;
+	}
+#endif
+	try
+	{
+		pReceiver->Start();
+	}
+	catch (CGenErr GenErr)
+	{
+		cerr << strName << ": " << GenErr.strError << endl;
+	}
+	catch (string strError)
+	{
+		cerr << strName << ": " << strError << endl;
+	}
+	catch (const char* pcError)
+	{
+		cerr << strName << ": " << pcError << endl;
+	}
+}
+
+void
+CDaemonInstance::Stop()
+{
+	if (isRunning())
+	{
+		pReceiver->Stop();
+		wait();
+	}
+}
+
+void
+CDaemonInstance::SaveSettings()
+{
+	/* Only instances with an own ini file keep their settings */
+	if (strSettingsFile == "")
+		return;
+	pReceiver->SaveSettings();
+	pSettings->SaveIni(strSettingsFile.c_str());
+}
+
+CReceiverDaemon::CReceiverDaemon() : vecInstances(),
+	iControlPort(DAEMON_DEFAULT_CONTROL_PORT), sListen(INVALID_SOCKET),
+	vecClients(), vecClientBuf(), bStop(false)
+{
+}
+
+CReceiverDaemon::~CReceiverDaemon()
+{
+	Stop();
+	for (size_t i = 0; i < vecInstances.size(); i++)
+		delete vecInstances[i];
+}
+
+bool
+CReceiverDaemon::Load(const string& strConfigFile)
+{
+	CIniFile Config;
+	if (strConfigFile == "" || !Config.LoadIni(strConfigFile.c_str()))
+	{
+		cerr << "Daemon: cannot read " << strConfigFile << endl;
+		return false;
+	}
+
+	const int iNumInstances =
+		atoi(Config.GetIniSetting(DAEMON_SECTION, "instances", "0").c_str());
+	if (iNumInstances <= 0 || iNumInstances > DAEMON_MAX_INSTANCES)
+	{
+		cerr << "Daemon: no receiver instances in " << strConfigFile << endl;
+		return false;
+	}
+	iControlPort = atoi(Config.GetIniSetting(DAEMON_SECTION, "controlport",
+		"0").c_str());
+	if (iControlPort <= 0)
+		iControlPort = DAEMON_DEFAULT_CONTROL_PORT;
+
+	/* Every section which is not a daemon or instance section gives the
+	   defaults of all receivers */
+	const vector<string> vecSections = Config.GetIniSectionNames();
+
+	for (int i = 0; i < iNumInstances; i++)
+	{
+		stringstream ssSection;
+		ssSection << "Instance " << i;
+		const string strSection = ssSection.str();
+
+		CSettings* pSettings = new CSettings;
+		for (size_t j = 0; j < vecSections.size(); j++)
+		{
+			if (vecSections[j] == DAEMON_SECTION ||
+				vecSections[j].compare(0, 9, "Instance ") == 0)
+				continue;
+			const INISection Defaults = Config.GetIniSection(vecSections[j]);
+			for (INISection::const_iterator k = Defaults.begin();
+				k != Defaults.end(); k++)
+				pSettings->Put(vecSections[j], k->first, k->second);
+		}
+		pSettings->Put("command", "mode", string("receive"));
+
+		const string strSettingsFile =
+			Config.GetIniSetting(strSection, "settings");
+		if (strSettingsFile != "")
+			(void)pSettings->LoadIni(strSettingsFile.c_str());
+
+		/* Instance keys work like command line arguments */
+		const INISection Instance = Config.GetIniSection(strSection);
+		for (INISection::const_iterator k = Instance.begin();
+			k != Instance.end(); k++)
+		{
+			if (k->first == "settings" || k->first == "core" ||
+				k->first == "name")
+				continue;
+			const size_t iSep = k->first.find('/');
+			if (iSep != string::npos)
+				pSettings->Put(k->first.substr(0, iSep),
+					k->first.substr(iSep + 1), k->second);
+			else
+				pSettings->Put("command", k->first, k->second);
+		}
+
+		const string strName = Config.GetIniSetting(strSection, "name",
+			strSection);
+		const int iCore = atoi(Config.GetIniSetting(strSection, "core",
+			"-1").c_str());
+
+		try
+		{
+			vecInstances.push_back(new CDaemonInstance(strName, pSettings,
+				strSettingsFile, iCore));
+		}
+		catch (CGenErr GenErr)
+		{
+			cerr << strName << ": " << GenErr.strError << endl;
+			delete pSettings;
+			return false;
+		}
+	}
+	return true;
+}
+
+void
+CReceiverDaemon::Start()
+{
+	signal(SIGTERM, OnQuitSignal);
+	signal(SIGINT, OnQuitSignal);
+
+	for (size_t i = 0; i < vecInstances.size(); i++)
+		vecInstances[i]->start();
+
+	if (!OpenControl())
+		cerr << "Daemon: control socket on port " << iControlPort
+			<< " not available" << endl;
+
+	/* The thread also serves the quit signals, it runs without the control
+	   socket, too */
+	bStop = false;
+	start();
+}
+
+void
+CReceiverDaemon::Stop()
+{
+	bStop = true;
+	if (isRunning())
+		wait();
+	CloseControl();
+
+	/* Ask all receivers to stop first, then wait for them */
+	for (size_t i = 0; i < vecInstances.size(); i++)
+		vecInstances[i]->GetReceiver().Stop();
+	for (size_t i = 0; i < vecInstances.size(); i++)
+	{
+		vecInstances[i]->Stop();
+		vecInstances[i]->SaveSettings();
+	}
+}
+
+void
+CReceiverDaemon::RequestQuit()
+{
+	QMetaObject::invokeMethod(QCoreApplication::instance(), "quit",
+		Qt::QueuedConnection);
+}
+
+bool
+CReceiverDaemon::OpenControl()
+{
+	sListen = socket(AF_INET, SOCK_STREAM, 0);
+	if (sListen == INVALID_SOCKET)
+		return false;
+
+	const int iReuse = 1;
+	(void)setsockopt(sListen, SOL_SOCKET, SO_REUSEADDR, (char*)&iReuse,
+		sizeof(iReuse));
+
+	sockaddr_in Addr;
+	memset(&Addr, 0, sizeof(Addr));
+	Addr.sin_family = AF_INET;
+	Addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	Addr.sin_port = htons(iControlPort);
+	if (bind(sListen, (sockaddr*)&Addr, sizeof(Addr)) == SOCKET_ERROR ||
+		listen(sListen, DAEMON_MAX_CONTROL_CLIENTS) == SOCKET_ERROR)
+	{
+		CloseControl();
+		return false;
+	}
+	return true;
+}
+
+void
+CReceiverDaemon::CloseControl()
+{
+	for (size_t i = 0; i < vecClients.size(); i++)
+		close_socket(vecClients[i]);
+	vecClients.clear();
+	vecClientBuf.clear();
+	if (sListen != INVALID_SOCKET)
+		close_socket(sListen);
+	sListen = INVALID_SOCKET;
+}
+
+void
+CReceiverDaemon::run()
+{
+	while (!bStop)
+	{
+		if (bQuitSignal)
+		{
+			bQuitSignal = 0;
+			RequestQuit();
+		}
+
+		if (sListen == INVALID_SOCKET)
+		{
+			msleep(200);
+			continue;
+		}
+
+		fd_set ReadSet;
+		FD_ZERO(&ReadSet);
+		FD_SET(sListen, &ReadSet);
+		SOCKET sMax = sListen;
+		for (size_t i = 0; i < vecClients.size(); i++)
+		{
+			FD_SET(vecClients[i], &ReadSet);
+			if (vecClients[i] > sMax)
+				sMax = vecClients[i];
+		}
+
+		/* Wake up regularly to look at the stop flags */
+		timeval Timeout;
+		Timeout.tv_sec = 0;
+		Timeout.tv_usec = 200000;
+		if (select(int(sMax) + 1, &ReadSet, NULL, NULL, &Timeout) <= 0)
+			continue;
+
+		/* Go backwards, HandleClient() removes closed connections */
+		for (size_t i = vecClients.size(); i > 0; i--)
+		{
+			if (FD_ISSET(vecClients[i - 1], &ReadSet))
+				HandleClient(i - 1);
+		}
+
+		if (FD_ISSET(sListen, &ReadSet))
+		{
+			SOCKET sClient = accept(sListen, NULL, NULL);
+			if (sClient == INVALID_SOCKET)
+				continue;
+			if (vecClients.size() >= DAEMON_MAX_CONTROL_CLIENTS)
+			{
+				close_socket(sClient);
+				continue;
+			}
+			vecClients.push_back(sClient);
+			vecClientBuf.push_back(string());
+		}
+	}
+}
+
+void
+CReceiverDaemon::HandleClient(size_t iClient)
+{
+	char buf[DAEMON_MAX_COMMAND_LEN];
+	const int n = recv(vecClients[iClient], buf, sizeof(buf), 0);
+	if (n > 0)
+	{
+		string& strBuf = vecClientBuf[iClient];
+		strBuf.append(buf, n);
+
+		size_t iEnd;
+		while ((iEnd = strBuf.find('\n')) != string::npos)
+		{
+			string strLine = strBuf.substr(0, iEnd);
+			strBuf.erase(0, iEnd + 1);
+			if (!strLine.empty() && strLine[strLine.size() - 1] == '\r')
+				strLine.erase(strLine.size() - 1);
+			if (strLine.empty())
+				continue;
+
+			const string strReply = Command(strLine) + "\n";
+			(void)send(vecClients[iClient], strReply.data(),
+				int(strReply.size()), 0);
+		}
+
+		/* Protect against clients never sending a newline */
+		if (strBuf.size() <= DAEMON_MAX_COMMAND_LEN)
+			return;
+	}
+
+	close_socket(vecClients[iClient]);
+	vecClients.erase(vecClients.begin() + iClient);
+	vecClientBuf.erase(vecClientBuf.begin() + iClient);
+}
+
+CDaemonInstance*
+CReceiverDaemon::Instance(istream& args)
+{
+	size_t iInst;
+	if (!(args >> iInst) || iInst >= vecInstances.size())
+		return NULL;
+	return vecInstances[iInst];
+}
+
+string
+CReceiverDaemon::Status(size_t iInst)
+{
+	CDRMReceiver& Receiver = vecInstances[iInst]->GetReceiver();
+	CParameter& Parameters = *Receiver.GetParameters();
+	stringstream ss;
+
+	Parameters.Lock();
+	ss << iInst << " " << vecInstances[iInst]->GetName()
+		<< (vecInstances[iInst]->isRunning() ? " running" : " stopped")
+		<< " freq=" << Parameters.GetFrequency()
+		<< " fsync=" << StatusName(Parameters.ReceiveStatus.FSync.GetStatus())
+		<< " tsync=" << StatusName(Parameters.ReceiveStatus.TSync.GetStatus())
+		<< " fac=" << StatusName(Parameters.ReceiveStatus.FAC.GetStatus())
+		<< " sdc=" << StatusName(Parameters.ReceiveStatus.SDC.GetStatus())
+		<< " audio=" << StatusName(Parameters.ReceiveStatus.SLAudio.GetStatus())
+		<< " snr=" << Parameters.GetSNR();
+	Parameters.Unlock();
+	ss << " tta=" << vecInstances[iInst]->GetReceiver().GetTimeToAudio()
+		<< (vecInstances[iInst]->GetReceiver().GetWarmStart() ? " warm" : " cold");
+	return ss.str();
+}
+
+void
+CReceiverDaemon::MOTCacheReport(CDRMReceiver& Receiver,
+	vector<string>& vecstrLines)
+{
+	/* One line per MOT decoder which holds objects */
+	CDataDecoder* pDataDecoder = Receiver.GetDataDecoder();
+	for (int i = 0; i < MAX_NUM_PACK_PER_STREAM; i++)
+	{
+		CMOTDABDec* pMOTDec = pDataDecoder->getApplication(i);
+		if (pMOTDec == NULL)
+			continue;
+		const CMOTCacheStats Stats = pMOTDec->GetCacheStats();
+		if (Stats.iNumObjects == 0)
+			continue;
+
+		stringstream ss;
+		ss << "mot." << i
+			<< " objects=" << Stats.iNumObjects
+			<< " complete=" << Stats.iNumComplete
+			<< " spilled=" << Stats.iNumSpilled
+			<< " bytes=" << Stats.iBytesInMemory
+			<< " peak=" << Stats.iPeakBytesInMemory
+			<< " evictions=" << Stats.iNumEvictions
+			<< " spills=" << Stats.iNumSpills
+			<< " reloads=" << Stats.iNumReloads
+			<< " dropped=" << Stats.iNumDropped;
+		vecstrLines.push_back(ss.str());
+	}
+}
+
+string
+CReceiverDaemon::Command(const string& strLine)
+{
+	stringstream args(strLine);
+	string strCmd;
+	args >> strCmd;
+
+	if (strCmd == "list")
+	{
+		stringstream ss;
+		ss << "OK " << vecInstances.size();
+		for (size_t i = 0; i < vecInstances.size(); i++)
+			ss << "\n" << i << " " << vecInstances[i]->GetName()
+				<< (vecInstances[i]->isRunning() ? " running" : " stopped")
+				<< " core=" << vecInstances[i]->GetCore();
+		return ss.str();
+	}
+	if (strCmd == "shutdown")
+	{
+		RequestQuit();
+		return "OK";
+	}
+
+	CDaemonInstance* pInst = Instance(args);
+	if (pInst == NULL)
+		return "ERR unknown command or instance";
+
+	if (strCmd == "status")
+	{
+		size_t iInst = 0;
+		while (vecInstances[iInst] != pInst)
+			iInst++;
+		return "OK " + Status(iInst);
+	}
+	if (strCmd == "stats")
+	{
+		CLatencyStats& Stats = pInst->GetReceiver().GetLatencyStats();
+		string strArg;
+		if ((args >> strArg) && (strArg == "reset"))
+		{
+			Stats.Reset();
+			return "OK";
+		}
+
+		vector<string> vecstrLines;
+		Stats.GetReport(vecstrLines);
+		MOTCacheReport(pInst->GetReceiver(), vecstrLines);
+		stringstream ss;
+		ss << "OK " << vecstrLines.size();
+		for (size_t i = 0; i < vecstrLines.size(); i++)
+			ss << "\n" << vecstrLines[i];
+		return ss.str();
+	}
+	if (strCmd == "freq")
+	{
+		int iFreqkHz;
+		if (!(args >> iFreqkHz) || iFreqkHz < 0 || iFreqkHz > MAX_RF_FREQ)
+			return "ERR frequency";
+		pInst->GetReceiver().SetFrequency(iFreqkHz);
+		return "OK";
+	}
+	if (strCmd == "acquire")
+	{
+		pInst->GetReceiver().RequestNewAcquisition();
+		return "OK";
+	}
+	if (strCmd == "start")
+	{
+		if (!pInst->isRunning())
+			pInst->start();
+		return "OK";
+	}
+	if (strCmd == "stop")
+	{
+		pInst->Stop();
+		return "OK";
+	}
+	return "ERR unknown command";
+}
+
+#endif /* QT_CORE_LIB */
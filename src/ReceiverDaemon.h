@@ -0,0 +1,140 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Headless daemon hosting several receivers in one process
+ *
+ * The daemon is started with "--daemon <file>". The file is an ini file:
+ *
+ *	[Daemon]
+ *	instances=2          number of receivers
+ *	controlport=7700     TCP port of the control socket (loopback only)
+ *
+ *	[Receiver]           defaults for all receivers, any section can be given
+ *	samplerateaud=48000
+ *
+ *	[Instance 0]
+ *	name=rx0             used in the control socket replies
+ *	settings=rx0.ini     optional ini file, loaded over the defaults and
+ *	                     written back on shutdown
+ *	core=0               pin the receiver thread to this CPU (Linux only)
+ *	rsiin=60001          other keys go to the "command" section, like the
+ *	Receiver/frequency=1440   command line arguments, or to the section
+ *	                          given before the "/"
+ *
+ * Control socket commands, one per line, replies start with "OK" or "ERR":
+ *	list, status <n>, stats <n> [reset], freq <n> <kHz>, acquire <n>,
+ *	start <n>, stop <n>, shutdown
+ * "list" and "stats" reply with the number of lines which follow. "stats"
+ * gives the latency statistics and the object store of each MOT decoder.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef _RECEIVERDAEMON_H
+#define _RECEIVERDAEMON_H
+
+#include "GlobalDefinitions.h"
+#include "util/Settings.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+#ifdef QT_CORE_LIB
+# include <QThread>
+
+#ifdef _WIN32
+# include <winsock2.h>
+#else
+  typedef int SOCKET;
+#endif
+
+class CDRMReceiver;
+
+/* Definitions ****************************************************************/
+#define DAEMON_SECTION				"Daemon"
+#define DAEMON_DEFAULT_CONTROL_PORT	7700
+#define DAEMON_MAX_INSTANCES		256
+#define DAEMON_MAX_CONTROL_CLIENTS	8
+#define DAEMON_MAX_COMMAND_LEN		256
+
+
+/* Classes ********************************************************************/
+class CDaemonInstance : public QThread
+{
+public:
+	CDaemonInstance(const string& strNewName, CSettings* pNewSettings,
+		const string& strNewSettingsFile, int iNewCore);
+	virtual ~CDaemonInstance();
+
+	void Stop();
+	void SaveSettings();
+
+	CDRMReceiver& GetReceiver() {return *pReceiver;}
+	const string& GetName() const {return strName;}
+	int GetCore() const {return iCore;}
+
+protected:
+	virtual void run();
+
+	string			strName;
+	string			strSettingsFile;
+	int				iCore;
+	CSettings*		pSettings;
+	CDRMReceiver*	pReceiver;
+};
+
+class CReceiverDaemon : public QThread
+{
+public:
+	CReceiverDaemon();
+	virtual ~CReceiverDaemon();
+
+	/* Returns false if the config could not be read */
+	bool Load(const string& strConfigFile);
+	void Start();
+	void Stop();
+
+	size_t NumInstances() const {return vecInstances.size();}
+
+protected:
+	/* Control socket */
+	virtual void run();
+	bool OpenControl();
+	void CloseControl();
+	void HandleClient(size_t iClient);
+	string Command(const string& strLine);
+	string Status(size_t iInst);
+	void MOTCacheReport(CDRMReceiver& Receiver, vector<string>& vecstrLines);
+	CDaemonInstance* Instance(istream& args);
+	void RequestQuit();
+
+	vector<CDaemonInstance*>	vecInstances;
+	int							iControlPort;
+	SOCKET						sListen;
+	vector<SOCKET>				vecClients;
+	vector<string>				vecClientBuf;
+	volatile bool				bStop;
+};
+
+#endif /* QT_CORE_LIB */
+
+#endif
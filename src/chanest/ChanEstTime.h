@@ -64,8 +64,8 @@ public:
 
 	virtual _REAL Estimate(CVectorEx<_COMPLEX>* pvecInputData, 
 						  CComplexVector& veccOutputData, 
-						  CVector<int>& veciMapTab, 
-						  CVector<_COMPLEX>& veccPilotCells, _REAL rSNR) = 0;
+						  const CMatrixConstRow<int>& veciMapTab, 
+						  const CMatrixConstRow<_COMPLEX>& veccPilotCells, _REAL rSNR) = 0;
 
 	virtual int Init(CParameter& Parameter) = 0;
 };
@@ -89,16 +89,16 @@ void CChannelEstimation::ProcessDataInternal(CParameter& Parameters)
 #endif
 
     /* Update the pilot memory for rpil tag of RSCI */
-    UpdateRSIPilotStore(Parameters, pvecInputData, Parameters.CellMappingTable.matiMapTab[iCurSymbIDTiInt],
-                        Parameters.CellMappingTable.matcPilotCells[iCurSymbIDTiInt], iSymbolCounter);
+    UpdateRSIPilotStore(Parameters, pvecInputData, Parameters.pCellMappingTable->matiMapTab[iCurSymbIDTiInt],
+                        Parameters.pCellMappingTable->matcPilotCells[iCurSymbIDTiInt], iSymbolCounter);
 
 
     /* Get symbol-counter for next symbol. Use the count from the frame
        synchronization (in OFDM.cpp). Call estimation routine */
     const _REAL rSNRAftTiInt =
         pTimeInt->Estimate(pvecInputData, veccPilots,
-                           Parameters.CellMappingTable.matiMapTab[iCurSymbIDTiInt],
-                           Parameters.CellMappingTable.matcPilotCells[iCurSymbIDTiInt],
+                           Parameters.pCellMappingTable->matiMapTab[iCurSymbIDTiInt],
+                           Parameters.pCellMappingTable->matcPilotCells[iCurSymbIDTiInt],
                            /* The channel estimation is based on the pilots so
                               it needs the SNR on the pilots. Do a correction */
                            rSNREstimate * rSNRTotToPilCorrFact);
@@ -287,14 +287,14 @@ void CChannelEstimation::ProcessDataInternal(CParameter& Parameters)
         {
             /* Identify pilot positions. Use MODIFIED "iSymbolID" (See lines
                above) */
-            if (_IsScatPil(Parameters.CellMappingTable.matiMapTab[iModSymNum][i]))
+            if (_IsScatPil(Parameters.pCellMappingTable->matiMapTab[iModSymNum][i]))
             {
                 /* We assume that the channel estimation in "veccChanEst" is
                    noise free (e.g., the wiener interpolation does noise
                    reduction). Thus, we have an estimate of the received signal
                    power \hat{r} = s * \hat{h}_{wiener} */
                 const _COMPLEX cModChanEst = veccChanEst[i] *
-                                             Parameters.CellMappingTable.matcPilotCells[iModSymNum][i];
+                                             Parameters.pCellMappingTable->matcPilotCells[iModSymNum][i];
 
 
                 /* Calculate and average noise and signal estimates --------- */
@@ -331,7 +331,7 @@ void CChannelEstimation::ProcessDataInternal(CParameter& Parameters)
                 if (iSNREstInitCnt < iNumSymPerFrame * iNumCarrier)
                 {
                     const int iCurCellFlag =
-                        Parameters.CellMappingTable.matiMapTab[iModSymNum][i];
+                        Parameters.pCellMappingTable->matiMapTab[iModSymNum][i];
 
                     /* Initial signal estimate. Use channel estimation from all
                        data and pilot cells. Apply averaging */
@@ -379,7 +379,7 @@ void CChannelEstimation::ProcessDataInternal(CParameter& Parameters)
             for (i = 0; i < iNumCarrier; i++)
             {
                 /* Only use FAC cells for this SNR estimation method */
-                if (_IsFAC(Parameters.CellMappingTable.matiMapTab[iModSymNum][i]))
+                if (_IsFAC(Parameters.pCellMappingTable->matiMapTab[iModSymNum][i]))
                 {
                     /* Get tentative decision for this FAC QAM symbol. FAC is
                        always 4-QAM. Calculate all distances to the four
@@ -415,7 +415,7 @@ void CChannelEstimation::ProcessDataInternal(CParameter& Parameters)
     for (i = 0; i < iNumCarrier; i++)
     {
         /* Use MSC cells for this SNR estimation method */
-        if (_IsMSC(Parameters.CellMappingTable.matiMapTab[iModSymNum][i]))
+        if (_IsMSC(Parameters.pCellMappingTable->matiMapTab[iModSymNum][i]))
         {
             CReal rCurErrPow = 0.0;
 
@@ -455,7 +455,7 @@ void CChannelEstimation::ProcessDataInternal(CParameter& Parameters)
             rSignalEstWMMAcc += vecrSqMagChanEst[i];
             iCountMERAcc ++;
         }
-        else if (_IsFAC(Parameters.CellMappingTable.matiMapTab[iModSymNum][i]))
+        else if (_IsFAC(Parameters.pCellMappingTable->matiMapTab[iModSymNum][i]))
         {
             /* Update accumulators for RSCI WMF */
             CReal rCurErrPow = SqMag(MinDist4QAM((*pvecOutputData)[i].cSig));
@@ -597,25 +597,25 @@ void CChannelEstimation::CalculateRint(CParameter& Parameters)
     Parameters.rICR = (rICRtmp > (_REAL) 1.0 ? (_REAL) 10.0 * log10(rICRtmp) : (_REAL) 0.0);
 
     /* Interferer frequency */
-    Parameters.rIntFreq = ((_REAL) iMaxIntCarrier + Parameters.CellMappingTable.iCarrierKmin) /
-                             Parameters.CellMappingTable.iFFTSizeN * iSampleRate;
+    Parameters.rIntFreq = ((_REAL) iMaxIntCarrier + Parameters.pCellMappingTable->iCarrierKmin) /
+                             Parameters.pCellMappingTable->iFFTSizeN * iSampleRate;
 }
 
 void CChannelEstimation::InitInternal(CParameter& Parameters)
 {
     Parameters.Lock();
     /* Get parameters from global struct */
-    iScatPilTimeInt = Parameters.CellMappingTable.iScatPilTimeInt;
-    iScatPilFreqInt = Parameters.CellMappingTable.iScatPilFreqInt;
-    iNumIntpFreqPil = Parameters.CellMappingTable.iNumIntpFreqPil;
-    iNumCarrier = Parameters.CellMappingTable.iNumCarrier;
-    iFFTSizeN = Parameters.CellMappingTable.iFFTSizeN;
-    iNumSymPerFrame = Parameters.CellMappingTable.iNumSymPerFrame;
+    iScatPilTimeInt = Parameters.pCellMappingTable->iScatPilTimeInt;
+    iScatPilFreqInt = Parameters.pCellMappingTable->iScatPilFreqInt;
+    iNumIntpFreqPil = Parameters.pCellMappingTable->iNumIntpFreqPil;
+    iNumCarrier = Parameters.pCellMappingTable->iNumCarrier;
+    iFFTSizeN = Parameters.pCellMappingTable->iFFTSizeN;
+    iNumSymPerFrame = Parameters.pCellMappingTable->iNumSymPerFrame;
     iSampleRate = Parameters.GetSigSampleRate();
 
     /* Length of guard-interval with respect to FFT-size! */
     rGuardSizeFFT = (_REAL) iNumCarrier *
-                    Parameters.CellMappingTable.RatioTgTu.iEnum / Parameters.CellMappingTable.RatioTgTu.iDenom;
+                    Parameters.pCellMappingTable->RatioTgTu.iEnum / Parameters.pCellMappingTable->RatioTgTu.iDenom;
 
     /* If robustness mode D is active, get DC position. This position cannot
        be "0" since in mode D no 5 kHz mode is defined (see DRM-standard).
@@ -626,7 +626,7 @@ void CChannelEstimation::InitInternal(CParameter& Parameters)
         /* Identify DC carrier position */
         for (int i = 0; i < iNumCarrier; i++)
         {
-            if (_IsDC(Parameters.CellMappingTable.matiMapTab[0][i]))
+            if (_IsDC(Parameters.pCellMappingTable->matiMapTab[0][i]))
                 iDCPos = i;
         }
     }
@@ -746,9 +746,9 @@ void CChannelEstimation::InitInternal(CParameter& Parameters)
        FAC method, the average signal power has to be considered. For the pilot
        based method, only the SNR on the pilots are evaluated. Therefore, to get
        the total SNR, a correction has to be applied */
-    rSNRFACSigCorrFact = Parameters.CellMappingTable.rAvPowPerSymbol / CReal(iNumCarrier);
-    rSNRTotToPilCorrFact = Parameters.CellMappingTable.rAvScatPilPow *
-                           (_REAL) iNumCarrier / Parameters.CellMappingTable.rAvPowPerSymbol;
+    rSNRFACSigCorrFact = Parameters.pCellMappingTable->rAvPowPerSymbol / CReal(iNumCarrier);
+    rSNRTotToPilCorrFact = Parameters.pCellMappingTable->rAvScatPilPow *
+                           (_REAL) iNumCarrier / Parameters.pCellMappingTable->rAvPowPerSymbol;
 
     /* Correction factor for transforming the estimated system SNR in the SNR
        where the noise bandwidth is according to the nominal DRM bandwidth */
@@ -785,19 +785,19 @@ void CChannelEstimation::InitInternal(CParameter& Parameters)
 
     /* Lambda for IIR filter */
     rLamSNREstFast = IIR1Lam(TICONST_SNREST_FAST, (CReal) iSampleRate /
-                             Parameters.CellMappingTable.iSymbolBlockSize);
+                             Parameters.pCellMappingTable->iSymbolBlockSize);
     rLamSNREstSlow = IIR1Lam(TICONST_SNREST_SLOW, (CReal) iSampleRate /
-                             Parameters.CellMappingTable.iSymbolBlockSize);
+                             Parameters.pCellMappingTable->iSymbolBlockSize);
     rLamMSCSNREst = IIR1Lam(TICONST_SNREST_MSC, (CReal) iSampleRate /
-                            Parameters.CellMappingTable.iSymbolBlockSize);
+                            Parameters.pCellMappingTable->iSymbolBlockSize);
 
     /* Init delay spread length estimation (index) */
     rLenPDSEst = (_REAL) 0.0;
 
     /* Init history for delay values */
     /* Duration of OFDM symbol */
-    const _REAL rTs = (CReal) (Parameters.CellMappingTable.iFFTSizeN +
-                               Parameters.CellMappingTable.iGuardSize) / iSampleRate;
+    const _REAL rTs = (CReal) (Parameters.pCellMappingTable->iFFTSizeN +
+                               Parameters.pCellMappingTable->iGuardSize) / iSampleRate;
 
     iLenDelayHist = (int) (LEN_HIST_DELAY_LOG_FILE_S / rTs);
     vecrDelayHist.Init(iLenDelayHist, (CReal) 0.0);
@@ -853,8 +853,8 @@ void CChannelEstimation::InitInternal(CParameter& Parameters)
            PDS ranges from the beginning of the guard-intervall to the end */
         UpdateWienerFiltCoef(
             pow((CReal) 10.0, INIT_VALUE_SNR_WIEN_FREQ_DB / 10),
-            (CReal) Parameters.CellMappingTable.RatioTgTu.iEnum /
-            Parameters.CellMappingTable.RatioTgTu.iDenom, (CReal) 0.0);
+            (CReal) Parameters.pCellMappingTable->RatioTgTu.iEnum /
+            Parameters.pCellMappingTable->RatioTgTu.iDenom, (CReal) 0.0);
     }
     else
     {
@@ -862,8 +862,8 @@ void CChannelEstimation::InitInternal(CParameter& Parameters)
            guard-interval length */
         UpdateWienerFiltCoef(
             pow((CReal) 10.0, Parameters.GetSysSNRdBPilPos() / 10),
-            (CReal) Parameters.CellMappingTable.RatioTgTu.iEnum /
-            Parameters.CellMappingTable.RatioTgTu.iDenom, (CReal) 0.0);
+            (CReal) Parameters.pCellMappingTable->RatioTgTu.iEnum /
+            Parameters.pCellMappingTable->RatioTgTu.iDenom, (CReal) 0.0);
     }
 
 
@@ -1280,7 +1280,7 @@ void CChannelEstimation::GetAvPoDeSp(CVector<_REAL>& vecrData,
 }
 
 void CChannelEstimation::UpdateRSIPilotStore(CParameter& Parameters, CVectorEx<_COMPLEX>* pvecInputData,
-        CVector<int>& veciMapTab, CVector<_COMPLEX>& veccPilotCells, const int iSymbolCounter)
+        const CMatrixConstRow<int>& veciMapTab, const CMatrixConstRow<_COMPLEX>& veccPilotCells, const int iSymbolCounter)
 {
     int			i;
     int			iPiHiIdx;
@@ -1305,9 +1305,9 @@ void CChannelEstimation::UpdateRSIPilotStore(CParameter& Parameters, CVectorEx<_
     /* Data is stored in the array with one row per pilot repetition, and in freq order in each row */
     /* Each row has one element per pilot-bearing carrier */
     /* This avoids having a jagged array with different lengths in different rows */
-    int iRow = iSymbolCounter / Parameters.CellMappingTable.iScatPilTimeInt;
+    int iRow = iSymbolCounter / Parameters.pCellMappingTable->iScatPilTimeInt;
 
-    int iScatPilFreqInt = Parameters.CellMappingTable.iScatPilFreqInt;
+    int iScatPilFreqInt = Parameters.pCellMappingTable->iScatPilFreqInt;
 
 
     /* Find the first pilot */
@@ -1344,7 +1344,7 @@ void CChannelEstimation::UpdateRSIPilotStore(CParameter& Parameters, CVectorEx<_
     }
 
     /* Is it the last symbol of the frame? If so, transfer to the CParam object for output via RSI */
-    if (iSymbolCounter == Parameters.CellMappingTable.iNumSymPerFrame - 1)
+    if (iSymbolCounter == Parameters.pCellMappingTable->iNumSymPerFrame - 1)
     {
         /* copy into CParam object */
         Parameters.matcReceivedPilotValues.Init(iNumSymPerFrame / iScatPilTimeInt, iNumCarrier/iScatPilFreqInt + 1,
@@ -239,7 +239,7 @@ protected:
     /* OPH: RSCI interference tag calculation */
     void CalculateRint(CParameter& Parameters);
     void UpdateRSIPilotStore(CParameter& Parameters, CVectorEx<_COMPLEX>* pvecInputData,
-                             CVector<int>& veciMapTab, CVector<_COMPLEX>& veccPilotCells, const int iSymbolCounter);
+                             const CMatrixConstRow<int>& veciMapTab, const CMatrixConstRow<_COMPLEX>& veccPilotCells, const int iSymbolCounter);
 
     CMatrix<_COMPLEX>	matcRSIPilotStore;
     int iTimeDiffAccuRSI; /* Accumulator for time differences for RSI pilot output */
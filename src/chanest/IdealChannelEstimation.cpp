@@ -111,13 +111,13 @@ void CIdealChanEst::InitInternal(CParameter& Parameters)
 	CPilotModiClass::InitRot(Parameters);
 
 	/* Get local parameters */
-	iNumCarrier = Parameters.CellMappingTable.iNumCarrier;
-	iNumSymPerFrame = Parameters.CellMappingTable.iNumSymPerFrame;
-	iDFTSize = Parameters.CellMappingTable.iFFTSizeN;
+	iNumCarrier = Parameters.pCellMappingTable->iNumCarrier;
+	iNumSymPerFrame = Parameters.pCellMappingTable->iNumSymPerFrame;
+	iDFTSize = Parameters.pCellMappingTable->iFFTSizeN;
 
 	/* Parameters for debaring the DC carriers from evaluation. First check if
 	   we have only useful part on the right side of the DC carrier */
-	if (Parameters.CellMappingTable.iCarrierKmin > 0)
+	if (Parameters.pCellMappingTable->iCarrierKmin > 0)
 	{
 		/* In this case, no DC carriers are in the useful spectrum */
 		iNumDCCarriers = 0;
@@ -128,12 +128,12 @@ void CIdealChanEst::InitInternal(CParameter& Parameters)
 		if (Parameters.GetWaveMode() == RM_ROBUSTNESS_MODE_A)
 		{
 			iNumDCCarriers = 3;
-			iStartDCCar = abs(Parameters.CellMappingTable.iCarrierKmin) - 1;
+			iStartDCCar = abs(Parameters.pCellMappingTable->iCarrierKmin) - 1;
 		}
 		else
 		{
 			iNumDCCarriers = 1;
-			iStartDCCar = abs(Parameters.CellMappingTable.iCarrierKmin);
+			iStartDCCar = abs(Parameters.pCellMappingTable->iCarrierKmin);
 		}
 	}
 
@@ -145,7 +145,7 @@ void CIdealChanEst::InitInternal(CParameter& Parameters)
 
 	/* Additional delay from long interleaving has to be considered */
 	if (Parameters.GetInterleaverDepth() == CParameter::SI_LONG)
-		iStartCnt += Parameters.CellMappingTable.iNumSymPerFrame * D_LENGTH_LONG_INTERL;
+		iStartCnt += Parameters.pCellMappingTable->iNumSymPerFrame * D_LENGTH_LONG_INTERL;
 
 
 	/* Allocate memory for intermedia results */
@@ -32,8 +32,8 @@
 /* Implementation *************************************************************/
 _REAL CTimeLinear::Estimate(CVectorEx<_COMPLEX>* pvecInputData, 
 						    CComplexVector& veccOutputData, 
-						    CVector<int>& veciMapTab, 
-						    CVector<_COMPLEX>& veccPilotCells, _REAL rSNR)
+						    const CMatrixConstRow<int>& veciMapTab, 
+						    const CMatrixConstRow<_COMPLEX>& veccPilotCells, _REAL rSNR)
 {
 	int			i, j;
 	int			iPiHiIndex;
@@ -122,12 +122,12 @@ int CTimeLinear::Init(CParameter& Parameter)
 	CPilotModiClass::InitRot(Parameter);
 
 	/* Get parameters from global struct */
-	iNumCarrier = Parameter.CellMappingTable.iNumCarrier;
-	iNumIntpFreqPil = Parameter.CellMappingTable.iNumIntpFreqPil;
-	iScatPilFreqInt = Parameter.CellMappingTable.iScatPilFreqInt;
+	iNumCarrier = Parameter.pCellMappingTable->iNumCarrier;
+	iNumIntpFreqPil = Parameter.pCellMappingTable->iNumIntpFreqPil;
+	iScatPilFreqInt = Parameter.pCellMappingTable->iScatPilFreqInt;
 
 	/* Set length of history-buffer according to time-int-index */
-	iLenHistBuff = Parameter.CellMappingTable.iScatPilTimeInt + 1;
+	iLenHistBuff = Parameter.pCellMappingTable->iScatPilTimeInt + 1;
 	
 	/* Init timing correction history with zeros */
 	iLenTiCorrHist = iLenHistBuff - 1;
@@ -51,8 +51,8 @@ public:
 	virtual int Init(CParameter& Parameter);
 	virtual _REAL Estimate(CVectorEx<_COMPLEX>* pvecInputData, 
 						   CComplexVector& veccOutputData, 
-						   CVector<int>& veciMapTab, 
-						   CVector<_COMPLEX>& veccPilotCells, _REAL rSNR);
+						   const CMatrixConstRow<int>& veciMapTab, 
+						   const CMatrixConstRow<_COMPLEX>& veccPilotCells, _REAL rSNR);
 
 protected:
 	int					iNumCarrier;
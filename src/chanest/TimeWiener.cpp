@@ -32,21 +32,37 @@
 /* Implementation *************************************************************/
 _REAL CTimeWiener::Estimate(CVectorEx<_COMPLEX>* pvecInputData,
 						    CComplexVector& veccOutputData,
-						    CVector<int>& veciMapTab,
-						    CVector<_COMPLEX>& veccPilotCells, _REAL rSNR)
+						    const CMatrixConstRow<int>& veciMapTab,
+						    const CMatrixConstRow<_COMPLEX>& veccPilotCells, _REAL rSNR)
 {
 	int			j, i;
 	int			iPiHiIdx;
-	int			iTimeDiffNew;
-	_COMPLEX	cNewPilot;
+	int			iRow;
 
 	/* Timing correction history -------------------------------------------- */
+	const int iCurTimeCorr = (*pvecInputData).GetExData().iCurTimeCorr;
+
 	/* Shift old vaules and add a "0" at the beginning of the vector */
 	vecTiCorrHist.AddBegin(0);
 
 	/* Add new one to all history values except of the current one */
 	for (i = 1; i < iLenTiCorrHist; i++)
-		vecTiCorrHist[i] += (*pvecInputData).GetExData().iCurTimeCorr;
+		vecTiCorrHist[i] += iCurTimeCorr;
+
+	/* Accumulated timing correction since the initialization. The pilots are
+	   stored with this correction removed, therefore all pilots in the
+	   history have the same reference and the filtering needs no phase
+	   correction per tap */
+	iAbsTiCorr = (iAbsTiCorr + iCurTimeCorr) % iFFTSize;
+	if (iAbsTiCorr < 0)
+		iAbsTiCorr += iFFTSize;
+
+	/* Reference of the symbol which is put out (delayed by the history) */
+	int iOutTiCorr = (iAbsTiCorr - vecTiCorrHist[iLenHistBuff - 1]) % iFFTSize;
+	if (iOutTiCorr < 0)
+		iOutTiCorr += iFFTSize;
+
+	const int iSymbolID = (*pvecInputData).GetExData().iSymbolID;
 
 
 	/* Update histories for channel estimates at the pilot positions -------- */
@@ -56,18 +72,17 @@ _REAL CTimeWiener::Estimate(CVectorEx<_COMPLEX>* pvecInputData,
 		if (_IsScatPil(veciMapTab[i]))
 		{
 			/* Save channel estimates at the pilot positions for each carrier.
-			   Move old estimates and put new value. Use reversed order to
-			   prepare vector for convolution */
-			for (j = iLengthWiener - 1; j > 0; j--)
-			{
-				matcChanAtPilPos[j][iPiHiIdx] =
-					matcChanAtPilPos[j - 1][iPiHiIdx];
-			}
+			   The history is circular, the newest estimate is at the row
+			   "veciPilHistHead" */
+			if (++veciPilHistHead[iPiHiIdx] == iLengthWiener)
+				veciPilHistHead[iPiHiIdx] = 0;
 
 			/* Add new channel estimate: h = r / s, h: transfer function of the
 			   channel, r: received signal, s: transmitted signal */
-			matcChanAtPilPos[0][iPiHiIdx] =
-				(*pvecInputData)[i] / veccPilotCells[i];
+			const _COMPLEX cNewPilot = RotateTab(
+				(*pvecInputData)[i] / veccPilotCells[i], i, -iAbsTiCorr);
+
+			matcChanAtPilPos[veciPilHistHead[iPiHiIdx]][iPiHiIdx] = cNewPilot;
 
 
 			/* Estimation of the channel correlation function --------------- */
@@ -75,30 +90,32 @@ _REAL CTimeWiener::Estimate(CVectorEx<_COMPLEX>* pvecInputData,
 			   result */
 			for (j = 0; j < iNumTapsSigEst; j++)
 			{
-				/* Correct pilot information for phase rotation */
-				iTimeDiffNew = vecTiCorrHist[iScatPilTimeInt * j];
-				cNewPilot = Rotate(matcChanAtPilPos[j][iPiHiIdx], i,
-					iTimeDiffNew);
+				iRow = veciPilHistHead[iPiHiIdx] - j;
+				if (iRow < 0)
+					iRow += iLengthWiener;
 
 				/* Use IIR filtering for averaging */
 				IIR1(veccTiCorrEst[j],
-					Conj(matcChanAtPilPos[0][iPiHiIdx]) * cNewPilot,
+					Conj(cNewPilot) * matcChanAtPilPos[iRow][iPiHiIdx],
 					rLamTiCorrAv);
 			}
 		}
 
+		/* Read current filter phase from table */
+		veciCurFiltPhase[iPiHiIdx] = matiFiltPhaseTable[iPiHiIdx][iSymbolID];
+	}
+
 
-		/* Wiener interpolation and filtering ------------------------------- */
+	/* Wiener interpolation and filtering ----------------------------------- */
+#ifdef USE_DD_WIENER_FILT_TIME
+	for (i = 0, iPiHiIdx = 0; i < iNumCarrier; i += iScatPilFreqInt, iPiHiIdx++)
+	{
 		/* This check is for robustness mode D since "iScatPilFreqInt" is "1"
 		   in this case it would include the DC carrier in the for-loop */
 		if (!_IsDC(veciMapTab[i]))
 		{
-			/* Read current filter phase from table */
-			const int iCurrFiltPhase = matiFiltPhaseTable[iPiHiIdx]
-				[(*pvecInputData).GetExData().iSymbolID];
-
+			const int iCurrFiltPhase = veciCurFiltPhase[iPiHiIdx];
 
-#ifdef USE_DD_WIENER_FILT_TIME
 // Get length of current filter, TODO: better solution
 			const int iCurFiltLen = vecvecPilIdx[iCurrFiltPhase].Size();
 			CComplexVector veccZFHestDD(iCurFiltLen);
@@ -110,26 +127,29 @@ _REAL CTimeWiener::Estimate(CVectorEx<_COMPLEX>* pvecInputData,
 			{
 				/* Build vector for filtering. Make sure that pilot cells and
 				   DD-data cells are at the correct place */
-				CComplex cNewPilot;
 				if (vecvecPilIdx[iCurrFiltPhase][j].bIsPilot == TRUE)
 				{
-					cNewPilot = matcChanAtPilPos[iPilIdx][iPiHiIdx];
+					iRow = veciPilHistHead[iPiHiIdx] - iPilIdx;
+					if (iRow < 0)
+						iRow += iLengthWiener;
+
+					/* Pilots only need the reference of the output symbol */
+					veccZFHestDD[j] = RotateTab(
+						matcChanAtPilPos[iRow][iPiHiIdx], i, iOutTiCorr);
 					iPilIdx++;
 				}
 				else
 				{
-					cNewPilot = matcChanAtDataPos[iDatIdx][iPiHiIdx];
+					/* We need to correct data cells due to timing
+					   corrections. Calculate timing difference */
+					const int iTimeDiffNew = vecTiCorrHist[
+						vecvecPilIdx[iCurrFiltPhase][j].iIdx + iCurrFiltPhase] -
+						vecTiCorrHist[iLenHistBuff - 1];
+
+					veccZFHestDD[j] = Rotate(
+						matcChanAtDataPos[iDatIdx][iPiHiIdx], i, iTimeDiffNew);
 					iDatIdx++;
 				}
-
-				/* We need to correct pilots due to timing corrections */
-				/* Calculate timing difference */
-				iTimeDiffNew = vecTiCorrHist[
-					vecvecPilIdx[iCurrFiltPhase][j].iIdx + iCurrFiltPhase] -
-					vecTiCorrHist[iLenHistBuff - 1];
-
-				/* Correct pilot information for phase rotation */
-				veccZFHestDD[j] = Rotate(cNewPilot, i, iTimeDiffNew);
 			}
 
 			/* Convolution */
@@ -184,31 +204,47 @@ _REAL CTimeWiener::Estimate(CVectorEx<_COMPLEX>* pvecInputData,
 
 				matcChanAtDataPos[0][iPiHiIdx] = cCurDDChanEst;
 			}
-#else
-			/* Convolution with one phase of the optimal filter */
-			/* Init sum */
-			_COMPLEX cCurChanEst = _COMPLEX((_REAL) 0.0, (_REAL) 0.0);
-			for (j = 0; j < iLengthWiener; j++)
-			{
-				/* We need to correct pilots due to timing corrections */
-				/* Calculate timing difference */
-				iTimeDiffNew =
-					vecTiCorrHist[j * iScatPilTimeInt + iCurrFiltPhase] -
-					vecTiCorrHist[iLenHistBuff - 1];
-
-				/* Correct pilot information for phase rotation */
-				cNewPilot =
-					Rotate(matcChanAtPilPos[j][iPiHiIdx], i, iTimeDiffNew);
-
-				/* Actual convolution with filter phase */
-				cCurChanEst += cNewPilot * matrFiltTime[iCurrFiltPhase][j];
-			}
-#endif
 
 			/* Copy channel estimation from current symbol in output buffer */
 			veccOutputData[iPiHiIdx] = cCurChanEst;
 		}
 	}
+#else
+	/* Convolution with the optimal filter. The filter phase depends on the
+	   carrier, the taps are applied in one sweep over all carriers for each
+	   tap. Each carrier has its own history head, so the history row is
+	   looked up per carrier */
+	const int iNumPiFreqDir = veciPilHistHead.Size();
+
+	for (iPiHiIdx = 0; iPiHiIdx < iNumPiFreqDir; iPiHiIdx++)
+		veccTiIntAcc[iPiHiIdx] = _COMPLEX((_REAL) 0.0, (_REAL) 0.0);
+
+	for (j = 0; j < iLengthWiener; j++)
+	{
+		for (iPiHiIdx = 0; iPiHiIdx < iNumPiFreqDir; iPiHiIdx++)
+		{
+			iRow = veciPilHistHead[iPiHiIdx] - j;
+			if (iRow < 0)
+				iRow += iLengthWiener;
+
+			veccTiIntAcc[iPiHiIdx] += matcChanAtPilPos[iRow][iPiHiIdx] *
+				matrFiltTime[veciCurFiltPhase[iPiHiIdx]][j];
+		}
+	}
+
+	for (i = 0, iPiHiIdx = 0; i < iNumCarrier; i += iScatPilFreqInt, iPiHiIdx++)
+	{
+		/* This check is for robustness mode D since "iScatPilFreqInt" is "1"
+		   in this case it would include the DC carrier in the for-loop */
+		if (!_IsDC(veciMapTab[i]))
+		{
+			/* Bring the estimate to the timing reference of the output symbol
+			   and copy it in output buffer */
+			veccOutputData[iPiHiIdx] =
+				RotateTab(veccTiIntAcc[iPiHiIdx], i, iOutTiCorr);
+		}
+	}
+#endif
 
 
 	/* Update sigma estimation ---------------------------------------------- */
@@ -260,7 +296,7 @@ int CTimeWiener::Init(CParameter& Parameters)
 	CPilotModiClass::InitRot(Parameters);
 
 	/* Set local parameters */
-	const CCellMappingTable& Param = Parameters.CellMappingTable;
+	const CCellMappingTable& Param = *Parameters.pCellMappingTable;
 	iNumCarrier = Param.iNumCarrier;
 	iScatPilTimeInt = Param.iScatPilTimeInt;
 	iScatPilFreqInt = Param.iScatPilFreqInt;
@@ -268,7 +304,7 @@ int CTimeWiener::Init(CParameter& Parameters)
 	const int iNumIntpFreqPil = Param.iNumIntpFreqPil;
 
 	/* Generate filter phase table for Wiener filter */
-	GenFiltPhaseTable(Parameters.CellMappingTable.matiMapTab, iNumCarrier, iNumSymPerFrame, iScatPilTimeInt);
+	GenFiltPhaseTable(Parameters.pCellMappingTable->matiMapTab, iNumCarrier, iNumSymPerFrame, iScatPilTimeInt);
 
 	/* Init length of filter and maximum value of sigma (doppler) */
 	switch (Parameters.GetWaveMode())
@@ -316,7 +352,7 @@ int CTimeWiener::Init(CParameter& Parameters)
 	iLenHistBuff = iSymDelyChanEst + 1;
 
 	/* Duration of useful part plus guard interval */
-	rTs = (_REAL) Parameters.CellMappingTable.iSymbolBlockSize / Parameters.GetSigSampleRate();
+	rTs = (_REAL) Parameters.pCellMappingTable->iSymbolBlockSize / Parameters.GetSigSampleRate();
 
 	/* Total number of interpolated pilots in frequency direction. We have to
 	   consider the last pilot at the end ("+ 1") */
@@ -324,6 +360,21 @@ int CTimeWiener::Init(CParameter& Parameters)
 
 	/* Allocate memory for Channel at pilot positions (matrix) and init with ones */
 	matcChanAtPilPos.Init(iLengthWiener, iTotNumPiFreqDir, _COMPLEX(1.0, 0.0));
+	veciPilHistHead.Init(iTotNumPiFreqDir, 0);
+	veciCurFiltPhase.Init(iTotNumPiFreqDir, 0);
+	veccTiIntAcc.Init(iTotNumPiFreqDir);
+	iAbsTiCorr = 0;
+
+	/* Table for the phase rotation caused by timing corrections:
+	   exp(-j * 2 * pi * n / N) */
+	iFFTSize = Param.iFFTSizeN;
+	iKmin = Param.iShiftedKmin;
+	veccRotTab.Init(iFFTSize);
+	for (int k = 0; k < iFFTSize; k++)
+	{
+		const _REAL rArg = (_REAL) -2.0 * crPi * k / iFFTSize;
+		veccRotTab[k] = _COMPLEX(cos(rArg), sin(rArg));
+	}
 
 	/* Set number of taps for sigma estimation */
 	if (iLengthWiener < NUM_TAPS_USED4SIGMA_EST)
@@ -340,7 +391,7 @@ int CTimeWiener::Init(CParameter& Parameters)
 	   direction are "iScatPilTimeInt * iScatPilFreqInt" apart */
 	const int iNumPilOneOFDMSym = iNumIntpFreqPil / iScatPilTimeInt;
 	rLamTiCorrAv = IIR1Lam(TICONST_TI_CORREL_EST * iNumPilOneOFDMSym,
-		(CReal) Parameters.GetSigSampleRate() / Parameters.CellMappingTable.iSymbolBlockSize);
+		(CReal) Parameters.GetSigSampleRate() / Parameters.pCellMappingTable->iSymbolBlockSize);
 
 	/* Init update counter for Wiener filter update. We immediatly use the
 	   filtered result although right at the beginning there is no averaging.
@@ -454,6 +505,9 @@ int CTimeWiener::Init(CParameter& Parameters)
 		bTracking = FALSE;
 	}
 
+	/* Filters of the previous settings cannot be used anymore */
+	FiltCache.clear();
+
 	/* Calculate initialization wiener filter taps and init MMSE */
 	rMMSE = UpdateFilterCoef(rSNR, rSigma);
 
@@ -490,6 +544,49 @@ void CTimeWiener::GenFiltPhaseTable(const CMatrix<int>& matiMapTab,
 }
 
 _REAL CTimeWiener::UpdateFilterCoef(const _REAL rNewSNR, const _REAL rNewSigma)
+{
+	/* Quantize the parameters to the cache buckets */
+	const int iSigmaKey = (int) Round(rNewSigma / WIENER_TIME_SIGMA_STEP);
+	_REAL rSNRdB = WIENER_TIME_MIN_SNR_DB;
+	if (rNewSNR > (_REAL) 0.0)
+	{
+		rSNRdB = Min(Max((_REAL) ((CReal) 10.0 * log10(rNewSNR)), rSNRdB),
+			WIENER_TIME_MAX_SNR_DB);
+	}
+	const int iSNRKey = (int) Round(rSNRdB / WIENER_TIME_SNR_STEP_DB);
+	const CFiltCacheKey Key(iSigmaKey, iSNRKey);
+
+	std::map<CFiltCacheKey, CFiltCacheEntry>::const_iterator it =
+		FiltCache.find(Key);
+
+	if (it != FiltCache.end())
+	{
+		/* Filter for this bucket was already calculated */
+		matrFiltTime = it->second.matrFilt;
+		return it->second.rMMSE;
+	}
+
+	/* Calculate the filter for the center of the bucket */
+	const _REAL rBucketSigma = Max((_REAL) iSigmaKey * WIENER_TIME_SIGMA_STEP,
+		(_REAL) LOW_BOUND_SIGMA);
+	const _REAL rBucketSNR = pow((CReal) 10.0,
+		(CReal) iSNRKey * WIENER_TIME_SNR_STEP_DB / 10);
+
+	const _REAL rNewMMSE = CalcFilterCoef(rBucketSNR, rBucketSigma);
+
+	/* Keep the cache small, the parameters usually change slowly */
+	if (FiltCache.size() >= MAX_NUM_WIENER_TIME_FILT)
+		FiltCache.clear();
+
+	CFiltCacheEntry& Entry = FiltCache[Key];
+	Entry.matrFilt.Init(iNumFiltPhasTi, iLengthWiener);
+	Entry.matrFilt = matrFiltTime;
+	Entry.rMMSE = rNewMMSE;
+
+	return rNewMMSE;
+}
+
+_REAL CTimeWiener::CalcFilterCoef(const _REAL rNewSNR, const _REAL rNewSigma)
 {
 	/* Calculate MMSE for wiener filtering for all phases and average */
 	_REAL rMMSE = (_REAL) 0.0;
@@ -35,6 +35,7 @@
 #include "../ofdmcellmapping/OFDMCellMapping.h"
 #include "../matlib/Matlib.h"
 #include "ChanEstTime.h"
+#include <map>
 #ifdef USE_DD_WIENER_FILT_TIME
 # include "../tables/TableQAMMapping.h"
 #endif
@@ -79,19 +80,29 @@
    overestimation */
 #define SIGMA_OVERESTIMATION_FACT		((_REAL) 3.0)
 
+/* Resolution of the cache for the optimal filters. Filters are calculated for
+   the center of a (sigma, SNR) bucket and reused as long as the estimates
+   stay in the same bucket */
+#define WIENER_TIME_SIGMA_STEP			((_REAL) 0.01 /* Hz */)
+#define WIENER_TIME_SNR_STEP_DB			((_REAL) 0.5 /* dB */)
+/* Range of the SNR buckets, estimates of zero or below use the lowest one */
+#define WIENER_TIME_MIN_SNR_DB			((_REAL) -10.0 /* dB */)
+#define WIENER_TIME_MAX_SNR_DB			((_REAL) 100.0 /* dB */)
+#define MAX_NUM_WIENER_TIME_FILT		64
+
 
 /* Classes ********************************************************************/
 class CTimeWiener : public CChanEstTime
 {
 public:
-	CTimeWiener() : bTracking(FALSE) {}
+	CTimeWiener() : iAbsTiCorr(0), iFFTSize(1), iKmin(0), bTracking(FALSE) {}
 	virtual ~CTimeWiener() {}
 
 	virtual int Init(CParameter& Parameters);
 	virtual _REAL Estimate(CVectorEx<_COMPLEX>* pvecInputData,
 						   CComplexVector& veccOutputData,
-						   CVector<int>& veciMapTab,
-						   CVector<_COMPLEX>& veccPilotCells, _REAL rSNR);
+						   const CMatrixConstRow<int>& veciMapTab,
+						   const CMatrixConstRow<_COMPLEX>& veccPilotCells, _REAL rSNR);
 
 	_REAL GetSigma() {return rSigma * 2;}
 
@@ -107,8 +118,32 @@ protected:
 						   const int iNumSymPerFrame,
 						   const int iScatPilTimeInt);
 	_REAL UpdateFilterCoef(const _REAL rNewSNR, const _REAL rNewSigma);
+	_REAL CalcFilterCoef(const _REAL rNewSNR, const _REAL rNewSigma);
 	CReal ModLinRegr(const CComplexVector& veccCorrEst);
 
+	/* Same as "Rotate()" but uses a table instead of cos() and sin() */
+	inline _COMPLEX RotateTab(const _COMPLEX cI, const int iCN,
+							  const int iTiDi) const
+	{
+		if (iTiDi == 0)
+			return cI;
+
+		int iIdx = (iTiDi * (iKmin + iCN)) % iFFTSize;
+		if (iIdx < 0)
+			iIdx += iFFTSize;
+
+		return veccRotTab[iIdx] * cI;
+	}
+
+	/* Filter phases and MMSE for one (sigma, SNR) bucket */
+	class CFiltCacheEntry
+	{
+	public:
+		CRealMatrix	matrFilt;
+		_REAL		rMMSE;
+	};
+	typedef std::pair<int, int> CFiltCacheKey;
+
 
 #ifdef USE_DD_WIENER_FILT_TIME
 	/* Decision directed Wiener */
@@ -143,7 +178,21 @@ protected:
 	int					iNumFiltPhasTi;
 	CRealMatrix			matrFiltTime;
 	
+	/* Circular history of the pilots, one row for each of the last
+	   "iLengthWiener" pilots, one column for each carrier. The pilots are
+	   stored with the accumulated timing correction removed */
 	CMatrix<_COMPLEX>	matcChanAtPilPos;
+	CVector<int>		veciPilHistHead;
+	CVector<int>		veciCurFiltPhase;
+	CVector<_COMPLEX>	veccTiIntAcc;
+	int					iAbsTiCorr;
+
+	/* Rotation table for timing corrections */
+	CVector<_COMPLEX>	veccRotTab;
+	int					iFFTSize;
+	int					iKmin;
+
+	std::map<CFiltCacheKey, CFiltCacheEntry>	FiltCache;
 
 	CComplexVector		veccTiCorrEst;
 	CReal				rLamTiCorrAv;
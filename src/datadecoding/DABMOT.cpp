@@ -32,6 +32,7 @@
 \******************************************************************************/
 
 #include "DABMOT.h"
+#include "epgutil.h"
 #include "../util/Utilities.h"
 #include <algorithm>
 #include <assert.h>
@@ -596,6 +597,13 @@ MOTDirectory(), MOTCarousel(), qiNewObjects()
 	assert(qiNewObjects.empty());
 }
 
+void
+CMOTDABDec::SetCacheLimits(size_t iBudget, const string & strSpillDir)
+{
+	MOTCarousel.SetSpillDirectory(strSpillDir);
+	MOTCarousel.SetMemoryBudget(iBudget);
+}
+
 _BOOLEAN
 CMOTDABDec::NewObjectAvailable()
 {
@@ -605,7 +613,7 @@ CMOTDABDec::NewObjectAvailable()
 void
 CMOTDABDec::GetNextObject(CMOTObject & NewMOTObject)
 {
-	TTransportID firstNew;
+	TTransportID firstNew = -1; /* none, if the wait times out */
 #ifdef QT_CORE_LIB
 	guard.lock();
 	if(qiNewObjects.empty())
@@ -626,10 +634,19 @@ CMOTDABDec::GetNextObject(CMOTObject & NewMOTObject)
 	}
 	guard.unlock();
 #else
-	firstNew = qiNewObjects.front();
-	qiNewObjects.pop();
+	if(!qiNewObjects.empty())
+	{
+		firstNew = qiNewObjects.front();
+		qiNewObjects.pop();
+	}
 #endif
-	NewMOTObject = MOTCarousel[firstNew];
+	if (firstNew == -1)
+	{
+		NewMOTObject.Reset();
+		return;
+	}
+	MOTCarousel.Get(firstNew, NewMOTObject);
+	MOTCarousel.Unpin(firstNew);
 }
 
 void
@@ -645,10 +662,13 @@ CMOTDABDec::DeliverIfReady(TTransportID TransportID)
 				/* Can't unzip so change the filename */
 				o.strName = string(o.strName.c_str()) + ".gz";
 		}
+		MOTCarousel.Update(TransportID);
 		//cerr << o << endl;;
 		ostringstream ss; ss << o << endl;
 #ifdef QT_CORE_LIB
 		guard.lock();
+		/* keep it in memory until the client has fetched it */
+		MOTCarousel.Pin(TransportID);
 		qiNewObjects.push(TransportID);
 		blocker.wakeOne();
 		guard.unlock();
@@ -818,6 +838,8 @@ CMOTDABDec::AddDataUnit(CVector < _BINARY > &vecbiNewData)
 				{
 					MOTCarousel[TransportID].AddHeader(o.vecData);
 					DeliverIfReady(TransportID);
+					/* the header is decoded, don't keep the segments */
+					MOTHeaders.erase(TransportID);
 				}
 			}
 			else if (iDataGroupType == 4)
@@ -828,8 +850,7 @@ CMOTDABDec::AddDataUnit(CVector < _BINARY > &vecbiNewData)
 				   defer decisions until the object and either header or directory
 				   are complete
 				 */
-				map < TTransportID, CMOTObject >::iterator o =
-					MOTCarousel.find(TransportID);
+				CMOTObjectCache::iterator o = MOTCarousel.find(TransportID);
 
 				if (o == MOTCarousel.end())
 				{
@@ -840,8 +861,15 @@ CMOTDABDec::AddDataUnit(CVector < _BINARY > &vecbiNewData)
 				/* is this an old object we have completed? */
 				if (o->second.bComplete == FALSE)
 				{
+					/* allocate the body in one go if the header told its
+					   size, not for compressed bodies, which are inflated
+					   on the fly */
+					if (o->second.bHasHeader
+						&& (o->second.iCompressionType == 0))
+						o->second.Body.SetSizeHint(o->second.iBodySize);
 					o->second.Body.AddSegment(vecbiNewData, iSegmentSize,
 											  iSegmentNum, biLastFlag);
+					MOTCarousel.Update(TransportID);
 				}
 				else
 				{
@@ -988,6 +1016,9 @@ CMOTDABDec::AddDataUnit(CVector < _BINARY > &vecbiNewData)
 			{
 				vecbiNewData.Separate(iSegmentSize * SIZEOF__BYTE);
 			}
+
+			/* keep the carousel within its memory budget */
+			MOTCarousel.Enforce();
 		}
 	}
 }
@@ -1005,15 +1036,9 @@ CMOTDABDec::ProcessDirectory(CBitReassembler & MOTDir)
 	   leave objects alone that were never in a carousel, they might
 	   become valid later. */
 
-	/* save bodies of old carousel */
-	map < TTransportID, CByteReassembler > Body;
-	for (map < TTransportID,
-		 CMOTObject >::iterator m =
-		 MOTCarousel.begin(); m != MOTCarousel.end(); m++)
-	{
-		Body[m->first] = m->second.Body;
-	}
-	MOTCarousel.erase(MOTCarousel.begin(), MOTCarousel.end());
+	/* keep any bodies or body fragments previously received for the
+	   objects of the new directory, forget the others */
+	MOTCarousel.BeginDirectory();
 
 	//cout << "decode directory " << MOTDirectory.  iNumberOfObjects << " === " << MOTDirectory.vecObjects.size() << " {";
 
@@ -1023,11 +1048,7 @@ CMOTDABDec::ProcessDirectory(CBitReassembler & MOTDir)
 	{
 		/* add each header to the carousel */
 		TTransportID tid = (TTransportID) MOTDir.vecData.Separate(16);
-		MOTCarousel[tid].AddHeader(MOTDir.vecData);
-		/* keep any bodies or body fragments previously received */
-		map < TTransportID, CByteReassembler >::iterator b = Body.find(tid);
-		if (b != Body.end())
-			MOTCarousel[tid].Body = b->second;
+		MOTCarousel.Renew(tid).AddHeader(MOTDir.vecData);
 		/* mark objects which are in the new directory */
 		MOTDirectory.vecObjects.push_back(tid);
 		//cout << tid << " ";
@@ -1035,6 +1056,7 @@ CMOTDABDec::ProcessDirectory(CBitReassembler & MOTDir)
 	}
 	//cout << "}" << endl;
 
+	MOTCarousel.EndDirectory();
 }
 
 void
@@ -1181,7 +1203,8 @@ void
 CReassembler::copyin(CVector < _BYTE > &vecDataIn, size_t iSegNum,
 					 size_t bytes)
 {
-	size_t offset = iSegNum * iSegmentSize;
+	/* the front of the object may already be consumed by the inflater */
+	size_t offset = iSegNum * iSegmentSize - iDiscarded;
 	size_t iNewSize = offset + bytes;
 	if (size_t(vecData.Size()) < iNewSize)
 		vecData.Enlarge(iNewSize - vecData.Size());
@@ -1189,69 +1212,271 @@ CReassembler::copyin(CVector < _BYTE > &vecDataIn, size_t iSegNum,
 		vecData[offset + i] = vecDataIn.Separate(8);
 }
 
+CReassembler::CReassembler(const CReassembler & r):CReassemblyCore(r),
+	bStream(r.bStream), bInflated(FALSE), pInflate(NULL), vecInflated(),
+	iNextInflateSeg(0), iDiscarded(0)
+{
+	*this = r;
+}
+
+CReassembler & CReassembler::operator=(const CReassembler & r)
+{
+	if (this == &r)
+		return *this;
+	CReassemblyCore::operator=(r);
+	vecData.Init(r.vecData.Size());
+	vecData = r.vecData;
+	vecLastSegment.Init(r.vecLastSegment.Size());
+	vecLastSegment = r.vecLastSegment;
+	bStream = r.bStream;
+	bInflated = r.bInflated;
+	vecInflated = r.vecInflated;
+	iNextInflateSeg = r.iNextInflateSeg;
+	iDiscarded = r.iDiscarded;
+	EndInflate();
+#ifdef HAVE_LIBZ
+	if (r.pInflate != NULL)
+	{
+		pInflate = new z_stream;
+		if (inflateCopy(pInflate, r.pInflate) != Z_OK)
+		{
+			delete pInflate;
+			pInflate = NULL;
+			/* can't continue the stream, collect the object again */
+			AbortInflate();
+		}
+		else
+		{
+			/* the output pointer has to point into our own buffer */
+			pInflate->next_out = vecInflated.empty() ? Z_NULL :
+				&vecInflated[0] + pInflate->total_out;
+		}
+	}
+#endif
+	return *this;
+}
+
 void
 CReassembler::AddSegment(CVector < _BYTE > &vecDataIn,
 						 int iSegSize, int iSegNum, _BOOLEAN bLast)
 {
-	if (bLast)
+	switch (PlaceSegment(iSegSize, iSegNum, bLast))
+	{
+	case SA_COPY:
+		copyin(vecDataIn, iSegNum, iSegSize);
+		break;
+	case SA_CACHE_LAST:
+		cachelast(vecDataIn, iSegSize);
+		break;
+	case SA_DISCARD:
+		break;
+	}
+
+	if (JustCompleted() && (vecLastSegment.Size() > 0))
+	{
+		/* we have everything, but the last segment came first */
+		copylast();
+	}
+
+	if (bStream && !bInflated && iNextInflateSeg >= 0)
+		Inflate();
+	//qDebug("AddSegment %d last %d ready %d\n", iSegNum, bLast?1:0, bReady?1:0);
+}
+
+void
+CReassembler::copylast()
+{
+	size_t offset = iLastSegmentNum * iSegmentSize - iDiscarded;
+	vecData.Enlarge(vecLastSegment.Size());
+	for (size_t i = 0; i < size_t(vecLastSegment.Size()); i++)
+		vecData[offset + i] = vecLastSegment[i];
+	vecLastSegment.Init(0);
+}
+
+void
+CReassembler::Inflate()
+{
+#ifdef HAVE_LIBZ
+	if (pInflate == NULL)
 	{
-		if (iLastSegmentNum == -1)
+		/* we can only start with the first segment. Segments received
+		   before it are already in place in vecData and are fed right
+		   away below, as far as they are contiguous with it */
+		if (!Tracker.HaveSegment(0))
+			return;
+		if (iDiscarded != 0 || !IsZipped())
 		{
-			iLastSegmentNum = iSegNum;
-			iLastSegmentSize = iSegSize;
-			/* three cases:
-			   1: single segment - easy! (actually degenerate with case 3)
-			   2: multi-segment and the last segment came first.
-			   3: normal - some segment, not the last, came first,
-			   we know the segment size
-			 */
-			if (iSegNum == 0)
-			{					/* case 1 */
-				copyin(vecDataIn, 0, iSegSize);
-			}
-			else if (iSegmentSize == 0)
-			{					/* case 2 */
-				cachelast(vecDataIn, iSegSize);
-			}
-			else
-			{					/* case 3 */
-				copyin(vecDataIn, iSegNum, iSegSize);
-			}
-		}						/* otherwise do nothing as we already have the last segment */
+			iNextInflateSeg = -1;
+			return;
+		}
+		pInflate = new z_stream;
+		memset(pInflate, 0, sizeof(z_stream));
+		/* 16: let zlib parse the gzip header and check the trailer */
+		if (inflateInit2(pInflate, 16 + MAX_WBITS) != Z_OK)
+		{
+			delete pInflate;
+			pInflate = NULL;
+			iNextInflateSeg = -1;
+			return;
+		}
+		/* the compressed data is dropped as it is consumed, so give back
+		   the room preallocated for the whole body */
+		if (vecData.capacity() > 2 * size_t(vecData.Size()))
+		{
+			vector < _BYTE > vecShrunk(vecData.begin(), vecData.end());
+			vecData.Swap(vecShrunk);
+		}
 	}
-	else
+
+	/* feed all segments which are contiguous with the data already fed,
+	   the first of them always starts at the beginning of vecData */
+	size_t iConsumed = 0;
+	int zerr = Z_OK;
+	for (;;)
 	{
-		iSegmentSize = iSegSize;
-		if (Tracker.HaveSegment(iSegNum) == FALSE)
+		size_t iSize;
+		if (!Tracker.HaveSegment(iNextInflateSeg))
+			break;
+		if (iNextInflateSeg == iLastSegmentNum)
+		{
+			if (vecLastSegment.Size() > 0)
+				break;			/* still cached, waits for the segment size */
+			iSize = iLastSegmentSize;
+		}
+		else
+			iSize = iSegmentSize;
+		if (iConsumed + iSize > size_t(vecData.Size()))
+			break;
+
+		pInflate->next_in = &vecData[iConsumed];
+		pInflate->avail_in = iSize;
+		do
 		{
-			copyin(vecDataIn, iSegNum, iSegSize);
+			if (pInflate->avail_out == 0)
+			{
+				/* grow the output, the final size is only in the trailer */
+				const size_t iUsed = pInflate->total_out;
+				size_t iNewSize = 2 * vecInflated.size();
+				if (iNewSize < 4 * iSize)
+					iNewSize = 4 * iSize;
+				if (iNewSize > MAX_DEC_NUM_BYTES_ZIP_DATA)
+					iNewSize = MAX_DEC_NUM_BYTES_ZIP_DATA;
+				if (iNewSize <= iUsed)
+				{
+					zerr = Z_MEM_ERROR;
+					break;
+				}
+				vecInflated.resize(iNewSize);
+				pInflate->next_out = &vecInflated[iUsed];
+				pInflate->avail_out = iNewSize - iUsed;
+			}
+			zerr = inflate(pInflate, Z_NO_FLUSH);
 		}
+		while (zerr == Z_OK &&
+			   (pInflate->avail_in > 0 || pInflate->avail_out == 0));
+
+		/* no progress possible without more input, that's fine */
+		if (zerr == Z_BUF_ERROR)
+			zerr = Z_OK;
+
+		iConsumed += iSize;
+		iNextInflateSeg++;
+
+		if (zerr != Z_OK)
+			break;
 	}
-	Tracker.AddSegment(iSegNum);	/* tracking the last segment makes the Ready work! */
 
-	if ((iLastSegmentSize != -1)	/* we have the last segment */
-		&& (bReady == FALSE)	/* we haven't already completed reassembly */
-		&& Tracker.Ready()		/* there are no gaps */
-		)
+	/* drop the compressed bytes consumed */
+	if (iConsumed > 0)
 	{
-		if (vecLastSegment.Size() > 0)
+		const int iRemaining = vecData.Size() - int(iConsumed);
+		if (iRemaining > 0)
 		{
-			/* we have everything, but the last segment came first */
-			copylast();
+			CVector < _BYTE > vecRest(iRemaining);
+			memcpy(&vecRest[0], &vecData[iConsumed], iRemaining);
+			vecData.Init(iRemaining);
+			vecData = vecRest;
 		}
-		bReady = TRUE;
+		else
+			vecData.Init(0);
+		iDiscarded += iConsumed;
 	}
-	//qDebug("AddSegment %d last %d ready %d\n", iSegNum, bLast?1:0, bReady?1:0);
+
+	if (zerr == Z_STREAM_END && bReady)
+	{
+		/* done, hand over the inflated data without copying it */
+		vecInflated.resize(pInflate->total_out);
+		vecData.Swap(vecInflated);
+		vector < _BYTE > ().swap(vecInflated);
+		EndInflate();
+		bInflated = TRUE;
+	}
+	else if ((zerr != Z_OK && zerr != Z_STREAM_END)
+			 || (bReady && zerr != Z_STREAM_END))
+	{
+		/* broken stream, the compressed data is gone, so start again */
+		AbortInflate();
+	}
+#endif
 }
 
 void
-CReassembler::copylast()
+CReassembler::EndInflate()
 {
-	size_t offset = iLastSegmentNum * iSegmentSize;
-	vecData.Enlarge(vecLastSegment.Size());
-	for (size_t i = 0; i < size_t(vecLastSegment.Size()); i++)
-		vecData[offset + i] = vecLastSegment[i];
-	vecLastSegment.Init(0);
+#ifdef HAVE_LIBZ
+	if (pInflate != NULL)
+	{
+		inflateEnd(pInflate);
+		delete pInflate;
+		pInflate = NULL;
+	}
+#endif
+}
+
+void
+CReassembler::AbortInflate()
+{
+	/* collect it again from the carousel, without streaming this time.
+	   If it still doesn't inflate, the object is delivered zipped */
+	Reset();
+	vector < _BYTE > ().swap(vecInflated);
+	bStream = FALSE;
+}
+
+void
+CReassembler::GetPartial(CVector < _BYTE > &vecOut) const
+{
+	if (bReady)
+	{
+		vecOut.Init(vecData.Size());
+		vecOut = vecData;
+		return;
+	}
+#ifdef HAVE_LIBZ
+	if (pInflate != NULL)
+	{
+		const size_t iSize = pInflate->total_out;
+		vecOut.Init(int(iSize));
+		if (iSize > 0)
+			memcpy(&vecOut[0], &vecInflated[0], iSize);
+		return;
+	}
+#endif
+	/* compressed data collected in one piece is of no use before the end */
+	if (iDiscarded > 0 || IsZipped())
+	{
+		vecOut.Init(0);
+		return;
+	}
+	size_t iSegments = Tracker.Contiguous();
+	if ((iLastSegmentNum != -1) && (iSegments > size_t(iLastSegmentNum)))
+		iSegments = iLastSegmentNum;
+	size_t iSize = iSegments * iSegmentSize;
+	if (iSize > size_t(vecData.Size()))
+		iSize = vecData.Size();
+	vecOut.Init(int(iSize));
+	for (size_t i = 0; i < iSize; i++)
+		vecOut[i] = vecData[i];
 }
 
 void
@@ -1287,6 +1512,391 @@ CBitReassembler::copylast()
 	vecLastSegment.ResetBitAccess();
 }
 
+size_t
+CReassembler::MemoryUsage() const
+{
+	size_t iBytes = vecData.capacity() + vecLastSegment.capacity() +
+		vecInflated.capacity() + Tracker.MemoryUsage();
+#ifdef HAVE_LIBZ
+	/* inflate state and its window */
+	if (pInflate != NULL)
+		iBytes += sizeof(z_stream) + (1 << MAX_WBITS);
+#endif
+	return iBytes;
+}
+
+void
+CReassembler::reserve(size_t iBytes)
+{
+	/* a body inflated on the fly never holds all the compressed data */
+	if (pInflate != NULL || bInflated)
+		return;
+	vecData.Reserve(int(iBytes));
+}
+
+void
+CBitReassembler::reserve(size_t iBytes)
+{
+	vecData.Reserve(int(8 * iBytes));
+}
+
+void
+CReassembler::Release()
+{
+	/* swap with an empty vector, Init() alone keeps the capacity */
+	vector < _BYTE > ().swap(vecData);
+	vecData.Init(0);
+	vector < _BYTE > ().swap(vecLastSegment);
+	vecLastSegment.Init(0);
+}
+
+/******************************************************************************\
+* Object store                                                                 *
+\******************************************************************************/
+CMOTObjectCache::CMOTObjectCache():Objects(), Entries(), LRU(),
+iBudget(DEFAULT_MOT_CACHE_BUDGET), strSpillDir(""), Stats(), Mutex()
+{
+}
+
+CMOTObjectCache::~CMOTObjectCache()
+{
+	clear();
+}
+
+void
+CMOTObjectCache::SetMemoryBudget(size_t iNewBudget)
+{
+	iBudget = iNewBudget;
+	Enforce();
+}
+
+void
+CMOTObjectCache::SetSpillDirectory(const string & strNewDir)
+{
+	Mutex.Lock();
+	strSpillDir = strNewDir;
+	if (strSpillDir != "")
+	{
+		const char c = strSpillDir[strSpillDir.size() - 1];
+		if (c != '/' && c != '\\')
+			strSpillDir += '/';
+		mkdirs(strSpillDir);
+	}
+	Mutex.Unlock();
+}
+
+CMOTObject &
+CMOTObjectCache::operator[](TTransportID TransportID)
+{
+	Mutex.Lock();
+	CMOTObject & o = Access(TransportID);
+	Mutex.Unlock();
+	return o;
+}
+
+CMOTObject &
+CMOTObjectCache::Access(TTransportID TransportID)
+{
+	map < TTransportID, CEntry >::iterator e = Entries.find(TransportID);
+	if (e == Entries.end())
+	{
+		e = Entries.insert(make_pair(TransportID, CEntry())).first;
+		e->second.itLRU = LRU.insert(LRU.end(), TransportID);
+	}
+	else
+		Touch(e->second);
+	return Objects[TransportID];
+}
+
+void
+CMOTObjectCache::Touch(CEntry & e)
+{
+	/* move to the most recently used end, iterators stay valid */
+	LRU.splice(LRU.end(), LRU, e.itLRU);
+}
+
+void
+CMOTObjectCache::Account(TTransportID TransportID, CEntry & e)
+{
+	const size_t iBytes = Objects[TransportID].Body.MemoryUsage();
+	Stats.iBytesInMemory = Stats.iBytesInMemory - e.iBytes + iBytes;
+	if (Stats.iBytesInMemory > Stats.iPeakBytesInMemory)
+		Stats.iPeakBytesInMemory = Stats.iBytesInMemory;
+	e.iBytes = iBytes;
+}
+
+void
+CMOTObjectCache::clear()
+{
+	Mutex.Lock();
+	while (!LRU.empty())
+		Remove(LRU.front());
+	Mutex.Unlock();
+}
+
+void
+CMOTObjectCache::Remove(TTransportID TransportID)
+{
+	map < TTransportID, CEntry >::iterator e = Entries.find(TransportID);
+	if (e == Entries.end())
+		return;
+	if (e->second.eBodyState == BS_SPILLED)
+		remove(e->second.strFile.c_str());
+	Stats.iBytesInMemory -= e->second.iBytes;
+	LRU.erase(e->second.itLRU);
+	Entries.erase(e);
+	Objects.erase(TransportID);
+}
+
+void
+CMOTObjectCache::Get(TTransportID TransportID, CMOTObject & MOTObjectOut)
+{
+	Mutex.Lock();
+	iterator o = Objects.find(TransportID);
+	if (o == Objects.end())
+	{
+		MOTObjectOut.Reset();
+		Mutex.Unlock();
+		return;
+	}
+	MOTObjectOut = o->second;
+	CEntry & e = Entries[TransportID];
+	Touch(e);
+	if (e.eBodyState == BS_SPILLED)
+	{
+		/* read the body back into the copy only, the store stays small */
+		FILE *pFile = fopen(e.strFile.c_str(), "rb");
+		if (pFile != NULL)
+		{
+			fseek(pFile, 0, SEEK_END);
+			const long iSize = ftell(pFile);
+			fseek(pFile, 0, SEEK_SET);
+			MOTObjectOut.Body.vecData.Init(iSize > 0 ? int(iSize) : 0);
+			if (iSize > 0 &&
+				fread(&MOTObjectOut.Body.vecData[0], 1, iSize, pFile) != size_t(iSize))
+				MOTObjectOut.Body.vecData.Init(0);
+			fclose(pFile);
+			Stats.iNumReloads++;
+		}
+	}
+	Mutex.Unlock();
+}
+
+_BOOLEAN
+CMOTObjectCache::GetPartial(TTransportID TransportID,
+							CMOTObject & MOTObjectOut)
+{
+	Mutex.Lock();
+	iterator o = Objects.find(TransportID);
+	const _BOOLEAN bFound = (o != Objects.end()) &&
+		(Entries[TransportID].eBodyState == BS_IN_MEMORY);
+	if (bFound)
+	{
+		MOTObjectOut.Reset();
+		MOTObjectOut.CopyHeader(o->second);
+		o->second.Body.GetPartial(MOTObjectOut.Body.vecData);
+	}
+	Mutex.Unlock();
+	if (!bFound)
+		Get(TransportID, MOTObjectOut);
+	return bFound || MOTObjectOut.bComplete;
+}
+
+void
+CMOTObjectCache::Update(TTransportID TransportID)
+{
+	Mutex.Lock();
+	map < TTransportID, CEntry >::iterator e = Entries.find(TransportID);
+	if (e != Entries.end())
+		Account(TransportID, e->second);
+	Mutex.Unlock();
+}
+
+void
+CMOTObjectCache::Pin(TTransportID TransportID)
+{
+	Mutex.Lock();
+	map < TTransportID, CEntry >::iterator e = Entries.find(TransportID);
+	if (e != Entries.end())
+		e->second.iPins++;
+	Mutex.Unlock();
+}
+
+void
+CMOTObjectCache::Unpin(TTransportID TransportID)
+{
+	Mutex.Lock();
+	map < TTransportID, CEntry >::iterator e = Entries.find(TransportID);
+	if (e != Entries.end() && e->second.iPins > 0)
+		e->second.iPins--;
+	Mutex.Unlock();
+}
+
+void
+CMOTObjectCache::BeginDirectory()
+{
+	Mutex.Lock();
+	for (map < TTransportID, CEntry >::iterator e = Entries.begin();
+		 e != Entries.end(); e++)
+		e->second.bRenewed = FALSE;
+	Mutex.Unlock();
+}
+
+CMOTObject &
+CMOTObjectCache::Renew(TTransportID TransportID)
+{
+	Mutex.Lock();
+	CMOTObject & o = Access(TransportID);
+	CEntry & e = Entries[TransportID];
+	if (e.eBodyState == BS_DROPPED)
+	{
+		/* the body is gone, reassemble it again from the carousel */
+		o.Reset();
+		e.eBodyState = BS_IN_MEMORY;
+	}
+	else
+	{
+		const CByteReassembler Body(o.Body);
+		o.Reset();
+		o.Body = Body;
+	}
+	o.TransportID = TransportID;
+	e.bRenewed = TRUE;
+	Account(TransportID, e);
+	Mutex.Unlock();
+	return o;
+}
+
+void
+CMOTObjectCache::EndDirectory()
+{
+	Mutex.Lock();
+	for (list < TTransportID >::iterator i = LRU.begin(); i != LRU.end();)
+	{
+		const TTransportID tid = *i++;
+		const CEntry & e = Entries[tid];
+		if (!e.bRenewed && e.iPins == 0)
+			Remove(tid);
+	}
+	Mutex.Unlock();
+}
+
+string
+CMOTObjectCache::SpillFileName(TTransportID TransportID,
+							   const string & strName) const
+{
+	/* flatten the ContentName, it may contain a path */
+	ostringstream ss;
+	ss << strSpillDir << TransportID << '_';
+	for (size_t i = 0; i < strName.size(); i++)
+	{
+		const char c = strName[i];
+		if (isalnum((unsigned char) c) || c == '.' || c == '-')
+			ss << c;
+		else
+			ss << '_';
+	}
+	return ss.str();
+}
+
+_BOOLEAN
+CMOTObjectCache::Spill(TTransportID TransportID, CEntry & e)
+{
+	const CMOTObject & o = Objects[TransportID];
+	const string strFile = SpillFileName(TransportID, o.strName);
+	FILE *pFile = fopen(strFile.c_str(), "wb");
+	if (pFile == NULL)
+		return FALSE;
+	const size_t iSize = o.Body.vecData.size();
+	const _BOOLEAN bOK = (iSize == 0) ||
+		(fwrite(&o.Body.vecData.front(), 1, iSize, pFile) == iSize);
+	fclose(pFile);
+	if (!bOK)
+	{
+		remove(strFile.c_str());
+		return FALSE;
+	}
+	e.strFile = strFile;
+	return TRUE;
+}
+
+void
+CMOTObjectCache::Evict(TTransportID TransportID, CEntry & e)
+{
+	if (strSpillDir != "" && Spill(TransportID, e))
+	{
+		e.eBodyState = BS_SPILLED;
+		Stats.iNumSpills++;
+	}
+	else
+		e.eBodyState = BS_DROPPED;
+	Objects[TransportID].Body.Release();
+	Account(TransportID, e);
+	Stats.iNumEvictions++;
+}
+
+void
+CMOTObjectCache::Enforce()
+{
+	list < TTransportID >::iterator i;
+
+	Mutex.Lock();
+
+	/* bodies of completed objects first, least recently used first */
+	for (i = LRU.begin(); i != LRU.end() && Stats.iBytesInMemory > iBudget; i++)
+	{
+		CEntry & e = Entries[*i];
+		if (Objects[*i].bComplete && e.iPins == 0 &&
+			e.eBodyState == BS_IN_MEMORY && e.iBytes > 0)
+			Evict(*i, e);
+	}
+
+	/* then incomplete objects, the carousel will bring them again */
+	for (i = LRU.begin(); i != LRU.end() && Stats.iBytesInMemory > iBudget; i++)
+	{
+		CEntry & e = Entries[*i];
+		CMOTObject & o = Objects[*i];
+		if (!o.bComplete && e.iPins == 0 && e.iBytes > 0)
+		{
+			o.Body.Reset();
+			o.Body.Release();
+			Account(*i, e);
+			Stats.iNumDropped++;
+		}
+	}
+
+	/* bound the number of stubs */
+	for (i = LRU.begin(); i != LRU.end() &&
+		 Entries.size() > MAX_NUM_MOT_CACHE_OBJECTS;)
+	{
+		const TTransportID tid = *i++;
+		if (Entries[tid].iPins == 0)
+			Remove(tid);
+	}
+
+	Mutex.Unlock();
+}
+
+CMOTCacheStats
+CMOTObjectCache::GetStats() const
+{
+	Mutex.Lock();
+	CMOTCacheStats s = Stats;
+	s.iNumObjects = Entries.size();
+	for (map < TTransportID, CEntry >::const_iterator e = Entries.begin();
+		 e != Entries.end(); e++)
+	{
+		map < TTransportID, CMOTObject >::const_iterator o =
+			Objects.find(e->first);
+		if (o != Objects.end() && o->second.bComplete)
+			s.iNumComplete++;
+		if (e->second.eBodyState == BS_SPILLED)
+			s.iNumSpilled++;
+	}
+	Mutex.Unlock();
+	return s;
+}
+
 string
 CMOTObjectBase::extractString(CVector < _BINARY > &vecbiData, int iLen) const
 {
@@ -1403,6 +2013,8 @@ CReassembler::IsZipped() const
 	see GZIP file format specification
 	http://www.ietf.org/rfc/rfc1952.txt
 */
+	if (bInflated)
+		return FALSE;
 	if(vecData.Size()<3)
 		return FALSE;
 	/* Check for gzip header [31, 139, 8] */
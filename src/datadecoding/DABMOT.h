@@ -32,7 +32,9 @@
 #include "../GlobalDefinitions.h"
 #include "../util/Vector.h"
 #include "../util/CRC.h"
+#include "../util/Reassemble.h"
 #include <time.h>
+#include <list>
 #include <map>
 #include <queue>
 #ifdef QT_CORE_LIB
@@ -51,6 +53,14 @@
    number of bytes */
 #define MAX_DEC_NUM_BYTES_ZIP_DATA		1000000	/* 1 MB */
 
+/* Default memory budget of the MOT object store of one decoder. Completed
+   objects are evicted (or spilled to disk) when this is exceeded */
+#define DEFAULT_MOT_CACHE_BUDGET		(8 * 1024 * 1024)	/* 8 MB */
+
+/* Maximum number of objects (including evicted stubs) kept per decoder. This
+   bounds the bookkeeping in header mode where transport IDs never repeat */
+#define MAX_NUM_MOT_CACHE_OBJECTS		4096
+
 /* Registrered BWS profiles (ETSI TS 101 498-1) */
 #define RESERVED_PROFILE	0x00
 #define BASIC_PROFILE		0x01
@@ -123,95 +133,26 @@ class CDateAndTime
 
 typedef int TTransportID;
 
-class CSegmentTracker
-{
-  public:
-
-    CSegmentTracker ()
-    {
-	Reset ();
-    }
-
-    void Reset ()
-    {
-	vecbHaveSegment.clear ();
-    }
-
-    size_t size ()
-    {
-	return vecbHaveSegment.size ();
-    }
+struct z_stream_s;
 
-    _BOOLEAN Ready ()
-    {
-	if (vecbHaveSegment.size () == 0)
-	    return FALSE;
-	for (size_t i = 0; i < vecbHaveSegment.size (); i++)
-	  {
-	      if (vecbHaveSegment[i] == FALSE)
-		{
-		    return FALSE;
-		}
-	  }
-	return TRUE;
-    }
-
-    void AddSegment (int iSegNum)
-    {
-	if ((iSegNum + 1) > int (vecbHaveSegment.size ()))
-	    vecbHaveSegment.resize (iSegNum + 1, FALSE);
-	vecbHaveSegment[iSegNum] = TRUE;
-    }
-
-    _BOOLEAN HaveSegment (int iSegNum)
-    {
-	if (iSegNum < int (vecbHaveSegment.size ()))
-	    return vecbHaveSegment[iSegNum];
-	return FALSE;
-    }
-
-  protected:
-    vector < _BOOLEAN > vecbHaveSegment;
-};
-
-class CReassembler
+class CReassembler:public CReassemblyCore
 {
   public:
 
-	CReassembler(): vecData(), vecLastSegment(),
-		iLastSegmentNum(-1), iLastSegmentSize(-1), iSegmentSize(0),
-		Tracker(), bReady(false)
+	CReassembler(): CReassemblyCore(), vecData(), vecLastSegment(),
+		bStream(TRUE), bInflated(FALSE),
+		pInflate(NULL), vecInflated(), iNextInflateSeg(0), iDiscarded(0)
     {
     }
 
-    CReassembler (const CReassembler & r):iLastSegmentNum (r.iLastSegmentNum),
-	iLastSegmentSize (r.iLastSegmentSize),
-	iSegmentSize (r.iSegmentSize), Tracker (r.Tracker), bReady (r.bReady)
-    {
-	vecData.Init (r.vecData.Size ());
-	vecData = r.vecData;
-	vecLastSegment.Init (r.vecLastSegment.Size ());
-	vecLastSegment = r.vecLastSegment;
-    }
+    CReassembler (const CReassembler & r);
 
     virtual ~ CReassembler ()
     {
+	EndInflate ();
     }
 
-    inline CReassembler & operator= (const CReassembler & r)
-    {
-	iLastSegmentNum = r.iLastSegmentNum;
-	iLastSegmentSize = r.iLastSegmentSize;
-	iSegmentSize = r.iSegmentSize;
-	Tracker = r.Tracker;
-	vecData.Init (r.vecData.Size ());
-	vecData = r.vecData;
-	vecLastSegment.Init (r.vecLastSegment.Size ());
-	vecLastSegment = r.vecLastSegment;
-	bReady = r.bReady;
-
-	return *this;
-    }
+    CReassembler & operator= (const CReassembler & r);
 
     void Reset ()
     {
@@ -219,16 +160,11 @@ class CReassembler
 	vecData.ResetBitAccess ();
 	vecLastSegment.Init (0);
 	vecLastSegment.ResetBitAccess ();
-	iLastSegmentNum = -1;
-	iLastSegmentSize = -1;
-	iSegmentSize = 0;
-	Tracker.Reset ();
-	bReady = FALSE;
-    }
-
-    _BOOLEAN Ready ()
-    {
-	return bReady;
+	ResetCore ();
+	EndInflate ();
+	bInflated = FALSE;
+	iNextInflateSeg = 0;
+	iDiscarded = 0;
     }
 
     void AddSegment (CVector < _BYTE > &vecDataIn,
@@ -237,6 +173,17 @@ class CReassembler
     _BOOLEAN IsZipped () const;
     _BOOLEAN uncompress();
 
+    /* The part of the object which is already usable: the inflated data so
+       far for gzip'ed bodies, otherwise the segments received without gap */
+    void GetPartial (CVector < _BYTE > &vecOut) const;
+
+    /* Heap memory held by this reassembler in bytes */
+    size_t MemoryUsage () const;
+
+    /* Free the reassembled data but keep the segment state, used when the
+       object store evicts a completed object */
+    void Release ();
+
     CVector < _BYTE > vecData;
 
   protected:
@@ -245,15 +192,26 @@ class CReassembler
 			 size_t bytes);
     virtual void cachelast (CVector < _BYTE > &vecDataIn, size_t iSegSize);
     virtual void copylast ();
+    virtual void reserve (size_t iBytes);
 
     unsigned int gzGetOriginalSize () const;
 
+    /* Streaming inflation: gzip'ed bodies are inflated segment by segment
+       as soon as they are contiguous with the data already inflated, the
+       compressed bytes are dropped once consumed. Out of order segments
+       wait in vecData until the gap is closed */
+    void Inflate ();
+    void EndInflate ();
+    void AbortInflate ();
+
     CVector < _BYTE > vecLastSegment;
-    int iLastSegmentNum;
-    int iLastSegmentSize;
-    size_t iSegmentSize;
-    CSegmentTracker Tracker;
-    _BOOLEAN bReady;
+
+    _BOOLEAN bStream;		/* streaming inflation allowed */
+    _BOOLEAN bInflated;		/* vecData holds the inflated body */
+    z_stream_s *pInflate;
+    vector < _BYTE > vecInflated;
+    int iNextInflateSeg;	/* next segment to feed, -1: not gzip'ed */
+    size_t iDiscarded;		/* compressed bytes consumed from vecData */
 };
 
 class CBitReassembler:public CReassembler
@@ -261,6 +219,8 @@ class CBitReassembler:public CReassembler
   public:
     CBitReassembler ():CReassembler ()
     {
+	/* headers and directories are never zipped */
+	bStream = FALSE;
     }
     CBitReassembler (const CBitReassembler & r):CReassembler (r)
     {
@@ -271,6 +231,7 @@ class CBitReassembler:public CReassembler
 			 size_t bytes);
     virtual void cachelast (CVector < _BYTE > &vecDataIn, size_t iSegSize);
     virtual void copylast ();
+    virtual void reserve (size_t iBytes);
 };
 
 typedef CReassembler CByteReassembler;
@@ -407,6 +368,18 @@ class CMOTObject:public CMOTObjectBase
     }
 
     inline CMOTObject & operator= (const CMOTObject & nO)
+    {
+        CopyHeader (nO);
+        Body = nO.Body;
+
+        vecbRawData.Init (nO.vecbRawData.Size ());
+        vecbRawData = nO.vecbRawData;
+
+        return *this;
+    }
+
+    /* all but the body and the raw data */
+    void CopyHeader (const CMOTObject & nO)
     {
         TransportID = nO.TransportID;
         ExpireTime = nO.ExpireTime;
@@ -431,12 +404,6 @@ class CMOTObject:public CMOTObjectBase
         ScopeStart = nO.ScopeStart;
         ScopeEnd = nO.ScopeEnd;
         iScopeId = nO.iScopeId;
-        Body = nO.Body;
-
-        vecbRawData.Init (nO.vecbRawData.Size ());
-        vecbRawData = nO.vecbRawData;
-
-        return *this;
     }
 
 
@@ -498,6 +465,126 @@ class CMOTObject:public CMOTObjectBase
 };
 
 
+/* Object store ------------------------------------------------------------- */
+class CMOTCacheStats
+{
+  public:
+    CMOTCacheStats ():iNumObjects(0), iNumComplete(0), iNumSpilled(0),
+    iBytesInMemory(0), iPeakBytesInMemory(0), iNumEvictions(0),
+    iNumSpills(0), iNumReloads(0), iNumDropped(0)
+    {
+    }
+
+    size_t iNumObjects;			/* entries, including evicted stubs */
+    size_t iNumComplete;
+    size_t iNumSpilled;
+    size_t iBytesInMemory;
+    size_t iPeakBytesInMemory;
+    unsigned long iNumEvictions;	/* completed objects taken out of memory */
+    unsigned long iNumSpills;		/* ... of these written to disk */
+    unsigned long iNumReloads;		/* spilled objects read back from disk */
+    unsigned long iNumDropped;		/* incomplete objects thrown away */
+};
+
+/* Bounded store of the carousel objects of one MOT decoder. All entries are
+   kept in least recently used order. When the byte budget is exceeded, the
+   bodies of completed objects are evicted first, written to the spill
+   directory if one is set. The remaining stub keeps the header so repeated
+   segments of the object are still recognized as already received */
+class CMOTObjectCache
+{
+  public:
+    typedef map < TTransportID, CMOTObject >::iterator iterator;
+
+    CMOTObjectCache ();
+    virtual ~CMOTObjectCache ();
+
+    void SetMemoryBudget (size_t iNewBudget);
+    void SetSpillDirectory (const string & strNewDir);
+
+    /* access an object, creating it if needed. Makes it most recently used */
+    CMOTObject & operator[] (TTransportID TransportID);
+
+    iterator find (TTransportID TransportID)
+    {
+        return Objects.find (TransportID);
+    }
+    iterator begin ()
+    {
+        return Objects.begin ();
+    }
+    iterator end ()
+    {
+        return Objects.end ();
+    }
+    size_t size () const
+    {
+        return Objects.size ();
+    }
+    void clear ();
+
+    /* copy out an object, reading the body back from disk if it was spilled */
+    void Get (TTransportID TransportID, CMOTObject & MOTObjectOut);
+
+    /* copy out the header and the usable part of an incomplete object */
+    _BOOLEAN GetPartial (TTransportID TransportID, CMOTObject & MOTObjectOut);
+
+    /* re-account the memory of an object after its body has changed */
+    void Update (TTransportID TransportID);
+
+    /* objects waiting for delivery are never evicted */
+    void Pin (TTransportID TransportID);
+    void Unpin (TTransportID TransportID);
+
+    /* a new directory arrived: entries not renewed before EndDirectory()
+       are removed, renewed entries keep their (possibly spilled) body */
+    void BeginDirectory ();
+    CMOTObject & Renew (TTransportID TransportID);
+    void EndDirectory ();
+
+    /* evict objects until the store fits the budget */
+    void Enforce ();
+
+    CMOTCacheStats GetStats () const;
+
+  protected:
+    enum EBodyState { BS_IN_MEMORY, BS_SPILLED, BS_DROPPED };
+
+    class CEntry
+    {
+      public:
+        CEntry ():itLRU(), iBytes(0), eBodyState(BS_IN_MEMORY), strFile(""),
+        iPins(0), bRenewed(FALSE)
+        {
+        }
+
+        list < TTransportID >::iterator itLRU;
+        size_t iBytes;
+        EBodyState eBodyState;
+        string strFile;
+        int iPins;
+        _BOOLEAN bRenewed;
+    };
+
+    CMOTObject & Access (TTransportID TransportID);
+    void Touch (CEntry & e);
+    void Account (TTransportID TransportID, CEntry & e);
+    void Evict (TTransportID TransportID, CEntry & e);
+    void Remove (TTransportID TransportID);
+    _BOOLEAN Spill (TTransportID TransportID, CEntry & e);
+    string SpillFileName (TTransportID TransportID, const string & strName) const;
+
+    map < TTransportID, CMOTObject > Objects;
+    map < TTransportID, CEntry > Entries;
+    list < TTransportID > LRU;		/* front: least recently used */
+
+    size_t iBudget;
+    string strSpillDir;
+    CMOTCacheStats Stats;
+    mutable CMutex Mutex;
+};
+
+
 /* Encoder ------------------------------------------------------------------ */
 class CMOTDABEnc
 {
@@ -565,7 +652,15 @@ class CMOTDABDec
 
     void GetObject (CMOTObject & NewMOTObject, TTransportID TransportID)
     {
-        NewMOTObject = MOTCarousel[TransportID];
+        MOTCarousel.Get (TransportID, NewMOTObject);
+    }
+
+    /* Objects being received: the body holds what can be used so far, for
+       gzip'ed bodies the data inflated up to now */
+    _BOOLEAN GetPartialObject (CMOTObject & NewMOTObject,
+                               TTransportID TransportID)
+    {
+        return MOTCarousel.GetPartial (TransportID, NewMOTObject);
     }
 
     void GetDirectory (CMOTDirectory & MOTDirectoryOut)
@@ -575,6 +670,14 @@ class CMOTDABDec
 
     _BOOLEAN NewObjectAvailable ();
 
+    /* object store limits, an empty directory disables spilling to disk */
+    void SetCacheLimits (size_t iBudget, const string & strSpillDir);
+
+    CMOTCacheStats GetCacheStats () const
+    {
+        return MOTCarousel.GetStats ();
+    }
+
     /* push from lower level */
     void AddDataUnit (CVector < _BINARY > &vecbiNewData);
 
@@ -594,7 +697,7 @@ class CMOTDABDec
 
     /* These fields are the cached complete carousel */
     CMOTDirectory MOTDirectory;
-    map < TTransportID, CMOTObject > MOTCarousel;
+    CMOTObjectCache MOTCarousel;
     queue < TTransportID > qiNewObjects;
 #ifdef QT_CORE_LIB
     QMutex guard;
@@ -31,6 +31,7 @@
 #include "Journaline.h"
 #include "Experiment.h"
 #include <iostream>
+#include <sstream>
 
 CDataDecoder::CDataDecoder ():iServPacketID (0), DoNotProcessData (TRUE),
 	Journaline(*new CJournaline()),
@@ -43,6 +44,7 @@ CDataDecoder::CDataDecoder ():iServPacketID (0), DoNotProcessData (TRUE),
 
 CDataDecoder::~CDataDecoder ()
 {
+	/* writes back the received objects */
 	delete &Journaline;
 }
 
@@ -279,6 +281,9 @@ CDataDecoder::ProcessDataInternal(CParameter & Parameters)
 	}
 	if(iEPGService >= 0)	/* if EPG decoding is active */
 		DecodeEPG(Parameters);
+
+	/* Write the schedules once a burst of EPG objects is over */
+	EPGStore.Flush();
 }
 
 void
@@ -308,6 +313,17 @@ CDataDecoder::DecodeEPG(const CParameter & Parameters)
 			fileName = epgFilename(NewObj.ScopeStart, iScopeId,
 								   NewObj.iContentSubType, advanced);
 
+			/* decode the schedule once here, so the guide can read it from
+			   the store instead of decoding the objects every time */
+			vector < CEPGProgramme > progs;
+			CEPGBinaryDecoder EPGDecoder;
+			if (EPGDecoder.Decode(NewObj.Body.vecData, progs))
+			{
+				EPGStore.SetDirectory(Parameters.GetDataDirectory("EPG") +
+									  "store/");
+				EPGStore.Update(iScopeId, progs);
+			}
+
 #if !defined(HAVE_LIBZ) && !defined(HAVE_LIBFREEIMAGE)
 			const string& s = NewObj.strName;
 			if (s.size() >= 3)
@@ -408,10 +424,16 @@ CDataDecoder::InitInternal(CParameter & Parameters)
 				// Problem: if two different services point to the same stream, they have different
 				// IDs and the Journaline is reset! TODO: fix this problem...
 
-				/* Reset Journaline decoder and store the new service
-				   ID number */
-				Journaline.Reset();
+				/* Keep what was received of the old service for the next
+				   time, then reset Journaline decoder and store the new
+				   service ID number. What we have of it is read from
+				   the file when the news are looked at */
 				iOldJournalineServiceID = iNewServID;
+				ostringstream ss;
+				ss << Parameters.GetDataDirectory("Journaline")
+					<< hex << iNewServID << ".jml";
+				Journaline.SetFile(ss.str());
+				Journaline.Reset();
 			}
 
 			/* Init vector for storing the CRC results for each packet */
@@ -496,12 +518,54 @@ _BOOLEAN
 	return bReturn;
 }
 
+void
+CDataDecoder::SetMOTCacheLimits(size_t iBudget, const string & strSpillDir)
+{
+	for (int i = 0; i < MAX_NUM_PACK_PER_STREAM; i++)
+	{
+		/* one spill directory per packet ID, transport IDs are only unique
+		   within one MOT stream */
+		string strDir;
+		if (strSpillDir != "")
+		{
+			ostringstream ss;
+			ss << strSpillDir << i << '/';
+			strDir = ss.str();
+		}
+		MOTObject[i].SetCacheLimits(iBudget, strDir);
+	}
+}
+
+void
+CDataDecoder::AddJournalineListener(CJournalineListener * pListener)
+{
+	Journaline.AddListener(pListener);
+}
+
+void
+CDataDecoder::RemoveJournalineListener(CJournalineListener * pListener)
+{
+	Journaline.RemoveListener(pListener);
+}
+
 void
 CDataDecoder::GetNews(const int iObjID, CNews & News)
 {
+	/* Read and write the stored objects in the caller's thread, the
+	   decoding thread is not held up by the file access */
+	CJournaline::CFileWork Work;
+	Lock();
+	const _BOOLEAN bFileWork = Journaline.TakeFileWork(Work);
+	Unlock();
+	if (bFileWork)
+		Work.Run();
+
 	/* Lock resources */
 	Lock();
 
+	if (bFileWork)
+		Journaline.FinishFileWork(Work);
+
 	/* Check if data service is Journaline application */
 	if ((DoNotProcessData == FALSE)
 		&& (eAppType[iServPacketID] == AT_JOURNALINE))
@@ -36,9 +36,11 @@
 #include "../util/Vector.h"
 #include "DABMOT.h"
 #include "MOTSlideShow.h"
+#include "epgstore.h"
 
 class CExperiment;
 class CJournaline;
+class CJournalineListener;
 class CNews;
 
 /* Definitions ****************************************************************/
@@ -75,7 +77,10 @@ class CDataDecoder:public CReceiverModul < _BINARY, _BINARY >
     _BOOLEAN GetMOTObject (CMOTObject & NewPic, const EAppType eAppTypeReq);
     _BOOLEAN GetMOTDirectory (CMOTDirectory & MOTDirectoryOut, const EAppType eAppTypeReq);
 	CMOTDABDec *getApplication(int iPacketID) { return (iPacketID>=0 && iPacketID<3)?&MOTObject[iPacketID]:NULL; }
+    void SetMOTCacheLimits (size_t iBudget, const string & strSpillDir);
     void GetNews (const int iObjID, CNews & News);
+    void AddJournalineListener (CJournalineListener * pListener);
+    void RemoveJournalineListener (CJournalineListener * pListener);
     EAppType GetAppType ()
     {
 		return eAppType[iServPacketID];
@@ -119,6 +124,7 @@ class CDataDecoder:public CReceiverModul < _BINARY, _BINARY >
 
     int iEPGService;
     int iEPGPacketID;
+    CEPGStore EPGStore;
     void DecodeEPG(const CParameter& Parameters);
 	EAppType GetAppType(const CDataParam&);
 
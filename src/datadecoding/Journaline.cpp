@@ -33,8 +33,12 @@
 #endif
 
 #include "journaline/newssvcdec_impl.h" // for log variables
+#include "epgutil.h"
+#include <algorithm>
 
-CJournaline::CJournaline() : dgdec(NULL), newsdec(NULL)
+CJournaline::CJournaline() : dgdec(NULL), newsdec(NULL), Objects(), LRU(),
+	iStoreBytes(0), strFile(""), bLoaded(FALSE), bLoading(FALSE),
+	PendingSave(), vecListeners(), ListenerMutex()
 {
 	/* This will be the first call to the Journaline decoder open function, the
 	   pointer to the decoders must have a defined value (NULL) to avoid
@@ -44,6 +48,10 @@ CJournaline::CJournaline() : dgdec(NULL), newsdec(NULL)
 
 CJournaline::~CJournaline()
 {
+	/* Nobody is decoding any more, write back what has not been yet */
+	SetFile("");
+	PendingSave.Run();
+
 	/* Delete decoder instances */
 	if (newsdec != NULL)
 		NEWS_SVC_DEC_deleteDec(newsdec);
@@ -54,11 +62,10 @@ CJournaline::~CJournaline()
 
 void CJournaline::ResetOpenJournalineDecoder()
 {
-	/* 1 MB memory for news decoder */
+	/* The decoded objects are kept in our store, the decoder only needs
+	   room for the ones just received */
 	unsigned long max_memory = 1024 * 1024;
-
-	/* No limit for number of NML objects (except max_memory limitation) */
-	unsigned long max_objects = 0;
+	unsigned long max_objects = JOURNALINE_DECODER_OBJECTS;
 
 	/* No extended header will be used */
 	unsigned long extended_header_len = 0;
@@ -75,43 +82,300 @@ void CJournaline::ResetOpenJournalineDecoder()
 	dgdec = DAB_DATAGROUP_DECODER_createDec(dg_cb, this);
 	newsdec = NEWS_SVC_DEC_createDec(obj_avail_cb, max_memory, &max_objects,
 		extended_header_len, this);
+
+	/* The objects of the old transmission are gone, too */
+	const _BOOLEAN bHadObjects = !Objects.empty();
+	Objects.clear();
+	LRU.clear();
+	iStoreBytes = 0;
+	if (bHadObjects)
+		Notify(JOURNALINE_ALL_OBJECTS);
 }
 
 void CJournaline::AddFile(const string filename)
 {
-	FILE *f = fopen(filename.c_str(), "rb");
-	bool err=false;
 	showDdNewsSvcDecInfo=1;
 	showDdNewsSvcDecErr=1;
-	while(!feof(f))
+	Load(filename);
+	showDdNewsSvcDecInfo=0;
+	showDdNewsSvcDecErr=0;
+}
+
+_BOOLEAN CJournaline::Load(const string& filename)
+{
+	vector<vector<_BYTE> > vecvecbyRaw;
+	const _BOOLEAN bOk = ReadObjects(filename, vecvecbyRaw);
+	for (size_t i = 0; i < vecvecbyRaw.size(); i++)
+	{
+		if(!PutObject(vecvecbyRaw[i].size(), &vecvecbyRaw[i][0]))
+			fprintf(stderr, "error decoding jml");
+	}
+	return bOk;
+}
+
+_BOOLEAN CJournaline::ReadObjects(const string& filename,
+	vector<vector<_BYTE> >& vecvecbyRaw)
+{
+	FILE *f = fopen(filename.c_str(), "rb");
+	if (f == NULL)
+		return FALSE;
+	_BOOLEAN bOk = TRUE;
+	for (;;)
 	{
 		unsigned char buf[8192];
 		uint16_t s;
 		size_t n = fread(&s, 2, 1, f);
 		if(n!=1)
-		{
-			err=true;
-			break;
-		}
+			break; /* end of file */
 		unsigned long size = ntohs(s);
-		if(size>8192)
-			break;
-		n = fread(buf, 1, size, f);
-		if(n==size)
-		{
-			if(NEWS_SVC_DEC_putData(newsdec, size, buf)!=1)
-				fprintf(stderr, "error decoding jml");
-		}
-		else
+		n = (size > 8192) ? 0 : fread(buf, 1, size, f);
+		if(n!=size || size==0)
 		{
-			err=true;
+			bOk = FALSE;
 			break;
 		}
+		vecvecbyRaw.push_back(vector<_BYTE>(buf, buf + size));
+	}
+	fclose(f);
+	return bOk;
+}
+
+_BOOLEAN CJournaline::WriteObjects(const string& filename,
+	const vector<vector<_BYTE> >& vecvecbyRaw)
+{
+	mkdirs(filename);
+	FILE *f = fopen(filename.c_str(), "wb");
+	if (f == NULL)
+		return FALSE;
+
+	_BOOLEAN bOk = TRUE;
+	for (size_t i = 0; bOk && (i < vecvecbyRaw.size()); i++)
+	{
+		const vector<_BYTE>& vecbyRaw = vecvecbyRaw[i];
+		if (vecbyRaw.empty() || (vecbyRaw.size() > 8192))
+			continue;
+		const uint16_t s = htons(uint16_t(vecbyRaw.size()));
+		bOk = (fwrite(&s, 2, 1, f) == 1) &&
+			(fwrite(&vecbyRaw[0], 1, vecbyRaw.size(), f) == vecbyRaw.size());
+	}
+	return (fclose(f) == 0) && bOk;
+}
+
+void CJournaline::TakeObjects(vector<vector<_BYTE> >& vecvecbyRaw)
+{
+	/* least recently used first, so they come back in the same order. The
+	   store is reset afterwards, so the data is moved instead of copied */
+	vecvecbyRaw.clear();
+	vecvecbyRaw.resize(LRU.size());
+	size_t i = 0;
+	for (list<int>::const_reverse_iterator it = LRU.rbegin();
+		it != LRU.rend(); it++)
+	{
+		vecvecbyRaw[i++].swap(Objects.find(*it)->second.vecbyRaw);
+	}
+}
+
+void CJournaline::SetFile(const string& strNewFile)
+{
+	/* Only a store which has the file merged in is complete enough to
+	   replace it. A save still pending cannot be overwritten here: this
+	   store was loaded after it, and loading takes the pending save */
+	if (bLoaded && (strFile != ""))
+	{
+		PendingSave.strSaveFile = strFile;
+		TakeObjects(PendingSave.vecvecbySave);
+	}
+	strFile = strNewFile;
+	bLoaded = FALSE;
+	bLoading = FALSE;
+}
+
+_BOOLEAN CJournaline::TakeFileWork(CFileWork& Work)
+{
+	Work.strSaveFile = PendingSave.strSaveFile;
+	Work.vecvecbySave.swap(PendingSave.vecvecbySave);
+	PendingSave.strSaveFile = "";
+	PendingSave.vecvecbySave.clear();
+
+	Work.strLoadFile = "";
+	Work.vecvecbyLoaded.clear();
+	if ((strFile != "") && !bLoaded && !bLoading)
+	{
+		Work.strLoadFile = strFile;
+		bLoading = TRUE;
+	}
+	return (Work.strSaveFile != "") || (Work.strLoadFile != "");
+}
+
+void CJournaline::CFileWork::Run()
+{
+	if (strSaveFile != "")
+	{
+		WriteObjects(strSaveFile, vecvecbySave);
+		strSaveFile = "";
+		vecvecbySave.clear();
+	}
+	if (strLoadFile != "")
+		ReadObjects(strLoadFile, vecvecbyLoaded);
+}
+
+void CJournaline::FinishFileWork(CFileWork& Work)
+{
+	/* The service may have changed again while the file was read */
+	if (!bLoading || (Work.strLoadFile != strFile))
+		return;
+
+	/* What was received in the meantime is newer than the file */
+	for (size_t i = 0; i < Work.vecvecbyLoaded.size(); i++)
+	{
+		const vector<_BYTE>& vecbyRaw = Work.vecvecbyLoaded[i];
+		PutObject(vecbyRaw.size(), &vecbyRaw[0], TRUE);
+	}
+	bLoaded = TRUE;
+	bLoading = FALSE;
+}
+
+void CJournaline::AddListener(CJournalineListener* pListener)
+{
+	ListenerMutex.Lock();
+	if (find(vecListeners.begin(), vecListeners.end(), pListener) ==
+		vecListeners.end())
+	{
+		vecListeners.push_back(pListener);
+	}
+	ListenerMutex.Unlock();
+}
+
+void CJournaline::RemoveListener(CJournalineListener* pListener)
+{
+	ListenerMutex.Lock();
+	vecListeners.erase(remove(vecListeners.begin(), vecListeners.end(),
+		pListener), vecListeners.end());
+	ListenerMutex.Unlock();
+}
+
+void CJournaline::Notify(const int iObjID)
+{
+	ListenerMutex.Lock();
+	for (size_t i = 0; i < vecListeners.size(); i++)
+		vecListeners[i]->ObjectChanged(iObjID);
+	ListenerMutex.Unlock();
+}
+
+_BOOLEAN CJournaline::PutObject(const unsigned long len,
+	const unsigned char* buf, const _BOOLEAN bKeepExisting)
+{
+	if ((newsdec == NULL) || (len < 2))
+		return FALSE;
+
+	if (bKeepExisting && (Objects.find((int(buf[0]) << 8) | buf[1]) !=
+		Objects.end()))
+	{
+		return TRUE;
+	}
+
+	/* The news decoder checks the object and unpacks it if compressed */
+	if (NEWS_SVC_DEC_putData(newsdec, len, buf) != 1)
+		return FALSE;
+
+	const int iObjID = (int(buf[0]) << 8) | buf[1];
+
+	/* Most objects are repetitions from the carousel, nothing to do then */
+	map<int, CObject>::iterator it = Objects.find(iObjID);
+	if ((it != Objects.end()) && (it->second.vecbyRaw.size() == len) &&
+		equal(buf, buf + len, it->second.vecbyRaw.begin()))
+	{
+		return TRUE;
+	}
+
+	if (Decode(iObjID, len, buf) == NULL)
+		return FALSE;
+
+	Notify(iObjID);
+	return TRUE;
+}
+
+CJournaline::CObject* CJournaline::Decode(const int iObjID,
+	const unsigned long len, const unsigned char* buf)
+{
+	NML::RawNewsObject_t rno;
+	unsigned long elen = 0;
+	unsigned long nmllen = 0;
+	if (!NEWS_SVC_DEC_get_news_object(newsdec, iObjID, &elen, &nmllen, rno.nml))
+		return NULL;
+
+	rno.nml_len = static_cast<unsigned short>(nmllen);
+	rno.extended_header_len = static_cast<unsigned short>(elen);
+	RemoveNMLEscapeSequences handler;
+	NML *nml = NMLFactory::Instance()->CreateNML(rno, &handler);
+	if (nml == NULL)
+		return NULL;
+
+	map<int, CObject>::iterator it = Objects.find(iObjID);
+	if (it == Objects.end())
+	{
+		it = Objects.insert(make_pair(iObjID, CObject())).first;
+		LRU.push_front(iObjID);
+		it->second.itLRU = LRU.begin();
+	}
+	else
+	{
+		iStoreBytes -= it->second.iBytes;
+		Touch(it->second, iObjID);
+	}
+	CObject& Obj = it->second;
+
+	Obj.vecbyRaw.assign(buf, buf + len);
+	Obj.sTitle = nml->GetTitle();
+	Obj.bMenu = nml->isMenu() ? TRUE : FALSE;
+	const int iNumItems = nml->GetNrOfItems();
+	Obj.vecsItemText.resize(iNumItems);
+	Obj.veciLinkID.resize(Obj.bMenu ? iNumItems : 0);
+	Obj.iBytes = sizeof(CObject) + Obj.vecbyRaw.size() + Obj.sTitle.size() +
+		Obj.veciLinkID.size() * sizeof(int);
+	for (int i = 0; i < iNumItems; i++)
+	{
+		Obj.vecsItemText[i] = nml->GetItemText(i);
+		Obj.iBytes += sizeof(string) + Obj.vecsItemText[i].size();
+		if (Obj.bMenu)
+			Obj.veciLinkID[i] = nml->GetLinkId(i);
+	}
+	iStoreBytes += Obj.iBytes;
+	delete nml;
+
+	Enforce();
+	return &Obj;
+}
+
+CJournaline::CObject* CJournaline::Find(const int iObjID)
+{
+	map<int, CObject>::iterator it = Objects.find(iObjID);
+	if (it == Objects.end())
+		return NULL;
+	Touch(it->second, iObjID);
+	return &it->second;
+}
+
+void CJournaline::Touch(CObject& Obj, const int iObjID)
+{
+	LRU.erase(Obj.itLRU);
+	LRU.push_front(iObjID);
+	Obj.itLRU = LRU.begin();
+}
+
+void CJournaline::Enforce()
+{
+	/* Drop the objects not looked at for the longest time, but never the
+	   one just used */
+	while ((iStoreBytes > JOURNALINE_STORE_BUDGET) && (LRU.size() > 1))
+	{
+		const int iObjID = LRU.back();
+		LRU.pop_back();
+		map<int, CObject>::iterator it = Objects.find(iObjID);
+		iStoreBytes -= it->second.iBytes;
+		Objects.erase(it);
+		Notify(iObjID);
 	}
-	if(!err)
-		fclose(f);
-	showDdNewsSvcDecInfo=0;
-	showDdNewsSvcDecErr=0;
 }
 
 void CJournaline::AddDataUnit(CVector<_BINARY>& vecbiNewData)
@@ -138,63 +402,45 @@ void CJournaline::GetNews(const int iObjID, CNews& News)
 	News.sTitle = "";
 	News.vecItem.Init(0);
 
-	NML::RawNewsObject_t rno;
-	unsigned long elen = 0;
-	unsigned long len = 0;
-	if(newsdec && NEWS_SVC_DEC_get_news_object(newsdec, iObjID, &elen, &len, rno.nml))
-	{
-		rno.nml_len = static_cast<unsigned short>(len);
-		rno.extended_header_len = static_cast<unsigned short>(elen);
-		RemoveNMLEscapeSequences handler;
-		NML *nml = NMLFactory::Instance()->CreateNML(rno, &handler);
+	const CObject* pObj = Find(iObjID);
+	if (pObj == NULL)
+		return;
 
-		/* Title */
-		News.sTitle = nml->GetTitle();
+	/* Title */
+	News.sTitle = pObj->sTitle;
 
-		/* Items */
-		const int iNumItems = nml->GetNrOfItems();
-		News.vecItem.Init(iNumItems);
+	/* Items */
+	const int iNumItems = (int) pObj->vecsItemText.size();
+	News.vecItem.Init(iNumItems);
 
-		/* For "keep in cache" function, init with zero length */
-		CVector<NML::NewsObjectId_t> iAvailIDs(0);
+	for (int i = 0; i < iNumItems; i++)
+	{
+		/* Text */
+		News.vecItem[i].sText = pObj->vecsItemText[i];
 
-		for (int i = 0; i < iNumItems; i++)
+		/* Link */
+		if (pObj->bMenu)
 		{
-			/* Text */
-			News.vecItem[i].sText = nml->GetItemText(i);
+			const int iLinkID = pObj->veciLinkID[i];
+			News.vecItem[i].iLinkID = iLinkID;
 
-			/* Link */
-			if (nml->isMenu())
+			/* Check availability of linked object */
+			if (Objects.find(iLinkID) != Objects.end())
 			{
-				elen = len = 0;
-
-				/* Check availability of linked object */
-				if (NEWS_SVC_DEC_get_news_object(newsdec, nml->GetLinkId(i),
-					&elen, &len, rno.nml))
-				{
-					/* Assign link */
-					News.vecItem[i].iLink = nml->GetLinkId(i);
-
-					/* Store link in vector for "keep in cache" function */
-					iAvailIDs.Add(nml->GetLinkId(i));
-				}
-				else
-				{
-					/* Not yet received */
-					News.vecItem[i].iLink = JOURNALINE_LINK_NOT_ACTIVE;
-				}
+				/* Assign link */
+				News.vecItem[i].iLink = iLinkID;
 			}
 			else
-				News.vecItem[i].iLink = JOURNALINE_IS_NO_LINK; /* No link */
+			{
+				/* Not yet received */
+				News.vecItem[i].iLink = JOURNALINE_LINK_NOT_ACTIVE;
+			}
 		}
-
-		const int iAvailIDsSize = iAvailIDs.Size();
-		if (iAvailIDsSize > 0)
+		else
 		{
-			/* Tell the decoder to keep the linked objects in cache */
-			NEWS_SVC_DEC_keep_in_cache(newsdec, iAvailIDsSize, &iAvailIDs[0]);
+			/* No link */
+			News.vecItem[i].iLink = JOURNALINE_IS_NO_LINK;
+			News.vecItem[i].iLinkID = JOURNALINE_IS_NO_LINK;
 		}
-
-		delete nml;
 	}
 }
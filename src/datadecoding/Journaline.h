@@ -30,6 +30,9 @@
 
 #include "../GlobalDefinitions.h"
 #include "../util/Vector.h"
+#include <list>
+#include <map>
+#include <vector>
 # include "journaline/NML.h"
 # include "journaline/newssvcdec.h"
 # include "journaline/dabdatagroupdecoder.h"
@@ -40,12 +43,23 @@
 #define JOURNALINE_IS_NO_LINK			-2
 #define JOURNALINE_LINK_NOT_ACTIVE		-1
 
+/* Passed to CJournalineListener when all objects have been dropped */
+#define JOURNALINE_ALL_OBJECTS			-3
+
+/* Memory for the decoded objects kept by CJournaline, in bytes */
+#define JOURNALINE_STORE_BUDGET			(1024 * 1024)
+
+/* Objects the NML decoder library keeps itself. Each object is taken over
+   into the store right after it was received, so only a few are needed */
+#define JOURNALINE_DECODER_OBJECTS		2
+
 
 /* Classes ********************************************************************/
 struct CNewsItem
 {
 	string	sText;
 	int		iLink;
+	int		iLinkID; /* object linked to, even if not yet received */
 };
 
 class CNews
@@ -58,6 +72,17 @@ public:
 };
 
 
+/* Gets told about new and changed objects, instead of polling GetNews() */
+class CJournalineListener
+{
+public:
+	virtual ~CJournalineListener() {}
+
+	/* Called from the decoding thread with the data decoder locked, so
+	   implementations must not call back into the decoder from here */
+	virtual void ObjectChanged(const int iObjID) = 0;
+};
+
 class CJournaline
 {
 public:
@@ -68,19 +93,93 @@ public:
 	void AddDataUnit(CVector<_BINARY>& vecbiNewData);
 	void Reset() {ResetOpenJournalineDecoder();}
 	void AddFile(const string filename);
+	_BOOLEAN Load(const string& filename);
+
+	/* Keep the received objects across restarts, as a sequence of objects
+	   each preceded by its length in two bytes (network byte order). None
+	   of the file access is done by the decoding thread: the file of a
+	   service is read the first time somebody asks for its news and written
+	   back after the service has changed, see CDataDecoder::GetNews() */
+	class CFileWork
+	{
+	public:
+		CFileWork() : strSaveFile(""), vecvecbySave(), strLoadFile(""),
+			vecvecbyLoaded() {}
+
+		/* Does the file access, without the decoder being locked */
+		void Run();
+
+		string					strSaveFile;
+		vector<vector<_BYTE> >	vecvecbySave;
+		string					strLoadFile;
+		vector<vector<_BYTE> >	vecvecbyLoaded;
+	};
+
+	/* Called by the decoding thread when the service changes, before Reset() */
+	void SetFile(const string& strNewFile);
+	_BOOLEAN TakeFileWork(CFileWork& Work);
+	void FinishFileWork(CFileWork& Work);
+
+	void AddListener(CJournalineListener* pListener);
+	void RemoveListener(CJournalineListener* pListener);
 
 protected:
+	/* A received object, decoded once when it arrives */
+	class CObject
+	{
+	public:
+		CObject() : vecbyRaw(), sTitle(""), vecsItemText(), veciLinkID(),
+			bMenu(FALSE), itLRU(), iBytes(0) {}
+
+		vector<_BYTE>		vecbyRaw; /* as received, for persistence */
+		string				sTitle;
+		vector<string>		vecsItemText;
+		vector<int>			veciLinkID;
+		_BOOLEAN			bMenu;
+		list<int>::iterator	itLRU;
+		size_t				iBytes;
+	};
+
 	DAB_DATAGROUP_DECODER_t	dgdec;
 	NEWS_SVC_DEC_decoder_t	newsdec;
 
+	/* Object store: the index by object ID and the order of use for
+	   bounding the memory */
+	map<int, CObject>		Objects;
+	list<int>				LRU;
+	size_t					iStoreBytes;
+
+	/* The file of the current service and whether it has been merged into
+	   the store yet, only then it is written back */
+	string					strFile;
+	_BOOLEAN				bLoaded;
+	_BOOLEAN				bLoading;
+	CFileWork				PendingSave;
+
+	vector<CJournalineListener*>	vecListeners;
+	mutable CMutex			ListenerMutex;
+
 	void ResetOpenJournalineDecoder();
+	_BOOLEAN PutObject(const unsigned long len, const unsigned char* buf,
+		const _BOOLEAN bKeepExisting = FALSE);
+	void TakeObjects(vector<vector<_BYTE> >& vecvecbyRaw);
+	static _BOOLEAN ReadObjects(const string& filename,
+		vector<vector<_BYTE> >& vecvecbyRaw);
+	static _BOOLEAN WriteObjects(const string& filename,
+		const vector<vector<_BYTE> >& vecvecbyRaw);
+	CObject* Find(const int iObjID);
+	CObject* Decode(const int iObjID, const unsigned long len,
+		const unsigned char* buf);
+	void Touch(CObject& Obj, const int iObjID);
+	void Enforce();
+	void Notify(const int iObjID);
 
 	/* Callback functions for journaline decoder internal tasks */
 	static void obj_avail_cb(unsigned long, NEWS_SVC_DEC_obj_availability_t*,
 		void*) {}
 	static void dg_cb(const DAB_DATAGROUP_DECODER_msc_datagroup_header_t*,
 		const unsigned long len, const unsigned char* buf, void* data)
-		{NEWS_SVC_DEC_putData(((CJournaline*) data)->newsdec, len, buf);}
+		{((CJournaline*) data)->PutObject(len, buf);}
 };
 
 #endif // !defined(JOURNALINE_H__3B0UBVE987346456363LIHGEW982__INCLUDED_)
@@ -0,0 +1,366 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	ETSI DAB/DRM Electronic Programme Guide binary decoder
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "epgbin.h"
+#include <sstream>
+
+/* element and attribute tags of ETSI TS 102 371 */
+#define EPG_TAG_CDATA			0x01
+#define EPG_TAG_EPG				0x02
+#define EPG_TAG_TOKEN_TABLE		0x04
+#define EPG_TAG_DEFAULT_ID		0x05
+#define EPG_TAG_MEDIUM_NAME		0x11
+#define EPG_TAG_LONG_NAME		0x12
+#define EPG_TAG_MEDIA_DESC		0x13
+#define EPG_TAG_GENRE			0x14
+#define EPG_TAG_LOCATION		0x19
+#define EPG_TAG_SHORT_DESC		0x1A
+#define EPG_TAG_PROGRAMME		0x1C
+#define EPG_TAG_TIME			0x2C
+#define EPG_TAG_ATTRIBUTE		0x80
+
+static uint32_t
+get_uint16(const _BYTE * p)
+{
+	return (uint32_t(p[0]) << 8) | p[1];
+}
+
+static uint32_t
+get_uint24(const _BYTE * p)
+{
+	return (uint32_t(p[0]) << 16) | (uint32_t(p[1]) << 8) | p[2];
+}
+
+static void
+addUnique(vector < string > &to, const vector < string > &from)
+{
+	for (size_t i = 0; i < from.size(); i++)
+	{
+		size_t j = 0;
+		while (j < to.size() && to[j] != from[i])
+			j++;
+		if (j == to.size())
+			to.push_back(from[i]);
+	}
+}
+
+void
+CEPGProgramme::augment(const CEPGProgramme & p)
+{
+	if (p.time != 0)
+		time = p.time;
+	if (p.actualTime != 0)
+		actualTime = p.actualTime;
+	if (p.duration > 0)
+		duration = p.duration;
+	if (p.actualDuration > 0)
+		actualDuration = p.actualDuration;
+	if (crid == "")
+		crid = p.crid;
+	if (name == "")
+		name = p.name;
+	if (description == "")
+		description = p.description;
+	if (shortId == 0 && p.shortId != 0)
+		shortId = p.shortId;
+	/* the same object is received again and again, don't repeat genres */
+	addUnique(mainGenre, p.mainGenre);
+	addUnique(secondaryGenre, p.secondaryGenre);
+	addUnique(otherGenre, p.otherGenre);
+}
+
+bool
+CEPGProgramme::operator==(const CEPGProgramme & p) const
+{
+	return time == p.time && actualTime == p.actualTime
+		&& duration == p.duration && actualDuration == p.actualDuration
+		&& name == p.name && description == p.description
+		&& crid == p.crid && shortId == p.shortId
+		&& mainGenre == p.mainGenre && secondaryGenre == p.secondaryGenre
+		&& otherGenre == p.otherGenre;
+}
+
+CEPGBinaryDecoder::CEPGBinaryDecoder()
+{
+}
+
+_BOOLEAN
+CEPGBinaryDecoder::Decode(const vector < _BYTE > &vecData,
+						  vector < CEPGProgramme > &progs)
+{
+	for (size_t i = 0; i < 20; i++)
+		tokens[i] = "";
+	if (vecData.empty())
+		return FALSE;
+	const _BYTE *p = &vecData[0];
+	CTLV tlv;
+	if (!next(p, p + vecData.size(), tlv) || tlv.tag != EPG_TAG_EPG)
+		return FALSE;
+	container(tlv, progs);
+	return TRUE;
+}
+
+_BOOLEAN
+CEPGBinaryDecoder::next(const _BYTE * &p, const _BYTE * end, CTLV & tlv)
+{
+	if (end - p < 2)
+		return FALSE;
+	tlv.tag = *p++;
+	tlv.length = *p++;
+	if (tlv.length == 0xFE)
+	{
+		if (end - p < 2)
+			return FALSE;
+		tlv.length = get_uint16(p);
+		p += 2;
+	}
+	else if (tlv.length == 0xFF)
+	{
+		if (end - p < 3)
+			return FALSE;
+		tlv.length = get_uint24(p);
+		p += 3;
+	}
+	if (size_t(end - p) < tlv.length)
+		return FALSE;			/* truncated */
+	tlv.value = p;
+	p += tlv.length;
+	return TRUE;
+}
+
+/* epg, schedule and the like: just look for programmes inside */
+void
+CEPGBinaryDecoder::container(const CTLV & tlv, vector < CEPGProgramme > &progs)
+{
+	const _BYTE *p = tlv.value, *end = tlv.value + tlv.length;
+	CTLV child;
+	while (next(p, end, child))
+	{
+		if (child.tag == EPG_TAG_TOKEN_TABLE)
+			tokenTable(child);
+		else if (child.tag == EPG_TAG_PROGRAMME)
+		{
+			CEPGProgramme prog;
+			programme(child, prog);
+			progs.push_back(prog);
+		}
+		else if (child.tag > EPG_TAG_DEFAULT_ID && child.tag < EPG_TAG_ATTRIBUTE)
+			container(child, progs);
+	}
+}
+
+void
+CEPGBinaryDecoder::programme(const CTLV & tlv, CEPGProgramme & prog)
+{
+	const _BYTE *p = tlv.value, *end = tlv.value + tlv.length;
+	CTLV child;
+	while (next(p, end, child))
+	{
+		switch (child.tag)
+		{
+		case EPG_TAG_ATTRIBUTE:	/* id */
+			prog.crid = decodeString(child.value, child.length);
+			break;
+		case EPG_TAG_ATTRIBUTE | 1:	/* shortId */
+			if (child.length >= 3)
+				prog.shortId = get_uint24(child.value);
+			break;
+		case EPG_TAG_MEDIUM_NAME:
+			if (prog.name == "")
+				prog.name = text(child);
+			break;
+		case EPG_TAG_LONG_NAME:
+			prog.name = text(child);
+			break;
+		case EPG_TAG_LOCATION:
+			location(child, prog);
+			break;
+		case EPG_TAG_MEDIA_DESC:
+			{
+				const _BYTE *q = child.value, *qend = child.value + child.length;
+				CTLV desc;
+				while (next(q, qend, desc))
+					if (desc.tag == EPG_TAG_SHORT_DESC)
+						prog.description = text(desc);
+			}
+			break;
+		case EPG_TAG_GENRE:
+			genre(child, prog);
+			break;
+		}
+	}
+}
+
+void
+CEPGBinaryDecoder::location(const CTLV & tlv, CEPGProgramme & prog)
+{
+	const _BYTE *p = tlv.value, *end = tlv.value + tlv.length;
+	CTLV child;
+	while (next(p, end, child))
+		if (child.tag == EPG_TAG_TIME)
+			timeElement(child, prog);
+}
+
+void
+CEPGBinaryDecoder::timeElement(const CTLV & tlv, CEPGProgramme & prog)
+{
+	/* like the XML, every time element describes the whole timing */
+	prog.time = prog.actualTime = 0;
+	prog.duration = prog.actualDuration = 0;
+	const _BYTE *p = tlv.value, *end = tlv.value + tlv.length;
+	CTLV a;
+	while (next(p, end, a))
+	{
+		switch (a.tag)
+		{
+		case EPG_TAG_ATTRIBUTE:
+			prog.time = decodeTime(a.value, a.length);
+			break;
+		case EPG_TAG_ATTRIBUTE | 1:
+			if (a.length >= 2)
+				prog.duration = get_uint16(a.value);
+			break;
+		case EPG_TAG_ATTRIBUTE | 2:
+			prog.actualTime = decodeTime(a.value, a.length);
+			break;
+		case EPG_TAG_ATTRIBUTE | 3:
+			if (a.length >= 2)
+				prog.actualDuration = get_uint16(a.value);
+			break;
+		}
+	}
+}
+
+void
+CEPGBinaryDecoder::genre(const CTLV & tlv, CEPGProgramme & prog)
+{
+	string href;
+	int type = 1;				/* main */
+	const _BYTE *p = tlv.value, *end = tlv.value + tlv.length;
+	CTLV a;
+	while (next(p, end, a))
+	{
+		if (a.tag == EPG_TAG_ATTRIBUTE)
+			href = decodeGenre(a.value, a.length);
+		else if (a.tag == (EPG_TAG_ATTRIBUTE | 1) && a.length > 0)
+			type = a.value[0];
+	}
+	switch (type)
+	{
+	case 1:
+		prog.mainGenre.push_back(href);
+		break;
+	case 2:
+		prog.secondaryGenre.push_back(href);
+		break;
+	case 3:
+		prog.otherGenre.push_back(href);
+		break;
+	}
+}
+
+string
+CEPGBinaryDecoder::text(const CTLV & tlv) const
+{
+	string s;
+	const _BYTE *p = tlv.value, *end = tlv.value + tlv.length;
+	CTLV child;
+	while (next(p, end, child))
+		if (child.tag == EPG_TAG_CDATA)
+			s += decodeString(child.value, child.length);
+	return s;
+}
+
+void
+CEPGBinaryDecoder::tokenTable(const CTLV & tlv)
+{
+	for (size_t i = 0; i < 20; i++)
+		tokens[i] = "";
+	for (size_t i = 0; i + 2 <= tlv.length;)
+	{
+		const _BYTE tok = tlv.value[i++];
+		const size_t len = tlv.value[i++];
+		if (i + len > tlv.length)
+			break;
+		if (tok < 20)
+			tokens[tok].assign((const char *) &tlv.value[i], len);
+		i += len;
+	}
+}
+
+string
+CEPGBinaryDecoder::decodeString(const _BYTE * p, size_t len) const
+{
+	string out;
+	out.reserve(len);
+	for (size_t i = 0; i < len; i++)
+	{
+		const _BYTE c = p[i];
+		if (1 <= c && c <= 19 && c != 0x9 && c != 0xa && c != 0xd)
+			out += tokens[c];
+		else
+			out += char (c);
+	}
+	return out;
+}
+
+/* the times are coded as UTC, the local time offset is only a hint for
+   display, so it doesn't change the value */
+time_t
+CEPGBinaryDecoder::decodeTime(const _BYTE * p, size_t len)
+{
+	if (len < 4)
+		return 0;
+	const uint32_t mjd = (get_uint24(p) >> 6) & 0x1ffff;
+	const _BOOLEAN utc_flag = (p[2] & 0x08) != 0;
+	const uint32_t n = get_uint16(&p[2]);
+	const int hours = (n >> 6) & 0x1f;
+	const int minutes = n & 0x3f;
+	int seconds = 0;
+	if (utc_flag && len >= 6)
+		seconds = p[4] >> 2;
+	/* MJD 40587 is 1970-01-01 */
+	return time_t(long (mjd) - 40587L) * 86400 +
+		3600 * hours + 60 * minutes + seconds;
+}
+
+/* only the code of the href is kept, e.g. "3.1.1" of
+   urn:tva:metadata:cs:ContentCS:2005:3.1.1 */
+string
+CEPGBinaryDecoder::decodeGenre(const _BYTE * p, size_t len)
+{
+	if (len < 2)
+		return "";
+	const int cs = p[0] & 0xff;
+	if (cs < 1 || cs > 8)
+		return "";
+	ostringstream out;
+	out << cs;
+	for (size_t i = 1; i < len && i < 4; i++)
+		out << '.' << int (p[i]);
+	return out.str();
+}
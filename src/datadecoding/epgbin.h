@@ -0,0 +1,111 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	ETSI DAB/DRM Electronic Programme Guide binary decoder
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef _EPGBIN_H
+#define _EPGBIN_H
+
+#include "../GlobalDefinitions.h"
+#include <string>
+#include <vector>
+#include <time.h>
+using namespace std;
+
+/* One programme of a schedule, with the information the guide shows */
+class CEPGProgramme
+{
+  public:
+
+    CEPGProgramme ():time (0), actualTime (0), duration (0), actualDuration (0),
+	name (""), description (""), crid (""), shortId (0),
+	mainGenre (), secondaryGenre (), otherGenre ()
+    {
+    }
+
+    /* take over what another record of the same programme knows */
+    void augment (const CEPGProgramme &);
+
+    time_t start () const
+    {
+	return (actualTime != 0) ? actualTime : time;
+    }
+
+    bool operator== (const CEPGProgramme &) const;
+    bool operator!= (const CEPGProgramme & p) const
+    {
+	return !(*this == p);
+    }
+
+    time_t time, actualTime;
+    int duration, actualDuration;
+    string name, description, crid;
+    uint32_t shortId;
+    /* genres as TV-Anytime classification codes, e.g. "3.1.1" */
+    vector < string > mainGenre, secondaryGenre, otherGenre;
+};
+
+/* Decodes binary EPG objects (ETSI TS 102 371) straight into programme
+   records, in one pass over the data and without building an XML tree.
+   Only the elements the guide uses are looked at, everything else is
+   skipped by its length */
+class CEPGBinaryDecoder
+{
+  public:
+
+    CEPGBinaryDecoder ();
+
+    /* appends the programmes found, FALSE if it is no binary EPG object */
+    _BOOLEAN Decode (const vector < _BYTE > &vecData,
+		     vector < CEPGProgramme > &progs);
+
+  protected:
+
+    class CTLV
+    {
+      public:
+	_BYTE tag;
+	const _BYTE *value;
+	size_t length;
+    };
+
+    static _BOOLEAN next (const _BYTE * &p, const _BYTE * end, CTLV & tlv);
+
+    void container (const CTLV & tlv, vector < CEPGProgramme > &progs);
+    void programme (const CTLV & tlv, CEPGProgramme & prog);
+    void location (const CTLV & tlv, CEPGProgramme & prog);
+    void timeElement (const CTLV & tlv, CEPGProgramme & prog);
+    void genre (const CTLV & tlv, CEPGProgramme & prog);
+    string text (const CTLV & tlv) const;
+    void tokenTable (const CTLV & tlv);
+
+    string decodeString (const _BYTE * p, size_t len) const;
+    static time_t decodeTime (const _BYTE * p, size_t len);
+    static string decodeGenre (const _BYTE * p, size_t len);
+
+    string tokens[20];
+};
+
+#endif
@@ -0,0 +1,423 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Store of decoded Electronic Programme Guide schedules
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "epgstore.h"
+#include "epgutil.h"
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+
+/* File layout, all numbers big endian:
+   "DEPG" version(4) count(4) datasize(4)
+   count * { start(8) offset(4) }, sorted by start
+   datasize bytes of records, offsets relative to the first one */
+#define EPG_STORE_MAGIC "DEPG"
+#define EPG_STORE_VERSION 1
+#define EPG_STORE_HEADER_SIZE 16
+#define EPG_STORE_INDEX_ENTRY_SIZE 12
+
+static void
+put32(string & out, uint32_t n)
+{
+	out += char (n >> 24);
+	out += char (n >> 16);
+	out += char (n >> 8);
+	out += char (n);
+}
+
+static void
+put64(string & out, int64_t n)
+{
+	put32(out, uint32_t(uint64_t(n) >> 32));
+	put32(out, uint32_t(n));
+}
+
+static void
+putString(string & out, const string & s)
+{
+	put32(out, uint32_t(s.size()));
+	out += s;
+}
+
+static void
+putStrings(string & out, const vector < string > &v)
+{
+	put32(out, uint32_t(v.size()));
+	for (size_t i = 0; i < v.size(); i++)
+		putString(out, v[i]);
+}
+
+/* reads from a buffer, any read past the end makes it bad */
+class CEPGStoreReader
+{
+  public:
+	CEPGStoreReader(const _BYTE * b, size_t n):p(b), end(b + n), bOk(true)
+	{
+	}
+	uint32_t get32()
+	{
+		if (end - p < 4)
+		{
+			bOk = false;
+			p = end;
+			return 0;
+		}
+		const uint32_t n = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16)
+			| (uint32_t(p[2]) << 8) | p[3];
+		p += 4;
+		return n;
+	}
+	int64_t get64()
+	{
+		const uint64_t h = get32();
+		return int64_t((h << 32) | get32());
+	}
+	string getString()
+	{
+		const size_t n = get32();
+		if (size_t(end - p) < n)
+		{
+			bOk = false;
+			p = end;
+			return "";
+		}
+		string s((const char *) p, n);
+		p += n;
+		return s;
+	}
+	void getStrings(vector < string > &v)
+	{
+		const size_t n = get32();
+		v.clear();
+		for (size_t i = 0; i < n && bOk; i++)
+			v.push_back(getString());
+	}
+	bool atEnd() const
+	{
+		return p == end;
+	}
+	const _BYTE *p, *end;
+	bool bOk;
+};
+
+static void
+putProgramme(string & out, const CEPGProgramme & p)
+{
+	put64(out, p.time);
+	put64(out, p.actualTime);
+	put32(out, uint32_t(p.duration));
+	put32(out, uint32_t(p.actualDuration));
+	put32(out, p.shortId);
+	putString(out, p.name);
+	putString(out, p.description);
+	putString(out, p.crid);
+	putStrings(out, p.mainGenre);
+	putStrings(out, p.secondaryGenre);
+	putStrings(out, p.otherGenre);
+}
+
+static bool
+getProgramme(CEPGStoreReader & in, CEPGProgramme & p)
+{
+	p.time = time_t(in.get64());
+	p.actualTime = time_t(in.get64());
+	p.duration = int (in.get32());
+	p.actualDuration = int (in.get32());
+	p.shortId = in.get32();
+	p.name = in.getString();
+	p.description = in.getString();
+	p.crid = in.getString();
+	in.getStrings(p.mainGenre);
+	in.getStrings(p.secondaryGenre);
+	in.getStrings(p.otherGenre);
+	return in.bOk;
+}
+
+/* header and index of an open store file */
+static bool
+readIndex(FILE * f, vector < _BYTE > &index, uint32_t & count,
+		  uint32_t & datasize)
+{
+	_BYTE h[EPG_STORE_HEADER_SIZE];
+	if (fread(h, 1, sizeof(h), f) != sizeof(h))
+		return false;
+	CEPGStoreReader r(h, sizeof(h));
+	if (string((const char *) h, 4) != EPG_STORE_MAGIC)
+		return false;
+	r.p += 4;
+	if (r.get32() != EPG_STORE_VERSION)
+		return false;
+	count = r.get32();
+	datasize = r.get32();
+	if (count > 0x100000)
+		return false;			/* not plausible */
+	index.resize(size_t(count) * EPG_STORE_INDEX_ENTRY_SIZE);
+	if (count > 0 && fread(&index[0], 1, index.size(), f) != index.size())
+		return false;
+	return true;
+}
+
+static int64_t
+indexStart(const vector < _BYTE > &index, size_t i)
+{
+	CEPGStoreReader r(&index[i * EPG_STORE_INDEX_ENTRY_SIZE],
+					  EPG_STORE_INDEX_ENTRY_SIZE);
+	return r.get64();
+}
+
+static uint32_t
+indexOffset(const vector < _BYTE > &index, size_t i)
+{
+	CEPGStoreReader r(&index[i * EPG_STORE_INDEX_ENTRY_SIZE + 8], 4);
+	return r.get32();
+}
+
+/* first index entry starting at or after t */
+static size_t
+lowerBound(const vector < _BYTE > &index, size_t count, int64_t t)
+{
+	size_t lo = 0, hi = count;
+	while (lo < hi)
+	{
+		const size_t mid = (lo + hi) / 2;
+		if (indexStart(index, mid) < t)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+string
+CEPGStore::fileName(uint32_t sid) const
+{
+	ostringstream s;
+	s << strDirectory << hex << setfill('0') << setw(6)
+		<< (unsigned long) sid << ".epgdb";
+	return s.str();
+}
+
+_BOOLEAN
+CEPGStore::Load(uint32_t sid, time_t from, time_t to,
+				vector < CEPGProgramme > &progs) const
+{
+	FILE *f = fopen(fileName(sid).c_str(), "rb");
+	if (f == NULL)
+		return FALSE;
+	vector < _BYTE > index;
+	uint32_t count = 0, datasize = 0;
+	_BOOLEAN bOk = readIndex(f, index, count, datasize);
+	if (bOk)
+	{
+		const size_t first = lowerBound(index, count, from);
+		const size_t last = lowerBound(index, count, to);
+		if (first < last)
+		{
+			const uint32_t begin = indexOffset(index, first);
+			const uint32_t end = (last < count) ?
+				indexOffset(index, last) : datasize;
+			vector < _BYTE > data(end > begin ? end - begin : 0);
+			if (data.empty()
+				|| fseek(f, long (EPG_STORE_HEADER_SIZE + index.size() + begin),
+						 SEEK_SET) != 0
+				|| fread(&data[0], 1, data.size(), f) != data.size())
+				bOk = FALSE;
+			else
+			{
+				CEPGStoreReader r(&data[0], data.size());
+				for (size_t i = first; i < last && bOk; i++)
+				{
+					CEPGProgramme p;
+					bOk = getProgramme(r, p);
+					if (bOk)
+						progs.push_back(p);
+				}
+			}
+		}
+	}
+	fclose(f);
+	return bOk;
+}
+
+_BOOLEAN
+CEPGStore::readAll(const string & path,
+				   map < time_t, CEPGProgramme > &progs) const
+{
+	FILE *f = fopen(path.c_str(), "rb");
+	if (f == NULL)
+		return FALSE;
+	vector < _BYTE > index;
+	uint32_t count = 0, datasize = 0;
+	bool bOk = readIndex(f, index, count, datasize);
+	if (bOk && datasize > 0)
+	{
+		vector < _BYTE > data(datasize);
+		bOk = fread(&data[0], 1, data.size(), f) == data.size();
+		CEPGStoreReader r(&data[0], data.size());
+		for (size_t i = 0; i < count && bOk; i++)
+		{
+			CEPGProgramme p;
+			bOk = getProgramme(r, p);
+			if (bOk)
+				progs[p.start()] = p;
+		}
+	}
+	fclose(f);
+	return bOk;
+}
+
+_BOOLEAN
+CEPGStore::writeAll(const string & path,
+					const map < time_t, CEPGProgramme > &progs) const
+{
+	string index, data;
+	for (map < time_t, CEPGProgramme >::const_iterator i = progs.begin();
+		 i != progs.end(); i++)
+	{
+		put64(index, i->first);
+		put32(index, uint32_t(data.size()));
+		putProgramme(data, i->second);
+	}
+	string header(EPG_STORE_MAGIC);
+	put32(header, EPG_STORE_VERSION);
+	put32(header, uint32_t(progs.size()));
+	put32(header, uint32_t(data.size()));
+
+	/* write a new file and move it into place, readers see the old or the
+	   new guide but never half of it */
+	const string tmp = path + ".tmp";
+	FILE *f = fopen(tmp.c_str(), "wb");
+	if (f == NULL)
+		return FALSE;
+	bool bOk = fwrite(header.data(), 1, header.size(), f) == header.size()
+		&& fwrite(index.data(), 1, index.size(), f) == index.size()
+		&& fwrite(data.data(), 1, data.size(), f) == data.size();
+	bOk = (fclose(f) == 0) && bOk;
+	if (!bOk)
+	{
+		remove(tmp.c_str());
+		return FALSE;
+	}
+#ifdef _WIN32
+	remove(path.c_str());
+#endif
+	return rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+void
+CEPGStore::SetDirectory(const string & strDir)
+{
+	if (strDir != strDirectory)
+	{
+		Flush(TRUE);
+		services.clear();
+		strDirectory = strDir;
+	}
+}
+
+_BOOLEAN
+CEPGStore::Update(uint32_t sid, const vector < CEPGProgramme > &progs)
+{
+	if (strDirectory == "" || progs.empty())
+		return FALSE;
+	CService & service = services[sid];
+	map < time_t, CEPGProgramme > &stored = service.progs;
+	if (!service.bLoaded)
+	{
+		readAll(fileName(sid), stored);
+		service.bLoaded = TRUE;
+	}
+
+	/* only keep a few days before the newest programme known */
+	time_t newest = stored.empty()? 0 : stored.rbegin()->first;
+	for (size_t i = 0; i < progs.size(); i++)
+		newest = max(newest, progs[i].start());
+	const time_t oldest = newest - EPG_STORE_RETENTION;
+
+	_BOOLEAN bChanged = FALSE;
+	for (size_t i = 0; i < progs.size(); i++)
+	{
+		CEPGProgramme p = progs[i];
+		const time_t start = p.start();
+		if (start == 0 || start < oldest)
+			continue;
+		map < time_t, CEPGProgramme >::iterator existing = stored.find(start);
+		if (existing == stored.end())
+		{
+			stored[start] = p;
+			bChanged = TRUE;
+		}
+		else
+		{
+			p.augment(existing->second);
+			if (p != existing->second)
+			{
+				existing->second = p;
+				bChanged = TRUE;
+			}
+		}
+	}
+
+	while (!stored.empty() && stored.begin()->first < oldest)
+	{
+		stored.erase(stored.begin());
+		bChanged = TRUE;
+	}
+
+	if (bChanged)
+	{
+		service.tLastChange = time(NULL);
+		if (service.tFirstChange == 0)
+			service.tFirstChange = service.tLastChange;
+	}
+	return bChanged;
+}
+
+void
+CEPGStore::Flush(_BOOLEAN bAll)
+{
+	const time_t now = time(NULL);
+	for (map < uint32_t, CService >::iterator i = services.begin();
+		 i != services.end(); i++)
+	{
+		CService & service = i->second;
+		if (service.tFirstChange == 0)
+			continue;
+		/* the clock may also have been set back */
+		if (!bAll && now >= service.tLastChange
+			&& now - service.tLastChange < EPG_STORE_FLUSH_IDLE
+			&& now - service.tFirstChange < EPG_STORE_FLUSH_MAX)
+			continue;
+		const string path = fileName(i->first);
+		mkdirs(path);
+		if (!writeAll(path, service.progs))
+			cerr << "EPG: could not write " << path << endl;
+		service.tFirstChange = 0;
+	}
+}
@@ -0,0 +1,97 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Store of decoded Electronic Programme Guide schedules
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef _EPGSTORE_H
+#define _EPGSTORE_H
+
+#include "epgbin.h"
+#include <map>
+
+/* Programmes starting this long before the newest one are dropped */
+#define EPG_STORE_RETENTION (8*24*60*60)
+/* Changes are written when no update came for this long, but at the latest
+   this long after the first unwritten change (seconds) */
+#define EPG_STORE_FLUSH_IDLE 5
+#define EPG_STORE_FLUSH_MAX 60
+
+/* The decoded schedules of all services. Each service has one file holding
+   its programmes sorted by start time, with an index of start times in
+   front, so the guide for a day is read with two seeks and without decoding
+   any EPG object again. Files are replaced atomically so the receiver can
+   update them while the guide reads them. Updates are merged in memory and
+   a service file is rewritten once per burst of EPG objects, not per
+   object */
+class CEPGStore
+{
+  public:
+
+    CEPGStore (const string & strDir = ""):strDirectory (strDir), services()
+    {
+    }
+    virtual ~CEPGStore ()
+    {
+	Flush (TRUE);
+    }
+
+    void SetDirectory (const string & strDir);
+
+    /* merge programmes of a service, TRUE if the stored guide changed */
+    _BOOLEAN Update (uint32_t sid, const vector < CEPGProgramme > &progs);
+    /* write the changed services which are due, or all of them */
+    void Flush (_BOOLEAN bAll = FALSE);
+
+    /* the programmes of a service starting in [from, to) */
+    _BOOLEAN Load (uint32_t sid, time_t from, time_t to,
+		   vector < CEPGProgramme > &progs) const;
+
+  protected:
+
+    string fileName (uint32_t sid) const;
+    _BOOLEAN readAll (const string & path,
+		      map < time_t, CEPGProgramme > &progs) const;
+    _BOOLEAN writeAll (const string & path,
+		       const map < time_t, CEPGProgramme > &progs) const;
+
+    class CService
+    {
+      public:
+	CService ():progs (), bLoaded (FALSE), tFirstChange (0),
+	    tLastChange (0)
+	{
+	}
+
+	map < time_t, CEPGProgramme > progs;
+	_BOOLEAN bLoaded;
+	time_t tFirstChange;	/* 0 if everything is written */
+	time_t tLastChange;
+    };
+
+    string strDirectory;
+    map < uint32_t, CService > services;
+};
+
+#endif
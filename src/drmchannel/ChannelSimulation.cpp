@@ -32,81 +32,273 @@
 /* Implementation *************************************************************/
 void CDRMChannel::ProcessDataInternal(CParameter&)
 {
-    int			i, j;
-    _COMPLEX	cCurTapSamp;
+    int i, j;
+    const int iNumTaps = Channel.GetNumTaps();
 
-    /* Save old values from the end of the vector */
-    for (i = 0; i < iMaxDelay; i++)
-        veccHistory[i] = veccHistory[i + iInputBlockSize];
+    for (i = 0; i < iInputBlockSize; i++)
+    {
+        vecrInRe[i] = (*pvecInputData)[i].real();
+        vecrInIm[i] = (*pvecInputData)[i].imag();
+    }
 
-    /* Write new symbol in memory */
-    for (i = iMaxDelay; i < iLenHist; i++)
-        veccHistory[i] = (*pvecInputData)[i - iMaxDelay];
+    /* Delay signal, add tap gains (fading) and doppler shift. Only the real
+       part of the output is needed */
+    Channel.Process(&vecrInRe[0], &vecrInIm[0], &vecrOutput[0], NULL,
+                    iInputBlockSize, iInputBlockSize);
+    const _REAL* prNoise = Channel.GetNoise();
 
-    /* Delay signal using history buffer, add tap gain (fading), multiply with
-       exp-function (optimized implementation, see below) to implement
-       doppler shift */
-    /* Direct path */
     for (i = 0; i < iInputBlockSize; i++)
     {
-        cCurTapSamp = tap[0].Update() * cCurExp[0];
+        /* Channel reference signal (without additional noise). The global
+           gain is already corrected, "* 2" due to the real-valued signal */
+        (*pvecOutputData)[i].tRef = vecrOutput[i] * 2;
 
-        veccOutput[i] =	veccHistory[i + iMaxDelay /* - 0 */] * cCurTapSamp;
+        /* Additional white Gaussian noise (AWGN) */
+        (*pvecOutputData)[i].tOut = vecrOutput[i] * 2 + prNoise[i] * rNoisepwrFactor;
 
-        /* Rotate exp-pointer one step further by complex multiplication with
-           precalculated rotation vector cExpStep. This saves us from
-           calling sin() and cos() functions all the time (iterative
-           calculation of these functions) */
-        cCurExp[0] *= cExpStep[0];
+        /* Input reference signal for channel estimation evaluation. "* 2" due
+           to the real-valued signal */
+        (*pvecOutputData)[i].tIn = vecrInRe[i] * 2;
 
-        /* Store the tap gain */
-        (*pvecOutputData)[i].veccTap[0] = cCurTapSamp;
+        /* Store the tap gains */
+        for (j = 0; j < iNumTaps; j++)
+            (*pvecOutputData)[i].veccTap[j] = Channel.GetTapGain(j, i);
     }
+}
+
+void CDRMChannel::InitInternal(CParameter& Parameters)
+{
+    Parameters.Lock();
+    const int iSampleRate = Parameters.GetSigSampleRate();
+    const int iSymbolBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
+
+    /* Set channel parameter according to selected channel number (table B.1).
+       Each instance gets its own random sequences */
+    const uint64_t iSeed = (uint64_t) time(NULL) ^ (uint64_t) (size_t) this;
+    Channel.Init(iSampleRate, Parameters.iDRMChannelNum,
+                 Parameters.iSpecChDoppler, iSymbolBlockSize, iSeed);
+
+    /* The paths and the noise are generated in parallel */
+    Channel.SetNumThreads(CWorkerPool::DefaultNumThreads(Channel.GetNumTaps() + 1));
+
+    /* Set number of taps, path delays and gain correction in global struct */
+    const int iNumTaps = Channel.GetNumTaps();
+    for (int i = 0; i < iNumTaps; i++)
+        Parameters.iPathDelay[i] = Channel.GetDelay(i);
+    Parameters.iNumTaps = iNumTaps;
+    Parameters.rGainCorr = Channel.GetGainCorr();
+
+    /* Memory allocation */
+    vecrInRe.Init(iSymbolBlockSize);
+    vecrInIm.Init(iSymbolBlockSize);
+    vecrOutput.Init(iSymbolBlockSize);
+
+
+    /* Calculate noise power factors for a given SNR ------------------------ */
+    /* Spectrum width (N / T_u) */
+    const _REAL rSpecOcc = (_REAL) Parameters.pCellMappingTable->iNumCarrier /
+                           Parameters.pCellMappingTable->iFFTSizeN * iSampleRate;
+
+    /* Bandwidth correction factor for noise (f_s / (2 * B))*/
+    const _REAL rBWFactor = (_REAL) iSampleRate / 2 / rSpecOcc;
+
+    /* Calculation of the gain factor for noise generator */
+    rNoisepwrFactor =
+        sqrt(pow((_REAL) 10.0, -Parameters.GetSystemSNRdB() / 10) *
+             Parameters.pCellMappingTable->rAvPowPerSymbol * 2 * rBWFactor);
 
-    /* Echos */
-    for (j = 1; j < iNumTaps; j++)
+    /* Define block-sizes for input and output */
+    iInputBlockSize = iSymbolBlockSize;
+    iOutputBlockSize = iSymbolBlockSize;
+    Parameters.Unlock();
+}
+
+CMultipathChannel::CMultipathChannel() : NoiseGen(), vecrNoise(), iSampleRate(0),
+    iNumTaps(0), iMaxDelay(0), iMaxBlockSize(0), rGainCorr((_REAL) 1.0),
+    vecrHistRe(), vecrHistIm(), iCurBlockSize(0), iCurNumNoise(0),
+    WorkerPool(), vecpTapTasks()
+{
+}
+
+CMultipathChannel::~CMultipathChannel()
+{
+}
+
+void CMultipathChannel::Init(const int iNewSampleRate, const int iChannelNum,
+                             const int iSpecChDoppler, const int iNewMaxBlockSize,
+                             const uint64_t iSeed)
+{
+    int i;
+
+    iSampleRate = iNewSampleRate;
+    iMaxBlockSize = iNewMaxBlockSize;
+
+    /* Independent random sequences for the noise and every path */
+    NoiseGen.Seed(iSeed);
+    for (i = 0; i < MAX_NUM_TAPS_DRM_CHAN; i++)
+        tap[i].Seed(iSeed + i + 1);
+
+    InitProfile(iChannelNum, iSpecChDoppler);
+
+    /* Init exponent steps (for doppler shift) and gain correction ---------- */
+    rGainCorr = (_REAL) 0.0;
+    iMaxDelay = 0;
+    for (i = 0; i < iNumTaps; i++)
     {
-        for (i = 0; i < iInputBlockSize; i++)
-        {
-            cCurTapSamp = tap[j].Update() * cCurExp[j];
+        /* Exponent function for shifting (doppler shift) */
+        cCurExp[i] = (_REAL) 1.0;
 
-            veccOutput[i] +=
-                veccHistory[i + iMaxDelay - tap[j].GetDelay()] * cCurTapSamp;
+        cExpStep[i] =
+            _COMPLEX(cos(tap[i].GetFShift()), sin(tap[i].GetFShift()));
+
+        /* Gain correction denominator */
+        rGainCorr += tap[i].GetGain() * tap[i].GetGain();
 
-            /* See above */
-            cCurExp[j] *= cExpStep[j];
+        if (tap[i].GetDelay() > iMaxDelay)
+            iMaxDelay = tap[i].GetDelay();
 
-            /* Store the tap gain */
-            (*pvecOutputData)[i].veccTap[j] = cCurTapSamp;
+        vecrTapI[i].Init(iMaxBlockSize);
+        vecrTapQ[i].Init(iMaxBlockSize);
+    }
+
+    /* Final gain correction value */
+    rGainCorr = (_REAL) 1.0 / sqrt(rGainCorr);
+
+
+    /* Memory allocation ---------------------------------------------------- */
+    /* Allocate memory for history, init vector with zeros. This history is used
+       for generating path delays */
+    vecrHistRe.Init(iMaxDelay + iMaxBlockSize, (_REAL) 0.0);
+    vecrHistIm.Init(iMaxDelay + iMaxBlockSize, (_REAL) 0.0);
+    iCurBlockSize = 0;
+
+    /* Complex noise at most */
+    vecrNoise.Init(2 * iMaxBlockSize);
+
+    /* One task per path and one for the noise */
+    vecpTapTasks.resize(iNumTaps + 1);
+    for (i = 0; i <= iNumTaps; i++)
+    {
+        TapTask[i].pChannel = this;
+        TapTask[i].iTap = i;
+        vecpTapTasks[i] = &TapTask[i];
+    }
+}
+
+void CMultipathChannel::Process(const _REAL* prInRe, const _REAL* prInIm,
+                                _REAL* prOutRe, _REAL* prOutIm,
+                                const int iLen, const int iNumNoise)
+{
+    int i, j;
+
+    /* Save old values from the end of the history */
+    for (i = 0; i < iMaxDelay; i++)
+    {
+        vecrHistRe[i] = vecrHistRe[i + iCurBlockSize];
+        vecrHistIm[i] = vecrHistIm[i + iCurBlockSize];
+    }
+
+    /* Write new block in memory */
+    for (i = 0; i < iLen; i++)
+    {
+        vecrHistRe[iMaxDelay + i] = prInRe[i];
+        vecrHistIm[iMaxDelay + i] = prInIm[i];
+    }
+
+    iCurBlockSize = iLen;
+    iCurNumNoise = iNumNoise;
+
+    /* Tap gains of all paths and the noise, they do not share any data */
+    if (WorkerPool.GetNumThreads() > 0)
+        WorkerPool.Run(vecpTapTasks);
+    else
+    {
+        for (j = 0; j <= iNumTaps; j++)
+            GenTap(j);
+    }
+
+    /* Sum of the delayed and weighted paths */
+    for (i = 0; i < iLen; i++)
+        prOutRe[i] = (_REAL) 0.0;
+    if (prOutIm != NULL)
+    {
+        for (i = 0; i < iLen; i++)
+            prOutIm[i] = (_REAL) 0.0;
+    }
+
+    for (j = 0; j < iNumTaps; j++)
+    {
+        const _REAL* prHistRe = &vecrHistRe[iMaxDelay - tap[j].GetDelay()];
+        const _REAL* prHistIm = &vecrHistIm[iMaxDelay - tap[j].GetDelay()];
+        const _REAL* prTapI = &vecrTapI[j][0];
+        const _REAL* prTapQ = &vecrTapQ[j][0];
+
+        for (i = 0; i < iLen; i++)
+            prOutRe[i] += prHistRe[i] * prTapI[i] - prHistIm[i] * prTapQ[i];
+
+        if (prOutIm != NULL)
+        {
+            for (i = 0; i < iLen; i++)
+                prOutIm[i] += prHistRe[i] * prTapQ[i] + prHistIm[i] * prTapI[i];
         }
     }
 
-    /* Get real output vector and correct global gain */
-    for (i = 0; i < iInputBlockSize; i++)
-        (*pvecOutputData)[i].tOut = veccOutput[i].real() * rGainCorr;
+    /* Correct global gain */
+    for (i = 0; i < iLen; i++)
+        prOutRe[i] *= rGainCorr;
+    if (prOutIm != NULL)
+    {
+        for (i = 0; i < iLen; i++)
+            prOutIm[i] *= rGainCorr;
+    }
+}
 
-    /* Additional white Gaussian noise (AWGN) */
-    for (i = 0; i < iInputBlockSize; i++)
-        (*pvecOutputData)[i].tOut += randn() * rNoisepwrFactor;
+void CMultipathChannel::GenTap(const int iTap)
+{
+    if (iTap == iNumTaps)
+    {
+        NoiseGen.randn(&vecrNoise[0], iCurNumNoise);
+        return;
+    }
 
+    _REAL* prI = &vecrTapI[iTap][0];
+    _REAL* prQ = &vecrTapQ[iTap][0];
 
-    /* Reference signals for channel estimation evaluation ------------------ */
-    /* Input reference signal. "* 2" due to the real-valued signal */
-    for (i = 0; i < iInputBlockSize; i++)
-        (*pvecOutputData)[i].tIn = (*pvecInputData)[i].real() * 2;
+    /* Tap gain (fading) */
+    tap[iTap].UpdateBlock(prI, prQ, iCurBlockSize);
 
-    /* Channel reference signal (without additional noise) */
-    for (i = 0; i < iInputBlockSize; i++)
-        (*pvecOutputData)[i].tRef = veccOutput[i].real() * rGainCorr;
+    if (tap[iTap].GetFShift() == (_REAL) 0.0)
+        return;
+
+    /* Multiply with exp-function to implement doppler shift. The exp-pointer
+       is rotated one step further by complex multiplication with the
+       precalculated rotation vector cExpStep. This saves us from calling
+       sin() and cos() functions all the time */
+    _REAL rExpRe = cCurExp[iTap].real();
+    _REAL rExpIm = cCurExp[iTap].imag();
+    const _REAL rStepRe = cExpStep[iTap].real();
+    const _REAL rStepIm = cExpStep[iTap].imag();
+
+    for (int i = 0; i < iCurBlockSize; i++)
+    {
+        const _REAL rI = prI[i];
+        const _REAL rQ = prQ[i];
+        prI[i] = rI * rExpRe - rQ * rExpIm;
+        prQ[i] = rI * rExpIm + rQ * rExpRe;
+
+        const _REAL rNewExpRe = rExpRe * rStepRe - rExpIm * rStepIm;
+        rExpIm = rExpRe * rStepIm + rExpIm * rStepRe;
+        rExpRe = rNewExpRe;
+    }
+
+    cCurExp[iTap] = _COMPLEX(rExpRe, rExpIm);
 }
 
-void CDRMChannel::InitInternal(CParameter& Parameters)
+void CMultipathChannel::InitProfile(const int iChannelNum, const int iSpecChDoppler)
 {
-    Parameters.Lock();
-    iSampleRate = Parameters.GetSigSampleRate();
-    /* Set channel parameter according to selected channel number (table B.1) */
-    switch (Parameters.iDRMChannelNum)
+    switch (iChannelNum)
     {
+    default:
     case 1:
         /* AWGN */
         iNumTaps = 1;
@@ -286,7 +478,7 @@ void CDRMChannel::InitInternal(CParameter& Parameters)
 	/* Delay: */	(_REAL) 0.0,
                                  /* Gain: */		(_REAL) 1.0,
                                  /* Fshift: */	(_REAL) 0.0,
-                                 /* Fd: */		(_REAL) Parameters.iSpecChDoppler);
+                                 /* Fd: */		(_REAL) iSpecChDoppler);
         break;
 
     case 9:
@@ -316,7 +508,7 @@ void CDRMChannel::InitInternal(CParameter& Parameters)
 		/* Sample Rate */	iSampleRate,
 	/* Delay: */	(_REAL) 0.0,
                                  /* Gain: */		(_REAL) 1.0,
-                                 /* Fshift: */	(_REAL) Parameters.iSpecChDoppler,
+                                 /* Fshift: */	(_REAL) iSpecChDoppler,
                                  /* Fd: */		(_REAL) 0.0);
         break;
 
@@ -329,14 +521,14 @@ void CDRMChannel::InitInternal(CParameter& Parameters)
 	/* Delay: */	(_REAL) 0.0,
                                  /* Gain: */		(_REAL) 1.0,
                                  /* Fshift: */	(_REAL) 0.0,
-                                 /* Fd: */		(_REAL) Parameters.iSpecChDoppler);
+                                 /* Fd: */		(_REAL) iSpecChDoppler);
 
         tap[1].Init(
 		/* Sample Rate */	iSampleRate,
 	/* Delay: */	(_REAL) 4.0,
                                  /* Gain: */		(_REAL) 1.0,
                                  /* Fshift: */	(_REAL) 0.0,
-                                 /* Fd: */		(_REAL) Parameters.iSpecChDoppler);
+                                 /* Fd: */		(_REAL) iSpecChDoppler);
         break;
 
     case 12:
@@ -349,70 +541,11 @@ void CDRMChannel::InitInternal(CParameter& Parameters)
 	/* Delay: */	(_REAL) 0.0,
                                  /* Gain: */		(_REAL) 1.0,
                                  /* Fshift: */	(_REAL) 0.0,
-                                 /* Fd: */		(_REAL) Parameters.iSpecChDoppler);
+                                 /* Fd: */		(_REAL) iSpecChDoppler);
         break;
     }
 
 
-    /* Init exponent steps (for doppler shift) and gain correction ---------- */
-    rGainCorr = (_REAL) 0.0;
-    for (int i = 0; i < iNumTaps; i++)
-    {
-        /* Exponent function for shifting (doppler shift) */
-        cCurExp[i] = (_REAL) 1.0;
-
-        cExpStep[i] =
-            _COMPLEX(cos(tap[i].GetFShift()), sin(tap[i].GetFShift()));
-
-        /* Gain correction denominator */
-        rGainCorr += tap[i].GetGain() * tap[i].GetGain();
-
-        /* Get path delays for global struct */
-        Parameters.iPathDelay[i] = tap[i].GetDelay();
-    }
-
-    /* Final gain correction value. "* 2" due to the real-valued signals */
-    rGainCorr = (_REAL) 1.0 / sqrt(rGainCorr) * 2;
-
-    /* Set number of taps and gain correction in global struct */
-    Parameters.iNumTaps = iNumTaps;
-    Parameters.rGainCorr = rGainCorr / 2;
-
-
-    /* Memory allocation ---------------------------------------------------- */
-    /* Maximum delay */
-    iMaxDelay = tap[iNumTaps - 1].GetDelay();
-
-    /* Allocate memory for history, init vector with zeros. This history is used
-       for generating path delays */
-    iLenHist = Parameters.CellMappingTable.iSymbolBlockSize + iMaxDelay;
-    veccHistory.Init(iLenHist, _COMPLEX((_REAL) 0.0, (_REAL) 0.0));
-
-    /* Allocate memory for temporary output vector for complex values */
-    veccOutput.Init(Parameters.CellMappingTable.iSymbolBlockSize);
-
-
-    /* Calculate noise power factors for a given SNR ------------------------ */
-    /* Spectrum width (N / T_u) */
-    const _REAL rSpecOcc = (_REAL) Parameters.CellMappingTable.iNumCarrier /
-                           Parameters.CellMappingTable.iFFTSizeN * iSampleRate;
-
-    /* Bandwidth correction factor for noise (f_s / (2 * B))*/
-    const _REAL rBWFactor = (_REAL) iSampleRate / 2 / rSpecOcc;
-
-    /* Calculation of the gain factor for noise generator */
-    rNoisepwrFactor =
-        sqrt(pow((_REAL) 10.0, -Parameters.GetSystemSNRdB() / 10) *
-             Parameters.CellMappingTable.rAvPowPerSymbol * 2 * rBWFactor);
-
-
-    /* Set seed of random noise generator */
-    srand((unsigned) time(NULL));
-
-    /* Define block-sizes for input and output */
-    iInputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
-    iOutputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
-    Parameters.Unlock();
 }
 
 void CTapgain::Init(int iNewSampleRate, _REAL rNewDelay, _REAL rNewGain, _REAL rNewFshift,
@@ -429,6 +562,9 @@ void CTapgain::Init(int iNewSampleRate, _REAL rNewDelay, _REAL rNewGain, _REAL r
     fshift = NormShift(rNewFshift);
     fd = rNewFd;
 
+    /* Weight with gain */
+    outgain = gain / sqrt((_REAL) 2.0);
+
     s = (_REAL) 0.5 * fd / samplerate;
 
     /* If tap is not fading, return function */
@@ -437,9 +573,10 @@ void CTapgain::Init(int iNewSampleRate, _REAL rNewDelay, _REAL rNewGain, _REAL r
 
     if (s > 0.03)
     {
+        /* Plain FIR, a new noise sample for every output */
         interpol = 0;
         polyinterpol = 1;
-        phase = -1;
+        phase = 0;
     }
     else
     {
@@ -478,106 +615,120 @@ void CTapgain::Init(int iNewSampleRate, _REAL rNewDelay, _REAL rNewGain, _REAL r
 
     gausstp(taps, s, polyinterpol);
 
+    /* Sort the coefficients of each phase in the order of the FIR buffer */
+    for (int p = 0; p < polyinterpol; p++)
+    {
+        for (k = 0; k < FIRLENGTH; k++)
+            phasetaps[p][k] = taps[polyinterpol * (FIRLENGTH - k) - p - 1];
+    }
+
     /* Initialize FIR buffer */
     for (k = 0; k < FIRLENGTH; k++)
     {
-        fir_buff[k][0] = randn();
-        fir_buff[k][1] = randn();
+        fir_buffI[k] = fir_buffI[k + FIRLENGTH] = randn();
+        fir_buffQ[k] = fir_buffQ[k + FIRLENGTH] = randn();
     }
 
+    /* Compute nextI and nextQ */
+    nextI = (_REAL) 0.0;
+    nextQ = (_REAL) 0.0;
+
     if (interpol)
     {
-        /* Compute nextI and nextQ */
-        nextI = (_REAL) 0.0;
-        nextQ = (_REAL) 0.0;
-
         /* FIR filter */
         for (k = 0; k < FIRLENGTH; k++)
         {
-            nextI += fir_buff[k][0] * taps[FIRLENGTH - k - 1];
-            nextQ += fir_buff[k][1] * taps[FIRLENGTH - k - 1];
+            nextI += fir_buffI[k] * taps[FIRLENGTH - k - 1];
+            nextQ += fir_buffQ[k] * taps[FIRLENGTH - k - 1];
         }
     }
 
+    lastI = nextI;
+    lastQ = nextQ;
     over_cnt = 0;
     fir_index = 0;
 }
 
 _COMPLEX CTapgain::Update()
 {
-    int			k;
-    _COMPLEX	out;
+    _REAL rI, rQ;
+    UpdateBlock(&rI, &rQ, 1);
+    return _COMPLEX(rI, rQ);
+}
+
+void CTapgain::PushNoise()
+{
+    /* The newest sample is written to both copies of the FIR buffer */
+    const _REAL rI = randn();
+    const _REAL rQ = randn();
+    fir_buffI[fir_index] = fir_buffI[fir_index + FIRLENGTH] = rI;
+    fir_buffQ[fir_index] = fir_buffQ[fir_index + FIRLENGTH] = rQ;
+
+    if (--fir_index < 0)
+        fir_index = FIRLENGTH - 1;
+}
+
+void CTapgain::UpdateBlock(_REAL* prI, _REAL* prQ, const int iLen)
+{
+    int i, k;
 
     /* If tap is not fading, just return gain */
     if (fd == (_REAL) 0.0)
-        return gain;
-
-    /* Over_cnt is always zero if no interpolation is used */
-    if (!over_cnt)
     {
-        lastI = nextI;
-        lastQ = nextQ;
+        for (i = 0; i < iLen; i++)
+        {
+            prI[i] = gain;
+            prQ[i] = (_REAL) 0.0;
+        }
+        return;
+    }
 
-        /* Get new noise sample */
-        if ((phase == -1) || (phase == 0))
+    for (i = 0; i < iLen; i++)
+    {
+        /* Over_cnt is always zero if no interpolation is used */
+        if (!over_cnt)
         {
-            fir_buff[fir_index][0] = randn();
-            fir_buff[fir_index][1] = randn();
+            lastI = nextI;
+            lastQ = nextQ;
 
-            fir_index = (fir_index - 1 + FIRLENGTH) % FIRLENGTH;
-        }
+            /* Get new noise sample */
+            if (phase == 0)
+                PushNoise();
 
-        /* Compute new filter output */
-        nextI = (_REAL) 0.0;
-        nextQ = (_REAL) 0.0;
+            /* Compute new filter output (polyphase FIR) */
+            const _REAL* prTaps = phasetaps[phase];
+            const _REAL* prBufI = &fir_buffI[fir_index];
+            const _REAL* prBufQ = &fir_buffQ[fir_index];
+            _REAL rSumI = (_REAL) 0.0;
+            _REAL rSumQ = (_REAL) 0.0;
 
-        if (phase == -1)
-        {
-            /* FIR */
             for (k = 0; k < FIRLENGTH; k++)
             {
-                nextI +=
-                    fir_buff[(k + fir_index) % FIRLENGTH][0] *
-                    taps[FIRLENGTH - k - 1];
-                nextQ +=
-                    fir_buff[(k + fir_index) % FIRLENGTH][1] *
-                    taps[FIRLENGTH - k - 1];
+                rSumI += prBufI[k] * prTaps[k];
+                rSumQ += prBufQ[k] * prTaps[k];
             }
+            nextI = rSumI;
+            nextQ = rSumQ;
+
+            if (++phase == polyinterpol)
+                phase = 0;
         }
-        else
+
+        if (interpol)
         {
-            /* Polyphase FIR with interpolation */
-            for (k = 0; k < FIRLENGTH; k++)
-            {
-                nextI +=
-                    fir_buff[(k + fir_index) % FIRLENGTH][0] *
-                    taps[polyinterpol * (FIRLENGTH - k) - phase - 1];
-                nextQ +=
-                    fir_buff[(k + fir_index) % FIRLENGTH][1] *
-                    taps[polyinterpol * (FIRLENGTH - k) - phase - 1];
-            }
+            /* Linear interpolation */
+            prI[i] = ((nextI - lastI) * (_REAL) over_cnt / interpol + lastI) * outgain;
+            prQ[i] = ((nextQ - lastQ) * (_REAL) over_cnt / interpol + lastQ) * outgain;
 
-            phase = (phase + 1) % polyinterpol;
+            if (++over_cnt == interpol)
+                over_cnt = 0;
+        }
+        else
+        {
+            prI[i] = nextI * outgain;
+            prQ[i] = nextQ * outgain;
         }
     }
-
-    if (interpol)
-    {
-        /* Linear interpolation */
-        out  = _COMPLEX((nextI - lastI) * (_REAL) over_cnt /
-                        interpol + lastI,
-                        (nextQ - lastQ) * (_REAL) over_cnt /
-                        interpol + lastQ);
-
-        if (++over_cnt == interpol)
-            over_cnt = 0;
-    }
-    else
-        out = _COMPLEX(nextI, nextQ);
-
-    /* Weight with gain */
-    const _REAL ccGainCorr = sqrt((_REAL) 2.0);
-    return out * gain / ccGainCorr;
 }
 
 void CTapgain::gausstp(_REAL taps[], _REAL& s, int& over) const
@@ -606,18 +757,70 @@ _REAL CTapgain::NormShift(const _REAL rShift) const
     return (_REAL) 2.0 * crPi / samplerate * rShift;
 }
 
-_REAL CChannelSim::randn() const
+void CChannelSim::Seed(const uint64_t iSeed)
 {
-    const int iNoRand = 10;
-    const _REAL rFactor = (_REAL) sqrt((_REAL) 12.0 / iNoRand) / RAND_MAX;
-    const int iRandMaxHalf = RAND_MAX / 2;
-
-    /* Add some constant distributed random processes to get Gaussian
-       distribution */
-    _REAL rNoise = 0;
-    for (int i = 0; i < iNoRand; i++)
-        rNoise += rand() - iRandMaxHalf;
-
-    /* Apply amplification factor */
-    return rNoise * rFactor;
+    /* Spread the seed over the state (splitmix64), similar seeds give
+       unrelated sequences then */
+    uint64_t z = iSeed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    iRandState = z ^ (z >> 31);
+
+    /* The generator must not start with zero */
+    if (iRandState == 0)
+        iRandState = 0x9E3779B97F4A7C15ULL;
+
+    bHaveSpare = FALSE;
+}
+
+_REAL CChannelSim::randu()
+{
+    /* xorshift64* generator, the upper 53 bits give the mantissa */
+    iRandState ^= iRandState >> 12;
+    iRandState ^= iRandState << 25;
+    iRandState ^= iRandState >> 27;
+    const uint64_t iRand = iRandState * 0x2545F4914F6CDD1DULL;
+
+    return (_REAL) ((iRand >> 11) + 1) * ((_REAL) 1.0 / 9007199254740992.0);
+}
+
+_REAL CChannelSim::randn()
+{
+    /* Box-Muller method, gives two independent samples per call */
+    if (bHaveSpare == TRUE)
+    {
+        bHaveSpare = FALSE;
+        return rSpare;
+    }
+
+    const _REAL rRadius = sqrt((_REAL) -2.0 * log(randu()));
+    const _REAL rAngle = (_REAL) 2.0 * crPi * randu();
+
+    rSpare = rRadius * sin(rAngle);
+    bHaveSpare = TRUE;
+
+    return rRadius * cos(rAngle);
+}
+
+void CChannelSim::randn(_REAL* prOut, const int iLen)
+{
+    int i = 0;
+
+    if (bHaveSpare == TRUE && iLen > 0)
+    {
+        bHaveSpare = FALSE;
+        prOut[i++] = rSpare;
+    }
+
+    for (; i + 1 < iLen; i += 2)
+    {
+        const _REAL rRadius = sqrt((_REAL) -2.0 * log(randu()));
+        const _REAL rAngle = (_REAL) 2.0 * crPi * randu();
+
+        prOut[i] = rRadius * cos(rAngle);
+        prOut[i + 1] = rRadius * sin(rAngle);
+    }
+
+    if (i < iLen)
+        prOut[i] = randn();
 }
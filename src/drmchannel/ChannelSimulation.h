@@ -31,20 +31,38 @@
 
 #include "../Parameter.h"
 #include "../util/Modul.h"
+#include "../util/WorkerPool.h"
 #include <time.h>
 
 
 /* Definitions ****************************************************************/
 #define FIRLENGTH					24
+/* Maximum polyphase interpolation factor of the tap gain generator */
+#define MAX_POLY_INTERPOL			8
 
 #define fsqr(a)						((a) * (a))
 
 
 /* Classes ********************************************************************/
+/* Gaussian noise source. Every object has its own generator state, so
+   objects can be used from different threads */
 class CChannelSim
 {
 public:
-    inline _REAL randn() const;
+    CChannelSim() : iRandState(0), bHaveSpare(FALSE), rSpare((_REAL) 0.0) {Seed(0);}
+
+    void Seed(const uint64_t iSeed);
+
+    inline _REAL randn();
+    /* Block of "iLen" independent samples */
+    void randn(_REAL* prOut, const int iLen);
+
+protected:
+    inline _REAL randu(); /* uniform in (0, 1] */
+
+    uint64_t	iRandState;
+    _BOOLEAN	bHaveSpare;
+    _REAL		rSpare;
 };
 
 class CTapgain : public CChannelSim
@@ -52,6 +70,8 @@ class CTapgain : public CChannelSim
 public:
     void Init(int iNewSampleRate, _REAL rNewDelay, _REAL rNewGain, _REAL rNewFshift, _REAL rNewFd);
     _COMPLEX Update();
+    /* Tap gains of the next "iLen" samples, without the Doppler shift */
+    void UpdateBlock(_REAL* prI, _REAL* prQ, const int iLen);
     _REAL GetGain() const {
         return gain;
     }
@@ -64,15 +84,20 @@ public:
 
 
 protected:
-    _REAL		taps[FIRLENGTH * 8]; /* FIR filter coefficients */
+    _REAL		taps[FIRLENGTH * MAX_POLY_INTERPOL]; /* FIR filter coefficients */
+    /* Coefficients in the order of the FIR buffer, one row per phase */
+    _REAL		phasetaps[MAX_POLY_INTERPOL][FIRLENGTH];
     int			over_cnt;		/* Counter for oversampling */
     int			phase;			/* Phase for polyphase oversampling */
     int			interpol;		/* interpolation factor for linear interpolation*/
     int			polyinterpol;	/* interpolation factor for polyphase interpolation */
     int			fir_index;		/* index to FIR buffer */
-    _REAL		fir_buff[FIRLENGTH][2]; /* FIR buffer */
+    /* FIR buffer, stored twice so that the filter needs no index wrapping */
+    _REAL		fir_buffI[2 * FIRLENGTH];
+    _REAL		fir_buffQ[2 * FIRLENGTH];
     _REAL		lastI, lastQ;	/* last FIR output, needed for interpolation */
     _REAL		nextI, nextQ;	/* next FIR output */
+    _REAL		outgain;		/* gain / sqrt(2) */
 
     _REAL fd;					/* Fading rate */
     _REAL fshift;				/* Doppler shift */
@@ -83,33 +108,115 @@ protected:
     int		DelMs2Sam(const _REAL rDelay) const;
     _REAL	NormShift(const _REAL rShift) const;
     void	gausstp(_REAL taps[], _REAL& s, int& over) const;
+    void	PushNoise();
+};
+
+/* Multipath channel of table B.1 without any DRM specific parameters, so it
+   can be used on any I/Q signal. The tap gains of the paths and the noise
+   are generated in parallel by a worker pool, the paths are summed up with
+   real valued arithmetic the compiler can vectorize */
+class CMultipathChannel
+{
+public:
+    CMultipathChannel();
+    virtual ~CMultipathChannel();
+
+    /* "iChannelNum" according to table B.1 (1 ... 6) or the own test channels
+       (7 ... 12), "iSpecChDoppler" is used by some of the test channels */
+    void Init(const int iNewSampleRate, const int iChannelNum,
+              const int iSpecChDoppler, const int iNewMaxBlockSize,
+              const uint64_t iSeed);
+
+    /* Number of additional threads, 0: everything in the calling thread */
+    void SetNumThreads(const int iNumThreads) {
+        WorkerPool.SetNumThreads(iNumThreads);
+    }
+
+    /* Runs the channel on "iLen" samples. The output is normalized to the
+       input power, without noise. "prOutIm" may be NULL if only the real part
+       is needed. "iNumNoise" unit variance noise samples are generated, too */
+    void Process(const _REAL* prInRe, const _REAL* prInIm, _REAL* prOutRe,
+                 _REAL* prOutIm, const int iLen, const int iNumNoise);
+
+    const _REAL* GetNoise() {
+        return &vecrNoise[0];
+    }
+    /* Tap gains of the last block including Doppler shift, without gain
+       correction */
+    _COMPLEX GetTapGain(const int iTap, const int i) const {
+        return _COMPLEX(vecrTapI[iTap][i], vecrTapQ[iTap][i]);
+    }
+
+    int GetNumTaps() const {
+        return iNumTaps;
+    }
+    int GetDelay(const int iTap) const {
+        return tap[iTap].GetDelay();
+    }
+    /* Gain correction to keep the power of the input signal */
+    _REAL GetGainCorr() const {
+        return rGainCorr;
+    }
+
+protected:
+    /* One path or the noise (iTap == iNumTaps) */
+    class CTapTask : public CWorkerTask
+    {
+    public:
+        CTapTask() : pChannel(NULL), iTap(0) {}
+        virtual void Run() {pChannel->GenTap(iTap);}
+
+        CMultipathChannel*	pChannel;
+        int					iTap;
+    };
+
+    void InitProfile(const int iChannelNum, const int iSpecChDoppler);
+    void GenTap(const int iTap);
+
+    CTapgain			tap[MAX_NUM_TAPS_DRM_CHAN];
+    _COMPLEX			cCurExp[MAX_NUM_TAPS_DRM_CHAN];
+    _COMPLEX			cExpStep[MAX_NUM_TAPS_DRM_CHAN];
+    CVector<_REAL>		vecrTapI[MAX_NUM_TAPS_DRM_CHAN];
+    CVector<_REAL>		vecrTapQ[MAX_NUM_TAPS_DRM_CHAN];
+    CChannelSim			NoiseGen;
+    CVector<_REAL>		vecrNoise;
+
+    int					iSampleRate;
+    int					iNumTaps;
+    int					iMaxDelay;
+    int					iMaxBlockSize;
+    _REAL				rGainCorr;
+
+    /* Input history, the last "iMaxDelay" samples followed by the block */
+    CVector<_REAL>		vecrHistRe;
+    CVector<_REAL>		vecrHistIm;
+
+    /* Block in work, for the tasks */
+    int					iCurBlockSize;
+    int					iCurNumNoise;
+
+    CWorkerPool			WorkerPool;
+    CTapTask			TapTask[MAX_NUM_TAPS_DRM_CHAN + 1];
+    vector<CWorkerTask*>	vecpTapTasks;
 };
 
 class CDRMChannel :
             /* The third template argument "_COMPLEX" is not used since this module
                has only one input and one output buffer */
-            public CSimulationModul<_COMPLEX, CChanSimDataMod, _COMPLEX>, CChannelSim
+            public CSimulationModul<_COMPLEX, CChanSimDataMod, _COMPLEX>
 {
 public:
     CDRMChannel() {}
     virtual ~CDRMChannel() {}
 
 protected:
-    CTapgain			tap[4];
-    _COMPLEX			cCurExp[4];
-    _COMPLEX			cExpStep[4];
+    CMultipathChannel	Channel;
 
-    int					iSampleRate;
-    int					iNumTaps;
-    CVector<_COMPLEX>	veccHistory;
-    int					iMaxDelay;
-    int					iLenHist;
-    CVector<_COMPLEX>	veccOutput;
-    _REAL				rGainCorr;
+    CVector<_REAL>		vecrInRe;
+    CVector<_REAL>		vecrInIm;
+    CVector<_REAL>		vecrOutput;
     _REAL				rNoisepwrFactor;
 
-    void InitTapgain(CTapgain& tapg);
-
     virtual void InitInternal(CParameter& Parameters);
     virtual void ProcessDataInternal(CParameter& Parameters);
 };
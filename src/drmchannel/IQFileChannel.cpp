@@ -0,0 +1,220 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Runs a recorded or generated I/Q file through one of the simulation
+ *	channels, without a receiver. The file is read twice: first to measure
+ *	the signal power for the noise level, then for the actual processing.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "IQFileChannel.h"
+#include <string.h>
+#include <time.h>
+
+
+/* Implementation *************************************************************/
+void CIQFileChannel::Process(const string& strInFile, const string& strOutFile,
+							 const int iChannelNum, const _REAL rSNRdB,
+							 const int iRawSampleRate)
+{
+	int i, iLen;
+
+	Open(strInFile, iRawSampleRate);
+
+	vecsData.Init(2 * IQ_CHAN_BLOCK_SIZE);
+	vecrRe.Init(IQ_CHAN_BLOCK_SIZE);
+	vecrIm.Init(IQ_CHAN_BLOCK_SIZE);
+	vecrOutRe.Init(IQ_CHAN_BLOCK_SIZE);
+	vecrOutIm.Init(IQ_CHAN_BLOCK_SIZE);
+
+	/* The noise covers the whole sample rate, half of it in I and in Q */
+	const _REAL rPower = MeasurePower();
+	const _REAL rNoiseStd = sqrt(rPower * pow((_REAL) 10.0, -rSNRdB / 10) *
+		iSampleRate / IQ_CHAN_NOM_BANDWIDTH / 2);
+
+	Channel.Init(iSampleRate, iChannelNum, IQ_CHAN_SPEC_DOPPLER,
+		IQ_CHAN_BLOCK_SIZE, (uint64_t) time(NULL));
+	Channel.SetNumThreads(CWorkerPool::DefaultNumThreads(Channel.GetNumTaps() + 1));
+
+	/* Output in the format of the input */
+	CWaveFile WaveOut;
+	FILE* pFileOut = NULL;
+	if (bWave == TRUE)
+		WaveOut.Open(strOutFile, iSampleRate);
+	else
+		pFileOut = fopen(strOutFile.c_str(), "wb");
+
+	if (WaveOut.IsOpen() == FALSE && pFileOut == NULL)
+	{
+		Close();
+		throw CGenErr("The file " + strOutFile + " cannot be created.");
+	}
+
+	Rewind();
+	while ((iLen = Read()) > 0)
+	{
+		for (i = 0; i < iLen; i++)
+		{
+			vecrRe[i] = vecsData[2 * i];
+			vecrIm[i] = vecsData[2 * i + 1];
+		}
+
+		Channel.Process(&vecrRe[0], &vecrIm[0], &vecrOutRe[0], &vecrOutIm[0],
+			iLen, 2 * iLen);
+		const _REAL* prNoise = Channel.GetNoise();
+
+		for (i = 0; i < iLen; i++)
+		{
+			vecsData[2 * i] = Real2Sample(vecrOutRe[i] + prNoise[2 * i] * rNoiseStd);
+			vecsData[2 * i + 1] =
+				Real2Sample(vecrOutIm[i] + prNoise[2 * i + 1] * rNoiseStd);
+		}
+
+		if (bWave == TRUE)
+			WaveOut.AddSamples(&vecsData[0], 2 * iLen);
+		else
+			(void)fwrite(&vecsData[0], sizeof(_SAMPLE), size_t(2 * iLen), pFileOut);
+	}
+
+	if (pFileOut != NULL)
+		fclose(pFileOut);
+	WaveOut.Close();
+	Close();
+}
+
+void CIQFileChannel::Open(const string& strInFile, const int iRawSampleRate)
+{
+	Close();
+
+	pFileIn = fopen(strInFile.c_str(), "rb");
+	if (pFileIn == NULL)
+		throw CGenErr("The file " + strInFile + " cannot be opened.");
+
+	char cId[4];
+	iSampleRate = iRawSampleRate;
+	iDataBytes = 0xFFFFFFFF; /* raw: up to the end of the file */
+	bWave = fread(cId, 1, 4, pFileIn) == 4 && memcmp(cId, "RIFF", 4) == 0;
+
+	if (bWave == TRUE)
+	{
+		/* Skip the length and "WAVE", then search the chunks */
+		_BOOLEAN bFormatOk = FALSE;
+		fseek(pFileIn, 12, SEEK_SET);
+		for (;;)
+		{
+			uint32_t iLen;
+			if (fread(cId, 1, 4, pFileIn) != 4 || fread(&iLen, 4, 1, pFileIn) != 1)
+			{
+				Close();
+				throw CGenErr("The file " + strInFile + " has no wave data.");
+			}
+
+			if (memcmp(cId, "fmt ", 4) == 0 && iLen >= 16)
+			{
+				uint16_t iFormatTag, iChannels, iBlockAlign, iBitsPerSample;
+				uint32_t iRate, iAvgBytesPerSec;
+				(void)fread(&iFormatTag, 2, 1, pFileIn);
+				(void)fread(&iChannels, 2, 1, pFileIn);
+				(void)fread(&iRate, 4, 1, pFileIn);
+				(void)fread(&iAvgBytesPerSec, 4, 1, pFileIn);
+				(void)fread(&iBlockAlign, 2, 1, pFileIn);
+				(void)fread(&iBitsPerSample, 2, 1, pFileIn);
+				bFormatOk = iFormatTag == 1 && iChannels == 2 &&
+					iBitsPerSample == 16;
+				iSampleRate = (int) iRate;
+				fseek(pFileIn, long(((iLen + 1) & ~1u) - 16), SEEK_CUR);
+			}
+			else if (memcmp(cId, "data", 4) == 0)
+			{
+				iDataBytes = iLen;
+				break;
+			}
+			else /* chunks are padded to an even length */
+				fseek(pFileIn, long((iLen + 1) & ~1u), SEEK_CUR);
+		}
+
+		if (bFormatOk == FALSE)
+		{
+			Close();
+			throw CGenErr("The file " + strInFile +
+				" is not a 16 bit stereo wave file.");
+		}
+	}
+	else
+		fseek(pFileIn, 0, SEEK_SET);
+
+	iDataStart = ftell(pFileIn);
+	iBytesLeft = iDataBytes;
+}
+
+void CIQFileChannel::Close()
+{
+	if (pFileIn != NULL)
+	{
+		fclose(pFileIn);
+		pFileIn = NULL;
+	}
+}
+
+void CIQFileChannel::Rewind()
+{
+	fseek(pFileIn, iDataStart, SEEK_SET);
+	iBytesLeft = iDataBytes;
+}
+
+int CIQFileChannel::Read()
+{
+	/* Stereo samples of 4 bytes */
+	uint32_t iNum = iBytesLeft / 4;
+	if (iNum > IQ_CHAN_BLOCK_SIZE)
+		iNum = IQ_CHAN_BLOCK_SIZE;
+
+	const size_t iRead =
+		fread(&vecsData[0], 2 * sizeof(_SAMPLE), size_t(iNum), pFileIn);
+	iBytesLeft -= uint32_t(iRead * 4);
+
+	return (int) iRead;
+}
+
+_REAL CIQFileChannel::MeasurePower()
+{
+	_REAL rSum = (_REAL) 0.0;
+	double dNum = 0.0;
+	int iLen;
+
+	Rewind();
+	while ((iLen = Read()) > 0)
+	{
+		for (int i = 0; i < 2 * iLen; i++)
+			rSum += (_REAL) vecsData[i] * vecsData[i];
+		dNum += iLen;
+	}
+
+	if (rSum == (_REAL) 0.0)
+	{
+		Close();
+		throw CGenErr("The input file contains no signal.");
+	}
+
+	return rSum / dNum;
+}
@@ -0,0 +1,83 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Channel simulation of an I/Q file. See IQFileChannel.cpp.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#if !defined(IQFILECHANNEL_H__INCLUDED_)
+#define IQFILECHANNEL_H__INCLUDED_
+
+#include "ChannelSimulation.h"
+#include "../util/AudioFile.h"
+#include <stdio.h>
+
+
+/* Definitions ****************************************************************/
+/* Samples per processing block */
+#define IQ_CHAN_BLOCK_SIZE			8192
+/* Bandwidth the SNR refers to, nominal bandwidth of spectrum occupancy 3 */
+#define IQ_CHAN_NOM_BANDWIDTH		10000
+/* Doppler of the test channels which need one */
+#define IQ_CHAN_SPEC_DOPPLER		2
+
+
+/* Classes ********************************************************************/
+class CIQFileChannel
+{
+public:
+	CIQFileChannel() : pFileIn(NULL), iSampleRate(0), iDataStart(0),
+		iDataBytes(0), iBytesLeft(0), bWave(FALSE), Channel(), vecsData(),
+		vecrRe(), vecrIm(), vecrOutRe(), vecrOutIm() {}
+	virtual ~CIQFileChannel() {Close();}
+
+	/* Runs "strInFile" through channel "iChannelNum" and writes the result
+	   to "strOutFile". The files are 16 bit stereo, I left and Q right,
+	   wave files or raw with "iRawSampleRate". The SNR is measured in
+	   IQ_CHAN_NOM_BANDWIDTH. Throws CGenErr on errors */
+	void Process(const string& strInFile, const string& strOutFile,
+		const int iChannelNum, const _REAL rSNRdB, const int iRawSampleRate);
+
+protected:
+	void Open(const string& strInFile, const int iRawSampleRate);
+	void Close();
+	void Rewind();
+	int Read(); /* number of stereo samples, 0 at the end */
+	_REAL MeasurePower();
+
+	FILE*				pFileIn;
+	int					iSampleRate;
+	long				iDataStart;
+	uint32_t			iDataBytes;
+	uint32_t			iBytesLeft;
+	_BOOLEAN			bWave;
+
+	CMultipathChannel	Channel;
+	CVector<_SAMPLE>	vecsData;
+	CVector<_REAL>		vecrRe;
+	CVector<_REAL>		vecrIm;
+	CVector<_REAL>		vecrOutRe;
+	CVector<_REAL>		vecrOutIm;
+};
+
+#endif // !defined(IQFILECHANNEL_H__INCLUDED_)
@@ -70,7 +70,7 @@ void CSymbInterleaver::InitInternal(CParameter& TransmParam)
 	TransmParam.Lock(); 
 
 	/* Set internal parameters */
-	iN_MUX = TransmParam.CellMappingTable.iNumUsefMSCCellsPerFrame;
+	iN_MUX = TransmParam.pCellMappingTable->iNumUsefMSCCellsPerFrame;
 
 	/* Allocate memory for table */
 	veciIntTable.Init(iN_MUX);
@@ -116,26 +116,39 @@ void CSymbInterleaver::InitInternal(CParameter& TransmParam)
 \******************************************************************************/
 void CSymbDeinterleaver::ProcessDataInternal(CParameter&)
 {
-	int i, j;
+	int i;
 
-	/* Deinterleave data according to the deinterleaver table. Use the
-	   the interleaver-blocks described in the DRM-standard 
-	   (Ro(i) = i (mod D)  -> "i % iD") */
-	for (i = 0; i < iInputBlockSize; i++)
-		matcDeinterlMemory[veciCurIndex[i % iD]][veciIntTable[i]] = 
-			(*pvecInputData)[i];
+	/* Store the new block as it is. The deinterleaving is done while reading
+	   the output */
+	if (++iCurBlock >= iD)
+		iCurBlock = 0;
+
+	_REAL* prReal = vecDeinterlMemory.Real();
+	_REAL* prImag = vecDeinterlMemory.Imag();
+	_REAL* prChan = vecDeinterlMemory.Chan();
 
-	/* Read data from current block (index "iD - 1")*/
+	const int iBlockOffs = iCurBlock * iN_MUX;
 	for (i = 0; i < iInputBlockSize; i++)
-		(*pvecOutputData)[i] = matcDeinterlMemory[veciCurIndex[iD - 1]][i];
+	{
+		const CEquSig& InCell = (*pvecInputData)[i];
+		prReal[iBlockOffs + i] = InCell.cSig.real();
+		prImag[iBlockOffs + i] = InCell.cSig.imag();
+		prChan[iBlockOffs + i] = InCell.rChan;
+	}
 
-	/* Set new indices. Move blocks forward (virtually) */
-	for (j = 0; j < iD; j++)
+	/* Gather the cells of the output block. Input cell "i" has to wait
+	   "iD - 1 - (i % iD)" blocks before it is put out at position
+	   "veciIntTable[i]" (Ro(i) = i (mod D), see DRM-standard). All three
+	   components are read in the same pass */
+	for (i = 0; i < iInputBlockSize; i++)
 	{
-		veciCurIndex[j]--;
+		int iBlock = iCurBlock - veciSrcDelay[i];
+		if (iBlock < 0)
+			iBlock += iD;
 
-		if (veciCurIndex[j] < 0)
-			veciCurIndex[j] = iD - 1;
+		const int iSrc = iBlock * iN_MUX + veciSrcIdx[i];
+		(*pvecOutputData)[i] =
+			CEquSig(_COMPLEX(prReal[iSrc], prImag[iSrc]), prChan[iSrc]);
 	}
 
 	/* Debar initialization phase */
@@ -157,10 +170,10 @@ void CSymbDeinterleaver::InitInternal(CParameter& Parameters)
 	Parameters.Lock(); 
 
 	/* Set internal parameters */
-	iN_MUX = Parameters.CellMappingTable.iNumUsefMSCCellsPerFrame;
+	iN_MUX = Parameters.pCellMappingTable->iNumUsefMSCCellsPerFrame;
 
 	/* Allocate memory for table */
-	veciIntTable.Init(iN_MUX);
+	CVector<int> veciIntTable(iN_MUX);
 
 	/* Make interleaver table */
 	MakeTable(veciIntTable, iN_MUX, SYMB_INTERL_CONST_T_0);
@@ -177,17 +190,22 @@ void CSymbDeinterleaver::InitInternal(CParameter& Parameters)
 		break;
 	}
 
-	/* Always allocate memory for long interleaver case (interleaver memory) */
-	matcDeinterlMemory.Init(D_LENGTH_LONG_INTERL, iN_MUX
+	/* Invert the interleaver table for reading the output in one pass */
+	veciSrcIdx.Init(iN_MUX);
+	veciSrcDelay.Init(iN_MUX);
+	for (i = 0; i < iN_MUX; i++)
+	{
+		veciSrcIdx[veciIntTable[i]] = i;
+		veciSrcDelay[veciIntTable[i]] = iD - 1 - (i % iD);
+	}
+
+	/* Memory for "iD" blocks, the first block is written at index "0" */
+	vecDeinterlMemory.Init(iD * iN_MUX
 #ifdef USE_ERASURE_FOR_FASTER_ACQ
 		, CEquSig(ERASURE_TAG_VALUE, ERASURE_TAG_VALUE) /* Init with erasures */
 #endif		
 		);
-
-	/* Index for addressing the buffers */
-	veciCurIndex.Init(D_LENGTH_LONG_INTERL);
-	for (i = 0; i < D_LENGTH_LONG_INTERL; i++)
-		veciCurIndex[i] = i;
+	iCurBlock = iD - 1;
 
 #ifdef USE_ERASURE_FOR_FASTER_ACQ
 	if (Parameters.eSimType == CParameter::ST_NONE)
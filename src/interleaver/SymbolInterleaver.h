@@ -71,9 +71,15 @@ public:
 
 protected:
 	int					iN_MUX;
-	CMatrix<CEquSig>	matcDeinterlMemory;
-	CVector<int>		veciCurIndex;
-	CVector<int>		veciIntTable;
+
+	/* The last "iD" input blocks, block "iCurBlock" is the newest one */
+	CEquSigVec			vecDeinterlMemory;
+	int					iCurBlock;
+
+	/* Source of each output cell: position in the memory relative to the
+	   newest block and the number of blocks it is delayed */
+	CVector<int>		veciSrcIdx;
+	CVector<int>		veciSrcDelay;
 	int					iD;
 	int					iInitCnt;
 
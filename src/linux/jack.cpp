@@ -49,18 +49,6 @@ instance_data_t::~instance_data_t()
     jack_ringbuffer_free(buff);
 }
 
-struct CJackCommon
-{
-    CJackCommon():client(NULL),is_active(false),capture_data(NULL),play_data(NULL) {}
-    jack_client_t * client;
-    volatile bool is_active;
-    instance_data_t *capture_data;
-    instance_data_t *play_data;
-    void initialise();
-    void terminate();
-};
-
-static CJackCommon data;
 
 static int
 capture_stereo(jack_nframes_t nframes, void *arg)
@@ -256,7 +244,7 @@ void CJackCommon::initialise()
        there is work to be done.
      */
 
-    jack_set_process_callback(client, process_callback, &data);
+    jack_set_process_callback(client, process_callback, this);
 
     /* tell the Jack server to call `jack_shutdown()' if
        it ever shuts down, either entirely, or if it
@@ -273,26 +261,24 @@ void CJackCommon::initialise()
 
 void CJackCommon::terminate()
 {
+    if (client == NULL)
+        return;
     jack_client_close(client);
     client = NULL;
+    is_active = false;
+    capture_data = NULL;
+    play_data = NULL;
 }
 
 CSoundInJack::CSoundInJack():iBufferSize(0), bBlocking(TRUE), capture_data(), dev(-1),ports()
 {
-    if (data.client==NULL)
-        data.initialise();
-
-    if (data.is_active && jack_deactivate(data.client))
-    {
-        throw "Jack: cannot deactivate client";
-    }
-    data.is_active = false;
+    jack.initialise();
 
     capture_data.left =
-        jack_port_register(data.client, "input_0", JACK_DEFAULT_AUDIO_TYPE,
+        jack_port_register(jack.client, "input_0", JACK_DEFAULT_AUDIO_TYPE,
                            JackPortIsInput, 0);
     capture_data.right =
-        jack_port_register(data.client, "input_1", JACK_DEFAULT_AUDIO_TYPE,
+        jack_port_register(jack.client, "input_1", JACK_DEFAULT_AUDIO_TYPE,
                            JackPortIsInput, 0);
 
     if ((capture_data.left == NULL) || (capture_data.right == NULL))
@@ -302,15 +288,15 @@ CSoundInJack::CSoundInJack():iBufferSize(0), bBlocking(TRUE), capture_data(), de
 
     jack_ringbuffer_reset(capture_data.buff);
 
-    data.capture_data = &capture_data;
+    jack.capture_data = &capture_data;
 
-    ports.load(data.client, JackPortIsOutput);
+    ports.load(jack.client, JackPortIsOutput);
 
-    if (jack_activate(data.client))
+    if (jack_activate(jack.client))
     {
         throw "Jack: cannot activate client";
     }
-    data.is_active = true;
+    jack.is_active = true;
 }
 
 CSoundInJack::CSoundInJack(const CSoundInJack & e):
@@ -331,27 +317,16 @@ CSoundInJack & CSoundInJack::operator=(const CSoundInJack & e)
 
 CSoundInJack::~CSoundInJack()
 {
-    Close();
-    if (data.client==NULL)
+    if (jack.client==NULL)
         return;
-
-    if (data.is_active && jack_deactivate(data.client))
-    {
-        throw "Jack: cannot deactivate client";
-    }
-    data.is_active = false;
-    data.capture_data = NULL;
-    if (jack_activate(data.client))
-    {
-        throw "Jack: cannot activate client";
-    }
-    data.is_active = true;
+    Close();
+    jack.terminate();
 }
 
 void
 CSoundInJack::Enumerate(vector<string>& choices)
 {
-    ports.load(data.client, JackPortIsOutput);
+    ports.load(jack.client, JackPortIsOutput);
     choices = ports.devices;
 }
 
@@ -390,13 +365,13 @@ CSoundInJack::Init(int iNewBufferSize, _BOOLEAN bNewBlocking)
 
     pair<string,string> source = ports.get_ports(dev);
 
-    int err = jack_connect (data.client, source.first.c_str(), jack_port_name(capture_data.left));
+    int err = jack_connect (jack.client, source.first.c_str(), jack_port_name(capture_data.left));
     if (err)
     {
         cout << "err " << err << " can't connect " << source.first << " to " << jack_port_name(capture_data.left) << endl;
     }
 
-    err = jack_connect (data.client, source.second.c_str(), jack_port_name(capture_data.right));
+    err = jack_connect (jack.client, source.second.c_str(), jack_port_name(capture_data.right));
     if (err)
     {
         cout << "err " << err << " can't connect " << source.second << " to " << jack_port_name(capture_data.right) << endl;
@@ -451,28 +426,21 @@ CSoundInJack::Read(CVector<short>& psData)
 void
 CSoundInJack::Close()
 {
-    jack_port_disconnect(data.client, capture_data.left);
-    jack_port_disconnect(data.client, capture_data.right);
+    jack_port_disconnect(jack.client, capture_data.left);
+    jack_port_disconnect(jack.client, capture_data.right);
     device_changed = true;
 }
 
 CSoundOutJack::CSoundOutJack():iBufferSize(0), bBlocking(TRUE), device_changed(TRUE),
         play_data(), dev(-1), ports()
 {
-    if (data.client==NULL)
-        data.initialise();
-
-    if (data.is_active && jack_deactivate(data.client))
-    {
-        throw "Jack: cannot deactivate client";
-    }
-    data.is_active = false;
+    jack.initialise();
 
     play_data.left =
-        jack_port_register(data.client, "output_0", JACK_DEFAULT_AUDIO_TYPE,
+        jack_port_register(jack.client, "output_0", JACK_DEFAULT_AUDIO_TYPE,
                            JackPortIsOutput, 0);
     play_data.right =
-        jack_port_register(data.client, "output_1", JACK_DEFAULT_AUDIO_TYPE,
+        jack_port_register(jack.client, "output_1", JACK_DEFAULT_AUDIO_TYPE,
                            JackPortIsOutput, 0);
 
     if ((play_data.left == NULL) || (play_data.right == NULL))
@@ -480,30 +448,22 @@ CSoundOutJack::CSoundOutJack():iBufferSize(0), bBlocking(TRUE), device_changed(T
         throw "Jack: no more ports available";
     }
 
-    data.play_data = &play_data;
-    ports.load(data.client, JackPortIsInput);
+    jack.play_data = &play_data;
+    ports.load(jack.client, JackPortIsInput);
 
-    if (jack_activate(data.client))
+    if (jack_activate(jack.client))
     {
         throw "Jack: cannot activate client";
     }
-    data.is_active = true;
+    jack.is_active = true;
 }
 
 CSoundOutJack::~CSoundOutJack()
 {
+    if (jack.client==NULL)
+        return;
     Close();
-    if (data.is_active && jack_deactivate(data.client))
-    {
-        throw "Jack: cannot deactivate client";
-    }
-    data.is_active = false;
-    data.capture_data = NULL;
-    if (jack_activate(data.client))
-    {
-        throw "Jack: cannot activate client";
-    }
-    data.is_active = true;
+    jack.terminate();
 }
 
 CSoundOutJack::CSoundOutJack(const CSoundOutJack & e):
@@ -524,7 +484,7 @@ CSoundOutJack & CSoundOutJack::operator=(const CSoundOutJack & e)
 void
 CSoundOutJack::Enumerate(vector<string>& choices)
 {
-    ports.load(data.client, JackPortIsInput);
+    ports.load(jack.client, JackPortIsInput);
     choices = ports.devices;
 }
 
@@ -562,12 +522,12 @@ CSoundOutJack::Init(int iNewBufferSize, _BOOLEAN bNewBlocking)
 
     pair<string,string> sink = ports.get_ports(dev);
 
-    int err = jack_connect (data.client, jack_port_name(play_data.left), sink.first.c_str());
+    int err = jack_connect (jack.client, jack_port_name(play_data.left), sink.first.c_str());
     if (err)
     {
         cout << "err " << err << " can't connect " << jack_port_name(play_data.left) << " to " << sink.first << endl;
     }
-    err = jack_connect (data.client, jack_port_name(play_data.right), sink.second.c_str());
+    err = jack_connect (jack.client, jack_port_name(play_data.right), sink.second.c_str());
     if (err)
     {
         cout << "err " << err << " can't connect " << jack_port_name(play_data.right) << " to " << sink.second << endl;
@@ -593,7 +553,7 @@ CSoundOutJack::Write(CVector<short>& psData)
 void
 CSoundOutJack::Close()
 {
-    jack_port_disconnect(data.client, play_data.left);
-    jack_port_disconnect(data.client, play_data.right);
+    jack_port_disconnect(jack.client, play_data.left);
+    jack_port_disconnect(jack.client, play_data.right);
     device_changed = true;
 }
@@ -54,6 +54,19 @@ struct instance_data_t
     string peer_left, peer_right;
 };
 
+/* Each sound device opens its own client, so every receiver instance has
+   its own process callback and ports */
+struct CJackCommon
+{
+    CJackCommon():client(NULL),is_active(false),capture_data(NULL),play_data(NULL) {}
+    jack_client_t * client;
+    volatile bool is_active;
+    instance_data_t *capture_data;
+    instance_data_t *play_data;
+    void initialise();
+    void terminate();
+};
+
 class CJackPorts
 {
 public:
@@ -86,6 +99,7 @@ protected:
     instance_data_t capture_data;
     int dev;
     CJackPorts ports;
+    CJackCommon jack;
 };
 
 class CSoundOutJack : public CSoundOutInterface
@@ -109,6 +123,7 @@ protected:
     instance_data_t play_data;
     int dev;
     CJackPorts ports;
+    CJackCommon jack;
 };
 
 #endif
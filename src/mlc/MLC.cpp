@@ -205,9 +205,14 @@ void CMLCDecoder::ProcessDataInternal(CParameter&)
 
     /* Save input signal for signal constellation. We cannot use the copy
        operator of vector because the input vector is not of the same size as
-       our intermediate buffer, therefore the "for"-loop */
+       our intermediate buffer, therefore the "for"-loop. The metric is
+       calculated several times on the same cells, split them once in
+       separate arrays for it */
     for (i = 0; i < iInputBlockSize; i++)
+    {
         vecSigSpacBuf[i] = (*pvecInputData)[i].cSig;
+        vecInSymb.Put(i, (*pvecInputData)[i]);
+    }
 
 
 
@@ -236,7 +241,7 @@ void CMLCDecoder::ProcessDataInternal(CParameter&)
             else
                 bIteration = FALSE;
 
-            MLCMetric.CalculateMetric(pvecInputData, vecMetric,
+            MLCMetric.CalculateMetric(vecInSymb, vecMetric,
                                       vecSubsetDef[0], vecSubsetDef[1], vecSubsetDef[2],
                                       vecSubsetDef[3], vecSubsetDef[4], vecSubsetDef[5],
                                       j, bIteration);
@@ -430,6 +435,7 @@ void CMLCDecoder::InitInternal(CParameter& Parameters)
 
     /* Init buffer for signal space */
     vecSigSpacBuf.Init(iN_mux);
+    vecInSymb.Init(iN_mux);
 
     /* Define block-size for input and output */
     iInputBlockSize = iN_mux;
@@ -513,7 +519,7 @@ void CMLC::CalculateParam(CParameter& Parameter, int iNewChannelType)
         /* SDC ********************************************************************/
     case CT_SDC:
         eCodingScheme = Parameter.eSDCCodingScheme;
-        iN_mux = Parameter.CellMappingTable.iNumSDCCellsPerSFrame;
+        iN_mux = Parameter.pCellMappingTable->iNumSDCCellsPerSFrame;
 
         iNumEncBits = iN_mux * 2;
 
@@ -616,7 +622,7 @@ void CMLC::CalculateParam(CParameter& Parameter, int iNewChannelType)
         /* MSC ********************************************************************/
     case CT_MSC:
         eCodingScheme = Parameter.eMSCCodingScheme;
-        iN_mux = Parameter.CellMappingTable.iNumUsefMSCCellsPerFrame;
+        iN_mux = Parameter.pCellMappingTable->iNumUsefMSCCellsPerFrame;
 
         /* Data length for part A is the sum of all lengths of the streams */
         iMSCDataLenPartA = Parameter.Stream[0].iLenPartA +
@@ -123,6 +123,7 @@ protected:
     CEngergyDispersal	EnergyDisp;
 
     /* Internal buffers */
+    CEquSigVec			vecInSymb;
     CVector<CDistance>	vecMetric;
 
     CVector<_DECISION>	vecDecOutBits[MC_MAX_NUM_LEVELS];
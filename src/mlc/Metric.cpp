@@ -52,7 +52,7 @@
 
 
 /* Implementation *************************************************************/
-void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
+void CMLCMetric::CalculateMetric(const CEquSigVec& vecInSymb,
                                  CVector<CDistance>& vecMetric,
                                  CVector<_DECISION>& vecSubsetDef1,
                                  CVector<_DECISION>& vecSubsetDef2,
@@ -65,6 +65,11 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
     int i, k;
     int iTabInd0;
 
+    /* Component arrays of the input cells */
+    const _REAL* prReal = vecInSymb.Real();
+    const _REAL* prImag = vecInSymb.Imag();
+    const _REAL* prChan = vecInSymb.Chan();
+
     switch (eMapType)
     {
     case CS_1_SM:
@@ -76,22 +81,22 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
         {
             /* Real part ---------------------------------------------------- */
             /* Distance to "0" */
-            vecMetric[k].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                          rTableQAM4[0][0], (*pcInSymb)[i].rChan);
+            vecMetric[k].rTow0 = Minimum1(prReal[i],
+                                          rTableQAM4[0][0], prChan[i]);
 
             /* Distance to "1" */
-            vecMetric[k].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                          rTableQAM4[1][0], (*pcInSymb)[i].rChan);
+            vecMetric[k].rTow1 = Minimum1(prReal[i],
+                                          rTableQAM4[1][0], prChan[i]);
 
 
             /* Imaginary part ----------------------------------------------- */
             /* Distance to "0" */
-            vecMetric[k + 1].rTow0 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                              rTableQAM4[0][1], (*pcInSymb)[i].rChan);
+            vecMetric[k + 1].rTow0 = Minimum1(prImag[i],
+                                              rTableQAM4[0][1], prChan[i]);
 
             /* Distance to "1" */
-            vecMetric[k + 1].rTow1 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                              rTableQAM4[1][1], (*pcInSymb)[i].rChan);
+            vecMetric[k + 1].rTow1 = Minimum1(prImag[i],
+                                              rTableQAM4[1][1], prChan[i]);
         }
 
         break;
@@ -111,58 +116,58 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     /* Real part -------------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                     vecMetric[k].rTow0 =
-                        Minimum2((*pcInSymb)[i].cSig.real(),
+                        Minimum2(prReal[i],
                                  rTableQAM16[BI_00 /* [0  0] */][0],
                                  rTableQAM16[BI_01 /* [0  1] */][0],
-                                 (*pcInSymb)[i].rChan, vecSubsetDef2[k]);
+                                 prChan[i], vecSubsetDef2[k]);
 
                     vecMetric[k].rTow1 =
-                        Minimum2((*pcInSymb)[i].cSig.real(),
+                        Minimum2(prReal[i],
                                  rTableQAM16[BI_10 /* [1  0] */][0],
                                  rTableQAM16[BI_11 /* [1  1] */][0],
-                                 (*pcInSymb)[i].rChan, vecSubsetDef2[k]);
+                                 prChan[i], vecSubsetDef2[k]);
 #else
                     /* Lowest bit defined by "vecSubsetDef2" */
                     iTabInd0 = ExtractBit(vecSubsetDef2[k]) & 1;
 
                     /* Distance to "0" */
                     vecMetric[k].rTow0 =
-                        Minimum1((*pcInSymb)[i].cSig.real(),
-                                 rTableQAM16[iTabInd0][0], (*pcInSymb)[i].rChan);
+                        Minimum1(prReal[i],
+                                 rTableQAM16[iTabInd0][0], prChan[i]);
 
                     /* Distance to "1" */
                     vecMetric[k].rTow1 =
-                        Minimum1((*pcInSymb)[i].cSig.real(),
+                        Minimum1(prReal[i],
                                  rTableQAM16[iTabInd0 | (1 << 1)][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 #endif
 
 
                     /* Imaginary part --------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
-                    vecMetric[k + 1].rTow0 = Minimum2((*pcInSymb)[i].cSig.imag(),
+                    vecMetric[k + 1].rTow0 = Minimum2(prImag[i],
                                                       rTableQAM16[BI_00 /* [0  0] */][1],
                                                       rTableQAM16[BI_01 /* [0  1] */][1],
-                                                      (*pcInSymb)[i].rChan, vecSubsetDef2[k + 1]);
+                                                      prChan[i], vecSubsetDef2[k + 1]);
 
-                    vecMetric[k + 1].rTow1 = Minimum2((*pcInSymb)[i].cSig.imag(),
+                    vecMetric[k + 1].rTow1 = Minimum2(prImag[i],
                                                       rTableQAM16[BI_10 /* [1  0] */][1],
                                                       rTableQAM16[BI_11 /* [1  1] */][1],
-                                                      (*pcInSymb)[i].rChan, vecSubsetDef2[k + 1]);
+                                                      prChan[i], vecSubsetDef2[k + 1]);
 #else
                     /* Lowest bit defined by "vecSubsetDef2" */
                     iTabInd0 = ExtractBit(vecSubsetDef2[k + 1]) & 1;
 
                     /* Distance to "0" */
                     vecMetric[k + 1].rTow0 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
-                                 rTableQAM16[iTabInd0][1], (*pcInSymb)[i].rChan);
+                        Minimum1(prImag[i],
+                                 rTableQAM16[iTabInd0][1], prChan[i]);
 
                     /* Distance to "1" */
                     vecMetric[k + 1].rTow1 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
+                        Minimum1(prImag[i],
                                  rTableQAM16[iTabInd0 | (1 << 1)][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 #endif
                 }
                 else
@@ -174,29 +179,29 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     /* Calculate distances */
                     /* Real part */
                     vecMetric[k].rTow0 =
-                        Minimum2((*pcInSymb)[i].cSig.real(),
+                        Minimum2(prReal[i],
                                  rTableQAM16[BI_00 /* [0  0] */][0],
                                  rTableQAM16[BI_01 /* [0  1] */][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     vecMetric[k].rTow1 =
-                        Minimum2((*pcInSymb)[i].cSig.real(),
+                        Minimum2(prReal[i],
                                  rTableQAM16[BI_10 /* [1  0] */][0],
                                  rTableQAM16[BI_11 /* [1  1] */][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     /* Imaginary part */
                     vecMetric[k + 1].rTow0 =
-                        Minimum2((*pcInSymb)[i].cSig.imag(),
+                        Minimum2(prImag[i],
                                  rTableQAM16[BI_00 /* [0  0] */][1],
                                  rTableQAM16[BI_01 /* [0  1] */][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum2((*pcInSymb)[i].cSig.imag(),
+                        Minimum2(prImag[i],
                                  rTableQAM16[BI_10 /* [1  0] */][1],
                                  rTableQAM16[BI_11 /* [1  1] */][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
                 }
             }
 
@@ -208,54 +213,54 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                 /* Real part ------------------------------------------------ */
 #ifdef USE_MAX_LOG_MAP
                 vecMetric[k].rTow0 =
-                    Minimum2((*pcInSymb)[i].cSig.real(),
+                    Minimum2(prReal[i],
                              rTableQAM16[BI_00 /* [0  0] */][0],
                              rTableQAM16[BI_10 /* [1  0] */][0],
-                             (*pcInSymb)[i].rChan, vecSubsetDef1[k]);
+                             prChan[i], vecSubsetDef1[k]);
 
                 vecMetric[k].rTow1 =
-                    Minimum2((*pcInSymb)[i].cSig.real(),
+                    Minimum2(prReal[i],
                              rTableQAM16[BI_01 /* [0  1] */][0],
                              rTableQAM16[BI_11 /* [1  1] */][0],
-                             (*pcInSymb)[i].rChan, vecSubsetDef1[k]);
+                             prChan[i], vecSubsetDef1[k]);
 #else
                 /* Higest bit defined by "vecSubsetDef1" */
                 iTabInd0 = ((ExtractBit(vecSubsetDef1[k]) & 1) << 1);
 
                 /* Distance to "0" */
-                vecMetric[k].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                              rTableQAM16[iTabInd0][0], (*pcInSymb)[i].rChan);
+                vecMetric[k].rTow0 = Minimum1(prReal[i],
+                                              rTableQAM16[iTabInd0][0], prChan[i]);
 
                 /* Distance to "1" */
-                vecMetric[k].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                              rTableQAM16[iTabInd0 | 1][0], (*pcInSymb)[i].rChan);
+                vecMetric[k].rTow1 = Minimum1(prReal[i],
+                                              rTableQAM16[iTabInd0 | 1][0], prChan[i]);
 #endif
 
 
                 /* Imaginary part ------------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                 vecMetric[k + 1].rTow0 =
-                    Minimum2((*pcInSymb)[i].cSig.imag(),
+                    Minimum2(prImag[i],
                              rTableQAM16[BI_00 /* [0  0] */][1],
                              rTableQAM16[BI_10 /* [1  0] */][1],
-                             (*pcInSymb)[i].rChan, vecSubsetDef1[k + 1]);
+                             prChan[i], vecSubsetDef1[k + 1]);
 
                 vecMetric[k + 1].rTow1 =
-                    Minimum2((*pcInSymb)[i].cSig.imag(),
+                    Minimum2(prImag[i],
                              rTableQAM16[BI_01 /* [0  1] */][1],
                              rTableQAM16[BI_11 /* [1  1] */][1],
-                             (*pcInSymb)[i].rChan, vecSubsetDef1[k + 1]);
+                             prChan[i], vecSubsetDef1[k + 1]);
 #else
                 /* Higest bit defined by "vecSubsetDef1" */
                 iTabInd0 = ((ExtractBit(vecSubsetDef1[k + 1]) & 1) << 1);
 
                 /* Distance to "0" */
-                vecMetric[k + 1].rTow0 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                                  rTableQAM16[iTabInd0][1], (*pcInSymb)[i].rChan);
+                vecMetric[k + 1].rTow0 = Minimum1(prImag[i],
+                                                  rTableQAM16[iTabInd0][1], prChan[i]);
 
                 /* Distance to "1" */
-                vecMetric[k + 1].rTow1 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                                  rTableQAM16[iTabInd0 | 1][1], (*pcInSymb)[i].rChan);
+                vecMetric[k + 1].rTow1 = Minimum1(prImag[i],
+                                                  rTableQAM16[iTabInd0 | 1][1], prChan[i]);
 #endif
             }
 
@@ -280,21 +285,21 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     /* Real part -------------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                     vecMetric[k].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64SM[BI_000 /* [0 0 0] */][0],
                                  rTableQAM64SM[BI_010 /* [0 1 0] */][0],
                                  rTableQAM64SM[BI_001 /* [0 0 1] */][0],
                                  rTableQAM64SM[BI_011 /* [0 1 1] */][0],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef2[k], vecSubsetDef3[k]);
 
                     vecMetric[k].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64SM[BI_100 /* [1 0 0] */][0],
                                  rTableQAM64SM[BI_110 /* [1 1 0] */][0],
                                  rTableQAM64SM[BI_101 /* [1 0 1] */][0],
                                  rTableQAM64SM[BI_111 /* [1 1 1] */][0],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef2[k], vecSubsetDef3[k]);
 #else
                     /* Lowest bit defined by "vecSubsetDef3" next bit defined
@@ -304,34 +309,34 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         ((ExtractBit(vecSubsetDef2[k]) & 1) << 1);
 
                     vecMetric[k].rTow0 =
-                        Minimum1((*pcInSymb)[i].cSig.real(),
-                                 rTableQAM64SM[iTabInd0][0],	(*pcInSymb)[i].rChan);
+                        Minimum1(prReal[i],
+                                 rTableQAM64SM[iTabInd0][0],	prChan[i]);
 
                     vecMetric[k].rTow1 =
-                        Minimum1((*pcInSymb)[i].cSig.real(),
+                        Minimum1(prReal[i],
                                  rTableQAM64SM[iTabInd0 | (1 << 2)][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 #endif
 
 
                     /* Imaginary part --------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                     vecMetric[k + 1].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64SM[BI_000 /* [0 0 0] */][1],
                                  rTableQAM64SM[BI_010 /* [0 1 0] */][1],
                                  rTableQAM64SM[BI_001 /* [0 0 1] */][1],
                                  rTableQAM64SM[BI_011 /* [0 1 1] */][1],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef2[k + 1], vecSubsetDef3[k + 1]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64SM[BI_100 /* [1 0 0] */][1],
                                  rTableQAM64SM[BI_110 /* [1 1 0] */][1],
                                  rTableQAM64SM[BI_101 /* [1 0 1] */][1],
                                  rTableQAM64SM[BI_111 /* [1 1 1] */][1],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef2[k + 1], vecSubsetDef3[k + 1]);
 #else
                     /* Lowest bit defined by "vecSubsetDef3" next bit defined
@@ -342,51 +347,51 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
 
                     /* Calculate distances, imaginary part */
                     vecMetric[k + 1].rTow0 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
-                                 rTableQAM64SM[iTabInd0][1],	(*pcInSymb)[i].rChan);
+                        Minimum1(prImag[i],
+                                 rTableQAM64SM[iTabInd0][1],	prChan[i]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
+                        Minimum1(prImag[i],
                                  rTableQAM64SM[iTabInd0 | (1 << 2)][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 #endif
                 }
                 else
                 {
                     /* Real part -------------------------------------------- */
                     vecMetric[k].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64SM[BI_000 /* [0 0 0] */][0],
                                  rTableQAM64SM[BI_001 /* [0 0 1] */][0],
                                  rTableQAM64SM[BI_010 /* [0 1 0] */][0],
                                  rTableQAM64SM[BI_011 /* [0 1 1] */][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     vecMetric[k].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64SM[BI_100 /* [1 0 0] */][0],
                                  rTableQAM64SM[BI_101 /* [1 0 1] */][0],
                                  rTableQAM64SM[BI_110 /* [1 1 0] */][0],
                                  rTableQAM64SM[BI_111 /* [1 1 1] */][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
 
                     /* Imaginary part --------------------------------------- */
                     vecMetric[k + 1].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64SM[BI_000 /* [0 0 0] */][1],
                                  rTableQAM64SM[BI_001 /* [0 0 1] */][1],
                                  rTableQAM64SM[BI_010 /* [0 1 0] */][1],
                                  rTableQAM64SM[BI_011 /* [0 1 1] */][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64SM[BI_100 /* [1 0 0] */][1],
                                  rTableQAM64SM[BI_101 /* [1 0 1] */][1],
                                  rTableQAM64SM[BI_110 /* [1 1 0] */][1],
                                  rTableQAM64SM[BI_111 /* [1 1 1] */][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
                 }
             }
 
@@ -400,21 +405,21 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     /* Real part -------------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                     vecMetric[k].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64SM[BI_000 /* [0 0 0] */][0],
                                  rTableQAM64SM[BI_100 /* [1 0 0] */][0],
                                  rTableQAM64SM[BI_001 /* [0 0 1] */][0],
                                  rTableQAM64SM[BI_101 /* [1 0 1] */][0],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef1[k], vecSubsetDef3[k]);
 
                     vecMetric[k].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64SM[BI_010 /* [0 1 0] */][0],
                                  rTableQAM64SM[BI_110 /* [1 1 0] */][0],
                                  rTableQAM64SM[BI_011 /* [0 1 1] */][0],
                                  rTableQAM64SM[BI_111 /* [1 1 1] */][0],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef1[k], vecSubsetDef3[k]);
 #else
                     /* Lowest bit defined by "vecSubsetDef3",highest defined
@@ -423,33 +428,33 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         ((ExtractBit(vecSubsetDef1[k]) & 1) << 2) |
                         (ExtractBit(vecSubsetDef3[k]) & 1);
 
-                    vecMetric[k].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                                  rTableQAM64SM[iTabInd0][0],	(*pcInSymb)[i].rChan);
+                    vecMetric[k].rTow0 = Minimum1(prReal[i],
+                                                  rTableQAM64SM[iTabInd0][0],	prChan[i]);
 
-                    vecMetric[k].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
+                    vecMetric[k].rTow1 = Minimum1(prReal[i],
                                                   rTableQAM64SM[iTabInd0 | (1 << 1)][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
 #endif
 
 
                     /* Imaginary part --------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                     vecMetric[k + 1].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64SM[BI_000 /* [0 0 0] */][1],
                                  rTableQAM64SM[BI_100 /* [1 0 0] */][1],
                                  rTableQAM64SM[BI_001 /* [0 0 1] */][1],
                                  rTableQAM64SM[BI_101 /* [1 0 1] */][1],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef1[k + 1], vecSubsetDef3[k + 1]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64SM[BI_010 /* [0 1 0] */][1],
                                  rTableQAM64SM[BI_110 /* [1 1 0] */][1],
                                  rTableQAM64SM[BI_011 /* [0 1 1] */][1],
                                  rTableQAM64SM[BI_111 /* [1 1 1] */][1],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef1[k + 1], vecSubsetDef3[k + 1]);
 #else
                     /* Lowest bit defined by "vecSubsetDef3",highest defined
@@ -459,14 +464,14 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         (ExtractBit(vecSubsetDef3[k + 1]) & 1);
 
                     vecMetric[k + 1].rTow0 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
+                        Minimum1(prImag[i],
                                  rTableQAM64SM[iTabInd0][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
+                        Minimum1(prImag[i],
                                  rTableQAM64SM[iTabInd0 | (1 << 1)][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 #endif
                 }
                 else
@@ -478,70 +483,70 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     /* Real part -------------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                     vecMetric[k].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64SM[BI_000 /* [0 0 0] */][0],
                                  rTableQAM64SM[BI_100 /* [1 0 0] */][0],
                                  rTableQAM64SM[BI_001 /* [0 0 1] */][0],
                                  rTableQAM64SM[BI_101 /* [1 0 1] */][0],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef1[k]);
 
                     vecMetric[k].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64SM[BI_010 /* [0 1 0] */][0],
                                  rTableQAM64SM[BI_110 /* [1 1 0] */][0],
                                  rTableQAM64SM[BI_011 /* [0 1 1] */][0],
                                  rTableQAM64SM[BI_111 /* [1 1 1] */][0],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef1[k]);
 #else
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[k]) & 1) << 2);
                     vecMetric[k].rTow0 =
-                        Minimum2((*pcInSymb)[i].cSig.real(),
+                        Minimum2(prReal[i],
                                  rTableQAM64SM[iTabInd0][0],
-                                 rTableQAM64SM[iTabInd0 | 1][0], (*pcInSymb)[i].rChan);
+                                 rTableQAM64SM[iTabInd0 | 1][0], prChan[i]);
 
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[k]) & 1) << 2) |
                                (1 << 1);
                     vecMetric[k].rTow1 =
-                        Minimum2((*pcInSymb)[i].cSig.real(),
+                        Minimum2(prReal[i],
                                  rTableQAM64SM[iTabInd0][0],
-                                 rTableQAM64SM[iTabInd0 | 1][0], (*pcInSymb)[i].rChan);
+                                 rTableQAM64SM[iTabInd0 | 1][0], prChan[i]);
 #endif
 
 
                     /* Imaginary part --------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                     vecMetric[k + 1].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64SM[BI_000 /* [0 0 0] */][1],
                                  rTableQAM64SM[BI_100 /* [1 0 0] */][1],
                                  rTableQAM64SM[BI_001 /* [0 0 1] */][1],
                                  rTableQAM64SM[BI_101 /* [1 0 1] */][1],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef1[k + 1]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64SM[BI_010 /* [0 1 0] */][1],
                                  rTableQAM64SM[BI_110 /* [1 1 0] */][1],
                                  rTableQAM64SM[BI_011 /* [0 1 1] */][1],
                                  rTableQAM64SM[BI_111 /* [1 1 1] */][1],
-                                 (*pcInSymb)[i].rChan,
+                                 prChan[i],
                                  vecSubsetDef1[k + 1]);
 #else
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[k + 1]) & 1) << 2);
                     vecMetric[k + 1].rTow0 =
-                        Minimum2((*pcInSymb)[i].cSig.imag(),
+                        Minimum2(prImag[i],
                                  rTableQAM64SM[iTabInd0][1],
-                                 rTableQAM64SM[iTabInd0 | 1][1], (*pcInSymb)[i].rChan);
+                                 rTableQAM64SM[iTabInd0 | 1][1], prChan[i]);
 
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[k + 1]) & 1) << 2) |
                                (1 << 1);
                     vecMetric[k + 1].rTow1 =
-                        Minimum2((*pcInSymb)[i].cSig.imag(),
+                        Minimum2(prImag[i],
                                  rTableQAM64SM[iTabInd0][1],
-                                 rTableQAM64SM[iTabInd0 | 1][1], (*pcInSymb)[i].rChan);
+                                 rTableQAM64SM[iTabInd0 | 1][1], prChan[i]);
 #endif
                 }
             }
@@ -554,21 +559,21 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                 /* Real part ------------------------------------------------ */
 #ifdef USE_MAX_LOG_MAP
                 vecMetric[k].rTow0 =
-                    Minimum4((*pcInSymb)[i].cSig.real(),
+                    Minimum4(prReal[i],
                              rTableQAM64SM[BI_000 /* [0 0 0] */][0],
                              rTableQAM64SM[BI_100 /* [1 0 0] */][0],
                              rTableQAM64SM[BI_010 /* [0 1 0] */][0],
                              rTableQAM64SM[BI_110 /* [1 1 0] */][0],
-                             (*pcInSymb)[i].rChan,
+                             prChan[i],
                              vecSubsetDef1[k], vecSubsetDef2[k]);
 
                 vecMetric[k].rTow1 =
-                    Minimum4((*pcInSymb)[i].cSig.real(),
+                    Minimum4(prReal[i],
                              rTableQAM64SM[BI_001 /* [0 0 1] */][0],
                              rTableQAM64SM[BI_101 /* [1 0 1] */][0],
                              rTableQAM64SM[BI_011 /* [0 1 1] */][0],
                              rTableQAM64SM[BI_111 /* [1 1 1] */][0],
-                             (*pcInSymb)[i].rChan,
+                             prChan[i],
                              vecSubsetDef1[k], vecSubsetDef2[k]);
 #else
                 /* Higest bit defined by "vecSubsetDef1" next bit defined
@@ -577,32 +582,32 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     ((ExtractBit(vecSubsetDef1[k]) & 1) << 2) |
                     ((ExtractBit(vecSubsetDef2[k]) & 1) << 1);
 
-                vecMetric[k].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                              rTableQAM64SM[iTabInd0][0], (*pcInSymb)[i].rChan);
+                vecMetric[k].rTow0 = Minimum1(prReal[i],
+                                              rTableQAM64SM[iTabInd0][0], prChan[i]);
 
-                vecMetric[k].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                              rTableQAM64SM[iTabInd0 | 1][0], (*pcInSymb)[i].rChan);
+                vecMetric[k].rTow1 = Minimum1(prReal[i],
+                                              rTableQAM64SM[iTabInd0 | 1][0], prChan[i]);
 #endif
 
 
                 /* Imaginary part ------------------------------------------- */
 #ifdef USE_MAX_LOG_MAP
                 vecMetric[k + 1].rTow0 =
-                    Minimum4((*pcInSymb)[i].cSig.imag(),
+                    Minimum4(prImag[i],
                              rTableQAM64SM[BI_000 /* [0 0 0] */][1],
                              rTableQAM64SM[BI_100 /* [1 0 0] */][1],
                              rTableQAM64SM[BI_010 /* [0 1 0] */][1],
                              rTableQAM64SM[BI_110 /* [1 1 0] */][1],
-                             (*pcInSymb)[i].rChan,
+                             prChan[i],
                              vecSubsetDef1[k + 1], vecSubsetDef2[k + 1]);
 
                 vecMetric[k + 1].rTow1 =
-                    Minimum4((*pcInSymb)[i].cSig.imag(),
+                    Minimum4(prImag[i],
                              rTableQAM64SM[BI_001 /* [0 0 1] */][1],
                              rTableQAM64SM[BI_101 /* [1 0 1] */][1],
                              rTableQAM64SM[BI_011 /* [0 1 1] */][1],
                              rTableQAM64SM[BI_111 /* [1 1 1] */][1],
-                             (*pcInSymb)[i].rChan,
+                             prChan[i],
                              vecSubsetDef1[k + 1], vecSubsetDef2[k + 1]);
 #else
                 /* Higest bit defined by "vecSubsetDef1" next bit defined
@@ -612,11 +617,11 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     ((ExtractBit(vecSubsetDef2[k + 1]) & 1) << 1);
 
                 /* Calculate distances, imaginary part */
-                vecMetric[k + 1].rTow0 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                                  rTableQAM64SM[iTabInd0][1], (*pcInSymb)[i].rChan);
+                vecMetric[k + 1].rTow0 = Minimum1(prImag[i],
+                                                  rTableQAM64SM[iTabInd0][1], prChan[i]);
 
-                vecMetric[k + 1].rTow1 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                                  rTableQAM64SM[iTabInd0 | 1][1], (*pcInSymb)[i].rChan);
+                vecMetric[k + 1].rTow1 = Minimum1(prImag[i],
+                                                  rTableQAM64SM[iTabInd0 | 1][1], prChan[i]);
 #endif
             }
 
@@ -645,12 +650,12 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         (ExtractBit(vecSubsetDef3[k]) & 1) |
                         ((ExtractBit(vecSubsetDef2[k]) & 1) << 1);
 
-                    vecMetric[k].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                                  rTableQAM64HMsym[iTabInd0][0], (*pcInSymb)[i].rChan);
+                    vecMetric[k].rTow0 = Minimum1(prReal[i],
+                                                  rTableQAM64HMsym[iTabInd0][0], prChan[i]);
 
-                    vecMetric[k].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
+                    vecMetric[k].rTow1 = Minimum1(prReal[i],
                                                   rTableQAM64HMsym[iTabInd0 | (1 << 2)][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
 
 
                     /* Imaginary part --------------------------------------- */
@@ -662,50 +667,50 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
 
                     /* Calculate distances, imaginary part */
                     vecMetric[k + 1].rTow0 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
-                                 rTableQAM64HMsym[iTabInd0][1], (*pcInSymb)[i].rChan);
+                        Minimum1(prImag[i],
+                                 rTableQAM64HMsym[iTabInd0][1], prChan[i]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
+                        Minimum1(prImag[i],
                                  rTableQAM64HMsym[iTabInd0 | (1 << 2)][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
                 }
                 else
                 {
                     /* Real part -------------------------------------------- */
                     vecMetric[k].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64HMsym[BI_000 /* [0 0 0] */][0],
                                  rTableQAM64HMsym[BI_001 /* [0 0 1] */][0],
                                  rTableQAM64HMsym[BI_010 /* [0 1 0] */][0],
                                  rTableQAM64HMsym[BI_011 /* [0 1 1] */][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     vecMetric[k].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.real(),
+                        Minimum4(prReal[i],
                                  rTableQAM64HMsym[BI_100 /* [1 0 0] */][0],
                                  rTableQAM64HMsym[BI_101 /* [1 0 1] */][0],
                                  rTableQAM64HMsym[BI_110 /* [1 1 0] */][0],
                                  rTableQAM64HMsym[BI_111 /* [1 1 1] */][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
 
                     /* Imaginary part --------------------------------------- */
                     vecMetric[k + 1].rTow0 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64HMsym[BI_000 /* [0 0 0] */][1],
                                  rTableQAM64HMsym[BI_001 /* [0 0 1] */][1],
                                  rTableQAM64HMsym[BI_010 /* [0 1 0] */][1],
                                  rTableQAM64HMsym[BI_011 /* [0 1 1] */][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum4((*pcInSymb)[i].cSig.imag(),
+                        Minimum4(prImag[i],
                                  rTableQAM64HMsym[BI_100 /* [1 0 0] */][1],
                                  rTableQAM64HMsym[BI_101 /* [1 0 1] */][1],
                                  rTableQAM64HMsym[BI_110 /* [1 1 0] */][1],
                                  rTableQAM64HMsym[BI_111 /* [1 1 1] */][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
                 }
             }
 
@@ -723,13 +728,13 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         ((ExtractBit(vecSubsetDef1[k]) & 1) << 2) |
                         (ExtractBit(vecSubsetDef3[k]) & 1);
 
-                    vecMetric[k].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
+                    vecMetric[k].rTow0 = Minimum1(prReal[i],
                                                   rTableQAM64HMsym[iTabInd0][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
 
-                    vecMetric[k].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
+                    vecMetric[k].rTow1 = Minimum1(prReal[i],
                                                   rTableQAM64HMsym[iTabInd0 | (1 << 1)][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
 
 
                     /* Imaginary part --------------------------------------- */
@@ -740,13 +745,13 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         (ExtractBit(vecSubsetDef3[k + 1]) & 1);
 
                     vecMetric[k + 1].rTow0 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
-                                 rTableQAM64HMsym[iTabInd0][1], (*pcInSymb)[i].rChan);
+                        Minimum1(prImag[i],
+                                 rTableQAM64HMsym[iTabInd0][1], prChan[i]);
 
                     vecMetric[k + 1].rTow1 =
-                        Minimum1((*pcInSymb)[i].cSig.imag(),
+                        Minimum1(prImag[i],
                                  rTableQAM64HMsym[iTabInd0 | (1 << 1)][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
                 }
                 else
                 {
@@ -757,35 +762,35 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     /* Real part -------------------------------------------- */
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[k]) & 1) << 2);
                     vecMetric[k].rTow0 =
-                        Minimum2((*pcInSymb)[i].cSig.real(),
+                        Minimum2(prReal[i],
                                  rTableQAM64HMsym[iTabInd0][0],
                                  rTableQAM64HMsym[iTabInd0 | 1][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[k]) & 1) << 2) |
                                (1 << 1);
                     vecMetric[k].rTow1 =
-                        Minimum2((*pcInSymb)[i].cSig.real(),
+                        Minimum2(prReal[i],
                                  rTableQAM64HMsym[iTabInd0][0],
                                  rTableQAM64HMsym[iTabInd0 | 1][0],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
 
                     /* Imaginary part --------------------------------------- */
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[k + 1]) & 1) << 2);
                     vecMetric[k + 1].rTow0 =
-                        Minimum2((*pcInSymb)[i].cSig.imag(),
+                        Minimum2(prImag[i],
                                  rTableQAM64HMsym[iTabInd0][1],
                                  rTableQAM64HMsym[iTabInd0 | 1][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
 
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[k + 1]) & 1) << 2) |
                                (1 << 1);
                     vecMetric[k + 1].rTow1 =
-                        Minimum2((*pcInSymb)[i].cSig.imag(),
+                        Minimum2(prImag[i],
                                  rTableQAM64HMsym[iTabInd0][1],
                                  rTableQAM64HMsym[iTabInd0 | 1][1],
-                                 (*pcInSymb)[i].rChan);
+                                 prChan[i]);
                 }
             }
 
@@ -801,11 +806,11 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     ((ExtractBit(vecSubsetDef1[k]) & 1) << 2) |
                     ((ExtractBit(vecSubsetDef2[k]) & 1) << 1);
 
-                vecMetric[k].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                              rTableQAM64HMsym[iTabInd0][0], (*pcInSymb)[i].rChan);
+                vecMetric[k].rTow0 = Minimum1(prReal[i],
+                                              rTableQAM64HMsym[iTabInd0][0], prChan[i]);
 
-                vecMetric[k].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                              rTableQAM64HMsym[iTabInd0 | 1][0], (*pcInSymb)[i].rChan);
+                vecMetric[k].rTow1 = Minimum1(prReal[i],
+                                              rTableQAM64HMsym[iTabInd0 | 1][0], prChan[i]);
 
 
                 /* Imaginary part ------------------------------------------- */
@@ -816,11 +821,11 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     ((ExtractBit(vecSubsetDef2[k + 1]) & 1) << 1);
 
                 /* Calculate distances, imaginary part */
-                vecMetric[k + 1].rTow0 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                                  rTableQAM64HMsym[iTabInd0][1], (*pcInSymb)[i].rChan);
+                vecMetric[k + 1].rTow0 = Minimum1(prImag[i],
+                                                  rTableQAM64HMsym[iTabInd0][1], prChan[i]);
 
-                vecMetric[k + 1].rTow1 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                                  rTableQAM64HMsym[iTabInd0 | 1][1], (*pcInSymb)[i].rChan);
+                vecMetric[k + 1].rTow1 = Minimum1(prImag[i],
+                                                  rTableQAM64HMsym[iTabInd0 | 1][1], prChan[i]);
             }
 
             break;
@@ -848,29 +853,29 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         (ExtractBit(vecSubsetDef5[i]) & 1) |
                         ((ExtractBit(vecSubsetDef3[i]) & 1) << 1);
 
-                    vecMetric[i].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                                  rTableQAM64HMmix[iTabInd0][0], (*pcInSymb)[i].rChan);
+                    vecMetric[i].rTow0 = Minimum1(prReal[i],
+                                                  rTableQAM64HMmix[iTabInd0][0], prChan[i]);
 
-                    vecMetric[i].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
+                    vecMetric[i].rTow1 = Minimum1(prReal[i],
                                                   rTableQAM64HMmix[iTabInd0 | (1 << 2)][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
                 }
                 else
                 {
                     /* Real part -------------------------------------------- */
-                    vecMetric[i].rTow0 = Minimum4((*pcInSymb)[i].cSig.real(),
+                    vecMetric[i].rTow0 = Minimum4(prReal[i],
                                                   rTableQAM64HMmix[BI_000 /* [0 0 0] */][0],
                                                   rTableQAM64HMmix[BI_001 /* [0 0 1] */][0],
                                                   rTableQAM64HMmix[BI_010 /* [0 1 0] */][0],
                                                   rTableQAM64HMmix[BI_011 /* [0 1 1] */][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
 
-                    vecMetric[i].rTow1 = Minimum4((*pcInSymb)[i].cSig.real(),
+                    vecMetric[i].rTow1 = Minimum4(prReal[i],
                                                   rTableQAM64HMmix[BI_100 /* [1 0 0] */][0],
                                                   rTableQAM64HMmix[BI_101 /* [1 0 1] */][0],
                                                   rTableQAM64HMmix[BI_110 /* [1 1 0] */][0],
                                                   rTableQAM64HMmix[BI_111 /* [1 1 1] */][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
                 }
             }
 
@@ -889,29 +894,29 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         ((ExtractBit(vecSubsetDef4[i]) & 1) << 1);
 
                     /* Calculate distances, imaginary part */
-                    vecMetric[i].rTow0 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                                  rTableQAM64HMmix[iTabInd0][1], (*pcInSymb)[i].rChan);
+                    vecMetric[i].rTow0 = Minimum1(prImag[i],
+                                                  rTableQAM64HMmix[iTabInd0][1], prChan[i]);
 
-                    vecMetric[i].rTow1 = Minimum1((*pcInSymb)[i].cSig.imag(),
+                    vecMetric[i].rTow1 = Minimum1(prImag[i],
                                                   rTableQAM64HMmix[iTabInd0 | (1 << 2)][1],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
                 }
                 else
                 {
                     /* Imaginary part --------------------------------------- */
-                    vecMetric[i].rTow0 = Minimum4((*pcInSymb)[i].cSig.imag(),
+                    vecMetric[i].rTow0 = Minimum4(prImag[i],
                                                   rTableQAM64HMmix[BI_000 /* [0 0 0] */][1],
                                                   rTableQAM64HMmix[BI_001 /* [0 0 1] */][1],
                                                   rTableQAM64HMmix[BI_010 /* [0 1 0] */][1],
                                                   rTableQAM64HMmix[BI_011 /* [0 1 1] */][1],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
 
-                    vecMetric[i].rTow1 = Minimum4((*pcInSymb)[i].cSig.imag(),
+                    vecMetric[i].rTow1 = Minimum4(prImag[i],
                                                   rTableQAM64HMmix[BI_100 /* [1 0 0] */][1],
                                                   rTableQAM64HMmix[BI_101 /* [1 0 1] */][1],
                                                   rTableQAM64HMmix[BI_110 /* [1 1 0] */][1],
                                                   rTableQAM64HMmix[BI_111 /* [1 1 1] */][1],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
                 }
             }
 
@@ -929,12 +934,12 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         ((ExtractBit(vecSubsetDef1[i]) & 1) << 2) |
                         (ExtractBit(vecSubsetDef5[i]) & 1);
 
-                    vecMetric[i].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                                  rTableQAM64HMmix[iTabInd0][0], (*pcInSymb)[i].rChan);
+                    vecMetric[i].rTow0 = Minimum1(prReal[i],
+                                                  rTableQAM64HMmix[iTabInd0][0], prChan[i]);
 
-                    vecMetric[i].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
+                    vecMetric[i].rTow1 = Minimum1(prReal[i],
                                                   rTableQAM64HMmix[iTabInd0 | (1 << 1)][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
                 }
                 else
                 {
@@ -944,17 +949,17 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
 
                     /* Real part -------------------------------------------- */
                     iTabInd0 = ((ExtractBit(vecSubsetDef1[i]) & 1) << 2);
-                    vecMetric[i].rTow0 = Minimum2((*pcInSymb)[i].cSig.real(),
+                    vecMetric[i].rTow0 = Minimum2(prReal[i],
                                                   rTableQAM64HMmix[iTabInd0][0],
                                                   rTableQAM64HMmix[iTabInd0 | 1][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
 
                     iTabInd0 =
                         ((ExtractBit(vecSubsetDef1[i]) & 1) << 2) | (1 << 1);
-                    vecMetric[i].rTow1 = Minimum2((*pcInSymb)[i].cSig.real(),
+                    vecMetric[i].rTow1 = Minimum2(prReal[i],
                                                   rTableQAM64HMmix[iTabInd0][0],
                                                   rTableQAM64HMmix[iTabInd0 | 1][0],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
                 }
             }
 
@@ -972,12 +977,12 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                         ((ExtractBit(vecSubsetDef2[i]) & 1) << 2) |
                         (ExtractBit(vecSubsetDef6[i]) & 1);
 
-                    vecMetric[i].rTow0 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                                  rTableQAM64HMmix[iTabInd0][1], (*pcInSymb)[i].rChan);
+                    vecMetric[i].rTow0 = Minimum1(prImag[i],
+                                                  rTableQAM64HMmix[iTabInd0][1], prChan[i]);
 
-                    vecMetric[i].rTow1 = Minimum1((*pcInSymb)[i].cSig.imag(),
+                    vecMetric[i].rTow1 = Minimum1(prImag[i],
                                                   rTableQAM64HMmix[iTabInd0 | (1 << 1)][1],
-                                                  (*pcInSymb)[i].rChan);
+                                                  prChan[i]);
                 }
                 else
                 {
@@ -987,15 +992,15 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
 
                     /* Imaginary part ------------------------------------------- */
                     iTabInd0 = ((ExtractBit(vecSubsetDef2[i]) & 1) << 2);
-                    vecMetric[i].rTow0 = Minimum2((*pcInSymb)[i].cSig.imag(),
+                    vecMetric[i].rTow0 = Minimum2(prImag[i],
                                                   rTableQAM64HMmix[iTabInd0][1],
-                                                  rTableQAM64HMmix[iTabInd0 | 1][1], (*pcInSymb)[i].rChan);
+                                                  rTableQAM64HMmix[iTabInd0 | 1][1], prChan[i]);
 
                     iTabInd0 =
                         ((ExtractBit(vecSubsetDef2[i]) & 1) << 2) | (1 << 1);
-                    vecMetric[i].rTow1 = Minimum2((*pcInSymb)[i].cSig.imag(),
+                    vecMetric[i].rTow1 = Minimum2(prImag[i],
                                                   rTableQAM64HMmix[iTabInd0][1],
-                                                  rTableQAM64HMmix[iTabInd0 | 1][1], (*pcInSymb)[i].rChan);
+                                                  rTableQAM64HMmix[iTabInd0 | 1][1], prChan[i]);
                 }
             }
 
@@ -1011,11 +1016,11 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     ((ExtractBit(vecSubsetDef1[i]) & 1) << 2) |
                     ((ExtractBit(vecSubsetDef3[i]) & 1) << 1);
 
-                vecMetric[i].rTow0 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                              rTableQAM64HMmix[iTabInd0][0], (*pcInSymb)[i].rChan);
+                vecMetric[i].rTow0 = Minimum1(prReal[i],
+                                              rTableQAM64HMmix[iTabInd0][0], prChan[i]);
 
-                vecMetric[i].rTow1 = Minimum1((*pcInSymb)[i].cSig.real(),
-                                              rTableQAM64HMmix[iTabInd0 | 1][0], (*pcInSymb)[i].rChan);
+                vecMetric[i].rTow1 = Minimum1(prReal[i],
+                                              rTableQAM64HMmix[iTabInd0 | 1][0], prChan[i]);
             }
 
             break;
@@ -1031,11 +1036,11 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
                     ((ExtractBit(vecSubsetDef4[i]) & 1) << 1);
 
                 /* Calculate distances, imaginary part */
-                vecMetric[i].rTow0 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                              rTableQAM64HMmix[iTabInd0][1], (*pcInSymb)[i].rChan);
+                vecMetric[i].rTow0 = Minimum1(prImag[i],
+                                              rTableQAM64HMmix[iTabInd0][1], prChan[i]);
 
-                vecMetric[i].rTow1 = Minimum1((*pcInSymb)[i].cSig.imag(),
-                                              rTableQAM64HMmix[iTabInd0 | 1][1], (*pcInSymb)[i].rChan);
+                vecMetric[i].rTow1 = Minimum1(prImag[i],
+                                              rTableQAM64HMmix[iTabInd0 | 1][1], prChan[i]);
             }
 
             break;
@@ -1051,7 +1056,7 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
         for (i = 0; i < iInputBlockSize; i++)
         {
             /* If input symbol is erasure, reset metrics to zero */
-            if ((*pcInSymb)[i].rChan == ERASURE_TAG_VALUE)
+            if (prChan[i] == ERASURE_TAG_VALUE)
             {
                 vecMetric[2 * i].rTow0 = (_REAL) 0.0;
                 vecMetric[2 * i].rTow1 = (_REAL) 0.0;
@@ -1065,7 +1070,7 @@ void CMLCMetric::CalculateMetric(CVector<CEquSig>* pcInSymb,
         for (i = 0; i < iInputBlockSize; i++)
         {
             /* If input symbol is erasure, reset metrics to zero */
-            if ((*pcInSymb)[i].rChan == ERASURE_TAG_VALUE)
+            if (prChan[i] == ERASURE_TAG_VALUE)
             {
                 vecMetric[i].rTow0 = (_REAL) 0.0;
                 vecMetric[i].rTow1 = (_REAL) 0.0;
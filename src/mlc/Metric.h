@@ -55,7 +55,7 @@ public:
     virtual ~CMLCMetric() {}
 
     /* Return the number of used symbols for calculating one branch-metric */
-    void CalculateMetric(CVector<CEquSig>* pcInSymb,
+    void CalculateMetric(const CEquSigVec& vecInSymb,
                          CVector<CDistance>& vecMetric,
                          CVector<_DECISION>& vecSubsetDef1,
                          CVector<_DECISION>& vecSubsetDef2,
@@ -35,9 +35,35 @@
 
 #include "../GlobalDefinitions.h"
 #include "CellMappingTable.h"
+#include <map>
+
+
+/* Tables made so far, key is (sample rate, robustness mode, occupancy) */
+typedef pair<int, pair<int, int> > CCellMappingKey;
+static map<CCellMappingKey, CCellMappingTable*> CellMappingTables;
+static CMutex CellMappingTablesMutex;
 
 
 /* Implementation *************************************************************/
+const CCellMappingTable* CCellMappingTable::Get(
+  ERobMode eNewRobustnessMode, ESpecOcc eNewSpectOccup, int iSampleRate)
+{
+	const CCellMappingKey Key(iSampleRate,
+		make_pair(int(eNewRobustnessMode), int(eNewSpectOccup)));
+
+	CellMappingTablesMutex.Lock();
+	CCellMappingTable*& pTable = CellMappingTables[Key];
+	if (pTable == NULL)
+	{
+		pTable = new CCellMappingTable;
+		pTable->MakeTable(eNewRobustnessMode, eNewSpectOccup, iSampleRate);
+	}
+	const CCellMappingTable* pResult = pTable;
+	CellMappingTablesMutex.Unlock();
+
+	return pResult;
+}
+
 void CCellMappingTable::MakeTable(
   ERobMode eNewRobustnessMode, ESpecOcc eNewSpectOccup, int iSampleRate)
 {
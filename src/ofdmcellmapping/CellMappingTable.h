@@ -71,13 +71,17 @@
 
 
 /* Classes ********************************************************************/
+/* The tables only depend on robustness mode, spectrum occupancy and sample
+   rate. Each combination is built once on first use and then shared by all
+   receivers and transmitters of the process, the tables are never changed
+   after they are made */
 class CCellMappingTable
 {
 public:
-	CCellMappingTable() : iNumSymbolsPerSuperframe(0) {}
 	virtual ~CCellMappingTable() {}
 
-	void MakeTable(ERobMode eNewRobustnessMode, ESpecOcc eNewSpectOccup, int iSampleRate);
+	static const CCellMappingTable* Get(ERobMode eNewRobustnessMode,
+		ESpecOcc eNewSpectOccup, int iSampleRate);
 
 	struct CRatio {int iEnum; int iDenom;};
 
@@ -121,6 +125,9 @@ public:
 	_REAL				rAvScatPilPow; /* Average power of scattered pilots per cell */
 
 protected:
+	CCellMappingTable() : iNumSymbolsPerSuperframe(0) {}
+	void MakeTable(ERobMode eNewRobustnessMode, ESpecOcc eNewSpectOccup, int iSampleRate);
+
 	/* Internal parameters for MakeTable function --------------------------- */
 	struct CScatPilots
 	{	
@@ -140,6 +147,10 @@ protected:
 
 
 private:
+	/* Not copyable, the tables are shared by pointer */
+	CCellMappingTable(const CCellMappingTable&);
+	CCellMappingTable& operator=(const CCellMappingTable&);
+
 	_COMPLEX	Polar2Cart(const _REAL rAbsolute, const int iPhase) const;
 	int			mod(const int ix, const int iy) const;
 };
@@ -35,7 +35,7 @@
 \******************************************************************************/
 void COFDMCellMapping::ProcessDataInternal(CParameter& TransmParam)
 {
-	const CCellMappingTable& Param = TransmParam.CellMappingTable;
+	const CCellMappingTable& Param = *TransmParam.pCellMappingTable;
 
 	/* Mapping of the data and pilot cells on the OFDM symbol --------------- */
 	/* Set absolute symbol position */
@@ -114,7 +114,7 @@ void COFDMCellMapping::ProcessDataInternal(CParameter& TransmParam)
 
 void COFDMCellMapping::InitInternal(CParameter& TransmParam)
 {
-	const CCellMappingTable& Param = TransmParam.CellMappingTable;
+	const CCellMappingTable& Param = *TransmParam.pCellMappingTable;
 
 	iNumSymPerFrame = Param.iNumSymPerFrame;
 	iNumCarrier = Param.iNumCarrier;
@@ -155,7 +155,7 @@ void COFDMCellMapping::InitInternal(CParameter& TransmParam)
 \******************************************************************************/
 void COFDMCellDemapping::ProcessDataInternal(CParameter& Parameters)
 {
-	const CCellMappingTable& Param = Parameters.CellMappingTable;
+	const CCellMappingTable& Param = *Parameters.pCellMappingTable;
 
 	/* Set absolute symbol position */
 	const int iSymbolCounterAbs =
@@ -292,7 +292,7 @@ void COFDMCellDemapping::ProcessDataInternal(CParameter& Parameters)
 
 void COFDMCellDemapping::InitInternal(CParameter& Parameters)
 {
-	const CCellMappingTable& Param = Parameters.CellMappingTable;
+	const CCellMappingTable& Param = *Parameters.pCellMappingTable;
 
 	iNumSymPerFrame = Param.iNumSymPerFrame;
 	iNumCarrier = Param.iNumCarrier;
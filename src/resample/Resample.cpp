@@ -13,7 +13,8 @@
  * whereby we perform a linear interpolation between these two samples to get
  * an arbitraty sample grid.
  * The polyphase filter is calculated with Matlab(TM), the associated file
- * is ResampleFilter.m.
+ * is ResampleFilter.m. A longer filter with finer phases is designed at
+ * initialization if high quality is requested.
  *
  ******************************************************************************
  *
@@ -35,6 +36,7 @@
 
 #include "Resample.h"
 #include "ResampleFilter.h"
+#include "../matlib/Matlib.h"
 #ifdef HAVE_SPEEX
 # include <string.h>
 # define RESAMPLING_QUALITY 6 /* 0-10 : 0=fast/bad 10=slow/good */
@@ -51,7 +53,7 @@ int CResample::Resample(CVector<_REAL>* prInput, CVector<_REAL>* prOutput,
 
 	/* Sample-interval of new sample frequency in relation to interpolated
 	   sample-interval */
-	rTStep = (_REAL) INTERP_DECIM_I_D / rRation;
+	rTStep = (_REAL) iNumPhases / rRation;
 
 	/* Init output counter */
 	int im = 0;
@@ -65,20 +67,22 @@ int CResample::Resample(CVector<_REAL>* prInput, CVector<_REAL>* prOutput,
 
 		/* Calculate convolutions for the two interpolation-taps ------------ */
 		/* Phase for the linear interpolation-taps */
-		const int ip1 = ik % INTERP_DECIM_I_D;
-		const int ip2 = (ik + 1) % INTERP_DECIM_I_D;
+		const int ip1 = ik % iNumPhases;
+		const int ip2 = (ik + 1) % iNumPhases;
 
 		/* Sample positions in input vector */
-		const int in1 = (int) (ik / INTERP_DECIM_I_D);
-		const int in2 = (int) ((ik + 1) / INTERP_DECIM_I_D);
+		const int in1 = (int) (ik / iNumPhases);
+		const int in2 = (int) ((ik + 1) / iNumPhases);
 
 		/* Convolution */
+		const float* pfTaps1 = &pfTaps[ip1 * iNumTaps];
+		const float* pfTaps2 = &pfTaps[ip2 * iNumTaps];
 		_REAL ry1 = (_REAL) 0.0;
 		_REAL ry2 = (_REAL) 0.0;
-		for (int i = 0; i < RES_FILT_NUM_TAPS_PER_PHASE; i++)
+		for (int i = 0; i < iNumTaps; i++)
 		{
-			ry1 += fResTaps1To1[ip1][i] * vecrIntBuff[in1 - i];
-			ry2 += fResTaps1To1[ip2][i] * vecrIntBuff[in2 - i];
+			ry1 += pfTaps1[i] * vecrIntBuff[in1 - i];
+			ry2 += pfTaps2[i] * vecrIntBuff[in2 - i];
 		}
 
 
@@ -97,28 +101,65 @@ int CResample::Resample(CVector<_REAL>* prInput, CVector<_REAL>* prOutput,
 	while (rtOut < rBlockDuration);
 
 	/* Set rtOut back */
-	rtOut -= iInputBlockSize * INTERP_DECIM_I_D;
+	rtOut -= iInputBlockSize * iNumPhases;
 
 	return im;
 }
 
-void CResample::Init(const int iNewInputBlockSize)
+void CResample::Init(const int iNewInputBlockSize,
+					 const _BOOLEAN bNewHighQuality)
 {
 	iInputBlockSize = iNewInputBlockSize;
 
+	/* Select the polyphase filter */
+	if (bNewHighQuality == TRUE)
+	{
+		if (vecfHighQualityTaps.Size() == 0)
+			MakeHighQualityFilter();
+
+		pfTaps = &vecfHighQualityTaps[0];
+		iNumTaps = RES_HQ_NUM_TAPS_PER_PHASE;
+		iNumPhases = RES_HQ_NUM_PHASES;
+	}
+	else
+	{
+		pfTaps = &fResTaps1To1[0][0];
+		iNumTaps = RES_FILT_NUM_TAPS_PER_PHASE;
+		iNumPhases = INTERP_DECIM_I_D;
+	}
+
 	/* History size must be one sample larger, because we use always TWO
 	   convolutions */
-	iHistorySize = RES_FILT_NUM_TAPS_PER_PHASE + 1;
+	iHistorySize = iNumTaps + 1;
 
 	/* Calculate block duration */
-	rBlockDuration =
-		(iInputBlockSize + RES_FILT_NUM_TAPS_PER_PHASE) * INTERP_DECIM_I_D;
+	rBlockDuration = (iInputBlockSize + iNumTaps) * iNumPhases;
 
 	/* Allocate memory for internal buffer, clear sample history */
 	vecrIntBuff.Init(iInputBlockSize + iHistorySize, (_REAL) 0.0);
 
 	/* Init absolute time for output stream (at the end of the history part) */
-	rtOut = (_REAL) RES_FILT_NUM_TAPS_PER_PHASE * INTERP_DECIM_I_D;
+	rtOut = (_REAL) iNumTaps * iNumPhases;
+}
+
+void CResample::MakeHighQualityFilter()
+{
+	/* Prototype filter at the upsampled rate. Each phase samples the sinc at
+	   whole input samples, so that it has unity gain on its own */
+	const int iLen = RES_HQ_NUM_TAPS_PER_PHASE * RES_HQ_NUM_PHASES;
+	const CReal rCenter = (CReal) (iLen - 1) / 2;
+	CRealVector vecrWin(Kaiser(iLen, RES_HQ_KAISER_BETA));
+
+	vecfHighQualityTaps.Init(iLen);
+	for (int ip = 0; ip < RES_HQ_NUM_PHASES; ip++)
+	{
+		for (int i = 0; i < RES_HQ_NUM_TAPS_PER_PHASE; i++)
+		{
+			const int m = ip + i * RES_HQ_NUM_PHASES;
+			vecfHighQualityTaps[ip * RES_HQ_NUM_TAPS_PER_PHASE + i] =
+				(float) (Sinc((m - rCenter) / RES_HQ_NUM_PHASES) * vecrWin[m]);
+		}
+	}
 }
 
 #ifdef HAVE_SPEEX
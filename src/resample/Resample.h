@@ -36,18 +36,33 @@
 #endif
 
 
+/* Definitions ****************************************************************/
+/* High quality polyphase filter of CResample, a Kaiser windowed sinc with the
+   cut-off at half the sample rate. About 80 dB image rejection and flat up
+   to 0.45 times the sample rate */
+#define RES_HQ_NUM_TAPS_PER_PHASE	48
+#define RES_HQ_NUM_PHASES			128
+#define RES_HQ_KAISER_BETA			((_REAL) 7.0)
+
+
 /* Classes ********************************************************************/
 class CResample
 {
 public:
-	CResample() {}
+	CResample() : pfTaps(NULL), iNumTaps(0), iNumPhases(0) {}
 	virtual ~CResample() {}
 
-	void Init(const int iNewInputBlockSize);
+	/* "bNewHighQuality" selects the long filter, for signals which must not
+	   be degraded, e.g. the receiver input. It costs four times the
+	   multiplications */
+	void Init(const int iNewInputBlockSize,
+			  const _BOOLEAN bNewHighQuality = FALSE);
 	int Resample(CVector<_REAL>* prInput, CVector<_REAL>* prOutput,
 				 _REAL rRation);
 
 protected:
+	void MakeHighQualityFilter();
+
 	_REAL					rTStep;
 	_REAL					rtOut;
 	_REAL					rBlockDuration;
@@ -56,6 +71,12 @@ protected:
 	int						iHistorySize;
 
 	int						iInputBlockSize;
+
+	/* Polyphase filter [phase][tap] */
+	const float*			pfTaps;
+	int						iNumTaps;
+	int						iNumPhases;
+	CVector<float>			vecfHighQualityTaps;
 };
 
 class CAudioResample
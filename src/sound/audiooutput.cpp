@@ -0,0 +1,287 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Audio output with an adaptive jitter buffer. The decoder delivers audio
+ *	in bursts of one DRM frame, the sound card takes it in small blocks
+ *	from a separate thread with its own clock. The mean fill level of the
+ *	buffer in between is held at the target latency by resampling the
+ *	incoming audio with a ratio close to one, which also takes out the
+ *	drift between the sound card and the transmitter clock without clicks.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "audiooutput.h"
+#include "../util/Latency.h"
+
+
+/* Implementation *************************************************************/
+CAudioOutput::CAudioOutput() :
+#ifdef QT_CORE_LIB
+	pThread(NULL),
+#endif
+	pSound(NULL), iLatencyMs(0), iSampleRate(1), iInputBlockSize(0),
+	iBlockSize(0), iTarget(0), vecsRing(), iRingSize(0), iRead(0), iWrite(0),
+	iFill(0), bXRun(FALSE), bPlaying(FALSE), Mutex(), StopCond(), bStop(FALSE),
+	bRunning(FALSE), ResampleLeft(), ResampleRight(), vecrInLeft(),
+	vecrInRight(), vecrOutLeft(), vecrOutRight(), rRatio((_REAL) 1.0),
+	rIntegral((_REAL) 0.0), rDelay((_REAL) 0.0), bDelayValid(FALSE)
+{
+}
+
+CAudioOutput::~CAudioOutput()
+{
+	Stop();
+}
+
+_BOOLEAN CAudioOutput::IsEnabled() const
+{
+#ifdef QT_CORE_LIB
+	return iLatencyMs > 0;
+#else
+	return FALSE;
+#endif
+}
+
+void CAudioOutput::Start(CSoundOutInterface* pNewSound, const int iNewSampleRate,
+						 const int iNewInputBlockSize)
+{
+	Stop();
+	if (!IsEnabled())
+		return;
+
+	pSound = pNewSound;
+	iSampleRate = iNewSampleRate;
+	iInputBlockSize = iNewInputBlockSize;
+	iBlockSize = iSampleRate * AUDIO_OUT_BLOCK_MS / 1000;
+	iTarget = (int) ((long long) iSampleRate * iLatencyMs / 1000);
+
+	/* The target must leave room for a block on the way to the card */
+	if (iTarget < 2 * iBlockSize)
+		iTarget = 2 * iBlockSize;
+
+	/* A whole input block comes in at once, plus reserve for the delay
+	   control */
+	const int iInLen = iInputBlockSize / 2;
+	iRingSize = iTarget + 2 * iInLen + 4 * iBlockSize;
+	vecsRing.Init(2 * iRingSize, 0);
+	iRead = iWrite = iFill = 0;
+	bXRun = FALSE;
+	bPlaying = FALSE;
+
+	ResampleLeft.Init(iInLen);
+	ResampleRight.Init(iInLen);
+	vecrInLeft.Init(iInLen);
+	vecrInRight.Init(iInLen);
+	const int iMaxOut =
+		(int) (iInLen * ((_REAL) 1.0 + 2 * AUDIO_OUT_MAX_CORRECTION)) + 4;
+	vecrOutLeft.Init(iMaxOut);
+	vecrOutRight.Init(iMaxOut);
+	rRatio = (_REAL) 1.0;
+	rIntegral = (_REAL) 0.0;
+	bDelayValid = FALSE;
+
+	/* Small blocking writes, the card sets the pace of the output thread */
+	pSound->Init(iSampleRate, 2 * iBlockSize, TRUE);
+
+#ifdef QT_CORE_LIB
+	bStop = FALSE;
+	pThread = new COutputThread(*this);
+	pThread->start(QThread::TimeCriticalPriority);
+	bRunning = TRUE;
+#endif
+}
+
+void CAudioOutput::Stop()
+{
+#ifdef QT_CORE_LIB
+	if (pThread != NULL)
+	{
+		Mutex.Lock();
+		bStop = TRUE;
+		StopCond.WakeAll();
+		Mutex.Unlock();
+		pThread->wait();
+		delete pThread;
+		pThread = NULL;
+	}
+#endif
+	bRunning = FALSE;
+}
+
+_BOOLEAN CAudioOutput::Put(CVector<_SAMPLE>& vecsData)
+{
+	int i;
+	const int iInLen = iInputBlockSize / 2;
+
+	for (i = 0; i < iInLen; i++)
+	{
+		vecrInLeft[i] = vecsData[2 * i];
+		vecrInRight[i] = vecsData[2 * i + 1];
+	}
+
+	/* Both channels have the same state, so the same number of samples
+	   comes out */
+	const int iNumOut =
+		ResampleLeft.Resample(&vecrInLeft, &vecrOutLeft, rRatio);
+	(void) ResampleRight.Resample(&vecrInRight, &vecrOutRight, rRatio);
+
+	Mutex.Lock();
+	const int iFillBefore = iFill;
+	const _BOOLEAN bWasPlaying = bPlaying;
+
+	/* The card has stalled, drop the oldest audio */
+	if (iFill + iNumOut > iRingSize)
+	{
+		const int iDrop = iFill + iNumOut - iTarget < iFill ?
+			iFill + iNumOut - iTarget : iFill;
+		iRead = (iRead + iDrop) % iRingSize;
+		iFill -= iDrop;
+		bXRun = TRUE;
+	}
+
+	/* (Re)start with silence in front of the frame, so that the reserve is
+	   at the target when the next frame comes */
+	for (; bWasPlaying == FALSE && iFill < iTarget; iFill++)
+	{
+		vecsRing[2 * iWrite] = 0;
+		vecsRing[2 * iWrite + 1] = 0;
+		if (++iWrite == iRingSize)
+			iWrite = 0;
+	}
+
+	for (i = 0; i < iNumOut; i++)
+	{
+		vecsRing[2 * iWrite] = Real2Sample(vecrOutLeft[i]);
+		vecsRing[2 * iWrite + 1] = Real2Sample(vecrOutRight[i]);
+		if (++iWrite == iRingSize)
+			iWrite = 0;
+	}
+	iFill += iNumOut;
+	bPlaying = TRUE;
+
+	const _BOOLEAN bBad = bXRun;
+	bXRun = FALSE;
+	Mutex.Unlock();
+
+	/* Only a playing buffer is drained, while it fills up again the delay
+	   says nothing about the clocks */
+	if (bWasPlaying == TRUE)
+		Control(iFillBefore, iNumOut);
+	else
+		bDelayValid = FALSE;
+
+	return bBad;
+}
+
+void CAudioOutput::Control(const int iFillBefore, const int iNumNew)
+{
+	/* The fill level is a saw tooth, a whole block comes in and is drained
+	   continuously. The low point just before a new block is the reserve
+	   against drop-outs, this is what is held at the target. It is only
+	   known to one sound card block, hence the smoothing */
+	if (bDelayValid == FALSE)
+	{
+		rDelay = (_REAL) iFillBefore;
+		bDelayValid = TRUE;
+	}
+	else
+	{
+		rDelay = AUDIO_OUT_DELAY_LAMBDA * rDelay +
+			((_REAL) 1.0 - AUDIO_OUT_DELAY_LAMBDA) * iFillBefore;
+	}
+
+	/* PI controller, critically damped. The integral part converges to the
+	   relative clock drift */
+	const _REAL rError = (rDelay - iTarget) / iSampleRate; /* s */
+	const _REAL rDt = (_REAL) iNumNew / iSampleRate;
+	rIntegral += rError * rDt / (AUDIO_OUT_TIME_CONST_S * AUDIO_OUT_TIME_CONST_S);
+	if (rIntegral > AUDIO_OUT_MAX_CORRECTION)
+		rIntegral = AUDIO_OUT_MAX_CORRECTION;
+	if (rIntegral < -AUDIO_OUT_MAX_CORRECTION)
+		rIntegral = -AUDIO_OUT_MAX_CORRECTION;
+
+	_REAL rCorrection = 2 * rError / AUDIO_OUT_TIME_CONST_S + rIntegral;
+	if (rCorrection > AUDIO_OUT_MAX_CORRECTION)
+		rCorrection = AUDIO_OUT_MAX_CORRECTION;
+	if (rCorrection < -AUDIO_OUT_MAX_CORRECTION)
+		rCorrection = -AUDIO_OUT_MAX_CORRECTION;
+
+	/* Too much delay: fewer output samples */
+	rRatio = (_REAL) 1.0 - rCorrection;
+}
+
+void CAudioOutput::Run()
+{
+	CVector<_SAMPLE> vecsBlock(2 * iBlockSize, 0);
+	const uint64_t iBlockNs = (uint64_t) iBlockSize * 1000000000 / iSampleRate;
+	uint64_t iNextNs = CLatencyStats::GetTimeNs();
+
+	Mutex.Lock();
+	while (bStop == FALSE)
+	{
+		/* Silence until the next frame restarts the playback */
+		if (bPlaying == TRUE && iFill < iBlockSize)
+		{
+			bPlaying = FALSE;
+			bXRun = TRUE;
+		}
+
+		int i;
+		if (bPlaying == TRUE)
+		{
+			for (i = 0; i < iBlockSize; i++)
+			{
+				vecsBlock[2 * i] = vecsRing[2 * iRead];
+				vecsBlock[2 * i + 1] = vecsRing[2 * iRead + 1];
+				if (++iRead == iRingSize)
+					iRead = 0;
+			}
+			iFill -= iBlockSize;
+		}
+		else
+		{
+			for (i = 0; i < 2 * iBlockSize; i++)
+				vecsBlock[i] = 0;
+		}
+		Mutex.Unlock();
+
+		(void) pSound->Write(vecsBlock);
+
+		/* Outputs which do not block are paced here. A blocking card may
+		   take a few blocks ahead into its own buffer */
+		iNextNs += iBlockNs;
+		const uint64_t iNowNs = CLatencyStats::GetTimeNs();
+
+		Mutex.Lock();
+		if (iNowNs > iNextNs + 4 * iBlockNs)
+			iNextNs = iNowNs; /* the card took longer, follow it */
+		else if (iNextNs > iNowNs + 2 * iBlockNs && bStop == FALSE)
+		{
+			const unsigned long iWaitMs =
+				(unsigned long) ((iNextNs - iNowNs - 2 * iBlockNs) / 1000000);
+			if (iWaitMs > 0)
+				(void) StopCond.Wait(&Mutex, iWaitMs);
+		}
+	}
+	Mutex.Unlock();
+}
@@ -0,0 +1,132 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Audio output with an adaptive jitter buffer. See audiooutput.cpp.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef _AUDIOOUTPUT_H
+#define _AUDIOOUTPUT_H
+
+#include "soundinterface.h"
+#include "../resample/Resample.h"
+
+#ifdef QT_CORE_LIB
+# include <QThread>
+#endif
+
+
+/* Definitions ****************************************************************/
+/* Block written to the sound card at once */
+#define AUDIO_OUT_BLOCK_MS			20
+/* Maximum deviation of the resampling ratio from one, 2000 ppm are far
+   more than any sound card drift and still inaudible */
+#define AUDIO_OUT_MAX_CORRECTION	((_REAL) 0.002)
+/* Time constant of the delay control loop */
+#define AUDIO_OUT_TIME_CONST_S		((_REAL) 20.0)
+/* Smoothing of the measured delay, per input block */
+#define AUDIO_OUT_DELAY_LAMBDA		((_REAL) 0.9)
+
+
+/* Classes ********************************************************************/
+class CAudioOutput
+{
+public:
+	CAudioOutput();
+	virtual ~CAudioOutput();
+
+	/* Reserve in ms, what the buffer still holds when the next frame
+	   arrives. The control loop keeps it at this value. 0 switches the
+	   buffer off. Takes effect at the next Start() */
+	void SetLatency(const int iNewLatencyMs) {iLatencyMs = iNewLatencyMs;}
+	int GetLatency() const {return iLatencyMs;}
+
+	/* Output thread available and a latency set */
+	_BOOLEAN IsEnabled() const;
+
+	/* Opens "pNewSound" with small blocks and starts the output thread.
+	   Each Put() brings "iNewInputBlockSize" stereo samples */
+	void Start(CSoundOutInterface* pNewSound, const int iNewSampleRate,
+		const int iNewInputBlockSize);
+	void Stop();
+	_BOOLEAN IsRunning() const {return bRunning;}
+
+	/* Receiver thread. Returns TRUE if the buffer ran empty or over since the
+	   last call, like CSoundOutInterface::Write() on errors */
+	_BOOLEAN Put(CVector<_SAMPLE>& vecsData);
+
+	/* Smoothed reserve of the buffer and the current resampling ratio */
+	_REAL GetDelayMs() const {return rDelay * 1000 / iSampleRate;}
+	_REAL GetRatio() const {return rRatio;}
+
+protected:
+	void Run();
+	void Control(const int iFillBefore, const int iNumNew);
+
+#ifdef QT_CORE_LIB
+	class COutputThread : public QThread
+	{
+	public:
+		COutputThread(CAudioOutput& NewOutput) : Output(NewOutput) {}
+	protected:
+		virtual void run() {Output.Run();}
+		CAudioOutput& Output;
+	};
+	COutputThread*		pThread;
+#endif
+
+	CSoundOutInterface*	pSound;
+	int					iLatencyMs;
+	int					iSampleRate;
+	int					iInputBlockSize; /* stereo samples */
+	int					iBlockSize; /* per channel */
+	int					iTarget; /* per channel */
+
+	/* Stereo ring, guarded by Mutex */
+	CVector<_SAMPLE>	vecsRing;
+	int					iRingSize; /* per channel */
+	int					iRead;
+	int					iWrite;
+	int					iFill;
+	_BOOLEAN			bXRun;
+	_BOOLEAN			bPlaying; /* FALSE from a drop-out to the next frame */
+
+	CMutex				Mutex;
+	CWaitCondition		StopCond;
+	volatile _BOOLEAN	bStop;
+	_BOOLEAN			bRunning;
+
+	/* Drift compensation, receiver thread only */
+	CResample			ResampleLeft;
+	CResample			ResampleRight;
+	CVector<_REAL>		vecrInLeft;
+	CVector<_REAL>		vecrInRight;
+	CVector<_REAL>		vecrOutLeft;
+	CVector<_REAL>		vecrOutRight;
+	_REAL				rRatio;
+	_REAL				rIntegral;
+	_REAL				rDelay; /* per channel samples */
+	_BOOLEAN			bDelayValid;
+};
+
+#endif
@@ -0,0 +1,85 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Layout of the shared memory I/Q ring, for SDR programs which feed one or
+ *	more receivers (see shmiqin.cpp). Plain C, so that it can be included
+ *	by the writer as it is.
+ *
+ *	The ring is a POSIX shared memory object created by the writer, e.g.
+ *	"/dream_iq", and selected in the receiver as sound in device
+ *	"shm:/dream_iq". It is laid out as
+ *
+ *		SHM_IQ_HEADER, padded to SHM_IQ_DATA_OFFSET bytes
+ *		ring_frames I/Q frames of frame_size bytes
+ *
+ *	A frame is one I/Q pair, I first, as int16 or float32 (full scale
+ *	+-1.0) in the byte order of the machine. The data size must be a
+ *	multiple of the page size, the readers map it twice in a row and read
+ *	blocks across the end of the ring in place.
+ *
+ *	The writer does not wait for the readers. For each block it
+ *	1. writes the frames at position write_count % ring_frames,
+ *	2. increments seq (odd: update in progress), memory barrier,
+ *	3. sets write_count += frames and write_time_ns,
+ *	4. memory barrier, increments seq (even again).
+ *	A reader which falls behind by more than half of the ring loses
+ *	samples. The ring should hold a second or more.
+ *
+ *	The fixed fields are set before magic, the readers check magic and
+ *	version when they open the ring. Setting magic to 0 tells the readers
+ *	that the writer has gone.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef _SHMIQ_H
+#define _SHMIQ_H
+
+#include <stdint.h>
+
+#define SHM_IQ_MAGIC		0x51494d44 /* "DMIQ" in little endian */
+#define SHM_IQ_VERSION		1
+#define SHM_IQ_DATA_OFFSET	4096 /* bytes, page aligned */
+
+/* Sample formats */
+#define SHM_IQ_INT16		0
+#define SHM_IQ_FLOAT32		1
+
+typedef struct
+{
+	/* Fixed while the ring exists */
+	volatile uint32_t	magic;
+	uint32_t			version;
+	uint32_t			format;
+	uint32_t			frame_size; /* bytes of one I/Q pair, 4 or 8 */
+	uint32_t			sample_rate; /* Hz */
+	uint32_t			ring_frames;
+	int64_t				centre_freq; /* Hz, of the frequency 0 of the I/Q */
+
+	/* Updated by the writer, see above */
+	volatile uint32_t	seq;
+	uint32_t			reserved;
+	volatile uint64_t	write_count; /* frames since the start */
+	volatile uint64_t	write_time_ns; /* CLOCK_REALTIME of frame write_count */
+} SHM_IQ_HEADER;
+
+#endif
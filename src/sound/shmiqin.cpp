@@ -0,0 +1,328 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	I/Q input from a shared memory ring written by an SDR program (layout
+ *	and protocol in shmiq.h). Any number of receivers can read the same
+ *	ring, each with its own read position. The data part is mapped twice in
+ *	a row, so that every block is contiguous and handed to CReceiveData in
+ *	place with ReadInPlace(), without copies.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "shmiqin.h"
+#include "../util/Latency.h"
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sched.h>
+
+
+/* Implementation *************************************************************/
+CShmIQIn::CShmIQIn() : strDevice(), bReported(FALSE), pHeader(NULL),
+	pData(NULL), iMapSize(0), iFrameSize(0), iRingFrames(0), iReadCount(0),
+	bStarted(FALSE), bStalled(FALSE), iStalledSeq(0), iBlockTimeNs(0),
+	iSampleRate(0), vecZeros()
+{
+}
+
+CShmIQIn::~CShmIQIn()
+{
+	Unmap();
+}
+
+_BOOLEAN CShmIQIn::IsShmDevice(const string& strDevice)
+{
+	return strDevice.compare(0, sizeof(SHM_IQ_DEVICE_PREFIX) - 1,
+		SHM_IQ_DEVICE_PREFIX) == 0;
+}
+
+void CShmIQIn::Enumerate(vector<string>& names, vector<string>& descriptions)
+{
+	names.clear();
+	descriptions.clear();
+	if (pHeader != NULL)
+	{
+		names.push_back(strDevice);
+		descriptions.push_back("I/Q ring");
+	}
+}
+
+void CShmIQIn::SetDev(string sNewDevice)
+{
+	if (sNewDevice != strDevice)
+	{
+		Unmap();
+		strDevice = sNewDevice;
+		bReported = FALSE;
+		(void) Open();
+	}
+}
+
+_BOOLEAN CShmIQIn::Init(int iNewSampleRate, int, _BOOLEAN)
+{
+	iSampleRate = iNewSampleRate;
+	bStarted = FALSE; /* start at the newest samples */
+
+	const _BOOLEAN bChanged = pHeader == NULL;
+	if (Open() == TRUE && GetSampleRate() != iSampleRate)
+	{
+		cerr << strDevice << ": sample rate " << GetSampleRate() << " Hz, "
+			<< iSampleRate << " Hz expected" << endl;
+	}
+	return bChanged;
+}
+
+void CShmIQIn::Close()
+{
+	Unmap();
+}
+
+_BOOLEAN CShmIQIn::Open()
+{
+	if (pHeader != NULL)
+		return TRUE;
+
+	if (!IsShmDevice(strDevice))
+		return FALSE;
+
+	const string strName = strDevice.substr(sizeof(SHM_IQ_DEVICE_PREFIX) - 1);
+	const int fd = shm_open(strName.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+	{
+		if (bReported == FALSE)
+			cerr << strDevice << ": waiting for the writer" << endl;
+		bReported = TRUE;
+		return FALSE;
+	}
+
+	/* Check the header on its own first */
+	struct stat st;
+	const SHM_IQ_HEADER* pH = NULL;
+	if (fstat(fd, &st) == 0 && st.st_size >= SHM_IQ_DATA_OFFSET)
+	{
+		void* p = mmap(NULL, SHM_IQ_DATA_OFFSET, PROT_READ, MAP_SHARED, fd, 0);
+		if (p != MAP_FAILED)
+			pH = (const SHM_IQ_HEADER*) p;
+	}
+
+	const size_t iPage = (size_t) sysconf(_SC_PAGESIZE);
+	_BOOLEAN bOk = pH != NULL && pH->magic == SHM_IQ_MAGIC &&
+		pH->version == SHM_IQ_VERSION && pH->sample_rate > 0 &&
+		((pH->format == SHM_IQ_INT16 && pH->frame_size == 4) ||
+		(pH->format == SHM_IQ_FLOAT32 && pH->frame_size == 8));
+	size_t iDataBytes = 0;
+	if (bOk == TRUE)
+	{
+		iFrameSize = pH->frame_size;
+		iRingFrames = pH->ring_frames;
+		iDataBytes = (size_t) iRingFrames * iFrameSize;
+		bOk = iDataBytes > 0 && iDataBytes % iPage == 0 &&
+			SHM_IQ_DATA_OFFSET % iPage == 0 &&
+			(size_t) st.st_size >= SHM_IQ_DATA_OFFSET + iDataBytes;
+	}
+	if (pH != NULL)
+		munmap((void*) pH, SHM_IQ_DATA_OFFSET);
+
+	/* Reserve the address range, then put the object and the data part a
+	   second time into it */
+	char* pBase = NULL;
+	if (bOk == TRUE)
+	{
+		iMapSize = SHM_IQ_DATA_OFFSET + 2 * iDataBytes;
+		void* p = mmap(NULL, iMapSize, PROT_NONE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		bOk = p != MAP_FAILED;
+		if (bOk == TRUE)
+		{
+			pBase = (char*) p;
+			bOk = mmap(pBase, SHM_IQ_DATA_OFFSET + iDataBytes, PROT_READ,
+				MAP_SHARED | MAP_FIXED, fd, 0) != MAP_FAILED &&
+				mmap(pBase + SHM_IQ_DATA_OFFSET + iDataBytes, iDataBytes,
+				PROT_READ, MAP_SHARED | MAP_FIXED, fd, SHM_IQ_DATA_OFFSET)
+				!= MAP_FAILED;
+			if (bOk == FALSE)
+				munmap(pBase, iMapSize);
+		}
+	}
+	close(fd);
+
+	if (bOk == FALSE)
+	{
+		if (bReported == FALSE)
+			cerr << strDevice << ": not a usable I/Q ring" << endl;
+		bReported = TRUE;
+		return FALSE;
+	}
+
+	pHeader = (const volatile SHM_IQ_HEADER*) pBase;
+	pData = pBase + SHM_IQ_DATA_OFFSET;
+	bStarted = FALSE;
+	bStalled = FALSE;
+	bReported = FALSE;
+	return TRUE;
+}
+
+void CShmIQIn::Unmap()
+{
+	/* The writer owns the object, it is not unlinked */
+	if (pHeader != NULL)
+	{
+		munmap((void*) pHeader, iMapSize);
+		pHeader = NULL;
+		pData = NULL;
+	}
+}
+
+int CShmIQIn::GetSampleRate() const
+{
+	return pHeader == NULL ? 0 : (int) pHeader->sample_rate;
+}
+
+int64_t CShmIQIn::GetCentreFrequency() const
+{
+	return pHeader == NULL ? 0 : pHeader->centre_freq;
+}
+
+_BOOLEAN CShmIQIn::GetWritePos(uint64_t& iCount, uint64_t& iTimeNs) const
+{
+	/* Sequence lock, the writer might be halfway through an update. A
+	   writer which died there leaves "seq" odd */
+	for (int i = 0; i < 1000; i++)
+	{
+		const uint32_t iSeq = pHeader->seq;
+		__sync_synchronize();
+		iCount = pHeader->write_count;
+		iTimeNs = pHeader->write_time_ns;
+		__sync_synchronize();
+		if ((iSeq & 1) == 0 && iSeq == pHeader->seq)
+			return TRUE;
+		sched_yield();
+	}
+	return FALSE;
+}
+
+const void* CShmIQIn::Silence(int iFrames, ESampleFormat& eFormat)
+{
+	/* Paced like a sound card, so that the receiver does not spin */
+	if (iSampleRate > 0)
+		usleep((useconds_t) ((uint64_t) iFrames * 1000000 / iSampleRate));
+
+	vecZeros.assign((size_t) iFrames * 2 * sizeof(_SAMPLE), 0);
+	eFormat = SF_INT16;
+	return &vecZeros[0];
+}
+
+const void* CShmIQIn::ReadInPlace(int iFrames, ESampleFormat& eFormat,
+								  _BOOLEAN& bError)
+{
+	bError = TRUE;
+
+	/* The writer may come, go and come back */
+	if (pHeader != NULL && pHeader->magic != SHM_IQ_MAGIC)
+		Unmap();
+	if (Open() == FALSE || (uint64_t) iFrames > iRingFrames / 2)
+		return Silence(iFrames, eFormat);
+
+	/* After a timeout only a new update of the writer ends the silence */
+	if (bStalled == TRUE)
+	{
+		if (pHeader->seq == iStalledSeq)
+			return Silence(iFrames, eFormat);
+		bStalled = FALSE;
+	}
+
+	const uint64_t iStartNs = CLatencyStats::GetTimeNs();
+	uint64_t iCount = 0, iTimeNs = 0;
+	for (;;)
+	{
+		if (GetWritePos(iCount, iTimeNs) == TRUE)
+		{
+			if (bStarted == FALSE)
+			{
+				iReadCount = iCount;
+				bStarted = TRUE;
+			}
+			if (iCount - iReadCount >= (uint64_t) iFrames)
+				break;
+		}
+
+		if (CLatencyStats::GetTimeNs() - iStartNs >
+			(uint64_t) SHM_IQ_TIMEOUT_MS * 1000000)
+		{
+			bStalled = TRUE;
+			iStalledSeq = pHeader->seq;
+			return Silence(iFrames, eFormat);
+		}
+
+		/* Sleep for about half of what is missing */
+		const uint64_t iMissing = bStarted == TRUE ?
+			iReadCount + iFrames - iCount : (uint64_t) iFrames;
+		uint64_t iSleepUs = iMissing * 500000 / pHeader->sample_rate;
+		if (iSleepUs < 500)
+			iSleepUs = 500;
+		usleep((useconds_t) iSleepUs);
+	}
+
+	bError = FALSE;
+
+	/* The writer went round us or is about to. It may be filling the frames
+	   after iCount and goes on while the block is processed in place, so
+	   half of the ring is kept free. Continue with the newest samples */
+	if (iCount - iReadCount > iRingFrames / 2)
+	{
+		iReadCount = iCount - iFrames;
+		bError = TRUE;
+	}
+
+	iBlockTimeNs = iTimeNs -
+		(iCount - iReadCount) * 1000000000 / pHeader->sample_rate;
+	eFormat = pHeader->format == SHM_IQ_FLOAT32 ? SF_FLOAT32 : SF_INT16;
+
+	const void* p = pData + (size_t) (iReadCount % iRingFrames) * iFrameSize;
+	iReadCount += iFrames;
+	return p;
+}
+
+_BOOLEAN CShmIQIn::Read(CVector<short>& psData)
+{
+	const int iFrames = psData.Size() / 2;
+	ESampleFormat eFormat;
+	_BOOLEAN bError;
+	const void* p = ReadInPlace(iFrames, eFormat, bError);
+
+	if (eFormat == SF_FLOAT32)
+	{
+		const float* pf = (const float*) p;
+		for (int i = 0; i < 2 * iFrames; i++)
+			psData[i] = Real2Sample(pf[i] * 32768);
+	}
+	else
+	{
+		const _SAMPLE* ps = (const _SAMPLE*) p;
+		for (int i = 0; i < 2 * iFrames; i++)
+			psData[i] = ps[i];
+	}
+	return bError;
+}
@@ -0,0 +1,97 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	I/Q input from a shared memory ring. See shmiqin.cpp and shmiq.h.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef _SHMIQIN_H
+#define _SHMIQIN_H
+
+#include "soundinterface.h"
+#include "shmiq.h"
+#include <vector>
+
+
+/* Definitions ****************************************************************/
+/* Device names of the ring start with this */
+#define SHM_IQ_DEVICE_PREFIX	"shm:"
+/* Without new samples for this long the input delivers silence */
+#define SHM_IQ_TIMEOUT_MS		1000
+
+
+/* Classes ********************************************************************/
+class CShmIQIn : public CSoundInInterface
+{
+public:
+	CShmIQIn();
+	virtual ~CShmIQIn();
+
+	static _BOOLEAN IsShmDevice(const string& strDevice);
+
+	virtual void		Enumerate(vector<string>& names,
+							vector<string>& descriptions);
+	/* "shm:<object name>". The ring is opened as soon as the writer has
+	   created it */
+	virtual void		SetDev(string sNewDevice);
+	virtual string		GetDev() {return strDevice;}
+
+	virtual _BOOLEAN	Init(int iNewSampleRate, int iNewBufferSize,
+							 _BOOLEAN bNewBlocking);
+	virtual _BOOLEAN	Read(CVector<short>& psData);
+	virtual void		Close();
+	virtual const void*	ReadInPlace(int iFrames, ESampleFormat& eFormat,
+									_BOOLEAN& bError);
+
+	/* From the ring header, 0 while it is not open */
+	int					GetSampleRate() const;
+	int64_t				GetCentreFrequency() const;
+	/* CLOCK_REALTIME of the first frame of the last block, ns */
+	uint64_t			GetTimestamp() const {return iBlockTimeNs;}
+
+protected:
+	_BOOLEAN			Open();
+	void				Unmap();
+	_BOOLEAN			GetWritePos(uint64_t& iCount, uint64_t& iTimeNs) const;
+	const void*			Silence(int iFrames, ESampleFormat& eFormat);
+
+	string				strDevice;
+	_BOOLEAN			bReported; /* open error already printed */
+
+	/* Header and data, the data mapped twice in a row */
+	const volatile SHM_IQ_HEADER*	pHeader;
+	const char*			pData;
+	size_t				iMapSize;
+	size_t				iFrameSize;
+	uint64_t			iRingFrames;
+
+	uint64_t			iReadCount;
+	_BOOLEAN			bStarted;
+	_BOOLEAN			bStalled; /* timed out, writer seq was iStalledSeq */
+	uint32_t			iStalledSeq;
+	uint64_t			iBlockTimeNs;
+	int					iSampleRate; /* requested, for the pacing without ring */
+	vector<char>		vecZeros;
+};
+
+#endif
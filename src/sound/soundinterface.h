@@ -35,6 +35,8 @@
 class CSoundInInterface : public CSelectionInterface
 {
 public:
+    enum ESampleFormat {SF_INT16, SF_FLOAT32};
+
     virtual 		~CSoundInInterface() {}
 
     /* sound card interface - used by ReadData */
@@ -42,6 +44,15 @@ public:
     virtual _BOOLEAN Read(CVector<short>& psData)=0;
     virtual void     Close()=0;
 
+    /* Zero copy alternative to Read() for interfaces which hold the samples
+       in memory: the next "iFrames" stereo frames in place, valid until the
+       next call. NULL if not supported, then Read() is used */
+    virtual const void* ReadInPlace(int iFrames, ESampleFormat& eFormat,
+                                    _BOOLEAN& bError)
+    {
+        (void) iFrames; (void) eFormat; (void) bError;
+        return NULL;
+    }
 };
 
 class CSoundOutInterface : public CSelectionInterface
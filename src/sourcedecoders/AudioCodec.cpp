@@ -31,45 +31,29 @@
 #include "aac_codec.h"
 #include "opus_codec.h"
 
-vector<CAudioCodec*>
-CAudioCodec::CodecList;
-
-int
-CAudioCodec::RefCount = 0;
-
-void
-CAudioCodec::InitCodecList()
+CAudioCodecList::CAudioCodecList()
 {
-	if (CodecList.size() == 0)
-	{
-		/* Null codec, MUST be the first */
-		CodecList.push_back(new NullCodec);
+	/* Null codec, MUST be the first */
+	CodecList.push_back(new NullCodec);
 
-		/* AAC */
-		CodecList.push_back(new AacCodec);
+	/* AAC */
+	CodecList.push_back(new AacCodec);
 
-		/* Opus */
-		CodecList.push_back(new OpusCodec);
-	}
-	RefCount ++;
+	/* Opus */
+	CodecList.push_back(new OpusCodec);
 }
 
-void
-CAudioCodec::UnrefCodecList()
+CAudioCodecList::~CAudioCodecList()
 {
-	RefCount --;
-	if (!RefCount)
+	while (CodecList.size() != 0)
 	{
-		while (CodecList.size() != 0)
-		{
-			delete CodecList.back();
-			CodecList.pop_back();
-		}
+		delete CodecList.back();
+		CodecList.pop_back();
 	}
 }
 
 CAudioCodec*
-CAudioCodec::GetDecoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPtr)
+CAudioCodecList::GetDecoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPtr)
 {
 	const int size = CodecList.size();
 	for (int i = 1; i < size; i++)
@@ -80,7 +64,7 @@ CAudioCodec::GetDecoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPt
 }
 
 CAudioCodec*
-CAudioCodec::GetEncoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPtr)
+CAudioCodecList::GetEncoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPtr)
 {
 	const int size = CodecList.size();
 	for (int i = 1; i < size; i++)
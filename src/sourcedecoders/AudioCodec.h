@@ -56,14 +56,23 @@ public:
 	virtual void EncClose() = 0;
 	virtual void EncSetBitrate(int iBitRate) = 0;
 	virtual void EncUpdate(CAudioParam& AudioParam) = 0;
-	/* Common */
-	static void InitCodecList();
-	static void UnrefCodecList();
-	static CAudioCodec* GetDecoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPtr=false);
-	static CAudioCodec* GetEncoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPtr=false);
+};
+
+/* Codec instances hold the decoder/encoder handles, so every source
+   decoder/encoder owns its own list and several receivers can run in the
+   same process without sharing codec state */
+class CAudioCodecList
+{
+public:
+	CAudioCodecList();
+	virtual ~CAudioCodecList();
+	CAudioCodec* GetDecoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPtr=false);
+	CAudioCodec* GetEncoder(CAudioParam::EAudCod eAudioCoding, bool bCanReturnNullPtr=false);
 private:
-	static vector<CAudioCodec*> CodecList;
-	static int RefCount;
+	/* Not copyable, the list owns the codecs */
+	CAudioCodecList(const CAudioCodecList&);
+	CAudioCodecList& operator=(const CAudioCodecList&);
+	vector<CAudioCodec*> CodecList;
 };
 
 #endif // _AUDIOCODEC_H_
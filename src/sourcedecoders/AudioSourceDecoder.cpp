@@ -45,20 +45,15 @@ CAudioSourceDecoder::CAudioSourceDecoder()
     :	bWriteToFile(FALSE), TextMessage(FALSE),
         bUseReverbEffect(TRUE), codec(NULL), pFile(NULL)
 {
-    /* Initialize Audio Codec List */
-    CAudioCodec::InitCodecList();
-
     /* Needed by fdrmdialog.cpp to report missing codec */
-    bCanDecodeAAC  = CAudioCodec::GetDecoder(CAudioParam::AC_AAC,  true) != NULL;
-    bCanDecodeCELP = CAudioCodec::GetDecoder(CAudioParam::AC_CELP, true) != NULL;
-    bCanDecodeHVXC = CAudioCodec::GetDecoder(CAudioParam::AC_HVXC, true) != NULL;
-    bCanDecodeOPUS = CAudioCodec::GetDecoder(CAudioParam::AC_OPUS, true) != NULL;
+    bCanDecodeAAC  = CodecList.GetDecoder(CAudioParam::AC_AAC,  true) != NULL;
+    bCanDecodeCELP = CodecList.GetDecoder(CAudioParam::AC_CELP, true) != NULL;
+    bCanDecodeHVXC = CodecList.GetDecoder(CAudioParam::AC_HVXC, true) != NULL;
+    bCanDecodeOPUS = CodecList.GetDecoder(CAudioParam::AC_OPUS, true) != NULL;
 }
 
 CAudioSourceDecoder::~CAudioSourceDecoder()
 {
-    /* Unreference Audio Codec List */
-    CAudioCodec::UnrefCodecList();
 }
 
 string
@@ -793,7 +788,7 @@ CAudioSourceDecoder::InitInternal(CParameter & Parameters)
         }
 
         /* Get decoder instance */
-        codec = CAudioCodec::GetDecoder(eAudioCoding);
+        codec = CodecList.GetDecoder(eAudioCoding);
 
         if (codec->CanDecode(eAudioCoding))
             audiodecoder = codec->DecGetVersion();
@@ -944,7 +939,9 @@ CAudioSourceDecoder::InitInternal(CParameter & Parameters)
             bCELPCRC = AudioParam.bCELPCRC;
 
             /* Init vectors storing the CELP raw data and CRCs */
-            celp_frame.Init(iNumAudioFrames, iTotalNumCELPBits);
+            celp_frame.Init(iNumAudioFrames);
+            for (int i = 0; i < iNumAudioFrames; i++)
+                celp_frame[i].Init(iTotalNumCELPBits);
             celp_crc_bits.Init(iNumAudioFrames);
 
 // TEST
@@ -999,7 +996,9 @@ CAudioSourceDecoder::InitInternal(CParameter & Parameters)
                 throw CInitErr(ET_AUDDECODER);
             }
 
-            hvxc_frame.Init(iNumAudioFrames, iNumHvxcBits);
+            hvxc_frame.Init(iNumAudioFrames);
+            for (int i = 0; i < iNumAudioFrames; i++)
+                hvxc_frame[i].Init(iNumHvxcBits);
 
 #ifdef USE_HVXC_DECODER
 
@@ -195,6 +195,7 @@ protected:
     int iNumAudioFrames;
 
     CAudioParam::EAudCod eAudioCoding;
+	CAudioCodecList CodecList;
 	CAudioCodec* codec;
 
     int iNumBorders;
@@ -205,11 +206,11 @@ protected:
     int iAudioPayloadLen;
 
     /* HVXC decoding */
-    CMatrix<_BINARY> hvxc_frame;
+    CVector<CVector<_BINARY> > hvxc_frame;
     int iNumHvxcBits;
 
     /* CELP decoding */
-    CMatrix<_BINARY> celp_frame;
+    CVector<CVector<_BINARY> > celp_frame;
     CVector<_BYTE> celp_crc_bits;
     int iNumHigherProtectedBits;
     int iNumLowerProtectedBits;
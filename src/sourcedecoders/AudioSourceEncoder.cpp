@@ -35,22 +35,17 @@
 CAudioSourceEncoderImplementation::CAudioSourceEncoderImplementation()
     : bUsingTextMessage(FALSE), codec(NULL)
 {
-    /* Initialize Audio Codec List */
-    CAudioCodec::InitCodecList();
-
     /* In case codec might be dereferenced before initialised this will
        get us a null codec at least, it is safer than other codec */
-    codec = CAudioCodec::GetEncoder(AC_NULL);
+    codec = CodecList.GetEncoder(AC_NULL);
 
     /* Needed by TransmDlg.cpp to report available codec */
-    bCanEncodeAAC  = CAudioCodec::GetEncoder(CAudioParam::AC_AAC,  true) != NULL;
-    bCanEncodeOPUS = CAudioCodec::GetEncoder(CAudioParam::AC_OPUS, true) != NULL;
+    bCanEncodeAAC  = CodecList.GetEncoder(CAudioParam::AC_AAC,  true) != NULL;
+    bCanEncodeOPUS = CodecList.GetEncoder(CAudioParam::AC_OPUS, true) != NULL;
 }
 
 CAudioSourceEncoderImplementation::~CAudioSourceEncoderImplementation()
 {
-    /* Unreference Audio Codec List */
-    CAudioCodec::UnrefCodecList();
 }
 
 void
@@ -291,7 +286,7 @@ CAudioSourceEncoderImplementation::InitInternalTx(CParameter & Parameters,
         CAudioParam::EAudCod eAudioCoding = Parameters.Service[iCurSelServ].AudioParam.eAudioCoding;
 
         /* Get encoder instance */
-        codec = CAudioCodec::GetEncoder(eAudioCoding);
+        codec = CodecList.GetEncoder(eAudioCoding);
 
         /* Total frame size is input block size minus the bytes for the text
            message (if text message is used) */
@@ -491,7 +486,7 @@ CAudioSourceEncoderImplementation::InitInternalRx(CParameter& Parameters,
         iTotAudFraSizeBits -= SIZEOF__BYTE * NUM_BYTES_TEXT_MESS_IN_AUD_STR;
 
     /* Get encoder instance */
-    codec = CAudioCodec::GetEncoder(Parameters.Service[0].AudioParam.eAudioCoding);
+    codec = CodecList.GetEncoder(Parameters.Service[0].AudioParam.eAudioCoding);
 
     switch (Parameters.Service[0].AudioParam.eAudioCoding) {
 
@@ -81,6 +81,7 @@ protected:
 	_BOOLEAN				bIsDataService;
 	int						iTotNumBitsForUsage;
 
+	CAudioCodecList		CodecList;
 	CAudioCodec*			codec;
 
 	unsigned long			lNumSampEncIn;
@@ -37,17 +37,14 @@ void CFreqSyncAcq::ProcessDataInternal(CParameter& Parameters)
 	int			i;
 	int			iMaxIndex=0;
 	CReal		rMaxValue = 0.0;
-	int			iNumDetPeaks;
 	//int			iDiffTemp;
 	//CReal		rLevDiff;
-	_BOOLEAN	bNoPeaksLeft;
-	CRealVector	vecrPSDPilPoin(3);
 
 	Parameters.Lock(); 
 
 	/* OPH: update free-running symbol counter */
 	iFreeSymbolCounter++;
-	if (iFreeSymbolCounter >= Parameters.CellMappingTable.iNumSymPerFrame)
+	if (iFreeSymbolCounter >= Parameters.pCellMappingTable->iNumSymPerFrame)
 	{
 		iFreeSymbolCounter = 0;
 	}
@@ -75,19 +72,19 @@ void CFreqSyncAcq::ProcessDataInternal(CParameter& Parameters)
 		else
 		{
 			/* Copy vector to matlib vector and calculate real-valued FFT */
-			const int iStartIdx = iHistBufSize - iFrAcFFTSize;
+			const _REAL* prHistory =
+				vecrFFTHistory.Window() + iHistBufSize - iFrAcFFTSize;
 			for (i = 0; i < iFrAcFFTSize; i++)
-				vecrFFTInput[i] = vecrFFTHistory[i + iStartIdx];
+				vecrFFTInput[i] = prHistory[i];
 
-			static CMatlibVector<CReal> vecRet;
-			vecRet.Init(vecrFFTInput.GetSize(), VTY_TEMP);
+			vecrFFTInputWin.Init(vecrFFTInput.GetSize(), VTY_TEMP);
 
 			for (int k = 0; k < vecrFFTInput.GetSize(); k++)
-				vecRet[k] = vecrFFTInput[k] * vecrHammingWin[k];
+				vecrFFTInputWin[k] = vecrFFTInput[k] * vecrHammingWin[k];
 
 			/* Calculate power spectrum (X = real(F)^2 + imag(F)^2) */
 			vecrSqMagFFTOut =
-				SqMag(rfft(vecRet, FftPlan));
+				SqMag(rfft(vecrFFTInputWin, FftPlan));
 
 			/* Calculate moving average for better estimate of PSD */
 			vvrPSDMovAv.Add(vecrSqMagFFTOut);
@@ -101,7 +98,7 @@ void CFreqSyncAcq::ProcessDataInternal(CParameter& Parameters)
 			else
 			{
 				/* Get PSD estimate */
-				const CRealVector vecrPSD(vvrPSDMovAv.GetAverage());
+				vecrPSD = vvrPSDMovAv.GetAverage();
 
 
 				/* -------------------------------------------------------------
@@ -159,162 +156,81 @@ fclose(pFile2);
 				}
 
 				/* Correlate known frequency-pilot structure with equalized
-				   power spectrum */
-				for (i = 0; i < iSearchWinSize; i++)
+				   power spectrum and detect peaks. The search window is split
+				   in parts which can be searched by different threads */
+				if (pWorkerPool != NULL)
+					pWorkerPool->Run(vecpPeakSearchTasks);
+				else
 				{
-					vecrPSDPilCor[i] =
-						vecrPSD[i + veciTableFreqPilots[0]] +
-						vecrPSD[i + veciTableFreqPilots[1]] +
-						vecrPSD[i + veciTableFreqPilots[2]];
+					for (i = 0; i < (int) vecPeakSearchTask.size(); i++)
+						SearchPeak(vecPeakSearchTask[i]);
 				}
 
-
-				/* Detect peaks --------------------------------------------- */
-				/* Get peak indices of detected peaks */
-				iNumDetPeaks = 0;
-				for (i = iStartDCSearch; i < iEndDCSearch; i++)
+				/* Get maximum of all parts, take the remaining peak which has
+				   the highest value */
+				iMaxIndex = -1;
+				for (i = 0; i < (int) vecPeakSearchTask.size(); i++)
 				{
-					/* Test peaks against a bound */
-					if (vecrPSDPilCor[i] > rPeakBoundFiltToSig)
+					const CPeakSearchTask& Task = vecPeakSearchTask[i];
+
+					if ((Task.iMaxIndex >= 0) &&
+						((iMaxIndex < 0) || (Task.rMaxValue > rMaxValue)))
 					{
-						veciPeakIndex[iNumDetPeaks] = i;
-						iNumDetPeaks++;
+						iMaxIndex = Task.iMaxIndex;
+						rMaxValue = Task.rMaxValue;
 					}
 				}
 
-				/* Check, if at least one peak was detected */
-				if (iNumDetPeaks > 0)
+				if (iMaxIndex >= 0)
 				{
-					/* ---------------------------------------------------------
-					   The following test shall exclude sinusoid interferers in
-					   the received spectrum */
-					CVector<int> vecbFlagVec(iNumDetPeaks, 1);
-
-					/* Check all detected peaks in the "PSD-domain" if there are
-					   at least two peaks with approx the same power at the
-					   correct places (positions of the desired pilots) */
-					for (i = 0; i < iNumDetPeaks; i++)
-					{
-						/* Fill the vector with the values at the desired
-						   pilot positions */
-						vecrPSDPilPoin[0] =
-							vecrPSD[veciPeakIndex[i] + veciTableFreqPilots[0]];
-						vecrPSDPilPoin[1] =
-							vecrPSD[veciPeakIndex[i] + veciTableFreqPilots[1]];
-						vecrPSDPilPoin[2] =
-							vecrPSD[veciPeakIndex[i] + veciTableFreqPilots[2]];
-
-						/* Sort, to extract the highest and second highest
-						   peak */
-						vecrPSDPilPoin = Sort(vecrPSDPilPoin);
-
-						/* Debar peak, if it is much higher than second highest
-						   peak (most probably a sinusoid interferer). The
-						   highest peak is stored at "vecrPSDPilPoin[2]". Also
-						   test for lowest peak */
-						if ((vecrPSDPilPoin[1] / vecrPSDPilPoin[2] <
-							MAX_RAT_PEAKS_AT_PIL_POS_HIGH) &&
-							(vecrPSDPilPoin[0] / vecrPSDPilPoin[2] <
-							MAX_RAT_PEAKS_AT_PIL_POS_LOW))
-						{
-							/* Reset "good-flag" */
-							vecbFlagVec[i] = 0;
-						}
-					}
-
-
-					/* Get maximum ------------------------------------------ */
-					/* First, get the first valid peak entry and init the
-					   maximum with this value. We also detect, if a peak is
-					   left */
-					bNoPeaksLeft = TRUE;
-					for (i = 0; i < iNumDetPeaks; i++)
-					{
-						if (vecbFlagVec[i] == 1)
-						{
-							/* At least one peak is left */
-							bNoPeaksLeft = FALSE;
-
-							/* Init max value */
-							iMaxIndex = veciPeakIndex[i];
-							rMaxValue = vecrPSDPilCor[veciPeakIndex[i]];
-						}
-					}
-
-					if (bNoPeaksLeft == FALSE)
-					{
-						/* Actual maximum detection, take the remaining peak
-						   which has the highest value */
-						for (i = 0; i < iNumDetPeaks; i++)
-						{
-							if ((vecbFlagVec[i] == 1) &&
-								(vecrPSDPilCor[veciPeakIndex[i]] >
-								rMaxValue))
-							{
-								iMaxIndex = veciPeakIndex[i];
-								rMaxValue = vecrPSDPilCor[veciPeakIndex[i]];
-							}
-						}
-
 #ifdef _DEBUG_
-/* Stores all important parameters for last shot */
+/* Stores the pilot correlation and the detected peak for last shot */
 FILE* pFile1 = fopen("test/freqacq.dat", "w");
-int iPeakCnt = 0;
-for (i = 1; i < iSearchWinSize; i++) {
-	_REAL rPM, rFinPM; /* rPM: peak marker, rFinPM: final peak marker */
-	if (iPeakCnt < iNumDetPeaks) {
-		if (i == veciPeakIndex[iPeakCnt]) {
-			rPM = vecrPSDPilCor[i];
-			if (vecbFlagVec[iPeakCnt] == 1) rFinPM = vecrPSDPilCor[i]; else rFinPM = 0;
-			iPeakCnt++;
-		} else {rPM = 0; rFinPM = 0;}
-	} else {rPM = 0; rFinPM = 0;}
-	fprintf(pFile1, "%e %e %e\n", vecrPSDPilCor[i], rPM, rFinPM);
-}
+for (i = 1; i < iSearchWinSize; i++)
+	fprintf(pFile1, "%e %e\n", vecrPSDPilCor[i], i == iMaxIndex ? vecrPSDPilCor[i] : 0);
 fclose(pFile1);
-// close all;load freqacq.dat;load freqacqFilt.dat;subplot(211),semilogy(freqacq(:,1));hold;plot(freqacq(:,2),'*y');plot(freqacq(:,3),'*k');subplot(212),semilogy(freqacqFilt)
-// close all;load freqacq.dat;semilogy(freqacq(:,1));hold;plot(freqacq(:,2),'*y');plot(freqacq(:,3),'*k');
+// close all;load freqacq.dat;load freqacqFilt.dat;subplot(211),semilogy(freqacq(:,1));hold;plot(freqacq(:,2),'*k');subplot(212),semilogy(freqacqFilt)
 #endif
 
 
-						/* -----------------------------------------------------
-						   An acquisition frequency offest estimation was
-						   found */
-						/* Calculate frequency offset and set global parameter
-						   for offset */
-						Parameters.rFreqOffsetAcqui =
-							(_REAL) iMaxIndex / iFrAcFFTSize;
+					/* -----------------------------------------------------
+					   An acquisition frequency offest estimation was
+					   found */
+					/* Calculate frequency offset and set global parameter
+					   for offset */
+					Parameters.rFreqOffsetAcqui =
+						(_REAL) iMaxIndex / iFrAcFFTSize;
 
-						/* Reset acquisition flag */
-						bAquisition = FALSE;
+					/* Reset acquisition flag */
+					bAquisition = FALSE;
 
 
-						/* Send out the data stored for FFT calculation ----- */
-						/* This does not work for bandpass filter. TODO: make
-						   this possible for bandpass filter, too */
-						if (bUseRecFilter == FALSE)
+					/* Send out the data stored for FFT calculation ----- */
+					/* This does not work for bandpass filter. TODO: make
+					   this possible for bandpass filter, too */
+					if (bUseRecFilter == FALSE)
+					{
+						iOutputBlockSize = iHistBufSize;
+
+						/* Frequency offset correction */
+						const _REAL rNormCurFreqOffsFst = (_REAL) 2.0 * crPi *
+							(Parameters.rFreqOffsetAcqui - rInternIFNorm);
+
+						const _REAL* prHistory = vecrFFTHistory.Window();
+						for (i = 0; i < iHistBufSize; i++)
 						{
-							iOutputBlockSize = iHistBufSize;
-
-							/* Frequency offset correction */
-							const _REAL rNormCurFreqOffsFst = (_REAL) 2.0 * crPi *
-								(Parameters.rFreqOffsetAcqui - rInternIFNorm);
-
-							for (i = 0; i < iHistBufSize; i++)
-							{
-								/* Multiply with exp(j omega t) */
-								(*pvecOutputData)[i] = vecrFFTHistory[i] *
-									_COMPLEX(Cos(i * rNormCurFreqOffsFst),
-									Sin(-i * rNormCurFreqOffsFst));
-							}
-
-							/* Init "exp-step" for regular frequency shift which
-							   is used in tracking mode to get contiuous mixing
-							   signal */
-							cCurExp =
-								_COMPLEX(Cos(iHistBufSize * rNormCurFreqOffsFst),
-								Sin(-iHistBufSize * rNormCurFreqOffsFst));
+							/* Multiply with exp(j omega t) */
+							(*pvecOutputData)[i] = prHistory[i] *
+								_COMPLEX(Cos(i * rNormCurFreqOffsFst),
+								Sin(-i * rNormCurFreqOffsFst));
 						}
+
+						/* Init "exp-step" for regular frequency shift which
+						   is used in tracking mode to get contiuous mixing
+						   signal */
+						cCurExp =
+							_COMPLEX(Cos(iHistBufSize * rNormCurFreqOffsFst),
+							Sin(-iHistBufSize * rNormCurFreqOffsFst));
 					}
 				}
 			}
@@ -328,7 +244,7 @@ fclose(pFile1);
 		if (bSyncInput == TRUE)
 		{
 			Parameters.rFreqOffsetAcqui =
-				(_REAL) Parameters.CellMappingTable.iIndexDCFreq / Parameters.CellMappingTable.iFFTSizeN;
+				(_REAL) Parameters.pCellMappingTable->iIndexDCFreq / Parameters.pCellMappingTable->iFFTSizeN;
 		}
 
 		/* Use the same block size as input block size */
@@ -368,6 +284,79 @@ fclose(pFile1);
 	Parameters.Unlock(); 
 }
 
+void CFreqSyncAcq::SearchPeak(CPeakSearchTask& Task)
+{
+	int			i;
+	int			iNumDetPeaks;
+	CRealVector	vecrPSDPilPoin(3);
+
+	/* Correlate known frequency-pilot structure with equalized power
+	   spectrum */
+	for (i = Task.iStart; i < Task.iEnd; i++)
+	{
+		vecrPSDPilCor[i] =
+			vecrPSD[i + veciTableFreqPilots[0]] +
+			vecrPSD[i + veciTableFreqPilots[1]] +
+			vecrPSD[i + veciTableFreqPilots[2]];
+	}
+
+
+	/* Detect peaks --------------------------------------------------------- */
+	/* Get peak indices of detected peaks */
+	const int iStartSearch =
+		Task.iStart > iStartDCSearch ? Task.iStart : iStartDCSearch;
+	const int iEndSearch = Task.iEnd < iEndDCSearch ? Task.iEnd : iEndDCSearch;
+
+	iNumDetPeaks = 0;
+	for (i = iStartSearch; i < iEndSearch; i++)
+	{
+		/* Test peaks against a bound */
+		if (vecrPSDPilCor[i] > rPeakBoundFiltToSig)
+		{
+			Task.veciPeakIndex[iNumDetPeaks] = i;
+			iNumDetPeaks++;
+		}
+	}
+
+	/* -------------------------------------------------------------------------
+	   The following test shall exclude sinusoid interferers in the received
+	   spectrum. Check all detected peaks in the "PSD-domain" if there are at
+	   least two peaks with approx the same power at the correct places
+	   (positions of the desired pilots). Of the remaining peaks, take the one
+	   which has the highest value */
+	Task.iMaxIndex = -1;
+	Task.rMaxValue = (CReal) 0.0;
+	for (i = 0; i < iNumDetPeaks; i++)
+	{
+		const int iPeakIndex = Task.veciPeakIndex[i];
+
+		/* Fill the vector with the values at the desired pilot positions */
+		vecrPSDPilPoin[0] = vecrPSD[iPeakIndex + veciTableFreqPilots[0]];
+		vecrPSDPilPoin[1] = vecrPSD[iPeakIndex + veciTableFreqPilots[1]];
+		vecrPSDPilPoin[2] = vecrPSD[iPeakIndex + veciTableFreqPilots[2]];
+
+		/* Sort, to extract the highest and second highest peak */
+		vecrPSDPilPoin = Sort(vecrPSDPilPoin);
+
+		/* Debar peak, if it is much higher than second highest peak (most
+		   probably a sinusoid interferer). The highest peak is stored at
+		   "vecrPSDPilPoin[2]". Also test for lowest peak */
+		if ((vecrPSDPilPoin[1] / vecrPSDPilPoin[2] <
+			MAX_RAT_PEAKS_AT_PIL_POS_HIGH) &&
+			(vecrPSDPilPoin[0] / vecrPSDPilPoin[2] <
+			MAX_RAT_PEAKS_AT_PIL_POS_LOW))
+		{
+			continue;
+		}
+
+		if ((Task.iMaxIndex < 0) || (vecrPSDPilCor[iPeakIndex] > Task.rMaxValue))
+		{
+			Task.iMaxIndex = iPeakIndex;
+			Task.rMaxValue = vecrPSDPilCor[iPeakIndex];
+		}
+	}
+}
+
 void CFreqSyncAcq::InitInternal(CParameter& Parameters)
 {
 	Parameters.Lock(); 
@@ -377,7 +366,7 @@ void CFreqSyncAcq::InitInternal(CParameter& Parameters)
 
 	/* Needed for calculating offset in Hertz in case of synchronized input
 	   (for simulation) */
-	iFFTSize = Parameters.CellMappingTable.iFFTSizeN;
+	iFFTSize = Parameters.pCellMappingTable->iFFTSizeN;
 
 	/* We using parameters from robustness mode B as pattern for the desired
 	   frequency pilot positions */
@@ -443,8 +432,25 @@ void CFreqSyncAcq::InitInternal(CParameter& Parameters)
 	vecrFiltResRL.Init(iHalfBuffer);
 	vecrFiltRes.Init(iHalfBuffer);
 
-	/* Index memory for detected peaks (assume worst case with the size) */
-	veciPeakIndex.Init(iHalfBuffer);
+	/* Equalized PSD estimate */
+	vecrPSD.Init(iHalfBuffer);
+
+	/* Split the search window in one part per thread. Each part has its own
+	   index memory for detected peaks (assume worst case with the size) */
+	const int iNumParts = pWorkerPool != NULL ? pWorkerPool->GetNumThreads() + 1 : 1;
+
+	vecPeakSearchTask.resize(iNumParts);
+	vecpPeakSearchTasks.resize(iNumParts);
+	for (int iPart = 0; iPart < iNumParts; iPart++)
+	{
+		CPeakSearchTask& Task = vecPeakSearchTask[iPart];
+
+		Task.pFreqSyncAcq = this;
+		Task.iStart = iSearchWinSize * iPart / iNumParts;
+		Task.iEnd = iSearchWinSize * (iPart + 1) / iNumParts;
+		Task.veciPeakIndex.Init(Task.iEnd - Task.iStart);
+		vecpPeakSearchTasks[iPart] = &Task;
+	}
 
 	/* Init plans for FFT (faster processing of Fft and Ifft commands) */
 	FftPlan.Init(iFrAcFFTSize);
@@ -460,24 +466,24 @@ void CFreqSyncAcq::InitInternal(CParameter& Parameters)
 	/* Frequency correction */
 	/* Start with phase null (arbitrary) */
 	cCurExp = (_REAL) 1.0;
-	rInternIFNorm = (_REAL) Parameters.CellMappingTable.iIndexDCFreq / iFFTSize;
+	rInternIFNorm = (_REAL) Parameters.pCellMappingTable->iIndexDCFreq / iFFTSize;
 
 
 	/* Init bandpass filter object */
-	BPFilter.Init(iSampleRate, Parameters.CellMappingTable.iSymbolBlockSize, VIRTUAL_INTERMED_FREQ,
+	BPFilter.Init(iSampleRate, Parameters.pCellMappingTable->iSymbolBlockSize, VIRTUAL_INTERMED_FREQ,
 		Parameters.GetSpectrumOccup(), CDRMBandpassFilt::FT_RECEIVER);
 
 
 	/* Define block-sizes for input (The output block size is set inside
 	   the processing routine, therefore only a maximum block size is set
 	   here) */
-	iInputBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+	iInputBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
 
 	/* We have to consider that the next module can take up to two symbols per
 	   step. This can be satisfied be multiplying with "3". We also want to ship
 	   the whole FFT buffer after finishing the frequency acquisition so that
 	   these samples can be reused for synchronization and do not get lost */
-	iMaxOutputBlockSize = 3 * Parameters.CellMappingTable.iSymbolBlockSize + iHistBufSize;
+	iMaxOutputBlockSize = 3 * Parameters.pCellMappingTable->iSymbolBlockSize + iHistBufSize;
 
 	/* OPH: init free-running symbol counter */
 	iFreeSymbolCounter = 0;
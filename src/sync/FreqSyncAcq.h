@@ -33,6 +33,7 @@
 #include "../util/Modul.h"
 #include "../matlib/Matlib.h"
 #include "../util/Utilities.h"
+#include "../util/WorkerPool.h"
 
 /* Definitions ****************************************************************/
 /* Bound for peak detection between filtered signal (in frequency direction) 
@@ -76,7 +77,7 @@ public:
 		veciTableFreqPilots(3), /* 3 frequency pilots */
 		bAquisition(FALSE), bSyncInput(FALSE),
 		rCenterFreq(0), rWinSize(0),
-		bUseRecFilter(FALSE)
+		bUseRecFilter(FALSE), pWorkerPool(NULL)
 		{}
 	virtual ~CFreqSyncAcq() {}
 
@@ -93,12 +94,35 @@ public:
 	/* To set the module up for synchronized DRM input data stream */
 	void SetSyncInput(_BOOLEAN bNewS) {bSyncInput = bNewS;}
 
+	/* Threads for the peak search, "NULL" searches in the receiver thread.
+	   The search window is split at the next initialization */
+	void SetWorkerPool(CWorkerPool* pNewPool) {pWorkerPool = pNewPool;}
+
 protected:
+	/* Pilot correlation and peak search on one part of the search window */
+	class CPeakSearchTask : public CWorkerTask
+	{
+	public:
+		CPeakSearchTask() : pFreqSyncAcq(NULL), iStart(0), iEnd(0),
+			veciPeakIndex(), iMaxIndex(-1), rMaxValue((CReal) 0.0) {}
+		virtual void Run() {pFreqSyncAcq->SearchPeak(*this);}
+
+		CFreqSyncAcq*	pFreqSyncAcq;
+		int				iStart;
+		int				iEnd;
+		CVector<int>	veciPeakIndex;
+
+		/* Best remaining peak, "-1" if none is left */
+		int				iMaxIndex;
+		CReal			rMaxValue;
+	};
+
 	CVector<int>				veciTableFreqPilots;
-	CShiftRegister<_REAL>		vecrFFTHistory;
+	CMirroredShiftRegister<_REAL>	vecrFFTHistory;
 
 	CFftPlans					FftPlan;
 	CRealVector					vecrFFTInput;
+	CRealVector					vecrFFTInputWin;
 	CRealVector					vecrSqMagFFTOut;
 	CRealVector					vecrHammingWin;
 	CMovingAv<CRealVector>		vvrPSDMovAv;
@@ -127,7 +151,8 @@ protected:
 	CRealVector					vecrFiltResLR;
 	CRealVector					vecrFiltResRL;
 	CRealVector					vecrFiltRes;
-	CVector<int>				veciPeakIndex;
+	CRealVector					vecrPSD;
+
 
 	_COMPLEX					cCurExp;
 	_REAL						rInternIFNorm;
@@ -135,10 +160,16 @@ protected:
 	CDRMBandpassFilt			BPFilter;
 	_BOOLEAN					bUseRecFilter;
 
+	CWorkerPool*				pWorkerPool;
+	vector<CPeakSearchTask>		vecPeakSearchTask;
+	vector<CWorkerTask*>		vecpPeakSearchTasks;
+
 	/* OPH: counter to count symbols within a frame in order to generate */
 	/* RSCI output even when unlocked */
 	int							iFreeSymbolCounter;
 
+	void SearchPeak(CPeakSearchTask& Task);
+
 	virtual void InitInternal(CParameter& Parameters);
 	virtual void ProcessDataInternal(CParameter& Parameters);
 };
@@ -313,18 +313,18 @@ void CSyncUsingPil::InitInternal(CParameter& Parameters)
 	CPilotModiClass::InitRot(Parameters);
 
 	/* Init internal parameters from global struct */
-	iNumCarrier = Parameters.CellMappingTable.iNumCarrier;
+	iNumCarrier = Parameters.pCellMappingTable->iNumCarrier;
 	eCurRobMode = Parameters.GetWaveMode();
 
 	/* Check if symbol number per frame has changed. If yes, reset the
 	   symbol counter */
-	if (iNumSymPerFrame != Parameters.CellMappingTable.iNumSymPerFrame)
+	if (iNumSymPerFrame != Parameters.pCellMappingTable->iNumSymPerFrame)
 	{
 		/* Init internal counter for symbol number */
 		iSymbCntFraSy = 0;
 
 		/* Refresh parameter */
-		iNumSymPerFrame = Parameters.CellMappingTable.iNumSymPerFrame;
+		iNumSymPerFrame = Parameters.pCellMappingTable->iNumSymPerFrame;
 	}
 
 	/* Allocate memory for histories. Init history with small values, because
@@ -349,14 +349,14 @@ void CSyncUsingPil::InitInternal(CParameter& Parameters)
 	for (i = 0; i < iNumCarrier - 1; i++)
 	{
 		/* Only successive pilots (in frequency direction) are used */
-		if (_IsPilot(Parameters.CellMappingTable.matiMapTab[0][i]) &&
-			_IsPilot(Parameters.CellMappingTable.matiMapTab[0][i + 1]))
+		if (_IsPilot(Parameters.pCellMappingTable->matiMapTab[0][i]) &&
+			_IsPilot(Parameters.pCellMappingTable->matiMapTab[0][i + 1]))
 		{
 			/* Store indices and complex numbers */
 			vecPilCorr[iNumPilPairs].iIdx1 = i;
 			vecPilCorr[iNumPilPairs].iIdx2 = i + 1;
-			vecPilCorr[iNumPilPairs].cPil1 = Parameters.CellMappingTable.matcPilotCells[0][i];
-			vecPilCorr[iNumPilPairs].cPil2 = Parameters.CellMappingTable.matcPilotCells[0][i + 1];
+			vecPilCorr[iNumPilPairs].cPil1 = Parameters.pCellMappingTable->matcPilotCells[0][i];
+			vecPilCorr[iNumPilPairs].cPil2 = Parameters.pCellMappingTable->matcPilotCells[0][i + 1];
 
 			iNumPilPairs++;
 		}
@@ -365,7 +365,7 @@ void CSyncUsingPil::InitInternal(CParameter& Parameters)
 	/* Calculate channel correlation in frequency direction. Use rectangular
 	   shaped PDS with the length of the guard-interval */
 	const CReal rArgSinc =
-		(CReal) Parameters.CellMappingTable.iGuardSize / Parameters.CellMappingTable.iFFTSizeN;
+		(CReal) Parameters.pCellMappingTable->iGuardSize / Parameters.pCellMappingTable->iFFTSizeN;
 	const CReal rArgExp = crPi * rArgSinc;
 
 	cR_HH = Sinc(rArgSinc) * CComplex(Cos(rArgExp), -Sin(rArgExp));
@@ -377,10 +377,10 @@ void CSyncUsingPil::InitInternal(CParameter& Parameters)
 	int iAvPilPos = 0;
 	for (i = 0; i < iNumCarrier - 1; i++)
 	{
-		if (_IsFreqPil(Parameters.CellMappingTable.matiMapTab[0][i]))
+		if (_IsFreqPil(Parameters.pCellMappingTable->matiMapTab[0][i]))
 		{
 			/* For average frequency pilot position to DC carrier */
-			iAvPilPos += i + Parameters.CellMappingTable.iCarrierKmin;
+			iAvPilPos += i + Parameters.pCellMappingTable->iCarrierKmin;
 			
 			iPosFreqPil[iFreqPilCount] = i;
 			iFreqPilCount++;
@@ -390,7 +390,7 @@ void CSyncUsingPil::InitInternal(CParameter& Parameters)
 	/* Average distance of the frequency pilots from the DC carrier. Needed for
 	   corrections for sample rate offset changes. Normalized to sample rate! */
 	rAvFreqPilDistToDC =
-		(CReal) iAvPilPos / NUM_FREQ_PILOTS / Parameters.CellMappingTable.iFFTSizeN;
+		(CReal) iAvPilPos / NUM_FREQ_PILOTS / Parameters.pCellMappingTable->iFFTSizeN;
 
 	/* Init memory for "old" frequency pilots */
 	for (i = 0; i < NUM_FREQ_PILOTS; i++)
@@ -398,11 +398,11 @@ void CSyncUsingPil::InitInternal(CParameter& Parameters)
 	
 	/* Nomalization constant for frequency offset estimation */
 	rNormConstFOE =
-		(CReal) 1.0 / ((CReal) 2.0 * crPi * Parameters.CellMappingTable.iSymbolBlockSize);
+		(CReal) 1.0 / ((CReal) 2.0 * crPi * Parameters.pCellMappingTable->iSymbolBlockSize);
 
 	/* Init time constant for IIR filter for frequency offset estimation */
 	rLamFreqOff = IIR1Lam(TICONST_FREQ_OFF_EST, (CReal) Parameters.GetSigSampleRate() /
-		Parameters.CellMappingTable.iSymbolBlockSize);
+		Parameters.pCellMappingTable->iSymbolBlockSize);
 
 	/* Init vector for averaging the frequency offset estimation */
 	cFreqOffVec = CComplex((CReal) 0.0, (CReal) 0.0);
@@ -421,7 +421,7 @@ void CSyncUsingPil::InitInternal(CParameter& Parameters)
 
 	/* Init time constant for IIR filter for sample rate offset estimation */
 	rLamSamRaOff = IIR1Lam(TICONST_SAMRATE_OFF_EST,
-		(CReal) Parameters.GetSigSampleRate() / Parameters.CellMappingTable.iSymbolBlockSize);
+		(CReal) Parameters.GetSigSampleRate() / Parameters.pCellMappingTable->iSymbolBlockSize);
 #endif
 
 
@@ -40,14 +40,12 @@ void CTimeSync::ProcessDataInternal(CParameter& Parameters)
 	int				i, j, k;
 	int				iMaxIndex;
 	int				iIntDiffToCenter;
-	int				iCurPos;
 	int				iDecInpuSize;
 	CReal			rMaxValue;
 	CReal			rMaxValRMCorr;
 	CReal			rSecHighPeak;
 	//CReal			rFreqOffsetEst;
 	CComplexVector	cvecInpTmp;
-	CRealVector		rResMode(NUM_ROBUSTNESS_MODES);
 	int				iNewStIndCount = 0;
 	/* Max number of detected peaks ("5" for safety reasons. Could be "2") */
 	CVector<int>	iNewStartIndexField(5);
@@ -124,15 +122,14 @@ void CTimeSync::ProcessDataInternal(CParameter& Parameters)
 		const int iCorrPosSec =
 			iDecSymBS + iHalHilFilDelDec + iLenUsefPart[iSelectedMode];
 
-		/* Actual correlation over entire guard-interval */
+		/* Actual correlation over entire guard-interval. Use start point
+		   from ML timing estimation. The input stream is automatically
+		   adjusted to have this point at "iDecSymBS" */
+		const _COMPLEX* pcFirst = HistoryBufCorr.Window() + iCorrPosFirst;
+		const _COMPLEX* pcSec = HistoryBufCorr.Window() + iCorrPosSec;
 		CComplex cGuardCorrFreqTrack = 0.0;
 		for (i = 0; i < iLenGuardInt[iSelectedMode]; i++)
-		{
-			/* Use start point from ML timing estimation. The input stream is
-			   automatically adjusted to have this point at "iDecSymBS" */
-			cGuardCorrFreqTrack += HistoryBufCorr[i + iCorrPosFirst] *
-				Conj(HistoryBufCorr[i + iCorrPosSec]);
-		}
+			cGuardCorrFreqTrack += pcFirst[i] * Conj(pcSec[i]);
 
 		/* Average vector, real and imaginary part separately */
 		IIR1(cFreqOffAv, cGuardCorrFreqTrack, rLamFreqOff);
@@ -161,169 +158,122 @@ void CTimeSync::ProcessDataInternal(CParameter& Parameters)
 			/* Init start-index count */
 			iNewStIndCount = 0;
 
-			/* We use the block in the middle of the buffer for observation */
-			for (i = iDecSymBS + iDecSymBS - iDecInpuSize;
-				i < iDecSymBS + iDecSymBS; i++)
+			/* We use the block in the middle of the buffer for observation.
+			   Only every "iStepSizeGuardCorr"'th value is calculated for
+			   efficiency reasons */
+			const int iEndCorrPos = iDecSymBS + iDecSymBS;
+			if ((iTimeSyncPos >= iEndCorrPos - iDecInpuSize) &&
+				(iTimeSyncPos < iEndCorrPos))
 			{
-				/* Only every "iStepSizeGuardCorr"'th value is calculated for
-				   efficiency reasons */
-				if (i == iTimeSyncPos)
-				{
-					/* Do the following guard interval correlation for all
-					   possible robustness modes (this is needed for robustness
-					   mode detection) */
-					for (j = 0; j < NUM_ROBUSTNESS_MODES; j++)
-					{
-						/* Guard-interval correlation ----------------------- */
-						/* Speed optimized calculation of the guard-interval
-						   correlation. We devide the total block, which has to
-						   be computed, in parts of length "iStepSizeGuardCorr".
-						   The results of these blocks are stored in a vector.
-						   Now, only one new part has to be calculated and one
-						   old one has to be subtracted from the global result.
-						   Special care has to be taken since "iGuardSize" must
-						   not be a multiple of "iStepSizeGuardCorr". Therefore
-						   the "if"-condition */
-						/* First subtract correlation values shifted out */
-						cGuardCorr[j] -= 
-							veccIntermCorrRes[j][iPosInIntermCResBuf[j]];
-						rGuardPow[j] -= 
-							vecrIntermPowRes[j][iPosInIntermCResBuf[j]];
-
-						/* Calculate new block and add in memory */
-						for (k = iLengthOverlap[j]; k < iLenGuardInt[j]; k++)
-						{
-							/* Actual correlation */
-							iCurPos = iTimeSyncPos + k;
-							cGuardCorrBlock[j] += HistoryBufCorr[iCurPos] * 
-								Conj(HistoryBufCorr[iCurPos + iLenUsefPart[j]]);
-
-							/* Energy calculation for ML solution */
-							rGuardPowBlock[j] +=
-								SqMag(HistoryBufCorr[iCurPos]) +
-								SqMag(HistoryBufCorr[iCurPos + iLenUsefPart[j]]);
-
-							/* If one complete block is ready -> store it. We
-							   need to add "1" to the k, because otherwise
-							   "iLengthOverlap" would satisfy the
-							   "if"-condition */
-							if (((k + 1) % iStepSizeGuardCorr) == 0)
-							{
-								veccIntermCorrRes[j][iPosInIntermCResBuf[j]] =
-									cGuardCorrBlock[j];
-
-								vecrIntermPowRes[j][iPosInIntermCResBuf[j]] =
-									rGuardPowBlock[j];
+				iNumCorrPos = (iEndCorrPos - iTimeSyncPos +
+					iStepSizeGuardCorr - 1) / iStepSizeGuardCorr;
+			}
+			else
+				iNumCorrPos = 0;
 
-								/* Add the new block to the global result */
-								cGuardCorr[j] += cGuardCorrBlock[j];
-								rGuardPow[j] += rGuardPowBlock[j];
+			vecrSelModeCorr.Init(iNumCorrPos);
 
-								/* Reset block result */
-								cGuardCorrBlock[j] = (CReal) 0.0;
-								rGuardPowBlock[j] = (CReal) 0.0;
+			/* Start robustness mode detection not until the buffer is
+			   filled */
+			bRMDetection = (bRobModAcqu == TRUE) && (iRobModInitCnt <= 1);
 
-								/* Increase position pointer and test if wrap */
-								iPosInIntermCResBuf[j]++;
-								if (iPosInIntermCResBuf[j] == iLengthIntermCRes[j])
-									iPosInIntermCResBuf[j] = 0;
-							}
-						}
-
-						/* Save correlation results in shift register */
-						for (k = 0; k < iRMCorrBufSize - 1; k++)
-							vecrRMCorrBuffer[j][k] = vecrRMCorrBuffer[j][k + 1];
+			/* Do the guard interval correlation for all possible robustness
+			   modes (this is needed for robustness mode detection). The modes
+			   do not share any data, therefore they can be calculated by
+			   different threads */
+			if (pWorkerPool != NULL)
+				pWorkerPool->Run(vecpRMCorrTasks);
+			else
+			{
+				for (j = 0; j < NUM_ROBUSTNESS_MODES; j++)
+					GuardCorrMode(j);
+			}
 
-						/* ML solution */
-						vecrRMCorrBuffer[j][iRMCorrBufSize - 1] =
-							abs(cGuardCorr[j] + cGuardCorrBlock[j]) - 
-							(rGuardPow[j] + rGuardPowBlock[j]) / 2;
+			for (i = 0; i < iNumCorrPos; i++)
+			{
+				/* Energy of guard intervall calculation and detection of
+				   peak is only needed if timing aquisition is true */
+				if (bTimingAcqu == TRUE)
+				{
+					/* Start timing detection not until initialization phase
+					   is finished */
+					if (iTiSyncInitCnt > 1)
+					{
+						/* Decrease counter */
+						iTiSyncInitCnt--;
 					}
-
-					/* Energy of guard intervall calculation and detection of
-					   peak is only needed if timing aquisition is true */
-					if (bTimingAcqu == TRUE)
+					else
 					{
-						/* Start timing detection not until initialization phase
-						   is finished */
-						if (iTiSyncInitCnt > 1)
-						{
-							/* Decrease counter */
-							iTiSyncInitCnt--;
-						}
-						else
-						{
-							/* Average the correlation results */
-							IIR1(vecCorrAvBuf[iCorrAvInd],
-								vecrRMCorrBuffer[iSelectedMode][iRMCorrBufSize - 1],
-								1 - rLambdaCoAv);
+						/* Average the correlation results */
+						IIR1(vecCorrAvBuf[iCorrAvInd],
+							vecrSelModeCorr[i],
+							1 - rLambdaCoAv);
 
 
-							/* Energy of guard-interval correlation calculation
-							   (this is simply a moving average operation) */
-							vecrGuardEnMovAv.Add(vecCorrAvBuf[iCorrAvInd]);
+						/* Energy of guard-interval correlation calculation
+						   (this is simply a moving average operation) */
+						vecrGuardEnMovAv.Add(vecCorrAvBuf[iCorrAvInd]);
 
 
-							/* Taking care of correlation average buffer ---- */
-							/* We use a "cyclic buffer" structure. This index
-							   defines the position in the buffer */
-							iCorrAvInd++;
-							if (iCorrAvInd == iMaxDetBufSize)
-							{
-								/* Adaptation of the lambda parameter for
-								   guard-interval correlation averaging IIR
-								   filter. With this adaptation we achieve
-								   better averaging results. A lower bound is
-								   defined for this parameter */
-								if (rLambdaCoAv <= 0.1)
-									rLambdaCoAv = 0.1;
-								else
-									rLambdaCoAv /= 2;
-
-								iCorrAvInd = 0;
-							}
+						/* Taking care of correlation average buffer ---- */
+						/* We use a "cyclic buffer" structure. This index
+						   defines the position in the buffer */
+						iCorrAvInd++;
+						if (iCorrAvInd == iMaxDetBufSize)
+						{
+							/* Adaptation of the lambda parameter for
+							   guard-interval correlation averaging IIR
+							   filter. With this adaptation we achieve
+							   better averaging results. A lower bound is
+							   defined for this parameter */
+							if (rLambdaCoAv <= 0.1)
+								rLambdaCoAv = 0.1;
+							else
+								rLambdaCoAv /= 2;
+
+							iCorrAvInd = 0;
+						}
 
 
-							/* Detection buffer ----------------------------- */
-							/* Update buffer for storing the moving average
-							   results */
-							pMaxDetBuffer.AddEnd(vecrGuardEnMovAv.GetAverage());
+						/* Detection buffer ----------------------------- */
+						/* Update buffer for storing the moving average
+						   results */
+						pMaxDetBuffer.AddEnd(vecrGuardEnMovAv.GetAverage());
 
-							/* Search for maximum */
-							iMaxIndex = 0;
-							rMaxValue = (CReal) -_MAXREAL; /* Init value */
-							for (k = 0; k < iMaxDetBufSize; k++)
+						/* Search for maximum */
+						iMaxIndex = 0;
+						rMaxValue = (CReal) -_MAXREAL; /* Init value */
+						for (k = 0; k < iMaxDetBufSize; k++)
+						{
+							if (pMaxDetBuffer[k] > rMaxValue)
 							{
-								if (pMaxDetBuffer[k] > rMaxValue)
-								{
-									rMaxValue = pMaxDetBuffer[k];
-									iMaxIndex = k;
-								}
+								rMaxValue = pMaxDetBuffer[k];
+								iMaxIndex = k;
 							}
+						}
 
-							/* If maximum is in the middle of the interval, mark
-							   position as the beginning of the FFT window */
-							if (iMaxIndex == iCenterOfMaxDetBuf)
-							{
-								/* The optimal start position for the FFT-window
-								   is the middle of the "MaxDetBuffer" */
-								iNewStartIndexField[iNewStIndCount] = 
-									iTimeSyncPos * iGrdcrrDecFact -
-									iSymbolBlockSize / 2 -
-									/* Compensate for Hilbert-filter delay. The
-									   delay is introduced in the downsampled
-									   domain, therefore devide it by
-									   "GRDCRR_DEC_FACT" */
-									iNumTapsHilbFilt / 2 / iGrdcrrDecFact;
-
-								iNewStIndCount++;
-							}
+						/* If maximum is in the middle of the interval, mark
+						   position as the beginning of the FFT window */
+						if (iMaxIndex == iCenterOfMaxDetBuf)
+						{
+							/* The optimal start position for the FFT-window
+							   is the middle of the "MaxDetBuffer" */
+							iNewStartIndexField[iNewStIndCount] = 
+								iTimeSyncPos * iGrdcrrDecFact -
+								iSymbolBlockSize / 2 -
+								/* Compensate for Hilbert-filter delay. The
+								   delay is introduced in the downsampled
+								   domain, therefore devide it by
+								   "GRDCRR_DEC_FACT" */
+								iNumTapsHilbFilt / 2 / iGrdcrrDecFact;
+
+							iNewStIndCount++;
 						}
 					}
-
-					/* Set position pointer to next step */
-					iTimeSyncPos += iStepSizeGuardCorr;
 				}
+
+				/* Set position pointer to next step */
+				iTimeSyncPos += iStepSizeGuardCorr;
 			}
 
 
@@ -345,17 +295,15 @@ void CTimeSync::ProcessDataInternal(CParameter& Parameters)
 					rMaxValRMCorr = (CReal) 0.0;
 					for (j = 0; j < NUM_ROBUSTNESS_MODES; j++)
 					{
-						/* Correlation with symbol rate frequency (Correlations
-						   must be normalized to be comparable!
-						   ("/ iGuardSizeX")) */
-						rResMode[j] =
-							Abs(Sum(vecrRMCorrBuffer[j] * vecrCos[j])) /
-							iLenGuardInt[j];
+						/* Correlation with symbol rate frequency was
+						   calculated together with the guard-interval
+						   correlation of this mode */
+						const CReal rResMode = vecrResMode[j];
 
 						/* Search for maximum */
-						if (rResMode[j] > rMaxValRMCorr)
+						if (rResMode > rMaxValRMCorr)
 						{
-							rMaxValRMCorr = rResMode[j];
+							rMaxValRMCorr = rResMode;
 							iDetectedRModeInd = j;
 						}
 					}
@@ -364,10 +312,10 @@ void CTimeSync::ProcessDataInternal(CParameter& Parameters)
 					rSecHighPeak = (CReal) 0.0;
 					for (j = 0; j < NUM_ROBUSTNESS_MODES; j++)
 					{
-						if ((rResMode[j] > rSecHighPeak) &&
+						if ((vecrResMode[j] > rSecHighPeak) &&
 							(iDetectedRModeInd != j))
 						{
-							rSecHighPeak = rResMode[j];
+							rSecHighPeak = vecrResMode[j];
 						}
 					}
 
@@ -538,8 +486,9 @@ fflush(pFile);
 		iStartIndex = i2SymBlSize;
 
 	/* Cut out the useful part of the OFDM symbol */
+	const _COMPLEX* pcHistory = HistoryBuf.Window();
 	for (k = iStartIndex; k < iStartIndex + iDFTSize; k++)
-		(*pvecOutputData)[k - iStartIndex] = HistoryBuf[k];
+		(*pvecOutputData)[k - iStartIndex] = pcHistory[k];
 
 	/* If synchronized DRM input stream is used, overwrite the detected
 	   timing */
@@ -553,8 +502,8 @@ fflush(pFile);
 		   module  */
 		for (k = iGuardSize; k < iSymbolBlockSize; k++)
 		{
-			(*pvecOutputData)[k - iGuardSize] = 
-				HistoryBuf[iTotalBufferSize - iInputBlockSize + k];
+			(*pvecOutputData)[k - iGuardSize] =
+				pcHistory[iTotalBufferSize - iInputBlockSize + k];
 		}
 	}
 
@@ -584,6 +533,95 @@ fflush(pFile);
 	(*pvecOutputData).GetExData().iCurTimeCorr = iIntDiffToCenter;
 }
 
+void CTimeSync::GuardCorrMode(const int j)
+{
+	int k, iCurPos;
+	int iCorrPos = iTimeSyncPos;
+	const _COMPLEX* pcHistory = HistoryBufCorr.Window();
+
+	for (int i = 0; i < iNumCorrPos; i++)
+	{
+		/* Guard-interval correlation ----------------------- */
+		/* Speed optimized calculation of the guard-interval
+		   correlation. We devide the total block, which has to
+		   be computed, in parts of length "iStepSizeGuardCorr".
+		   The results of these blocks are stored in a vector.
+		   Now, only one new part has to be calculated and one
+		   old one has to be subtracted from the global result.
+		   Special care has to be taken since "iGuardSize" must
+		   not be a multiple of "iStepSizeGuardCorr". Therefore
+		   the "if"-condition */
+		/* First subtract correlation values shifted out */
+		cGuardCorr[j] -= 
+			veccIntermCorrRes[j][iPosInIntermCResBuf[j]];
+		rGuardPow[j] -= 
+			vecrIntermPowRes[j][iPosInIntermCResBuf[j]];
+
+		/* Calculate new block and add in memory */
+		for (k = iLengthOverlap[j]; k < iLenGuardInt[j]; k++)
+		{
+			/* Actual correlation */
+			iCurPos = iCorrPos + k;
+			cGuardCorrBlock[j] += pcHistory[iCurPos] *
+				Conj(pcHistory[iCurPos + iLenUsefPart[j]]);
+
+			/* Energy calculation for ML solution */
+			rGuardPowBlock[j] +=
+				SqMag(pcHistory[iCurPos]) +
+				SqMag(pcHistory[iCurPos + iLenUsefPart[j]]);
+
+			/* If one complete block is ready -> store it. We
+			   need to add "1" to the k, because otherwise
+			   "iLengthOverlap" would satisfy the
+			   "if"-condition */
+			if (((k + 1) % iStepSizeGuardCorr) == 0)
+			{
+				veccIntermCorrRes[j][iPosInIntermCResBuf[j]] =
+					cGuardCorrBlock[j];
+
+				vecrIntermPowRes[j][iPosInIntermCResBuf[j]] =
+					rGuardPowBlock[j];
+
+				/* Add the new block to the global result */
+				cGuardCorr[j] += cGuardCorrBlock[j];
+				rGuardPow[j] += rGuardPowBlock[j];
+
+				/* Reset block result */
+				cGuardCorrBlock[j] = (CReal) 0.0;
+				rGuardPowBlock[j] = (CReal) 0.0;
+
+				/* Increase position pointer and test if wrap */
+				iPosInIntermCResBuf[j]++;
+				if (iPosInIntermCResBuf[j] == iLengthIntermCRes[j])
+					iPosInIntermCResBuf[j] = 0;
+			}
+		}
+
+		/* Save correlation results in shift register */
+		for (k = 0; k < iRMCorrBufSize - 1; k++)
+			vecrRMCorrBuffer[j][k] = vecrRMCorrBuffer[j][k + 1];
+
+		/* ML solution */
+		vecrRMCorrBuffer[j][iRMCorrBufSize - 1] =
+			abs(cGuardCorr[j] + cGuardCorrBlock[j]) - 
+			(rGuardPow[j] + rGuardPowBlock[j]) / 2;
+
+		/* The timing detection only needs the selected mode */
+		if (j == iSelectedMode)
+			vecrSelModeCorr[i] = vecrRMCorrBuffer[j][iRMCorrBufSize - 1];
+
+		iCorrPos += iStepSizeGuardCorr;
+	}
+
+	/* Correlation with symbol rate frequency (Correlations must be normalized
+	   to be comparable! ("/ iGuardSizeX")) */
+	if (bRMDetection == TRUE)
+	{
+		vecrResMode[j] =
+			Abs(Sum(vecrRMCorrBuffer[j] * vecrCos[j])) / iLenGuardInt[j];
+	}
+}
+
 void CTimeSync::InitInternal(CParameter& Parameters)
 {
 	int	i, j;
@@ -666,9 +704,9 @@ void CTimeSync::InitInternal(CParameter& Parameters)
 	   always "VIRTUAL_INTERMED_FREQ" */
 	SetFilterTaps((CReal) VIRTUAL_INTERMED_FREQ / iSampleRate);
 
-	iGuardSize = Parameters.CellMappingTable.iGuardSize;
-	iDFTSize = Parameters.CellMappingTable.iFFTSizeN;
-	iSymbolBlockSize = Parameters.CellMappingTable.iSymbolBlockSize;
+	iGuardSize = Parameters.pCellMappingTable->iGuardSize;
+	iDFTSize = Parameters.pCellMappingTable->iFFTSizeN;
+	iSymbolBlockSize = Parameters.pCellMappingTable->iSymbolBlockSize;
 
 	/* Decimated symbol block size */
 	iDecSymBS = iSymbolBlockSize / iGrdcrrDecFact;
@@ -903,8 +941,16 @@ CTimeSync::CTimeSync() : iSampleRate(0), iGrdcrrDecFact(0),
 	iLengthOverlap(NUM_ROBUSTNESS_MODES), iLenUsefPart(NUM_ROBUSTNESS_MODES),
 	iLenGuardInt(NUM_ROBUSTNESS_MODES), cGuardCorr(NUM_ROBUSTNESS_MODES),
 	cGuardCorrBlock(NUM_ROBUSTNESS_MODES), rGuardPow(NUM_ROBUSTNESS_MODES),
-	rGuardPowBlock(NUM_ROBUSTNESS_MODES), vecrRMCorrBuffer()
+	rGuardPowBlock(NUM_ROBUSTNESS_MODES), vecrRMCorrBuffer(),
+	iNumCorrPos(0), vecrSelModeCorr(), vecrResMode(NUM_ROBUSTNESS_MODES),
+	bRMDetection(FALSE), pWorkerPool(NULL), vecpRMCorrTasks(NUM_ROBUSTNESS_MODES)
 {
+	for (int i = 0; i < NUM_ROBUSTNESS_MODES; i++)
+	{
+		RMCorrTask[i].pTimeSync = this;
+		RMCorrTask[i].iMode = i;
+		vecpRMCorrTasks[i] = &RMCorrTask[i];
+	}
 }
 
 int CTimeSync::GetIndFromRMode(ERobMode eNewMode)
@@ -33,6 +33,7 @@
 #include "../util/Modul.h"
 #include "../util/Vector.h"
 #include "../matlib/Matlib.h"
+#include "../util/WorkerPool.h"
 #include "TimeSyncFilter.h"
 
 
@@ -98,7 +99,23 @@ public:
 	void StopTimingAcqu() {bTimingAcqu = FALSE;}
 	void StopRMDetAcqu() {bRobModAcqu = FALSE;}
 
+	/* Threads for the guard-interval correlation of the robustness modes,
+	   "NULL" calculates all modes in the receiver thread */
+	void SetWorkerPool(CWorkerPool* pNewPool) {pWorkerPool = pNewPool;}
+
 protected:
+	/* Guard-interval correlation of one robustness mode for all positions of
+	   the current block */
+	class CRMCorrTask : public CWorkerTask
+	{
+	public:
+		CRMCorrTask() : pTimeSync(NULL), iMode(0) {}
+		virtual void Run() {pTimeSync->GuardCorrMode(iMode);}
+
+		CTimeSync*	pTimeSync;
+		int			iMode;
+	};
+
 	int							iSampleRate;
 	int							iGrdcrrDecFact;
 	int							iNumTapsHilbFilt;
@@ -107,8 +124,8 @@ protected:
 	int							iAveCorr;
 	int							iStepSizeGuardCorr;
 
-	CShiftRegister<_COMPLEX>	HistoryBuf;
-	CShiftRegister<_COMPLEX>	HistoryBufCorr;
+	CMirroredShiftRegister<_COMPLEX>	HistoryBuf;
+	CMirroredShiftRegister<_COMPLEX>	HistoryBufCorr;
 	CShiftRegister<_REAL>		pMaxDetBuffer;
 	CRealVector					vecrHistoryFilt;
 	CMovingAv<CReal>			vecrGuardEnMovAv;
@@ -167,6 +184,17 @@ protected:
 	CRealVector					vecrCos[NUM_ROBUSTNESS_MODES];
 	int							iRMCorrBufSize;
 
+	/* Correlation positions of the current block, results for the
+	   selected mode and for robustness mode detection */
+	int							iNumCorrPos;
+	CVector<CReal>				vecrSelModeCorr;
+	CRealVector					vecrResMode;
+	_BOOLEAN					bRMDetection;
+
+	CWorkerPool*				pWorkerPool;
+	CRMCorrTask					RMCorrTask[NUM_ROBUSTNESS_MODES];
+	vector<CWorkerTask*>		vecpRMCorrTasks;
+
 #ifdef USE_FRQOFFS_TRACK_GUARDCORR
 	CComplex					cFreqOffAv;
 	CReal						rLamFreqOff;
@@ -176,6 +204,7 @@ protected:
 	int			GetIndFromRMode(ERobMode eNewMode);
 	ERobMode	GetRModeFromInd(int iNewInd);
 	void		SetFilterTaps(CReal rNewOffsetNorm);
+	void		GuardCorrMode(const int j);
 
 	virtual void InitInternal(CParameter& Parameters);
 	virtual void ProcessDataInternal(CParameter& Parameters);
@@ -431,10 +431,10 @@ void CTimeSyncTrack::Process(CParameter& Parameters,
 
 void CTimeSyncTrack::Init(CParameter& Parameters, int iNewSymbDelay)
 {
-	iNumCarrier = Parameters.CellMappingTable.iNumCarrier;
-	iScatPilFreqInt = Parameters.CellMappingTable.iScatPilFreqInt;
-	iNumIntpFreqPil = Parameters.CellMappingTable.iNumIntpFreqPil;
-	iDFTSize = Parameters.CellMappingTable.iFFTSizeN;
+	iNumCarrier = Parameters.pCellMappingTable->iNumCarrier;
+	iScatPilFreqInt = Parameters.pCellMappingTable->iScatPilFreqInt;
+	iNumIntpFreqPil = Parameters.pCellMappingTable->iNumIntpFreqPil;
+	iDFTSize = Parameters.pCellMappingTable->iFFTSizeN;
 
 	/* Timing correction history */
 	iSymDelay = iNewSymbDelay;
@@ -451,14 +451,14 @@ void CTimeSyncTrack::Init(CParameter& Parameters, int iNewSymbDelay)
 
 	/* Lambda for IIR filter for averaging the PDS */
 	rLamAvPDS = IIR1Lam(TICONST_PDS_EST_TISYNC, (CReal) Parameters.GetSigSampleRate() /
-		Parameters.CellMappingTable.iSymbolBlockSize);
+		Parameters.pCellMappingTable->iSymbolBlockSize);
 
 	/* Vector for rotated result */
 	vecrAvPoDeSpRot.Init(iNumIntpFreqPil);
 
 	/* Length of guard-interval with respect to FFT-size! */
 	rGuardSizeFFT = (CReal) iNumCarrier *
-		Parameters.CellMappingTable.RatioTgTu.iEnum / Parameters.CellMappingTable.RatioTgTu.iDenom;
+		Parameters.pCellMappingTable->RatioTgTu.iEnum / Parameters.pCellMappingTable->RatioTgTu.iDenom;
 
 	/* Get the hamming window taps. The window is to reduce the leakage effect
 	   of a DFT transformation */
@@ -511,11 +511,11 @@ void CTimeSyncTrack::Init(CParameter& Parameters, int iNewSymbDelay)
 	/* Calculate number of symbols for a given time span as defined for the
 	   length of the sample rate offset estimation history size */
 	iLenCorrectionHist = (int) ((_REAL) Parameters.GetSigSampleRate() *
-		HIST_LEN_SAM_OFF_EST_TI_CORR / Parameters.CellMappingTable.iSymbolBlockSize);
+		HIST_LEN_SAM_OFF_EST_TI_CORR / Parameters.pCellMappingTable->iSymbolBlockSize);
 
 	/* Init count for acquisition */
 	iResOffAcqCntMax = (int) ((_REAL) Parameters.GetSigSampleRate() *
-		SAM_OFF_EST_TI_CORR_ACQ_LEN / Parameters.CellMappingTable.iSymbolBlockSize);
+		SAM_OFF_EST_TI_CORR_ACQ_LEN / Parameters.pCellMappingTable->iSymbolBlockSize);
 
 	/* Init sample rate offset estimation acquisition count */
 	iResOffsetAcquCnt = iResOffAcqCntMax;
@@ -525,7 +525,7 @@ void CTimeSyncTrack::Init(CParameter& Parameters, int iNewSymbDelay)
 
 	/* Symbol block size converted in domain of estimated PDS */
 	rSymBloSiIRDomain =
-		(CReal) Parameters.CellMappingTable.iSymbolBlockSize * iNumCarrier / iDFTSize;
+		(CReal) Parameters.pCellMappingTable->iSymbolBlockSize * iNumCarrier / iDFTSize;
 
 	/* Init variable for storing the old difference of maximum position */
 	iOldNonZeroDiff = 0;
@@ -722,8 +722,8 @@ void CTimeSyncTrack::CalculateRdel(CParameter& Parameters)
 	{
 		CReal rInterval =
 			((_REAL) (vecrIntervalEnd[j] - vecrIntervalStart[j])) *
-			Parameters.CellMappingTable.iFFTSizeN / (Parameters.GetSigSampleRate() *
-			Parameters.CellMappingTable.iNumIntpFreqPil * Parameters.CellMappingTable.iScatPilFreqInt) * 1000;
+			Parameters.pCellMappingTable->iFFTSizeN / (Parameters.GetSigSampleRate() *
+			Parameters.pCellMappingTable->iNumIntpFreqPil * Parameters.pCellMappingTable->iScatPilFreqInt) * 1000;
 
 		/* Clip the delay interval values for display purposes */
 		if (rInterval < (CReal) -9.9)
@@ -753,7 +753,7 @@ void CTimeSyncTrack::CalculateRdop(CParameter& Parameters)
 		rSumSqChan += SqMag(veccPilots[i]);
 	}
 
-	CReal rTs = (_REAL) Parameters.CellMappingTable.iSymbolBlockSize / Parameters.GetSigSampleRate();
+	CReal rTs = (_REAL) Parameters.pCellMappingTable->iSymbolBlockSize / Parameters.GetSigSampleRate();
 
 	Parameters.rRdop = Sqrt(rSumSqDiff / rSumSqChan) / (crPi * rTs);
 }
@@ -1236,6 +1236,7 @@ EPG::EPG(CParameter& NParameters):Parameters(NParameters)
     }
     dir = Parameters.GetDataDirectory("EPG").c_str();
     CreateDirectories(dir);
+    store.SetDirectory(Parameters.GetDataDirectory("EPG") + "store/");
     servicesFilename = dir + "services.xml";
     loadChannels (servicesFilename);
     saveChannels (servicesFilename);
@@ -1246,6 +1247,7 @@ EPG& EPG::operator=(const EPG& e)
     progs = e.progs;
     genres = e.genres;
     servicesFilename = e.servicesFilename;
+    store = e.store;
     Parameters = e.Parameters;
     return *this;
 }
@@ -1333,22 +1335,81 @@ EPG::parseDoc (const QDomDocument & doc)
                 }
                 l2 = l2.nextSibling ();
             }
-            time_t start;
-            if (p.actualTime!=0)
-                start = p.actualTime;
-            else
-                start = p.time;
-            QMap<time_t,CProg>::ConstIterator existing = progs.find(start);
-            if (existing != progs.end())
-            {
-                p.augment(existing.value());
-            }
-            progs[start] = p;
+            addProg (p);
         }
         l1 = l1.nextSibling ();
     }
 }
 
+void
+EPG::addProg (CProg & p)
+{
+    time_t start;
+    if (p.actualTime!=0)
+        start = p.actualTime;
+    else
+        start = p.time;
+    QMap<time_t,CProg>::ConstIterator existing = progs.find(start);
+    if (existing != progs.end())
+    {
+        p.augment(existing.value());
+    }
+    progs[start] = p;
+}
+
+void
+EPG::addProgrammes (const vector < CEPGProgramme > &v)
+{
+    for (size_t i = 0; i < v.size(); i++)
+    {
+        const CEPGProgramme& e = v[i];
+        CProg p;
+        p.time = e.time;
+        p.actualTime = e.actualTime;
+        p.duration = e.duration;
+        p.actualDuration = e.actualDuration;
+        p.name = QString().fromUtf8(e.name.c_str());
+        p.description = QString().fromUtf8(e.description.c_str());
+        p.crid = QString().fromUtf8(e.crid.c_str());
+        p.shortId = e.shortId;
+        size_t j;
+        for (j = 0; j < e.mainGenre.size(); j++)
+            p.mainGenre.push_back (genres[e.mainGenre[j].c_str()]);
+        for (j = 0; j < e.secondaryGenre.size(); j++)
+            p.secondaryGenre.push_back (genres[e.secondaryGenre[j].c_str()]);
+        for (j = 0; j < e.otherGenre.size(); j++)
+            p.otherGenre.push_back (genres[e.otherGenre[j].c_str()]);
+        addProg (p);
+    }
+}
+
+bool
+EPG::parseFile (const QString & fileName)
+{
+    QFile file (fileName);
+    if (!file.open (QIODevice::ReadOnly))
+        return false;
+    QByteArray data = file.readAll ();
+    file.close ();
+    vector<_BYTE> vecData (data.begin (), data.end ());
+    vector < CEPGProgramme > v;
+    CEPGBinaryDecoder decoder;
+    if (!decoder.Decode (vecData, v))
+        return false;
+    addProgrammes (v);
+    return true;
+}
+
+bool
+EPG::loadStore (uint32_t sid, time_t from, time_t to)
+{
+    vector < CEPGProgramme > v;
+    if (!store.Load (sid, from, to, v) || v.empty ())
+        return false;
+    addProgrammes (v);
+    return true;
+}
+
 void EPG::CProg::augment(const CProg& p)
 {
     if (p.time!=0)
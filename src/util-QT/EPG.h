@@ -35,6 +35,7 @@
 #include "../Parameter.h"
 #include "../datadecoding/DABMOT.h"
 #include "epgdec.h"
+#include "../datadecoding/epgstore.h"
 
 class EPG
 {
@@ -51,6 +52,11 @@ class EPG
     void saveChannels (const QString & fileName);
     void addChannel (const string& label, uint32_t sid);
     void parseDoc (const QDomDocument &);
+    /* decode a binary EPG file without building a document */
+    bool parseFile (const QString & fileName);
+    /* the programmes of a service the receiver has stored, FALSE if none */
+    bool loadStore (uint32_t sid, time_t from, time_t to);
+    void addProgrammes (const vector < CEPGProgramme > &);
 
     class CProg
     {
@@ -75,8 +81,10 @@ class EPG
     QString dir, servicesFilename;
     CParameter& Parameters;
     QMap < QString, time_t > filesLoaded;
+    CEPGStore store;
 private:
     static const struct gl { const char *genre; const char* desc; } genre_list[];
+    void addProg (CProg &);
     time_t parseTime(const QString & time);
     int parseDuration (const QString & duration);
 };
@@ -35,7 +35,7 @@
 #include "../datadecoding/DABMOT.h"
 #include "../util/Utilities.h"
 
-static QDomElement element(QDomDocument& doc, const tag_length_value& tlv);
+static QDomElement element(CEPGDecoder& dec, const tag_length_value& tlv);
 
 void
 CEPGDecoder::decode (const vector<_BYTE>& vecData)
@@ -44,7 +44,7 @@ CEPGDecoder::decode (const vector<_BYTE>& vecData)
     doc.setContent (QString (""));
     tag_length_value tlv(&vecData[0]);
     if(tlv.is_epg()) {
-      doc.appendChild (element(doc, tlv));
+      doc.appendChild (element(*this, tlv));
     }
 }
 
@@ -58,10 +58,6 @@ typedef struct
     enum_attr_t decode;
 } dectab;
 
-static char token_list[20][255];
-
-static uint32_t default_content_id;
-
 static const char *enums0[] = { (char*)2, "DAB", "DRM" };
 static const char *enums1[] = { (char*)9, 0, "series",
     "show",
@@ -268,10 +264,11 @@ static eltab_t element_tables[] = {
 
 
 
-string decode_string (const _BYTE * p, size_t len);
+string decode_string (const vector<string>& tokens, const _BYTE * p, size_t len);
 const string element_name (_BYTE tag);
-static void attribute(map<string,string>& out, _BYTE element_tag, tag_length_value& tlv);
-static void string_token_table(const tag_length_value& tlv);
+static void attribute(map<string,string>& out, const vector<string>& tokens,
+                      _BYTE element_tag, tag_length_value& tlv);
+static void string_token_table(vector<string>& tokens, const tag_length_value& tlv);
 
 uint16_t
 get_uint16 (const _BYTE* p)
@@ -304,8 +301,9 @@ tag_length_value::tag_length_value(const _BYTE* q)
 }
 
 static QDomElement
-element(QDomDocument& doc, const tag_length_value& tlv)
+element(CEPGDecoder& dec, const tag_length_value& tlv)
 {
+  QDomDocument& doc = dec.doc;
   QString name (element_tables[tlv.tag].element_name);
   QDomElement e = doc.createElement (name);
   map<string,string> attr;
@@ -319,7 +317,7 @@ element(QDomDocument& doc, const tag_length_value& tlv)
   tag_length_value a(tlv.value);
   while(a.is_attribute())
   {
-      attribute(attr, tlv.tag, a);
+      attribute(attr, dec.tokens, tlv.tag, a);
       _BYTE* p = a.value+a.length;
       if(p>=end)
         break;
@@ -332,16 +330,16 @@ element(QDomDocument& doc, const tag_length_value& tlv)
   while(p<end)
   {
       if(a.is_string_token_table() && !tlv.is_child_element())
-          string_token_table(a);
+          string_token_table(dec.tokens, a);
       else if(a.is_default_id() && !tlv.is_child_element()) {
-	      default_content_id = get_uint24(p);
+	      dec.default_content_id = get_uint24(p);
 	      p+=3;
       }
       else if(a.is_child_element()) {
-		e.appendChild (element(doc, a));
+		e.appendChild (element(dec, a));
 	}
       else if(a.is_cdata()) {
-          string value = decode_string(a.value, a.length);
+          string value = decode_string(dec.tokens, a.value, a.length);
 	  QDomText t = doc.createTextNode (QString ().fromUtf8 (value.c_str()));
 	  e.appendChild (t);
       }
@@ -378,7 +376,7 @@ decode_genre_href (const _BYTE* p, size_t len)
 }
 
 string
-decode_string (const _BYTE* p, size_t len)
+decode_string (const vector<string>& tokens, const _BYTE* p, size_t len)
 {
     size_t i;
     string out;
@@ -389,7 +387,7 @@ decode_string (const _BYTE* p, size_t len)
 	      if (c == 0x9 || c == 0xa || c == 0xd)
 		      out += c;
 	      else
-		      out += token_list[p[i]];
+		      out += tokens[p[i]];
 	  else
 	      out += c;
     }
@@ -548,7 +546,8 @@ decode_attribute_name(const dectab& tab)
 }
 
 static string
-decode_attribute_value (enum_attr_t format, const _BYTE* p, size_t len)
+decode_attribute_value (enum_attr_t format, const vector<string>& tokens,
+                        const _BYTE* p, size_t len)
 {
     switch(format) {
     case nu_attr:
@@ -558,7 +557,7 @@ decode_attribute_value (enum_attr_t format, const _BYTE* p, size_t len)
          return "undecoded enum";
          break;
     case string_attr:
-         return decode_string(p, len);
+         return decode_string(tokens, p, len);
          break;
     case u16_attr:
          return decode_uint16(p);
@@ -587,7 +586,8 @@ decode_attribute_value (enum_attr_t format, const _BYTE* p, size_t len)
     }
 }
 
-static void attribute(map<string,string>& out, _BYTE element_tag, tag_length_value& tlv)
+static void attribute(map<string,string>& out, const vector<string>& tokens,
+                      _BYTE element_tag, tag_length_value& tlv)
 {
   size_t el = size_t(element_tag);
   size_t e = sizeof (element_tables) / sizeof (eltab_t);
@@ -614,24 +614,25 @@ static void attribute(map<string,string>& out, _BYTE element_tag, tag_length_val
 		else
 			value = "out of range";
     } else {
-      value = decode_attribute_value(tab.decode, tlv.value, tlv.length);
+      value = decode_attribute_value(tab.decode, tokens, tlv.value, tlv.length);
     }
     out[name] = value;
   }
 }
 
-static void string_token_table(const tag_length_value& tlv)
+static void string_token_table(vector<string>& tokens, const tag_length_value& tlv)
 {
 	  size_t i = 0;
 	  _BYTE* p = tlv.value;
-	  for (i = 0; i < 20; i++)
-	      token_list[i][0] = 0;
-	  for (i = 0; i < tlv.length;)
+	  tokens.assign(EPG_NUM_STRING_TOKENS, string());
+	  for (i = 0; i + 2 <= tlv.length;)
 	    {
 		_BYTE tok = p[i++];
 		size_t tlen = p[i++];
-		memcpy (token_list[tok], &p[i], tlen);
-		token_list[tok][tlen] = 0;
+		if (i + tlen > tlv.length)
+		    break;
+		if (tok < EPG_NUM_STRING_TOKENS)
+		    tokens[tok].assign((const char*)&p[i], tlen);
 		i += tlen;
 	    }
 }
@@ -32,8 +32,12 @@
 #include "../GlobalDefinitions.h"
 #include <QDomDocument>
 #include <vector>
+#include <string>
 using namespace std;
 
+/* string tokens use the byte values 1 to 19 */
+#define EPG_NUM_STRING_TOKENS 20
+
 class tag_length_value
 {
 public:
@@ -56,12 +60,16 @@ public:
 class CEPGDecoder
 {
   public:
-    CEPGDecoder ():doc()
+    CEPGDecoder ():doc(),tokens(EPG_NUM_STRING_TOKENS),default_content_id(0)
     {
     }
     void decode (const vector<_BYTE>&);
 
     QDomDocument doc;
 
+    /* state of this decoder, the string tokens stay valid until the next
+       token table is received */
+    vector<string> tokens;
+    uint32_t default_content_id;
 };
 #endif
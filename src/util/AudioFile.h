@@ -72,6 +72,18 @@ public:
 		}
 	}
 
+	_BOOLEAN IsOpen() const {return pFile != NULL;}
+
+	/* "iNumSamples" interleaved stereo samples */
+	void AddSamples(const _SAMPLE* psData, const int iNumSamples)
+	{
+		if (pFile != NULL)
+		{
+			iBytesWritten += iNumSamples * sizeof(_SAMPLE);
+			(void)fwrite((const void*) psData, sizeof(_SAMPLE), size_t(iNumSamples), pFile);
+		}
+	}
+
 	void Close()
 	{
 		if (pFile != NULL)
@@ -45,6 +45,7 @@ public:
 	void			SetRequestFlag(const _BOOLEAN bNewRequestFlag)
 						{bRequestFlag = bNewRequestFlag;}
 	_BOOLEAN		GetRequestFlag() const {return bRequestFlag;}
+	int				GetBufferSize() const {return iBufferSize;}
 
 	/* Virtual function to be declared by the derived object */
 	virtual void				Init(const int iNewBufferSize);
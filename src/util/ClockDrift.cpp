@@ -0,0 +1,122 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	The sample rate offset the receiver estimates while it is locked is
+ *	mostly the error of the sound card clock, the transmitter clocks are
+ *	precise. It is averaged over hours per input device and kept in the
+ *	settings, so that the receiver starts with the right resampling ratio
+ *	instead of zero after every restart or loss of sync.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "ClockDrift.h"
+#include "Latency.h"
+#include <sstream>
+
+
+/* Implementation *************************************************************/
+void CClockDriftModel::LoadSettings(const CSettings& Settings)
+{
+	/* One entry per device: "<offset ppm> <observed seconds>" */
+	const INISection Section = Settings.GetIniSection("Clock drift");
+	for (INISection::const_iterator i = Section.begin(); i != Section.end(); i++)
+	{
+		CEstimate Estimate;
+		istringstream ss(i->second);
+		ss >> Estimate.rOffsetPPM >> Estimate.rObservedS;
+		if (!ss.fail() && fabs(Estimate.rOffsetPPM) < CLOCK_DRIFT_MAX_PPM)
+			mapDevices[i->first] = Estimate;
+	}
+}
+
+void CClockDriftModel::SaveSettings(CSettings& Settings) const
+{
+	for (map<string, CEstimate>::const_iterator i = mapDevices.begin();
+		i != mapDevices.end(); i++)
+	{
+		ostringstream ss;
+		ss << i->second.rOffsetPPM << " " << (int) i->second.rObservedS;
+		Settings.Put("Clock drift", i->first, ss.str());
+	}
+}
+
+void CClockDriftModel::SetDevice(const string& strNewDevice)
+{
+	const string strNewKey = Key(strNewDevice);
+	if (strNewKey != strDevice)
+	{
+		strDevice = strNewKey;
+		Pause();
+	}
+}
+
+void CClockDriftModel::Update(const _REAL rOffsetPPM)
+{
+	const uint64_t iNowNs = CLatencyStats::GetTimeNs();
+	const _REAL rDt = iLastUpdateNs == 0 ? (_REAL) 0.0 :
+		(_REAL) (iNowNs - iLastUpdateNs) / 1e9;
+	iLastUpdateNs = iNowNs;
+
+	if (rDt <= (_REAL) 0.0 || rDt > CLOCK_DRIFT_MAX_GAP_S ||
+		fabs(rOffsetPPM) >= CLOCK_DRIFT_MAX_PPM)
+	{
+		return;
+	}
+
+	/* Plain mean at first, later an exponential average with the memory
+	   as time constant */
+	CEstimate& Estimate = mapDevices[strDevice];
+	_REAL rWeight = Estimate.rObservedS + rDt;
+	if (rWeight > CLOCK_DRIFT_MEMORY_S)
+		rWeight = CLOCK_DRIFT_MEMORY_S;
+	Estimate.rOffsetPPM += rDt / rWeight * (rOffsetPPM - Estimate.rOffsetPPM);
+	Estimate.rObservedS += rDt;
+	if (Estimate.rObservedS > CLOCK_DRIFT_MEMORY_S)
+		Estimate.rObservedS = CLOCK_DRIFT_MEMORY_S;
+}
+
+_BOOLEAN CClockDriftModel::GetOffsetPPM(_REAL& rOffsetPPM) const
+{
+	map<string, CEstimate>::const_iterator i = mapDevices.find(strDevice);
+	if (i == mapDevices.end() || i->second.rObservedS < CLOCK_DRIFT_MIN_OBS_S)
+		return FALSE;
+
+	rOffsetPPM = i->second.rOffsetPPM;
+	return TRUE;
+}
+
+string CClockDriftModel::Key(const string& strDevice)
+{
+	/* The device name becomes an ini key */
+	if (strDevice.empty())
+		return "default";
+
+	string strKey = strDevice;
+	for (size_t i = 0; i < strKey.size(); i++)
+	{
+		const char c = strKey[i];
+		if (c == '=' || c == '[' || c == ']' || c == '\r' || c == '\n')
+			strKey[i] = '_';
+	}
+	return strKey;
+}
@@ -0,0 +1,87 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Learned sample clock drift of the sound cards. See ClockDrift.cpp.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#if !defined(CLOCK_DRIFT_H_INCLUDED)
+#define CLOCK_DRIFT_H_INCLUDED
+
+#include "../GlobalDefinitions.h"
+#include "Settings.h"
+#include <map>
+
+
+/* Definitions ****************************************************************/
+/* Observations older than this fade out, the drift changes with temperature
+   and ageing */
+#define CLOCK_DRIFT_MEMORY_S		((_REAL) 6.0 * 3600)
+/* Observation time before the estimate is used */
+#define CLOCK_DRIFT_MIN_OBS_S		((_REAL) 60.0)
+/* Larger gaps between two updates do not count as observation time */
+#define CLOCK_DRIFT_MAX_GAP_S		((_REAL) 2.0)
+/* Anything beyond is not a sound card clock */
+#define CLOCK_DRIFT_MAX_PPM			((_REAL) 1000.0)
+
+
+/* Classes ********************************************************************/
+class CClockDriftModel
+{
+public:
+	CClockDriftModel() : mapDevices(), strDevice(), iLastUpdateNs(0) {}
+	virtual ~CClockDriftModel() {}
+
+	void LoadSettings(const CSettings& Settings);
+	void SaveSettings(CSettings& Settings) const;
+
+	/* Device the following calls refer to */
+	void SetDevice(const string& strNewDevice);
+
+	/* Current offset estimate of the receiver while it is locked, called
+	   regularly. The time between the calls weights the observation */
+	void Update(const _REAL rOffsetPPM);
+	/* A new observation period starts with the next Update() */
+	void Pause() {iLastUpdateNs = 0;}
+
+	/* FALSE if the device has not been observed long enough */
+	_BOOLEAN GetOffsetPPM(_REAL& rOffsetPPM) const;
+
+protected:
+	class CEstimate
+	{
+	public:
+		CEstimate() : rOffsetPPM((_REAL) 0.0), rObservedS((_REAL) 0.0) {}
+
+		_REAL	rOffsetPPM;
+		_REAL	rObservedS;
+	};
+
+	static string Key(const string& strDevice);
+
+	map<string, CEstimate>	mapDevices;
+	string					strDevice; /* key */
+	uint64_t				iLastUpdateNs;
+};
+
+#endif // !defined(CLOCK_DRIFT_H_INCLUDED)
@@ -0,0 +1,199 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Histograms of processing times. Every module has one for its
+ *	ProcessData() calls, the receiver adds the times from the start of an
+ *	acquisition to each lock milestone. The histograms are logarithmic, so
+ *	adding a value is only a few integer operations
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "Latency.h"
+#include <sstream>
+#include <iomanip>
+#ifdef _WIN32
+# include <windows.h>
+#else
+# include <time.h>
+# include <sys/time.h>
+# include <unistd.h>
+#endif
+
+
+/* Implementation *************************************************************/
+CLatencyHistogram::CLatencyHistogram(const _BOOLEAN bNewProcessing) :
+	bProcessing(bNewProcessing)
+{
+	Reset();
+}
+
+void CLatencyHistogram::Add(const uint64_t iNs)
+{
+	/* Find bucket, log2 of the duration in microseconds */
+	uint64_t iUs = iNs / 1000;
+	int iBucket = 0;
+	while ((iUs > 1) && (iBucket < NUM_LATENCY_BUCKETS - 1))
+	{
+		iUs >>= 1;
+		iBucket++;
+	}
+	veciBucket[iBucket]++;
+
+	iCount++;
+	iSumNs += iNs;
+	iLastNs = iNs;
+	if (iNs > iMaxNs)
+		iMaxNs = iNs;
+}
+
+void CLatencyHistogram::Reset()
+{
+	for (int i = 0; i < NUM_LATENCY_BUCKETS; i++)
+		veciBucket[i] = 0;
+	iCount = 0;
+	iSumNs = 0;
+	iMaxNs = 0;
+	iLastNs = 0;
+}
+
+_REAL CLatencyHistogram::GetMeanUs() const
+{
+	if (iCount == 0)
+		return (_REAL) 0.0;
+	return (_REAL) iSumNs / iCount / 1000;
+}
+
+_REAL CLatencyHistogram::GetQuantileUs(const _REAL rQuantile) const
+{
+	if (iCount == 0)
+		return (_REAL) 0.0;
+
+	const uint64_t iRank = (uint64_t) (rQuantile * iCount);
+	uint64_t iSum = 0;
+	for (int i = 0; i < NUM_LATENCY_BUCKETS - 1; i++)
+	{
+		iSum += veciBucket[i];
+		if (iSum > iRank)
+		{
+			/* Upper bound of the bucket, but never more than the maximum */
+			const _REAL rBoundUs = (_REAL) ((uint64_t) 2 << i);
+			return rBoundUs < GetMaxUs() ? rBoundUs : GetMaxUs();
+		}
+	}
+	return GetMaxUs();
+}
+
+CLatencyStats::CLatencyStats() : Mutex(), mapHist(), iBusyNs(0),
+	bEnabled(TRUE)
+{
+}
+
+CLatencyHistogram* CLatencyStats::GetHistogram(const string& strName,
+	const _BOOLEAN bProcessing)
+{
+	Mutex.Lock();
+	map<string, CLatencyHistogram>::iterator it = mapHist.find(strName);
+	if (it == mapHist.end())
+	{
+		it = mapHist.insert(
+			make_pair(strName, CLatencyHistogram(bProcessing))).first;
+	}
+	CLatencyHistogram* pHist = &it->second;
+	Mutex.Unlock();
+
+	return pHist;
+}
+
+void CLatencyStats::Add(CLatencyHistogram* pHist, const uint64_t iNs)
+{
+	Mutex.Lock();
+	pHist->Add(iNs);
+	if (pHist->IsProcessing() == TRUE)
+		iBusyNs += iNs;
+	Mutex.Unlock();
+}
+
+void CLatencyStats::Reset()
+{
+	Mutex.Lock();
+	for (map<string, CLatencyHistogram>::iterator it = mapHist.begin();
+		it != mapHist.end(); it++)
+	{
+		it->second.Reset();
+	}
+	Mutex.Unlock();
+}
+
+uint64_t CLatencyStats::GetBusyNs()
+{
+	Mutex.Lock();
+	const uint64_t iNs = iBusyNs;
+	Mutex.Unlock();
+
+	return iNs;
+}
+
+void CLatencyStats::GetReport(vector<string>& vecstrLines)
+{
+	vecstrLines.clear();
+
+	Mutex.Lock();
+	for (map<string, CLatencyHistogram>::const_iterator it = mapHist.begin();
+		it != mapHist.end(); it++)
+	{
+		const CLatencyHistogram& Hist = it->second;
+
+		/* Only what was measured at least once */
+		if (Hist.GetCount() == 0)
+			continue;
+
+		stringstream ss;
+		ss << fixed << setprecision(0) << it->first
+			<< " count=" << Hist.GetCount()
+			<< " mean=" << Hist.GetMeanUs()
+			<< " p50=" << Hist.GetQuantileUs((_REAL) 0.5)
+			<< " p99=" << Hist.GetQuantileUs((_REAL) 0.99)
+			<< " max=" << Hist.GetMaxUs()
+			<< " last=" << Hist.GetLastUs();
+		vecstrLines.push_back(ss.str());
+	}
+	Mutex.Unlock();
+}
+
+uint64_t CLatencyStats::GetTimeNs()
+{
+#ifdef _WIN32
+	LARGE_INTEGER Freq, Count;
+	QueryPerformanceFrequency(&Freq);
+	QueryPerformanceCounter(&Count);
+	return (uint64_t) ((double) Count.QuadPart * 1e9 / Freq.QuadPart);
+#elif defined(_POSIX_TIMERS) && (_POSIX_TIMERS > 0)
+	timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (uint64_t) now.tv_sec * 1000000000 + now.tv_nsec;
+#else
+	timeval now;
+	gettimeofday(&now, NULL);
+	return (uint64_t) now.tv_sec * 1000000000 + (uint64_t) now.tv_usec * 1000;
+#endif
+}
@@ -0,0 +1,130 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	See Latency.cpp
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef LATENCY_H_INCLUDED
+#define LATENCY_H_INCLUDED
+
+#include "../GlobalDefinitions.h"
+#include <map>
+#include <string>
+#include <vector>
+
+
+/* Definitions ****************************************************************/
+/* Bucket "i" counts durations from 2^i to 2^(i+1) microseconds, the first
+   bucket everything below 2 us, the last one everything above */
+#define NUM_LATENCY_BUCKETS			32
+
+
+/* Classes ********************************************************************/
+class CLatencyHistogram
+{
+public:
+	CLatencyHistogram(const _BOOLEAN bNewProcessing = TRUE);
+
+	void Add(const uint64_t iNs);
+	void Reset();
+
+	uint64_t GetCount() const {return iCount;}
+	_REAL GetMeanUs() const;
+	_REAL GetMaxUs() const {return (_REAL) iMaxNs / 1000;}
+	_REAL GetLastUs() const {return (_REAL) iLastNs / 1000;}
+	/* Upper bound of the bucket which holds the "rQuantile" quantile */
+	_REAL GetQuantileUs(const _REAL rQuantile) const;
+
+	/* Module processing time, as opposed to waiting for I/O or a time
+	   since the start of the acquisition */
+	_BOOLEAN IsProcessing() const {return bProcessing;}
+
+protected:
+	_BOOLEAN	bProcessing;
+	uint64_t	veciBucket[NUM_LATENCY_BUCKETS];
+	uint64_t	iCount;
+	uint64_t	iSumNs;
+	uint64_t	iMaxNs;
+	uint64_t	iLastNs;
+};
+
+class CLatencyStats
+{
+public:
+	CLatencyStats();
+
+	void SetEnabled(const _BOOLEAN bNewEnabled) {bEnabled = bNewEnabled;}
+	_BOOLEAN GetEnabled() const {return bEnabled;}
+
+	/* The histogram is created on first use and stays valid as long as this
+	   object exists */
+	CLatencyHistogram* GetHistogram(const string& strName,
+		const _BOOLEAN bProcessing = TRUE);
+
+	void Add(CLatencyHistogram* pHist, const uint64_t iNs);
+	void Reset();
+
+	/* Sum of all processing times since the start */
+	uint64_t GetBusyNs();
+
+	/* One line per histogram: name count mean p50 p99 max last [us] */
+	void GetReport(vector<string>& vecstrLines);
+
+	/* Monotonic clock */
+	static uint64_t GetTimeNs();
+
+protected:
+	CMutex								Mutex;
+	map<string, CLatencyHistogram>		mapHist;
+	uint64_t							iBusyNs;
+	_BOOLEAN							bEnabled;
+};
+
+/* Adds the time between construction and destruction to a histogram */
+class CScopedTimer
+{
+public:
+	CScopedTimer(CLatencyStats* pNewStats, CLatencyHistogram* pNewHist) :
+		pStats((pNewStats != NULL) && (pNewHist != NULL) &&
+			(pNewStats->GetEnabled() == TRUE) ? pNewStats : NULL),
+		pHist(pNewHist),
+		iStartNs(pStats != NULL ? CLatencyStats::GetTimeNs() : 0) {}
+
+	~CScopedTimer()
+	{
+		if (pStats != NULL)
+			pStats->Add(pHist, CLatencyStats::GetTimeNs() - iStartNs);
+	}
+
+protected:
+	CLatencyStats*		pStats;
+	CLatencyHistogram*	pHist;
+	uint64_t			iStartNs;
+
+private:
+	CScopedTimer(const CScopedTimer&);
+	CScopedTimer& operator=(const CScopedTimer&);
+};
+
+#endif
@@ -32,6 +32,7 @@
 
 #include "Buffer.h"
 #include "Vector.h"
+#include "Latency.h"
 #include "../Parameter.h"
 #include <iostream>
 
@@ -48,6 +49,10 @@ public:
 	virtual void Init(CParameter& Parameter);
 	virtual void Init(CParameter& Parameter, CBuffer<TOutput>& OutputBuffer);
 
+	/* Measure the processing time of this module, "NULL" switches it off */
+	void SetLatencyStats(CLatencyStats* pNewStats, const string& strName,
+		const _BOOLEAN bProcessing = TRUE);
+
 protected:
 	CVectorEx<TInput>*	pvecInputData;
 	CVectorEx<TOutput>*	pvecOutputData;
@@ -64,10 +69,13 @@ protected:
 	void				InitThreadSave(CParameter& Parameter);
 	virtual void		InitInternal(CParameter& Parameter) = 0;
 	void				ProcessDataThreadSave(CParameter& Parameter);
+	void				ProcessDataTimed(CParameter& Parameter);
 	virtual void		ProcessDataInternal(CParameter& Parameter) = 0;
 
 private:
 	CMutex				Mutex;
+	CLatencyStats*		pLatencyStats;
+	CLatencyHistogram*	pLatencyHist;
 };
 
 
@@ -249,6 +257,27 @@ CModul<TInput, TOutput>::CModul()
 	iOutputBlockSize = 0;
 	pvecInputData = NULL;
 	pvecOutputData = NULL;
+	pLatencyStats = NULL;
+	pLatencyHist = NULL;
+}
+
+template<class TInput, class TOutput>
+void CModul<TInput, TOutput>::SetLatencyStats(CLatencyStats* pNewStats,
+	const string& strName, const _BOOLEAN bProcessing)
+{
+	pLatencyStats = pNewStats;
+	pLatencyHist = pNewStats != NULL ?
+		pNewStats->GetHistogram(strName, bProcessing) : NULL;
+}
+
+template<class TInput, class TOutput>
+void CModul<TInput, TOutput>::ProcessDataTimed(CParameter& Parameter)
+{
+	/* The timer is only running if statistics are enabled */
+	CScopedTimer Timer(pLatencyStats, pLatencyHist);
+
+	/* Call processing routine of derived modul */
+	ProcessDataInternal(Parameter);
 }
 
 template<class TInput, class TOutput>
@@ -258,7 +287,7 @@ void CModul<TInput, TOutput>::ProcessDataThreadSave(CParameter& Parameter)
 	Lock();
 
 	/* Call processing routine of derived modul */
-	ProcessDataInternal(Parameter);
+	ProcessDataTimed(Parameter);
 
 	/* Unlock resources */
 	Unlock();
@@ -387,7 +416,7 @@ _BOOLEAN CTransmitterModul<TInput, TOutput>::
 			SetExData((*(this->pvecInputData)).GetExData());
 
 		/* Call the underlying processing-routine */
-		this->ProcessDataInternal(Parameter);
+		this->ProcessDataTimed(Parameter);
 
 		/* Write processed data from internal memory in transfer-buffer */
 		OutputBuffer.Put(this->iOutputBlockSize);
@@ -442,7 +471,7 @@ void CTransmitterModul<TInput, TOutput>::
 		this->pvecOutputData = OutputBuffer.QueryWriteBuffer();
 
 		/* Call the underlying processing-routine */
-		this->ProcessDataInternal(Parameter);
+		this->ProcessDataTimed(Parameter);
 
 		/* Write processed data from internal memory in transfer-buffer */
 		OutputBuffer.Put(this->iOutputBlockSize);
@@ -465,7 +494,7 @@ void CTransmitterModul<TInput, TOutput>::
 		this->pvecOutputData = OutputBuffer.QueryWriteBuffer();
 
 		/* Call the underlying processing-routine */
-		this->ProcessDataInternal(Parameter);
+		this->ProcessDataTimed(Parameter);
 
 		/* Write processed data from internal memory in transfer-buffer */
 		OutputBuffer.Put(this->iOutputBlockSize);
@@ -493,7 +522,7 @@ _BOOLEAN CTransmitterModul<TInput, TOutput>::
 	this->pvecInputData = InputBuffer.Get(this->iInputBlockSize);
 
 	/* Call the underlying processing-routine */
-	this->ProcessDataInternal(Parameter);
+	this->ProcessDataTimed(Parameter);
 
 	return TRUE;
 }
@@ -1198,7 +1227,7 @@ void CSimulationModul<TInput, TOutput, TInOut2>::
 	this->pvecOutputData = OutputBuffer.QueryWriteBuffer();
 
 	/* Call the underlying processing-routine */
-	this->ProcessDataInternal(Parameter);
+	this->ProcessDataTimed(Parameter);
 
 	/* Write processed data from internal memory in transfer-buffer */
 	OutputBuffer.Put(this->iOutputBlockSize);
@@ -1232,7 +1261,7 @@ _BOOLEAN CSimulationModul<TInput, TOutput, TInOut2>::
 			SetExData((*(this->pvecInputData)).GetExData());
 
 		/* Call the underlying processing-routine */
-		this->ProcessDataInternal(Parameter);
+		this->ProcessDataTimed(Parameter);
 
 		/* Write processed data from internal memory in transfer-buffer */
 		OutputBuffer.Put(this->iOutputBlockSize);
@@ -1264,7 +1293,7 @@ _BOOLEAN CSimulationModul<TInput, TOutput, TInOut2>::
 		pvecOutputData2 = OutputBuffer2.QueryWriteBuffer();
 
 		/* Call the underlying processing-routine */
-		this->ProcessDataInternal(Parameter);
+		this->ProcessDataTimed(Parameter);
 
 		/* Write processed data from internal memory in transfer-buffers */
 		OutputBuffer.Put(this->iOutputBlockSize);
@@ -0,0 +1,182 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Bounded block queue between two processing threads. The producer hands
+ *	over the content of its output transfer-buffer, the consumer fills its
+ *	input transfer-buffer from it. Exactly one thread may push and one
+ *	thread may pop.
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#if !defined(PIPELINE_BUFFER_H__INCLUDED_)
+#define PIPELINE_BUFFER_H__INCLUDED_
+
+#include "../GlobalDefinitions.h"
+#include "Buffer.h"
+#include <vector>
+
+
+/* Classes ********************************************************************/
+template<class TData> class CPipelineBuffer
+{
+public:
+	CPipelineBuffer() : vecBlocks(), veciBlockSize(), iRead(0), iWrite(0),
+		iCount(0), bStopped(FALSE), Mutex(), NotEmpty(), NotFull() {}
+	virtual ~CPipelineBuffer() {}
+
+	void Init(const int iNewNumBlocks, const int iNewBlockSize);
+	void Clear();
+
+	/* Moves the whole content of "Buffer" into the queue, waits while the
+	   queue is full. Returns FALSE if the pipeline was stopped */
+	_BOOLEAN Push(CBuffer<TData>& Buffer);
+
+	/* Writes the next block into the (empty) "Buffer", waits while the
+	   queue is empty, at most "iMaxWaitMs" if it is not negative. Returns
+	   FALSE if the pipeline was stopped or nothing came in time */
+	_BOOLEAN Pop(CBuffer<TData>& Buffer, const int iMaxWaitMs = -1);
+
+	/* Wakes up both sides, Push() and Pop() return FALSE from now on */
+	void Stop();
+
+	int GetFillLevel();
+
+protected:
+	vector< CVectorEx<TData> >	vecBlocks;
+	vector<int>					veciBlockSize;
+	int							iRead; /* consumer only */
+	int							iWrite; /* producer only */
+	int							iCount; /* guarded by Mutex */
+	_BOOLEAN					bStopped;
+
+	CMutex						Mutex;
+	CWaitCondition				NotEmpty;
+	CWaitCondition				NotFull;
+};
+
+
+/* Implementation *************************************************************/
+template<class TData> void CPipelineBuffer<TData>::Init(const int iNewNumBlocks,
+														const int iNewBlockSize)
+{
+	vecBlocks.resize(iNewNumBlocks);
+	veciBlockSize.resize(iNewNumBlocks);
+	for (int i = 0; i < iNewNumBlocks; i++)
+		vecBlocks[i].Init(iNewBlockSize);
+
+	Clear();
+}
+
+template<class TData> void CPipelineBuffer<TData>::Clear()
+{
+	Mutex.Lock();
+	iRead = iWrite = iCount = 0;
+	bStopped = FALSE;
+	Mutex.Unlock();
+}
+
+template<class TData> void CPipelineBuffer<TData>::Stop()
+{
+	Mutex.Lock();
+	bStopped = TRUE;
+	NotEmpty.WakeAll();
+	NotFull.WakeAll();
+	Mutex.Unlock();
+}
+
+template<class TData> int CPipelineBuffer<TData>::GetFillLevel()
+{
+	Mutex.Lock();
+	const int iFill = iCount;
+	Mutex.Unlock();
+	return iFill;
+}
+
+template<class TData> _BOOLEAN CPipelineBuffer<TData>::Push(CBuffer<TData>& Buffer)
+{
+	const int iSize = Buffer.GetFillLevel();
+	if (iSize == 0)
+		return TRUE;
+
+	Mutex.Lock();
+	while (iCount == (int) vecBlocks.size() && !bStopped)
+		(void) NotFull.Wait(&Mutex, 100);
+	const _BOOLEAN bStop = bStopped;
+	Mutex.Unlock();
+	if (bStop)
+		return FALSE;
+
+	/* The free block belongs to the producer until it is counted */
+	CVectorEx<TData>& vecBlock = vecBlocks[iWrite];
+	CVectorEx<TData>* pvecIn = Buffer.Get(iSize);
+	if (vecBlock.Size() < iSize)
+		vecBlock.Init(iSize);
+	for (int i = 0; i < iSize; i++)
+		vecBlock[i] = (*pvecIn)[i];
+	vecBlock.SetExData(pvecIn->GetExData());
+	veciBlockSize[iWrite] = iSize;
+	iWrite = (iWrite + 1) % (int) vecBlocks.size();
+
+	Mutex.Lock();
+	iCount++;
+	NotEmpty.WakeOne();
+	Mutex.Unlock();
+	return TRUE;
+}
+
+template<class TData> _BOOLEAN CPipelineBuffer<TData>::Pop(CBuffer<TData>& Buffer,
+														const int iMaxWaitMs)
+{
+	Mutex.Lock();
+	if (iMaxWaitMs >= 0)
+	{
+		if (iCount == 0 && !bStopped)
+			(void) NotEmpty.Wait(&Mutex, iMaxWaitMs);
+	}
+	else
+	{
+		while (iCount == 0 && !bStopped)
+			(void) NotEmpty.Wait(&Mutex, 100);
+	}
+	const _BOOLEAN bNoData = bStopped || iCount == 0;
+	Mutex.Unlock();
+	if (bNoData)
+		return FALSE;
+
+	CVectorEx<TData>& vecBlock = vecBlocks[iRead];
+	const int iSize = veciBlockSize[iRead];
+	CVectorEx<TData>* pvecOut = Buffer.QueryWriteBuffer();
+	for (int i = 0; i < iSize; i++)
+		(*pvecOut)[i] = vecBlock[i];
+	pvecOut->SetExData(vecBlock.GetExData());
+	Buffer.Put(iSize);
+	iRead = (iRead + 1) % (int) vecBlocks.size();
+
+	Mutex.Lock();
+	iCount--;
+	NotFull.WakeOne();
+	Mutex.Unlock();
+	return TRUE;
+}
+
+#endif // !defined(PIPELINE_BUFFER_H__INCLUDED_)
@@ -29,40 +29,65 @@
 #include "Reassemble.h"
 #include <iostream>
 
-CReassemblerN::CReassemblerN (const CReassemblerN & r):iLastSegmentNum (r.iLastSegmentNum),
-		iLastSegmentSize (r.iLastSegmentSize),
-		iSegmentSize (r.iSegmentSize), Tracker (r.Tracker), bReady (r.bReady)
+_BOOLEAN
+CSegmentTrackerN::AddSegment (int iSegNum)
 {
-	vecData.resize (r.vecData.size ());
-	vecData = r.vecData;
-	vecLastSegment.resize (r.vecLastSegment.size ());
-	vecLastSegment = r.vecLastSegment;
+	if (iSegNum < 0)
+		return FALSE;
+	const size_t iWord = size_t (iSegNum) / BITS_PER_WORD;
+	const uint32_t iBit = uint32_t (1) << (iSegNum % BITS_PER_WORD);
+	if (iWord >= vecWords.size ())
+		vecWords.resize (iWord + 1, 0);
+	if (size_t (iSegNum) >= iSize)
+		iSize = iSegNum + 1;
+	if (vecWords[iWord] & iBit)
+		return FALSE;
+	vecWords[iWord] |= iBit;
+	iCount++;
+	return TRUE;
 }
 
-CReassemblerN & CReassemblerN::operator= (const CReassemblerN & r)
+size_t
+CSegmentTrackerN::Contiguous () const
 {
-	iLastSegmentNum = r.iLastSegmentNum;
-	iLastSegmentSize = r.iLastSegmentSize;
-	iSegmentSize = r.iSegmentSize;
-	Tracker = r.Tracker;
-	vecData.resize (r.vecData.size ());
-	vecData = r.vecData;
-	vecLastSegment.resize (r.vecLastSegment.size ());
-	vecLastSegment = r.vecLastSegment;
-	bReady = r.bReady;
-
-	return *this;
+	if (Ready ())
+		return iSize;
+	/* skip the full words, then count the ones in the first word with a gap */
+	size_t iWord = 0;
+	while (iWord < vecWords.size () && vecWords[iWord] == 0xffffffffUL)
+		iWord++;
+	size_t n = iWord * BITS_PER_WORD;
+	if (iWord < vecWords.size ())
+	{
+		uint32_t w = vecWords[iWord];
+		while (w & 1)
+		{
+			w >>= 1;
+			n++;
+		}
+	}
+	return n < iSize ? n : iSize;
 }
 
 void
-CReassemblerN::AddSegment (vector<_BYTE> &vecDataIn, int iSegNum, _BOOLEAN bLast)
+CReassemblyCore::SetSizeHint (size_t iBytes)
 {
+	if ((iBytes <= iSizeHint) || (iBytes > MAX_REASSEMBLY_PREALLOC))
+		return;
+	iSizeHint = iBytes;
+	reserve (iBytes);
+}
+
+CReassemblyCore::ESegmentAction
+CReassemblyCore::PlaceSegment (int iSegSize, int iSegNum, _BOOLEAN bLast)
+{
+	ESegmentAction eAction = SA_DISCARD;
 	if (bLast)
 	{
 		if (iLastSegmentNum == -1)
 		{
 			iLastSegmentNum = iSegNum;
-			iLastSegmentSize = vecDataIn.size();
+			iLastSegmentSize = iSegSize;
 			/* three cases:
 			   1: single segment - easy! (actually degenerate with case 3)
 			   2: multi-segment and the last segment came first.
@@ -71,43 +96,101 @@ CReassemblerN::AddSegment (vector<_BYTE> &vecDataIn, int iSegNum, _BOOLEAN bLast
 			 */
 			if (iSegNum == 0)
 			{					/* case 1 */
-				iSegmentSize = vecDataIn.size();
-				copyin (vecDataIn, 0);
+				iSegmentSize = iSegSize;
+				eAction = SA_COPY;
 			}
 			else if (iSegmentSize == 0)
 			{					/* case 2 */
-				cachelast (vecDataIn, vecDataIn.size());
+				eAction = SA_CACHE_LAST;
 			}
 			else
 			{					/* case 3 */
-				copyin (vecDataIn, iSegNum);
+				eAction = SA_COPY;
 			}
+			if (iSegmentSize != 0)
+				SetSizeHint (size_t (iLastSegmentNum) * iSegmentSize + iLastSegmentSize);
+			else
+				Tracker.Reserve (iLastSegmentNum + 1);
 		}						/* otherwise do nothing as we already have the last segment */
 	}
 	else
 	{
-		iSegmentSize = vecDataIn.size();
-		if (Tracker.HaveSegment (iSegNum) == FALSE)
+		if ((iSegmentSize == 0) && (iLastSegmentSize != -1))
 		{
-			copyin (vecDataIn, iSegNum);
+			/* the last segment came first, now the total is known */
+			SetSizeHint (size_t (iLastSegmentNum) * iSegSize + iLastSegmentSize);
 		}
+		else if ((iSegmentSize == 0) && (iSizeHint > 0) && (iSegSize > 0))
+		{
+			Tracker.Reserve (iSizeHint / iSegSize + 1);
+		}
+		iSegmentSize = iSegSize;
+		if (Tracker.HaveSegment (iSegNum) == FALSE)
+			eAction = SA_COPY;
 	}
 	Tracker.AddSegment (iSegNum);	/* tracking the last segment makes the Ready work! */
+	return eAction;
+}
 
+_BOOLEAN
+CReassemblyCore::JustCompleted ()
+{
 	if ((iLastSegmentSize != -1)	/* we have the last segment */
 		&& (bReady == false)	/* we haven't already completed reassembly */
 		&& Tracker.Ready ()		/* there are no gaps */
 		)
+	{
+		bReady = true;
+		return TRUE;
+	}
+	return FALSE;
+}
+
+CReassemblerN::CReassemblerN (const CReassemblerN & r):CReassemblyCore (r),
+		vecData (r.vecData), vecLastSegment (r.vecLastSegment)
+{
+}
+
+CReassemblerN & CReassemblerN::operator= (const CReassemblerN & r)
+{
+	CReassemblyCore::operator= (r);
+	vecData = r.vecData;
+	vecLastSegment = r.vecLastSegment;
+
+	return *this;
+}
+
+void
+CReassemblerN::AddSegment (vector<_BYTE> &vecDataIn, int iSegNum, _BOOLEAN bLast)
+{
+	switch (PlaceSegment (vecDataIn.size (), iSegNum, bLast))
+	{
+	case SA_COPY:
+		copyin (vecDataIn, iSegNum);
+		break;
+	case SA_CACHE_LAST:
+		cachelast (vecDataIn, vecDataIn.size ());
+		break;
+	case SA_DISCARD:
+		break;
+	}
+
+	if (JustCompleted ())
 	{
 		if (vecLastSegment.size () > 0)
 		{
 			/* we have everything, but the last segment came first */
 			copylast ();
 		}
-		bReady = true;
 	}
 }
 
+void
+CReassemblerN::reserve (size_t iBytes)
+{
+	vecData.reserve (iBytes);
+}
+
 void
 CReassemblerN::copyin (vector < _BYTE > &vecDataIn, size_t iSegNum)
 {
@@ -137,6 +220,12 @@ CReassemblerN::copylast ()
     vecLastSegment.resize (0);
 }
 
+void
+CBitReassemblerN::reserve (size_t iBytes)
+{
+	vecData.reserve (iBytes * (bPack?1:8));
+}
+
 void
 CBitReassemblerN::copyin (CVector < _BYTE > &vecDataIn, size_t iSegNum)
 {
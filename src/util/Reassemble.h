@@ -31,52 +31,137 @@
 
 #include "Vector.h"
 
+/* Size hints above this are not trusted for preallocation, the buffers
+   grow as the segments arrive instead */
+#define MAX_REASSEMBLY_PREALLOC (4*1024*1024)
+
+/* Record of the segments received so far, one bit per segment packed into
+ * words. The number of segments held is counted as they arrive, so checking
+ * for completeness doesn't need to look at the bitmap at all.
+ */
 class CSegmentTrackerN
 {
 public:
 
-	CSegmentTrackerN():vecbHaveSegment() { }
+	CSegmentTrackerN():vecWords(), iCount(0), iSize(0) { }
 
 	void Reset ()
 	{
-		vecbHaveSegment.clear ();
+		vecWords.clear ();
+		iCount = 0;
+		iSize = 0;
+	}
+
+	/* make room for the expected number of segments up front */
+	void Reserve (size_t iNumSegments)
+	{
+		vecWords.reserve ((iNumSegments + BITS_PER_WORD - 1) / BITS_PER_WORD);
+	}
+
+	/* highest segment number seen plus one */
+	size_t size () const
+	{
+		return iSize;
 	}
 
-	size_t size ()
+	/* number of different segments seen */
+	size_t count () const
 	{
-		return vecbHaveSegment.size ();
+		return iCount;
 	}
 
-	_BOOLEAN Ready ()
+	/* no gaps below the highest segment seen */
+	_BOOLEAN Ready () const
 	{
-		if (vecbHaveSegment.size () == 0)
+		return (iCount > 0) && (iCount == iSize);
+	}
+
+	/* returns TRUE if the segment is new */
+	_BOOLEAN AddSegment (int iSegNum);
+
+	_BOOLEAN HaveSegment (int iSegNum) const
+	{
+		if ((iSegNum < 0) || (size_t (iSegNum) >= iSize))
 			return FALSE;
-		for (size_t i = 0; i < vecbHaveSegment.size (); i++)
-		{
-			if (vecbHaveSegment[i] == FALSE)
-			{
-				return FALSE;
-			}
-		}
-		return TRUE;
+		return (vecWords[iSegNum / BITS_PER_WORD]
+				>> (iSegNum % BITS_PER_WORD)) & 1;
+	}
+
+	/* number of segments received without gap, counting from segment 0 */
+	size_t Contiguous () const;
+
+	size_t MemoryUsage () const
+	{
+		return vecWords.capacity () * sizeof (uint32_t);
 	}
 
-	void AddSegment (int iSegNum)
+protected:
+	enum { BITS_PER_WORD = 32 };
+
+	vector < uint32_t > vecWords;
+	size_t iCount;
+	size_t iSize;
+};
+
+/* The segment bookkeeping shared by all the reassemblers, i.e. the ones
+ * below used by PFT and the MOT ones in DABMOT.h: it decides what to do
+ * with each new segment and when the object is complete. Storing the data
+ * is left to the derived classes, which may also use the size hint to
+ * allocate their buffers in one go.
+ */
+class CReassemblyCore
+{
+public:
+
+	CReassemblyCore(): iLastSegmentNum(-1), iLastSegmentSize(-1),
+		iSegmentSize(0), Tracker(), bReady(false), iSizeHint(0)
 	{
-		if ((iSegNum + 1) > int (vecbHaveSegment.size ()))
-			vecbHaveSegment.resize (iSegNum + 1, FALSE);
-		vecbHaveSegment[iSegNum] = TRUE;
 	}
 
-	_BOOLEAN HaveSegment (int iSegNum)
+	virtual ~CReassemblyCore ()
 	{
-		if (iSegNum < int (vecbHaveSegment.size ()))
-			return vecbHaveSegment[iSegNum];
-		return FALSE;
 	}
 
+	_BOOLEAN Ready () const
+	{
+		return bReady;
+	}
+
+	/* the size of the complete object in bytes, if known from a header.
+	   Only used to preallocate, the segments decide the actual size */
+	void SetSizeHint (size_t iBytes);
+
 protected:
-	vector < _BOOLEAN > vecbHaveSegment;
+
+	enum ESegmentAction { SA_DISCARD, SA_COPY, SA_CACHE_LAST };
+
+	void ResetCore ()
+	{
+		iLastSegmentNum = -1;
+		iLastSegmentSize = -1;
+		iSegmentSize = 0;
+		Tracker.Reset ();
+		bReady = false;
+		iSizeHint = 0;
+	}
+
+	/* Account for a new segment and tell where its data has to go */
+	ESegmentAction PlaceSegment (int iSegSize, int iSegNum, _BOOLEAN bLast);
+
+	/* TRUE once, when the last gap has just been closed */
+	_BOOLEAN JustCompleted ();
+
+	/* Called with the expected object size in bytes as soon as it is known */
+	virtual void reserve (size_t)
+	{
+	}
+
+	int iLastSegmentNum;
+	int iLastSegmentSize;
+	size_t iSegmentSize;
+	CSegmentTrackerN Tracker;
+	bool bReady;
+	size_t iSizeHint;
 };
 
 /* The base class reassembles chunks of byte vectors into one big vector.
@@ -97,13 +182,11 @@ protected:
  *
  */
 
-class CReassemblerN
+class CReassemblerN: public CReassemblyCore
 {
 public:
 
-	CReassemblerN(): vecData(), vecLastSegment(),
-		iLastSegmentNum(-1), iLastSegmentSize(-1), iSegmentSize(0),
-		Tracker(), bReady(false)
+	CReassemblerN(): CReassemblyCore(), vecData(), vecLastSegment()
 	{
 	}
 
@@ -119,16 +202,7 @@ public:
 	{
 		vecData.resize (0);
 		vecLastSegment.resize (0);
-		iLastSegmentNum = -1;
-		iLastSegmentSize = -1;
-		iSegmentSize = 0;
-		Tracker.Reset ();
-		bReady = false;
-	}
-
-	_BOOLEAN Ready ()
-	{
-		return bReady;
+		ResetCore ();
 	}
 
 	void AddSegment (vector<_BYTE> &vecDataIn, int iSegNum, _BOOLEAN bLast);
@@ -140,13 +214,9 @@ protected:
 	virtual void copyin (vector<_BYTE> &vecDataIn, size_t iSegNum);
 	virtual void cachelast (vector<_BYTE> &vecDataIn, size_t iSegSize);
 	virtual void copylast ();
+	virtual void reserve (size_t iBytes);
 
 	vector<_BYTE> vecLastSegment;
-	int iLastSegmentNum;
-	int iLastSegmentSize;
-	size_t iSegmentSize;
-	CSegmentTrackerN Tracker;
-	bool bReady;
 };
 
 /* CBitReassemblerN uses the Dream CVector class to take a vector of bytes, each holding one bit.
@@ -173,7 +243,7 @@ public:
 
 	inline CBitReassemblerN & operator= (const CBitReassemblerN & r)
 	{
-		CReassemblerN(*this) = r;
+		CReassemblerN::operator= (r);
 		bPack = r.bPack;
 		return *this;
 	}
@@ -183,6 +253,7 @@ protected:
 	virtual void copyin (CVector < _BYTE > &vecDataIn, size_t iSegNum);
 	virtual void cachelast (CVector < _BYTE > &vecDataIn, size_t iSegSize);
 	virtual void copylast ();
+	virtual void reserve (size_t iBytes);
 
 	bool bPack;
 };
@@ -300,6 +300,14 @@ CSettings::ParseArguments(int argc, char **argv)
 			continue;
 		}
 
+		/* Audio output jitter buffer --------------------------------------- */
+		if (GetNumericArgument(argc, argv, i, "--audiolatency", "--audiolatency",
+							   0, 5000, rArgument) == TRUE)
+		{
+			Put("Receiver", "audiolatency", int (rArgument));
+			continue;
+		}
+
 		/* Reverb audio flag ------------------------------------------------ */
 		if (GetNumericArgument(argc, argv, i, "-b", "--reverb",
 							   0, 1, rArgument) == TRUE)
@@ -340,6 +348,54 @@ CSettings::ParseArguments(int argc, char **argv)
 			continue;
 		}
 
+		/* Transmitter: render the signal to a file, not in realtime -------- */
+		if (GetStringArgument(argc, argv, i, "--render", "--render",
+							  strArgument) == TRUE)
+		{
+			Put("command", "render", strArgument);
+			continue;
+		}
+
+		/* Length of the rendering ------------------------------------------ */
+		if (GetNumericArgument(argc, argv, i, "--renderlen", "--renderlen",
+							   0, 86400, rArgument) == TRUE)
+		{
+			Put("command", "renderlen", rArgument);
+			continue;
+		}
+
+		/* SlideShow pictures for the rendering ----------------------------- */
+		if (GetStringArgument(argc, argv, i, "--slideshow", "--slideshow",
+							  strArgument) == TRUE)
+		{
+			Put("command", "slideshow", strArgument);
+			continue;
+		}
+
+		/* Channel simulation for the rendering ----------------------------- */
+		if (GetNumericArgument(argc, argv, i, "--channel", "--channel",
+							   0, 12, rArgument) == TRUE)
+		{
+			Put("command", "channel", int (rArgument));
+			continue;
+		}
+
+		if (GetNumericArgument(argc, argv, i, "--snr", "--snr",
+							   -20, 100, rArgument) == TRUE)
+		{
+			Put("command", "snr", rArgument);
+			continue;
+		}
+
+		/* Channel simulation of an I/Q file, input from -f ----------------- */
+		if (GetStringArgument(argc, argv, i, "--chansim", "--chansim",
+							  strArgument) == TRUE)
+		{
+			Put("command", "mode", "channelsim");
+			Put("command", "chansim", strArgument);
+			continue;
+		}
+
 		/* Number of iterations for MLC setting ----------------------------- */
 		if (GetNumericArgument(argc, argv, i, "-i", "--mlciter", 0,
 							   MAX_NUM_MLC_IT, rArgument) == TRUE)
@@ -465,13 +521,15 @@ CSettings::ParseArguments(int argc, char **argv)
 
 
 #endif
-		/* MDI out address -------------------------------------------------- */
+		/* MDI out address, transmitter ------------------------------------- */
 		if (GetStringArgument(argc, argv, i, "--mdiout", "--mdiout",
 							  strArgument) == TRUE)
 		{
-			cerr <<
-				"content server mode not implemented yet, perhaps you wanted rsiout"
-				<< endl;
+			string s = Get("command", "mdiout", string(""));
+			if(s == "")
+				Put("command", "mdiout", strArgument);
+			else
+				Put("command", "mdiout", s+" "+strArgument);
 			continue;
 		}
 
@@ -586,6 +644,14 @@ CSettings::ParseArguments(int argc, char **argv)
 			continue;
 		}
 #endif
+		/* Headless multi-receiver daemon ----------------------------------- */
+		if (GetStringArgument(argc, argv, i, "--daemon", "--daemon", strArgument) == TRUE)
+		{
+			Put("command", "mode", "daemon");
+			Put("command", "daemonconfig", strArgument);
+			continue;
+		}
+
 		/* invoke test functionality ---------------------------------------- */
 		if (GetStringArgument(argc, argv, i, "--test", "--test", strArgument) == TRUE)
 		{
@@ -639,9 +705,20 @@ CSettings::UsageArguments()
 		"  -i <n>, --mlciter <n>        number of MLC iterations (allowed range: 0...4 default: 1)\n"
 		"  -s <r>, --sampleoff <r>      sample rate offset initial value [Hz] (allowed range: -200.0...200.0)\n"
 		"  -m <b>, --muteaudio <b>      mute audio output (0: off; 1: on)\n"
+		"  --audiolatency <n>           audio output through a jitter buffer with clock drift\n"
+		"                               compensation, reserve kept in the buffer before each\n"
+		"                               audio frame [ms] (0: off, default)\n"
 		"  -b <b>, --reverb <b>         audio reverberation on drop-out (0: off; 1: on)\n"
 		"  -f <s>, --fileio <s>         disable sound card, use file <s> instead\n"
 		"  -w <s>, --writewav <s>       write output to wave file\n"
+		"  --render <s>                 transmitter: write the signal to file <s> (.wav or raw) as fast as possible,\n"
+		"                               audio from the file given with -f, silence without\n"
+		"  --renderlen <r>              length of the rendering [s] (default: 60)\n"
+		"  --slideshow <s>              render a SlideShow data service with the files of directory <s>\n"
+		"  --channel <n>                render through simulation channel <n> (0: off (default); 1...12)\n"
+		"  --snr <r>                    SNR of the simulation channel [dB] (default: 30)\n"
+		"  --chansim <s>                run the I/Q file given with -f through the channel given with --channel\n"
+		"                               and write it to file <s>, no receiver (raw files at the rate of -R)\n"
 		"  -S <r>, --fracwinsize <r>    freq. acqu. search window size [Hz] (-1.0: sample rate / 2 (default))\n"
 		"  -E <r>, --fracwincent <r>    freq. acqu. search window center [Hz] (-1.0: sample rate / 4 (default))\n"
 		"  -F <b>, --filter <b>         apply bandpass filter (0: off; 1: on)\n"
@@ -664,7 +741,8 @@ CSettings::UsageArguments()
 		"                               0: blue-white (default);   1: green-black;   2: black-grey\n"
 #endif
 		"  --enablepsd <b>              if 0 then only measure PSD when RSCI in use otherwise always measure it\n"
-		"  --mdiout <s>                 MDI out address format [IP#:]IP#:port (for Content Server)\n"
+		"  --mdiout <s>                 transmitter: MDI out address [IP#:]IP#:port, can be repeated\n"
+		"                               (prefix address with 'p' for PFT, with 'f' for PFT with FEC)\n"
 		"  --mdiin  <s>                 MDI in address (for modulator) [[IP#:]IP:]port\n"
 		"  --rsioutprofile <s>          MDI/RSCI output profile: A|B|C|D|Q|M\n"
 		"  --rsiout <s>                 MDI/RSCI output address format [IP#:]IP#:port (prefix address with 'p' to enable the simple PFT)\n"
@@ -678,7 +756,8 @@ CSettings::UsageArguments()
 		"  -R <n>, --samplerate <n>     set audio and signal sound card sample rate [Hz]\n"
 		"  --audsrate <n>               set audio sound card sample rate [Hz] (allowed range: 8000...192000)\n"
 		"  --sigsrate <n>               set signal sound card sample rate [Hz] (allowed values: 24000, 48000, 96000, 192000)\n"
-		"  -I <s>, --snddevin <s>       set sound in device\n"
+		"  -I <s>, --snddevin <s>       set sound in device, shm:<name> reads the I/Q ring <name>\n"
+		"                               of an SDR program (see src/sound/shmiq.h)\n"
 		"  -O <s>, --snddevout <s>      set sound out device\n"
 		"  -U <n>, --sigupratio <n>     set signal upscale ratio (allowed values: 1, 2)\n"
 #ifdef HAVE_LIBHAMLIB
@@ -687,6 +766,9 @@ CSettings::UsageArguments()
 		"  -T <b>, --ensmeter <b>       enable S-Meter (0: off; 1: on)\n"
 #endif
 		"  --test <n>                   if 1 then some test setup will be done\n"
+#if defined(QT_CORE_LIB) && !defined(QT_GUI_LIB)
+		"  --daemon <s>                 run the receivers listed in config file <s> without user interface\n"
+#endif
 		"  -h, -?, --help               this help text\n"
 		"\n"
 		"Example: $EXECNAME -p --sampleoff -0.23 -i 2"
@@ -786,6 +868,29 @@ CIniFile::GetIniSetting(const string& section,
 	return result;
 }
 
+INISection
+CIniFile::GetIniSection(const string& section) const
+{
+	INISection result;
+	const_cast<CMutex*>(&Mutex)->Lock();
+	INIFile::const_iterator iSection = ini.find(section);
+	if (iSection != ini.end())
+		result = iSection->second;
+	const_cast<CMutex*>(&Mutex)->Unlock();
+	return result;
+}
+
+vector<string>
+CIniFile::GetIniSectionNames() const
+{
+	vector<string> result;
+	const_cast<CMutex*>(&Mutex)->Lock();
+	for (INIFile::const_iterator i = ini.begin(); i != ini.end(); i++)
+		result.push_back(i->first);
+	const_cast<CMutex*>(&Mutex)->Unlock();
+	return result;
+}
+
 void
 CIniFile::PutIniSetting(const string& section, const string& key, const string& value)
 {
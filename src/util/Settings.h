@@ -32,6 +32,7 @@
 #include "../GlobalDefinitions.h"
 #include <map>
 #include <string>
+#include <vector>
 
 
 /* Definitions ****************************************************************/
@@ -141,6 +142,8 @@ public:
 				const string& strDefaultVal = "") const;
 	void PutIniSetting(const string& strSection, const string& strKey="",
 				const string& strVal = "");
+	INISection GetIniSection(const string& strSection) const;
+	vector<string> GetIniSectionNames() const;
 protected:
 	INIFile ini;
 	CMutex Mutex;
@@ -31,6 +31,7 @@
 
 #include "../GlobalDefinitions.h"
 #include <vector>
+#include <algorithm>
 
 
 /******************************************************************************\
@@ -60,6 +61,9 @@ public:
 
 	void Enlarge(const int iAddedSize);
 	void Add(const TData& tI) {Enlarge(1); pData[iVectorSize - 1] = tI;}
+	/* Preallocate without changing the size */
+	void Reserve(const int iNewCapacity)
+		{this->reserve(iNewCapacity); pData = this->begin();}
 
 	inline int Size() const {return iVectorSize;}
 
@@ -106,6 +110,14 @@ public:
 	}
 
 
+	/* Exchange the contents with a standard vector without copying */
+	void Swap(vector<TData>& vecI) {
+		vector<TData>::swap(vecI);
+		iVectorSize = (int) this->size();
+		iBitArrayCounter = 0;
+		pData = this->begin();
+	}
+
 	/* Bit operation functions */
 	void		Enqueue(uint32_t iInformation, const int iNumOfBits);
 	uint32_t	Separate(const int iNumOfBits);
@@ -264,6 +276,133 @@ template<class TData> void CShiftRegister<TData>::AddEnd(const CVector<TData>& v
 }
 
 
+/******************************************************************************\
+* CMirroredShiftRegister class                                                 *
+\******************************************************************************/
+/* Same behaviour as "AddEnd()" of the CShiftRegister but without moving the
+   old values. The data is stored twice in a buffer of double size, so the
+   current register content is always available as one linear window starting
+   at the oldest value. Adding a block costs O(block) instead of O(register) */
+template<class TData> class CMirroredShiftRegister
+{
+public:
+	CMirroredShiftRegister() : vecBuffer(), iSize(0), iStart(0) {}
+	CMirroredShiftRegister(const int iNeSi) {Init(iNeSi);}
+	CMirroredShiftRegister(const int iNeSi, const TData tInVa)
+		{Init(iNeSi, tInVa);}
+
+	void Init(const int iNewSize);
+	void Init(const int iNewSize, const TData tIniVal);
+	void Reset(const TData tResetVal);
+
+	inline int Size() const {return iSize;}
+
+	/* Add one value at the end, the oldest value drops out */
+	void AddEnd(const TData tNewD);
+
+	/* Add a vector at the end, the oldest values drop out */
+	void AddEnd(const CVector<TData>& vectNewD, const int iLen);
+
+	/* Index 0 is the oldest value, "Size() - 1" the newest one */
+	inline TData operator[](const int iPos) const {
+#ifdef _DEBUG_
+		if ((iPos < 0) || (iPos > iSize - 1))
+		{
+			DebugError("Reading shift register out of bounds",
+				"Register size", iSize, "New parameter", iPos);
+		}
+#endif
+		return vecBuffer[iStart + iPos];}
+
+	/* Linear view of the whole register, valid until the next "AddEnd()" */
+	inline const TData* Window() const {return &vecBuffer[iStart];}
+
+protected:
+	vector<TData>	vecBuffer;
+	int				iSize;
+	int				iStart;
+};
+
+template<class TData> void CMirroredShiftRegister<TData>::Init(
+	const int iNewSize)
+{
+	iSize = iNewSize;
+	iStart = 0;
+
+	vecBuffer.clear();
+	vecBuffer.resize(2 * iNewSize);
+}
+
+template<class TData> void CMirroredShiftRegister<TData>::Init(
+	const int iNewSize, const TData tIniVal)
+{
+	Init(iNewSize);
+	Reset(tIniVal);
+}
+
+template<class TData> void CMirroredShiftRegister<TData>::Reset(
+	const TData tResetVal)
+{
+	std::fill(vecBuffer.begin(), vecBuffer.end(), tResetVal);
+	iStart = 0;
+}
+
+template<class TData> void CMirroredShiftRegister<TData>::AddEnd(
+	const TData tNewD)
+{
+	if (iSize == 0)
+		return;
+
+	/* The oldest value is overwritten in both halves */
+	vecBuffer[iStart] = tNewD;
+	vecBuffer[iStart + iSize] = tNewD;
+
+	iStart++;
+	if (iStart == iSize)
+		iStart = 0;
+}
+
+template<class TData> void CMirroredShiftRegister<TData>::AddEnd(
+	const CVector<TData>& vectNewD, const int iLen)
+{
+	if ((iSize == 0) || (iLen <= 0))
+		return;
+
+	int iSrc = 0;
+	int iNum = iLen;
+
+	/* Only the last "iSize" values can survive */
+	if (iNum > iSize)
+	{
+		iSrc = iNum - iSize;
+		iNum = iSize;
+	}
+
+	/* Write in at most two runs, the second one wraps around */
+	const int iFirst = min(iNum, iSize - iStart);
+	TData* pBuf = &vecBuffer[0];
+	int i;
+
+	for (i = 0; i < iFirst; i++)
+	{
+		const TData tVal = vectNewD[iSrc + i];
+		pBuf[iStart + i] = tVal;
+		pBuf[iStart + iSize + i] = tVal;
+	}
+
+	for (i = iFirst; i < iNum; i++)
+	{
+		const TData tVal = vectNewD[iSrc + i];
+		pBuf[i - iFirst] = tVal;
+		pBuf[i - iFirst + iSize] = tVal;
+	}
+
+	iStart += iNum;
+	if (iStart >= iSize)
+		iStart -= iSize;
+}
+
+
 /******************************************************************************\
 * CFIFO class (first in, first out)                                            *
 \******************************************************************************/
@@ -409,19 +548,124 @@ protected:
 /******************************************************************************\
 * CMatrix base class                                                           *
 \******************************************************************************/
-template<class TData> class CMatrix
+/* Views into the storage of a CMatrix. They do not own any memory and are only
+   valid until the matrix is initialized again */
+template<class TData> class CMatrixConstRow
 {
 public:
-	CMatrix() : ppData(NULL), iRow(0), iCol(0) {}
-	CMatrix(const int iNewR, const int iNewC) {Init(iNewR, iNewC);}
-	CMatrix(const int iNewR, const int iNewC, const TData tInVa) 
-		{Init(iNewR, iNewC, tInVa);}
-	CMatrix(const CMatrix& m): ppData(NULL) {
-		Init(m.iRow,m.iCol); 
-		for (int i=0; i<m.NumRows(); i++)
-			ppData[i] = m[i];
+	CMatrixConstRow(const TData* pNewData, const int iNewSize) :
+		pData(pNewData), iSize(iNewSize) {}
+
+	inline int Size() const {return iSize;}
+	inline const TData* Data() const {return pData;}
+
+	inline const TData& operator[](const int iPos) const {
+#ifdef _DEBUG_
+		if ((iPos < 0) || (iPos > iSize - 1))
+		{
+			DebugError("Matrix row: Reading out of bounds", "Row size",
+				iSize, "New parameter", iPos);
+		}
+#endif
+		return pData[iPos];}
+
+protected:
+	const TData*	pData;
+	int				iSize;
+};
+
+template<class TData> class CMatrixRow
+{
+public:
+	CMatrixRow(TData* pNewData, const int iNewSize) :
+		pData(pNewData), iSize(iNewSize) {}
+
+	inline int Size() const {return iSize;}
+	inline TData* Data() const {return pData;}
+
+	inline operator CMatrixConstRow<TData>() const
+		{return CMatrixConstRow<TData>(pData, iSize);}
+
+	inline TData& operator[](const int iPos) {
+#ifdef _DEBUG_
+		if ((iPos < 0) || (iPos > iSize - 1))
+		{
+			DebugError("Matrix row: Writing out of bounds", "Row size",
+				iSize, "New parameter", iPos);
+		}
+#endif
+		return pData[iPos];}
+
+	inline const TData& operator[](const int iPos) const {
+#ifdef _DEBUG_
+		if ((iPos < 0) || (iPos > iSize - 1))
+		{
+			DebugError("Matrix row: Reading out of bounds", "Row size",
+				iSize, "New parameter", iPos);
+		}
+#endif
+		return pData[iPos];}
+
+	/* Assigning copies the elements, the sizes must be the same */
+	inline CMatrixRow<TData>& operator=(const CMatrixRow<TData>& rowI) {
+		for (int i = 0; i < iSize; i++)
+			pData[i] = rowI[i];
+		return *this;
 	}
-	virtual	~CMatrix();
+
+	inline CMatrixRow<TData>& operator=(const CVector<TData>& vecI) {
+		for (int i = 0; i < iSize; i++)
+			pData[i] = vecI[i];
+		return *this;
+	}
+
+	inline CMatrixRow<TData>& operator=(const CMatrixConstRow<TData>& rowI) {
+		for (int i = 0; i < iSize; i++)
+			pData[i] = rowI[i];
+		return *this;
+	}
+
+protected:
+	TData*	pData;
+	int		iSize;
+};
+
+template<class TData> class CMatrixColumn
+{
+public:
+	CMatrixColumn(TData* pNewData, const int iNewSize, const int iNewStride) :
+		pData(pNewData), iSize(iNewSize), iStride(iNewStride) {}
+
+	inline int Size() const {return iSize;}
+
+	inline TData& operator[](const int iPos) const {
+#ifdef _DEBUG_
+		if ((iPos < 0) || (iPos > iSize - 1))
+		{
+			DebugError("Matrix column: Access out of bounds", "Column size",
+				iSize, "New parameter", iPos);
+		}
+#endif
+		return pData[iPos * iStride];}
+
+protected:
+	TData*	pData;
+	int		iSize;
+	int		iStride;
+};
+
+/* All elements are stored row by row in one contiguous block of memory.
+   "operator[]" returns a view of one row so that "Matrix[row][column]" works
+   as before */
+template<class TData> class CMatrix
+{
+public:
+	CMatrix() : vecData(), iRow(0), iCol(0) {}
+	CMatrix(const int iNewR, const int iNewC) : vecData(), iRow(0), iCol(0)
+		{Init(iNewR, iNewC);}
+	CMatrix(const int iNewR, const int iNewC, const TData tInVa) :
+		vecData(), iRow(0), iCol(0) {Init(iNewR, iNewC, tInVa);}
+	virtual	~CMatrix() {}
 
 	void Init(const int iNewRow, const int iNewColumn);
 
@@ -429,37 +673,46 @@ public:
 	void Init(const int iNewRow, const int iNewColumn, const TData tIniVal);
 	void Reset(const TData tResetVal);
 
-	inline CVector<TData>& operator[](const int iPos) const {
+	inline CMatrixRow<TData> operator[](const int iPos) {
 #ifdef _DEBUG_
 		if ((iPos < 0) || (iPos > iRow - 1))
 		{
 			DebugError("Matrix: Writing vector out of bounds", "Row size",
 				iRow, "New parameter", iPos);
 		}
-#endif		
-		return ppData[iPos];}
-
-	inline CMatrix& operator=(const CMatrix& m) {
-		this->Init(m.NumRows(), m.NumColumns());
-		for (int i=0; i<m.NumRows(); i++)
-			this->ppData[i] = m[i];
-		return *this;
-	}
+#endif
+		return CMatrixRow<TData>(Data() + iPos * iCol, iCol);}
 
+	inline CMatrixConstRow<TData> operator[](const int iPos) const {
 #ifdef _DEBUG_
-	inline CVector<TData> operator[](const int iPos) const {
 		if ((iPos < 0) || (iPos > iRow - 1))
 		{
 			DebugError("Matrix: Reading vector out of bounds", "Row size",
 				iRow, "New parameter", iPos);
 		}
-		return ppData[iPos];}
 #endif
+		return CMatrixConstRow<TData>(Data() + iPos * iCol, iCol);}
+
+	inline CMatrixColumn<TData> Column(const int iPos) {
+#ifdef _DEBUG_
+		if ((iPos < 0) || (iPos > iCol - 1))
+		{
+			DebugError("Matrix: Column out of bounds", "Column size",
+				iCol, "New parameter", iPos);
+		}
+#endif
+		return CMatrixColumn<TData>(Data() + iPos, iRow, iCol);}
+
+	/* Pointer to the whole storage, row after row */
+	inline TData* Data() {return vecData.empty() ? NULL : &vecData[0];}
+	inline const TData* Data() const
+		{return vecData.empty() ? NULL : &vecData[0];}
+
 	inline int NumRows(void) const { return iRow;}
 	inline int NumColumns(void) const { return iCol;}
 
 protected:
-	CVector<TData>*	ppData;
+	vector<TData>	vecData;
 	int				iRow;
 	int				iCol;
 };
@@ -472,17 +725,10 @@ template<class TData> void CMatrix<TData>::Init(const int iNewRow,
 	iRow = iNewRow;
 	iCol = iNewColumn;
 
-	if (iRow > 0)
-	{
-		/* Delete resources from previous init */
-		if (ppData != NULL)
-			delete[] ppData;
-
-		/* Allocate new memory for history buffer */
-		ppData = new CVector<TData>[iRow];
-		for (int i = 0; i < iRow; i++)
-			ppData[i].Init(iNewColumn);
-	}
+	/* Clear old buffer and allocate one block for the whole matrix */
+	vecData.clear();
+	if ((iRow > 0) && (iCol > 0))
+		vecData.resize(iRow * iCol);
 }
 
 template<class TData> void CMatrix<TData>::Init(const int iNewRow,
@@ -499,17 +745,60 @@ template<class TData> void CMatrix<TData>::Init(const int iNewRow,
 template<class TData> void CMatrix<TData>::Reset(const TData tResetVal)
 {
 	/* Set all values to reset value */
-	for (int i = 0; i < iRow; i++)
-		for (int j = 0; j < ppData[i].Size(); j++)
-			ppData[i][j] = tResetVal;
+	std::fill(vecData.begin(), vecData.end(), tResetVal);
 }
 
-template<class TData> CMatrix<TData>::~CMatrix()
+
+/******************************************************************************\
+* CEquSigVec class                                                             *
+\******************************************************************************/
+/* Equalized cells stored as "structure of arrays": real part, imaginary part
+   and channel power each have their own contiguous array so that loops which
+   work on one component can be vectorized by the compiler */
+class CEquSigVec
 {
-	/* Delete buffer */
-	if (ppData != NULL)
-		delete[] ppData;
-}
+public:
+	CEquSigVec() : vecrReal(), vecrImag(), vecrChan() {}
+	CEquSigVec(const int iNeSi) {Init(iNeSi);}
+
+	void Init(const int iNewSize) {
+		vecrReal.assign(iNewSize, (_REAL) 0.0);
+		vecrImag.assign(iNewSize, (_REAL) 0.0);
+		vecrChan.assign(iNewSize, (_REAL) 0.0);}
+
+	/* Use this init to give all elements a defined value */
+	void Init(const int iNewSize, const CEquSig tIniVal) {
+		vecrReal.assign(iNewSize, tIniVal.cSig.real());
+		vecrImag.assign(iNewSize, tIniVal.cSig.imag());
+		vecrChan.assign(iNewSize, tIniVal.rChan);}
+
+	inline int Size() const {return (int) vecrReal.size();}
+
+	inline void Put(const int iPos, const CEquSig& tVal) {
+		vecrReal[iPos] = tVal.cSig.real();
+		vecrImag[iPos] = tVal.cSig.imag();
+		vecrChan[iPos] = tVal.rChan;}
+
+	inline CEquSig Get(const int iPos) const {
+		return CEquSig(_COMPLEX(vecrReal[iPos], vecrImag[iPos]),
+			vecrChan[iPos]);}
+
+	/* Direct access to the component arrays */
+	inline _REAL* Real() {return vecrReal.empty() ? NULL : &vecrReal[0];}
+	inline _REAL* Imag() {return vecrImag.empty() ? NULL : &vecrImag[0];}
+	inline _REAL* Chan() {return vecrChan.empty() ? NULL : &vecrChan[0];}
+	inline const _REAL* Real() const
+		{return vecrReal.empty() ? NULL : &vecrReal[0];}
+	inline const _REAL* Imag() const
+		{return vecrImag.empty() ? NULL : &vecrImag[0];}
+	inline const _REAL* Chan() const
+		{return vecrChan.empty() ? NULL : &vecrChan[0];}
+
+protected:
+	vector<_REAL>	vecrReal;
+	vector<_REAL>	vecrImag;
+	vector<_REAL>	vecrChan;
+};
 
 
 #endif // !defined(VECTOR_H__3B0BA660_CA6LIUBEFIB2B_23E7A0D31912__INCLUDED_)
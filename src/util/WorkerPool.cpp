@@ -0,0 +1,179 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	Small pool of threads for splitting the acquisition search into
+ *	independent tasks. The threads sleep while the receiver is locked, a call
+ *	to Run() wakes them, hands out the tasks one by one and waits for the
+ *	last result. Without Qt the tasks are run one after the other
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#include "WorkerPool.h"
+#include <climits>
+
+
+/* Implementation *************************************************************/
+CWorkerPool::CWorkerPool() : iNumThreads(0), Mutex(), StartCond(), DoneCond(),
+	pvecpTasks(NULL), iNextTask(0), iNumPending(0), iGeneration(0),
+	bQuit(FALSE)
+{
+}
+
+CWorkerPool::~CWorkerPool()
+{
+	SetNumThreads(0);
+}
+
+void CWorkerPool::SetNumThreads(int iNewNumThreads)
+{
+#ifdef QT_CORE_LIB
+	if (iNewNumThreads < 0)
+		iNewNumThreads = 0;
+
+	if (iNewNumThreads == iNumThreads)
+		return;
+
+	StopThreads();
+
+	for (int i = 0; i < iNewNumThreads; i++)
+	{
+		vecpWorkers.push_back(new CWorker(*this));
+		vecpWorkers.back()->start();
+	}
+	iNumThreads = iNewNumThreads;
+#else
+	(void)iNewNumThreads;
+#endif
+}
+
+int CWorkerPool::DefaultNumThreads(int iMaxTasks)
+{
+#ifdef QT_CORE_LIB
+	/* Leave one core for the rest of the receiver chain */
+	const int iNumThr = QThread::idealThreadCount() - 1;
+
+	if (iNumThr < 0)
+		return 0;
+	return iNumThr < iMaxTasks - 1 ? iNumThr : iMaxTasks - 1;
+#else
+	(void)iMaxTasks;
+	return 0;
+#endif
+}
+
+void CWorkerPool::Run(const vector<CWorkerTask*>& vecpTasks)
+{
+	/* Nothing to share */
+	if ((iNumThreads == 0) || (vecpTasks.size() < 2))
+	{
+		for (size_t i = 0; i < vecpTasks.size(); i++)
+			vecpTasks[i]->Run();
+		return;
+	}
+
+	Mutex.Lock();
+	pvecpTasks = &vecpTasks;
+	iNextTask = 0;
+	iNumPending = vecpTasks.size();
+	iGeneration++;
+	StartCond.WakeAll();
+	Mutex.Unlock();
+
+	RunTasks();
+
+	Mutex.Lock();
+	while (iNumPending > 0)
+		DoneCond.Wait(&Mutex, ULONG_MAX);
+	pvecpTasks = NULL;
+	Mutex.Unlock();
+}
+
+void CWorkerPool::RunTasks()
+{
+	for (;;)
+	{
+		Mutex.Lock();
+		if ((pvecpTasks == NULL) || (iNextTask >= pvecpTasks->size()))
+		{
+			Mutex.Unlock();
+			return;
+		}
+		CWorkerTask* pTask = (*pvecpTasks)[iNextTask];
+		iNextTask++;
+		Mutex.Unlock();
+
+		pTask->Run();
+
+		Mutex.Lock();
+		iNumPending--;
+		if (iNumPending == 0)
+			DoneCond.WakeAll();
+		Mutex.Unlock();
+	}
+}
+
+#ifdef QT_CORE_LIB
+void CWorkerPool::Work()
+{
+	unsigned int iSeenGeneration = 0;
+
+	Mutex.Lock();
+	iSeenGeneration = iGeneration;
+	for (;;)
+	{
+		while ((bQuit == FALSE) && (iGeneration == iSeenGeneration))
+			StartCond.Wait(&Mutex, ULONG_MAX);
+
+		if (bQuit == TRUE)
+			break;
+
+		iSeenGeneration = iGeneration;
+		Mutex.Unlock();
+
+		RunTasks();
+
+		Mutex.Lock();
+	}
+	Mutex.Unlock();
+}
+
+void CWorkerPool::StopThreads()
+{
+	Mutex.Lock();
+	bQuit = TRUE;
+	StartCond.WakeAll();
+	Mutex.Unlock();
+
+	for (size_t i = 0; i < vecpWorkers.size(); i++)
+	{
+		vecpWorkers[i]->wait();
+		delete vecpWorkers[i];
+	}
+	vecpWorkers.clear();
+	iNumThreads = 0;
+
+	Mutex.Lock();
+	bQuit = FALSE;
+	Mutex.Unlock();
+}
+#endif
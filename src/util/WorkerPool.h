@@ -0,0 +1,102 @@
+/******************************************************************************\
+ * Copyright (c) 2026
+ *
+ * Author(s):
+ *	Dream developers
+ *
+ * Description:
+ *	See WorkerPool.cpp
+ *
+ ******************************************************************************
+ *
+ * This program is free software; you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation; either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc.,
+ * 59 Temple Place, Suite 330, Boston, MA 02111-1307 USA
+ *
+\******************************************************************************/
+
+#ifndef WORKERPOOL_H_INCLUDED
+#define WORKERPOOL_H_INCLUDED
+
+#include "../GlobalDefinitions.h"
+#include <vector>
+
+#ifdef QT_CORE_LIB
+# include <QThread>
+#endif
+
+
+/* Classes ********************************************************************/
+/* One independent piece of work, the tasks given to one call of
+   CWorkerPool::Run() must not share any writable data */
+class CWorkerTask
+{
+public:
+	virtual ~CWorkerTask() {}
+	virtual void Run() = 0;
+};
+
+class CWorkerPool
+{
+public:
+	CWorkerPool();
+	virtual ~CWorkerPool();
+
+	/* Number of threads in addition to the calling thread. With "0" or
+	   without thread support all tasks are run by the caller */
+	void SetNumThreads(int iNewNumThreads);
+	int GetNumThreads() const {return iNumThreads;}
+
+	/* Number of additional threads if the user did not choose */
+	static int DefaultNumThreads(int iMaxTasks);
+
+	/* Runs all tasks and returns when the last one is finished. The caller
+	   works on the tasks, too */
+	void Run(const vector<CWorkerTask*>& vecpTasks);
+
+protected:
+	void RunTasks();
+
+	int							iNumThreads;
+
+	CMutex						Mutex;
+	CWaitCondition				StartCond;
+	CWaitCondition				DoneCond;
+	const vector<CWorkerTask*>*	pvecpTasks;
+	size_t						iNextTask;
+	size_t						iNumPending;
+	unsigned int				iGeneration;
+	_BOOLEAN					bQuit;
+
+#ifdef QT_CORE_LIB
+	class CWorker : public QThread
+	{
+	public:
+		CWorker(CWorkerPool& NewPool) : Pool(NewPool) {}
+	protected:
+		virtual void run() {Pool.Work();}
+		CWorkerPool& Pool;
+	};
+
+	void Work();
+	void StopThreads();
+
+	vector<CWorker*>			vecpWorkers;
+#endif
+
+private:
+	CWorkerPool(const CWorkerPool&);
+	CWorkerPool& operator=(const CWorkerPool&);
+};
+
+#endif